@@ -0,0 +1,120 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <robot2D/Ecs/SpatialIndex.hpp>
+
+namespace {
+    constexpr int objectsCount = 100000;
+    constexpr int framesCount = 10;
+    constexpr int queriesPerFrame = 100000;
+    constexpr float worldSize = 20000.F;
+
+    using Clock = std::chrono::steady_clock;
+
+    double elapsedSeconds(Clock::time_point start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+}
+
+int main() {
+    std::mt19937 generator{1};
+    std::uniform_real_distribution<float> position{0.F, worldSize};
+    std::uniform_real_distribution<float> size{4.F, 64.F};
+    std::uniform_real_distribution<float> velocity{-3.F, 3.F};
+
+    robot2D::ecs::SpatialIndex spatialIndex{};
+    std::vector<robot2D::FloatRect> rects(objectsCount);
+    std::vector<robot2D::vec2f> velocities(objectsCount);
+    std::vector<robot2D::ecs::SpatialIndex::ProxyID> proxies(objectsCount);
+
+    auto start = Clock::now();
+    for(int i = 0; i < objectsCount; ++i) {
+        rects[i] = { position(generator), position(generator), size(generator), size(generator) };
+        velocities[i] = { velocity(generator), velocity(generator) };
+        proxies[i] = spatialIndex.createProxy(rects[i], robot2D::ecs::Entity{});
+    }
+    std::printf("build: %d proxies in %.2f ms, height %d\n", objectsCount,
+                elapsedSeconds(start) * 1000.0, spatialIndex.getHeight());
+
+    std::vector<robot2D::FloatRect> queryRects(queriesPerFrame);
+    for(auto& rect: queryRects)
+        rect = { position(generator), position(generator), 128.F, 128.F };
+
+    double moveTime = 0.0;
+    double queryTime = 0.0;
+    std::size_t reinserted = 0;
+    std::size_t found = 0;
+    std::vector<robot2D::ecs::Entity> result;
+    result.reserve(256);
+
+    for(int frame = 0; frame < framesCount; ++frame) {
+        start = Clock::now();
+        for(int i = 0; i < objectsCount; ++i) {
+            rects[i].lx += velocities[i].x;
+            rects[i].ly += velocities[i].y;
+            if(spatialIndex.moveProxy(proxies[i], rects[i], velocities[i]))
+                ++reinserted;
+        }
+        moveTime += elapsedSeconds(start);
+
+        start = Clock::now();
+        for(const auto& rect: queryRects) {
+            result.clear();
+            spatialIndex.query(rect, result);
+            found += result.size();
+        }
+        queryTime += elapsedSeconds(start);
+    }
+
+    const double totalQueries = static_cast<double>(queriesPerFrame) * framesCount;
+    std::printf("move: %.2f ms per frame, %zu reinserts\n", moveTime * 1000.0 / framesCount, reinserted);
+    std::printf("random query: %.0f queries/s, %.1f hits per query\n", totalQueries / queryTime,
+                static_cast<double>(found) / totalQueries);
+
+    /// culling and hit-testing ask about neighbouring areas one after another, so tree nodes stay in cache
+    std::sort(queryRects.begin(), queryRects.end(), [](const robot2D::FloatRect& left,
+                                                       const robot2D::FloatRect& right) {
+        const auto leftRow = static_cast<int>(left.ly / 512.F);
+        const auto rightRow = static_cast<int>(right.ly / 512.F);
+        return leftRow != rightRow ? leftRow < rightRow : left.lx < right.lx;
+    });
+
+    found = 0;
+    start = Clock::now();
+    for(int frame = 0; frame < framesCount; ++frame) {
+        for(const auto& rect: queryRects) {
+            result.clear();
+            spatialIndex.query(rect, result);
+            found += result.size();
+        }
+    }
+    queryTime = elapsedSeconds(start);
+    std::printf("coherent query: %.0f queries/s, %.1f hits per query\n", totalQueries / queryTime,
+                static_cast<double>(found) / totalQueries);
+    return 0;
+}
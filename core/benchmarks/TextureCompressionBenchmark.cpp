@@ -0,0 +1,133 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include <robot2D/Graphics/Image.hpp>
+#include <robot2D/Graphics/ImageAtlas.hpp>
+#include <robot2D/Graphics/TextureCompression.hpp>
+#include <robot2D/Util/Logger.hpp>
+
+namespace {
+    constexpr unsigned int imageSide = 1024;
+    constexpr int decodeRepeats = 5;
+
+    using Clock = std::chrono::steady_clock;
+
+    double elapsedSeconds(Clock::time_point start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    /// Sprite like content: smooth shapes, some noise and transparent background.
+    robot2D::Image makeImage() {
+        std::mt19937 generator{1};
+        std::uniform_int_distribution<int> noise{-6, 6};
+        std::vector<std::uint8_t> pixels(imageSide * imageSide * 4);
+        for(unsigned int y = 0; y < imageSide; ++y) {
+            for(unsigned int x = 0; x < imageSide; ++x) {
+                auto* pixel = pixels.data() + (y * imageSide + x) * 4;
+                const float u = static_cast<float>(x) / imageSide;
+                const float v = static_cast<float>(y) / imageSide;
+                const float wave = std::sin(u * 40.F) * std::cos(v * 25.F);
+                pixel[0] = static_cast<std::uint8_t>(std::clamp(static_cast<int>(u * 255.F) + noise(generator), 0, 255));
+                pixel[1] = static_cast<std::uint8_t>(std::clamp(static_cast<int>(128.F + wave * 100.F), 0, 255));
+                pixel[2] = static_cast<std::uint8_t>(std::clamp(static_cast<int>(v * 255.F) + noise(generator), 0, 255));
+                const float distance = std::hypot(u - 0.5F, v - 0.5F);
+                pixel[3] = static_cast<std::uint8_t>(std::clamp(static_cast<int>((0.45F - distance) * 2550.F), 0, 255));
+            }
+        }
+        robot2D::Image image;
+        image.create({imageSide, imageSide}, pixels.data(), robot2D::ImageColorFormat::RGBA);
+        return image;
+    }
+}
+
+int main() {
+    logger::Log::Init();
+    const auto image = makeImage();
+    const std::size_t rawBytes = static_cast<std::size_t>(imageSide) * imageSide * 4;
+
+    /// PNG is what textures are loaded from now, stb decodes it on every load.
+    /// Image can't write PNG, single image atlas without padding is same image.
+    const auto pngPath = (std::filesystem::temp_directory_path() / "robot2D-compression-benchmark.png").string();
+    robot2D::ImageAtlasOptions atlasOptions;
+    atlasOptions.padding = 0;
+    atlasOptions.trim = false;
+    robot2D::ImageAtlas atlas;
+    if(!atlas.packAtlas({image}, {}, atlasOptions) || !atlas.saveAtlas(pngPath))
+        return 1;
+    std::ifstream pngFile{pngPath, std::ios::binary};
+    const std::vector<char> pngBytes{std::istreambuf_iterator<char>(pngFile), std::istreambuf_iterator<char>()};
+    pngFile.close();
+    std::filesystem::remove(pngPath);
+
+    auto start = Clock::now();
+    for(int repeat = 0; repeat < decodeRepeats; ++repeat) {
+        robot2D::Image decoded;
+        decoded.loadFromMemory(pngBytes.data(), pngBytes.size());
+    }
+    std::printf("RGBA8: %zu KB in VRAM, PNG %zu KB, PNG decode %.2f ms\n", rawBytes / 1024,
+                pngBytes.size() / 1024, elapsedSeconds(start) * 1000.0 / decodeRepeats);
+
+    const std::pair<robot2D::CompressedFormat, const char*> formats[] = {
+        {robot2D::CompressedFormat::BC1, "BC1"},
+        {robot2D::CompressedFormat::BC3, "BC3"},
+        {robot2D::CompressedFormat::BC7, "BC7"},
+        {robot2D::CompressedFormat::ETC2_RGB, "ETC2 RGB"},
+        {robot2D::CompressedFormat::ETC2_RGBA, "ETC2 RGBA"},
+    };
+
+    for(const auto& [format, name]: formats) {
+        robot2D::CompressedImage compressed;
+        start = Clock::now();
+        compressed.create(image, format, false);
+        const double encodeTime = elapsedSeconds(start);
+
+        std::vector<std::uint8_t> container;
+        compressed.saveToMemory(container);
+        start = Clock::now();
+        for(int repeat = 0; repeat < decodeRepeats; ++repeat) {
+            robot2D::CompressedImage loaded;
+            loaded.loadFromMemory(container.data(), container.size());
+        }
+        const double loadTime = elapsedSeconds(start) / decodeRepeats;
+
+        robot2D::Image decoded;
+        start = Clock::now();
+        compressed.decompress(decoded);
+        const double decodeTime = elapsedSeconds(start);
+
+        std::printf("%-9s: %zu KB (%.1fx smaller), encode %.1f ms, load %.2f ms, CPU fallback decode %.2f ms\n",
+                    name, compressed.getBytes() / 1024,
+                    static_cast<double>(rawBytes) / static_cast<double>(compressed.getBytes()),
+                    encodeTime * 1000.0, loadTime * 1000.0, decodeTime * 1000.0);
+    }
+    return 0;
+}
@@ -3,6 +3,7 @@
 #include <memory>
 #include <robot2D/Core/Event.hpp>
 #include <robot2D/Graphics/RenderWindow.hpp>
+#include <robot2D/Graphics/FramePacket.hpp>
 #include <robot2D/Core/MessageBus.hpp>
 
 namespace robot2D {
@@ -23,6 +24,9 @@ namespace robot2D {
         virtual void guiUpdate(float deltaTime);
         virtual void render() = 0;
 
+        /// \brief Pipelined render mode only. Fill packet for render thread, don't touch Graphics API here.
+        virtual void record(FramePacket& packet);
+
         bool isRunning() const;
     protected:
         bool m_running;
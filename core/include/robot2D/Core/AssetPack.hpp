@@ -0,0 +1,128 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <robot2D/Config.hpp>
+#include "MappedFileInputStream.hpp"
+#include "MemoryInputStream.hpp"
+
+namespace robot2D {
+
+    enum class AssetCompression: std::uint32_t {
+        None = 0,
+        LZ4
+    };
+
+    /// \brief Bytes of one asset, valid while AssetPack is open.
+    struct AssetView {
+        const std::uint8_t* data{nullptr};
+        std::size_t size{0};
+
+        explicit operator bool() const { return data != nullptr; }
+    };
+
+    /**
+     * \brief Read-only pack of assets, whole file is memory mapped.
+     * \details File is header, blobs aligned by 64 bytes and index of names at the end.
+     * Uncompressed blobs are given out as pointers into mapping, LZ4 blobs are decoded once on first request
+     * and kept by pack, so every AssetView lives as long as pack is open. getAsset can be called from any thread.
+     */
+    class ROBOT2D_EXPORT_API AssetPack {
+    public:
+        static constexpr std::uint32_t magic = 0x50413252; // "R2AP"
+        static constexpr std::uint16_t version = 1;
+        static constexpr std::size_t blobAlignment = 64;
+
+        AssetPack() = default;
+        AssetPack(const AssetPack& other) = delete;
+        AssetPack& operator=(const AssetPack& other) = delete;
+        AssetPack(AssetPack&& other) = delete;
+        AssetPack& operator=(AssetPack&& other) = delete;
+        ~AssetPack() = default;
+
+        bool openFromFile(const std::string& path);
+        void close();
+        bool isOpen() const { return m_file.isOpen(); }
+
+        bool hasAsset(const std::string& name) const;
+        /// Empty view if pack doesn't have asset or its blob is corrupted.
+        AssetView getAsset(const std::string& name);
+        bool openStream(const std::string& name, MemoryInputStream& stream);
+
+        std::vector<std::string> getAssetNames() const;
+    private:
+        struct Entry {
+            std::uint64_t offset;
+            std::uint64_t storedSize;
+            std::uint64_t size;
+            AssetCompression compression;
+        };
+
+        MappedFileInputStream m_file;
+        std::unordered_map<std::string, Entry> m_entries;
+        std::unordered_map<std::string, std::unique_ptr<std::uint8_t[]>> m_decoded;
+        std::mutex m_mutex;
+    };
+
+    /// \brief Builds AssetPack file, files are read only while pack is saved.
+    class ROBOT2D_EXPORT_API AssetPackWriter {
+    public:
+        /// Called after every written asset, returning false cancels saving.
+        using ProgressCallback = std::function<bool(std::size_t written, std::size_t total)>;
+
+        AssetPackWriter() = default;
+        AssetPackWriter(const AssetPackWriter& other) = delete;
+        AssetPackWriter& operator=(const AssetPackWriter& other) = delete;
+        AssetPackWriter(AssetPackWriter&& other) = delete;
+        AssetPackWriter& operator=(AssetPackWriter&& other) = delete;
+        ~AssetPackWriter() = default;
+
+        /// LZ4 blob falls back to None when compression doesn't make it smaller.
+        void addFile(const std::string& name, const std::string& path,
+                     AssetCompression compression = AssetCompression::None);
+        void addData(const std::string& name, std::vector<std::uint8_t>&& data,
+                     AssetCompression compression = AssetCompression::None);
+
+        bool saveToFile(const std::string& path, const ProgressCallback& progressCallback = {});
+        std::size_t getAssetsCount() const { return m_sources.size(); }
+    private:
+        struct Source {
+            std::string name;
+            std::string path;
+            std::vector<std::uint8_t> data;
+            AssetCompression compression;
+        };
+
+        std::vector<Source> m_sources;
+    };
+
+}
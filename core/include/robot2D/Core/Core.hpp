@@ -21,7 +21,9 @@ source distribution.
 
 #pragma once
 
+#include "AssetPack.hpp"
 #include "Event.hpp"
+#include "JobSystem.hpp"
 #include "Keyboard.hpp"
 #include "Mouse.hpp"
 #include "Vector2.hpp"
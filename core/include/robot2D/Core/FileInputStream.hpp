@@ -24,32 +24,35 @@ source distribution.
 #include <memory>
 #include <fstream>
 #include <cstdint>
+#include <string>
+
+#include "InputStream.hpp"
 
 namespace robot2D {
 
-    class FileInputStream {
+    class ROBOT2D_EXPORT_API FileInputStream: public InputStream {
     public:
         FileInputStream() = default;
         FileInputStream(const FileInputStream& other) = delete;
         FileInputStream& operator=(const FileInputStream& other) = delete;
         FileInputStream(FileInputStream&& other) = delete;
         FileInputStream& operator=(FileInputStream&& other) = delete;
-        ~FileInputStream() = default;
+        ~FileInputStream() override = default;
 
         /// \brief open's file as binary in reading mode only
         bool openFromFile(std::string path);
 
         /// \brief Read's buffer from File and move cursor byself.
-        std::uint64_t read(void* buffer, std::uint64_t size);
+        std::uint64_t read(void* buffer, std::uint64_t size) override;
 
         /// \brief Move file's actual cursor. If result == -1 endof file or can't get.
-        std::uint64_t seek(std::uint64_t position);
+        std::uint64_t seek(std::uint64_t position) override;
 
         /// \brief Get file's actual cursor. If result == -1 endof file or can't get.
-        std::uint64_t tell();
+        std::uint64_t tell() override;
 
         /// \brief Get file size.
-        std::uint64_t getSize();
+        std::uint64_t getSize() override;
     private:
         struct FileCloser {
             void operator()(std::FILE*);
@@ -0,0 +1,48 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#pragma once
+
+#include <cstdint>
+#include <robot2D/Config.hpp>
+
+namespace robot2D {
+
+    /// \brief Source of bytes for loaders, implemented by files, mapped files and memory blocks.
+    class ROBOT2D_EXPORT_API InputStream {
+    public:
+        virtual ~InputStream() = 0;
+
+        /// \brief Read's buffer from stream and move cursor byself.
+        virtual std::uint64_t read(void* buffer, std::uint64_t size) = 0;
+
+        /// \brief Move stream's actual cursor. If result == -1 endof stream or can't get.
+        virtual std::uint64_t seek(std::uint64_t position) = 0;
+
+        /// \brief Get stream's actual cursor. If result == -1 endof stream or can't get.
+        virtual std::uint64_t tell() = 0;
+
+        /// \brief Get stream size.
+        virtual std::uint64_t getSize() = 0;
+    };
+
+}
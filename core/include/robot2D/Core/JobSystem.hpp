@@ -0,0 +1,176 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <robot2D/Config.hpp>
+#include "Time.hpp"
+
+namespace robot2D {
+    namespace priv {
+        struct JobState;
+        class WorkStealingDeque;
+    }
+
+    /// \brief Order in which free workers pick up jobs and main thread drains their completions.
+    enum class JobPriority {
+        /// User waits for result, taken before anything else.
+        Interactive = 0,
+        Normal,
+        /// Bulk work like imports, taken only when nothing else is queued.
+        Background,
+        Count
+    };
+
+    /// \brief Shared reference to scheduled job, empty handle counts as finished job.
+    class ROBOT2D_EXPORT_API JobHandle {
+    public:
+        JobHandle() = default;
+        JobHandle(const JobHandle& other) = default;
+        JobHandle& operator=(const JobHandle& other) = default;
+        JobHandle(JobHandle&& other) = default;
+        JobHandle& operator=(JobHandle&& other) = default;
+        ~JobHandle() = default;
+
+        /// Work part of job has finished, main thread callback may still wait for drain.
+        bool isDone() const;
+        bool valid() const { return m_state != nullptr; }
+        explicit operator bool() const { return valid(); }
+    private:
+        friend class JobSystem;
+        explicit JobHandle(std::shared_ptr<priv::JobState> state): m_state{std::move(state)} {}
+
+        std::shared_ptr<priv::JobState> m_state{nullptr};
+    };
+
+    /**
+     * \brief Pool of workers which execute small jobs and steal them from each other.
+     * \details Every worker owns lock-free deque: it pushes and pops own jobs from bottom,
+     * idle workers steal from top of others. Jobs scheduled outside of workers go through shared queue.
+     * Job starts when all its dependencies finished, its completion callback is called on thread
+     * which drains completed jobs, usually main one.
+     * Interactive and Background jobs always go through shared queues, so priority is respected across workers.
+     */
+    class ROBOT2D_EXPORT_API JobSystem {
+    public:
+        using Work = std::function<void()>;
+        using Completion = std::function<void()>;
+        /// Processes [begin, end) part of range.
+        using RangeWork = std::function<void(std::size_t begin, std::size_t end)>;
+
+        /// \brief Pool shared by engine and application, so parallel parts don't oversubscribe cores.
+        static JobSystem& getInstance();
+
+        /// \brief Zero workers means hardware concurrency minus main thread, at least one.
+        explicit JobSystem(unsigned int workersCount = 0);
+        JobSystem(const JobSystem& other) = delete;
+        JobSystem& operator=(const JobSystem& other) = delete;
+        JobSystem(JobSystem&& other) = delete;
+        JobSystem& operator=(JobSystem&& other) = delete;
+        ~JobSystem();
+
+        JobHandle schedule(Work&& work, Completion&& completion = {},
+                           JobPriority priority = JobPriority::Normal);
+
+        /// \brief Job waits for all dependencies, empty handles are ignored.
+        JobHandle schedule(Work&& work, const std::vector<JobHandle>& dependencies,
+                           Completion&& completion = {}, JobPriority priority = JobPriority::Normal);
+
+        /// \brief Continuation which starts after parent's work.
+        JobHandle then(const JobHandle& parent, Work&& work, Completion&& completion = {},
+                       JobPriority priority = JobPriority::Normal);
+
+        /**
+         * \brief Blocks until job's work has finished.
+         * \details Worker executes other jobs while waiting, so it's safe to call from job itself.
+         * Other threads only run awaited job when it's still queued, so frame never stalls on background work.
+         */
+        void wait(const JobHandle& handle);
+
+        /**
+         * \brief Splits [0, count) into chunks and waits till all of them are processed.
+         * \details Chunk is at least minChunkSize long and there are no more chunks than workers plus calling thread,
+         * which processes first chunk itself and waits like wait does, so it's safe to call from job.
+         */
+        void parallelFor(std::size_t count, std::size_t minChunkSize, const RangeWork& work,
+                         JobPriority priority = JobPriority::Normal);
+
+        /**
+         * \brief Calls completion callbacks of finished jobs.
+         * \details Interactive completions go first. Stops after callback which exceeded budget,
+         * so at least one callback is called when any is ready.
+         * \return how many callbacks were called.
+         */
+        std::size_t drainCompleted(Time budget);
+
+        /// Jobs which work or completion callback hasn't finished yet.
+        bool hasPendingJobs() const { return m_pendingJobs.load(std::memory_order_acquire) > 0; }
+        unsigned int getWorkersCount() const { return static_cast<unsigned int>(m_workers.size()); }
+
+        /// Finishes queued jobs and joins workers, undrained completions are dropped.
+        /// Jobs scheduled after stop are executed on calling thread.
+        void stop();
+    private:
+        using JobPtr = std::shared_ptr<priv::JobState>;
+
+        static constexpr std::size_t prioritiesCount = static_cast<std::size_t>(JobPriority::Count);
+
+        JobHandle makeJob(Work&& work, Completion&& completion, const std::vector<JobHandle>& dependencies,
+                          JobPriority priority);
+        priv::JobState* popShared(JobPriority priority);
+        void enqueue(priv::JobState* job);
+        priv::JobState* takeJob(int workerIndex);
+        /// Removes job from shared queue if nobody has taken it yet.
+        bool takeQueued(priv::JobState* job);
+        void execute(priv::JobState* job, int workerIndex);
+        void finish(priv::JobState* job, int workerIndex);
+        void workerThread(int workerIndex);
+        int currentWorkerIndex() const;
+    private:
+        std::vector<std::thread> m_workers;
+        std::vector<std::unique_ptr<priv::WorkStealingDeque>> m_deques;
+
+        std::mutex m_sharedMutex;
+        std::array<std::deque<priv::JobState*>, prioritiesCount> m_sharedQueues;
+
+        std::mutex m_completedMutex;
+        std::array<std::deque<JobPtr>, prioritiesCount> m_completedJobs;
+
+        std::mutex m_sleepMutex;
+        std::condition_variable m_sleepCondition;
+        std::atomic<int> m_queuedJobs{0};
+        std::atomic<int> m_pendingJobs{0};
+        std::atomic<bool> m_running{false};
+        std::atomic<bool> m_joined{false};
+    };
+
+}
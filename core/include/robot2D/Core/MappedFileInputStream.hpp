@@ -0,0 +1,66 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "MemoryInputStream.hpp"
+
+namespace robot2D {
+
+    /**
+     * \brief Maps whole file into memory read-only.
+     * \details Reading doesn't copy file through OS buffers, getData gives pointer into mapping,
+     * which stays valid until stream is closed or destroyed.
+     */
+    class ROBOT2D_EXPORT_API MappedFileInputStream: public InputStream {
+    public:
+        MappedFileInputStream() = default;
+        MappedFileInputStream(const MappedFileInputStream& other) = delete;
+        MappedFileInputStream& operator=(const MappedFileInputStream& other) = delete;
+        MappedFileInputStream(MappedFileInputStream&& other) = delete;
+        MappedFileInputStream& operator=(MappedFileInputStream&& other) = delete;
+        ~MappedFileInputStream() override;
+
+        bool openFromFile(const std::string& path);
+        void close();
+        bool isOpen() const { return m_data != nullptr; }
+
+        std::uint64_t read(void* buffer, std::uint64_t size) override;
+        std::uint64_t seek(std::uint64_t position) override;
+        std::uint64_t tell() override;
+        std::uint64_t getSize() override;
+
+        const std::uint8_t* getData() const { return m_data; }
+        std::size_t getDataSize() const { return m_size; }
+    private:
+        const std::uint8_t* m_data{nullptr};
+        std::size_t m_size{0};
+        /// Native mapping handle, used only on Windows.
+        void* m_mapping{nullptr};
+        MemoryInputStream m_stream;
+    };
+
+}
@@ -0,0 +1,58 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "InputStream.hpp"
+
+namespace robot2D {
+
+    /// \brief Reads block of memory it doesn't own, block must outlive stream.
+    class ROBOT2D_EXPORT_API MemoryInputStream: public InputStream {
+    public:
+        MemoryInputStream() = default;
+        MemoryInputStream(const void* data, std::size_t size);
+        MemoryInputStream(const MemoryInputStream& other) = default;
+        MemoryInputStream& operator=(const MemoryInputStream& other) = default;
+        MemoryInputStream(MemoryInputStream&& other) = default;
+        MemoryInputStream& operator=(MemoryInputStream&& other) = default;
+        ~MemoryInputStream() override = default;
+
+        void open(const void* data, std::size_t size);
+
+        std::uint64_t read(void* buffer, std::uint64_t size) override;
+        std::uint64_t seek(std::uint64_t position) override;
+        std::uint64_t tell() override;
+        std::uint64_t getSize() override;
+
+        /// Whole block, loaders which accept memory can use it without copy.
+        const std::uint8_t* getData() const { return m_data; }
+    private:
+        const std::uint8_t* m_data{nullptr};
+        std::size_t m_size{0};
+        std::size_t m_position{0};
+    };
+
+}
@@ -87,6 +87,26 @@ namespace robot2D {
         ///
         void display();
 
+        ///
+        /// \brief only swap buffers, for render thread which doesn't own OS events
+        ///
+        void swapBuffers();
+
+        ///
+        /// \brief only process OS events, must be called from thread which created window
+        ///
+        void processEvents();
+
+        ///
+        /// \brief bind / unbind render context to calling thread
+        ///
+        void setActive(bool flag);
+
+        ///
+        /// \brief size of default framebuffer in pixels, differs from window size on HiDPI screens
+        ///
+        vec2u getFramebufferSize() const;
+
         void setTitle(const std::string& title);
 
         void setSize(const robot2D::vec2u& size);
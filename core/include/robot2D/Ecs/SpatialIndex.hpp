@@ -0,0 +1,201 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include <robot2D/Config.hpp>
+#include <robot2D/Core/Vector2.hpp>
+#include <robot2D/Graphics/Rect.hpp>
+
+#include "Entity.hpp"
+
+namespace robot2D::ecs {
+
+    /**
+     * \brief Dynamic AABB tree to answer rect, point and ray queries over entities.
+     * \details Each proxy keeps fat AABB enlarged by margin, so small movements don't touch tree at all.
+     * Tree is kept balanced by rotations on insertion, nodes are stored in one array and reused through free list.
+     * Rotation of rects is ignored, pass bounding box of rotated object.
+     */
+    class ROBOT2D_EXPORT_API SpatialIndex {
+    public:
+        using ProxyID = std::int32_t;
+        static constexpr ProxyID nullProxy = -1;
+
+        struct RayHit {
+            Entity entity;
+            /// Position of hit on segment, 0 is start and 1 is end.
+            float fraction;
+        };
+
+        explicit SpatialIndex(float fatMargin = 4.F);
+        SpatialIndex(const SpatialIndex& other) = delete;
+        SpatialIndex& operator=(const SpatialIndex& other) = delete;
+        SpatialIndex(SpatialIndex&& other) = delete;
+        SpatialIndex& operator=(SpatialIndex&& other) = delete;
+        ~SpatialIndex() = default;
+
+        ProxyID createProxy(const FloatRect& rect, Entity entity);
+        void destroyProxy(ProxyID proxyID);
+
+        /// \brief Updates proxy bounds, displacement enlarges fat AABB in direction of movement.
+        /// \return true if proxy was reinserted into tree.
+        bool moveProxy(ProxyID proxyID, const FloatRect& rect, const vec2f& displacement = {});
+
+        void clear();
+
+        /// Appends entities which bounds intersect rect.
+        void query(const FloatRect& rect, std::vector<Entity>& result) const;
+        /// Appends entities which bounds contain point.
+        void query(const vec2f& point, std::vector<Entity>& result) const;
+        /// Appends entities crossed by segment, sorted from start to end.
+        void rayCast(const vec2f& from, const vec2f& to, std::vector<RayHit>& result) const;
+
+        /// \brief Calls callback(ProxyID) for every intersected proxy, return false from callback to stop query.
+        template<typename Callback>
+        void query(const FloatRect& rect, Callback&& callback) const;
+
+        Entity getEntity(ProxyID proxyID) const { return m_links[proxyID].entity; }
+        FloatRect getFatRect(ProxyID proxyID) const;
+        std::size_t getProxyCount() const { return m_proxyCount; }
+        int getHeight() const { return m_root == nullProxy ? 0 : m_links[m_root].height; }
+    private:
+        struct AABB {
+            float minX{0.F};
+            float minY{0.F};
+            float maxX{0.F};
+            float maxY{0.F};
+
+            bool overlaps(const AABB& other) const {
+                return minX <= other.maxX && other.minX <= maxX && minY <= other.maxY && other.minY <= maxY;
+            }
+
+            bool contains(const AABB& other) const {
+                return minX <= other.minX && minY <= other.minY && other.maxX <= maxX && other.maxY <= maxY;
+            }
+
+            float perimeter() const { return 2.F * ((maxX - minX) + (maxY - minY)); }
+
+            static AABB combine(const AABB& left, const AABB& right);
+            static AABB fromRect(const FloatRect& rect);
+        };
+
+        /// Traversal touches only these 24 bytes, everything else lives in NodeLink.
+        struct Node {
+            AABB fatAABB;
+            ProxyID child1{nullProxy};
+            ProxyID child2{nullProxy};
+
+            bool isLeaf() const { return child1 == nullProxy; }
+        };
+
+        struct NodeLink {
+            /// Real bounds of leaf, internal nodes test only fat ones.
+            AABB aabb;
+            Entity entity;
+            /// Next free node when node is in free list.
+            ProxyID parent{nullProxy};
+            /// leaf = 0, free node = -1
+            int height{-1};
+        };
+
+        ProxyID allocateNode();
+        void freeNode(ProxyID nodeID);
+        void insertLeaf(ProxyID leaf);
+        void removeLeaf(ProxyID leaf);
+        /// Balances and refits bounds from index up to root.
+        void refit(ProxyID index);
+        ProxyID balance(ProxyID nodeID);
+        AABB makeFat(const AABB& aabb, const vec2f& displacement) const;
+
+        /// Walks nodes which fat AABB passes nodeTest, leafCallback(ProxyID) returns false to stop.
+        template<typename NodeTest, typename LeafCallback>
+        void traverse(NodeTest&& nodeTest, LeafCallback&& leafCallback) const;
+    private:
+        std::vector<Node> m_nodes;
+        std::vector<NodeLink> m_links;
+        ProxyID m_root{nullProxy};
+        ProxyID m_freeList{nullProxy};
+        std::size_t m_proxyCount{0};
+        float m_fatMargin;
+    };
+
+    template<typename NodeTest, typename LeafCallback>
+    void SpatialIndex::traverse(NodeTest&& nodeTest, LeafCallback&& leafCallback) const {
+        if(m_root == nullProxy)
+            return;
+
+        /// balanced tree rarely is deeper than fixed stack, heap is used only then
+        constexpr std::size_t fixedStackSize = 128;
+        ProxyID fixedStack[fixedStackSize];
+        std::vector<ProxyID> heapStack;
+        std::size_t stackSize = 0;
+        auto push = [&](ProxyID nodeID) {
+            if(stackSize < fixedStackSize)
+                fixedStack[stackSize] = nodeID;
+            else
+                heapStack.push_back(nodeID);
+            ++stackSize;
+        };
+        auto pop = [&]() {
+            --stackSize;
+            if(stackSize < fixedStackSize)
+                return fixedStack[stackSize];
+            const auto nodeID = heapStack.back();
+            heapStack.pop_back();
+            return nodeID;
+        };
+
+        push(m_root);
+        while(stackSize > 0) {
+            const auto nodeID = pop();
+
+            const auto& node = m_nodes[nodeID];
+            if(!nodeTest(node.fatAABB))
+                continue;
+
+            if(node.isLeaf()) {
+                if(!leafCallback(nodeID))
+                    return;
+            }
+            else {
+                push(node.child1);
+                push(node.child2);
+            }
+        }
+    }
+
+    template<typename Callback>
+    void SpatialIndex::query(const FloatRect& rect, Callback&& callback) const {
+        const auto aabb = AABB::fromRect(rect);
+        traverse([&aabb](const AABB& fatAABB) { return fatAABB.overlaps(aabb); },
+                 [this, &aabb, &callback](ProxyID proxyID) {
+            if(!m_links[proxyID].aabb.overlaps(aabb))
+                return true;
+            return static_cast<bool>(callback(proxyID));
+        });
+    }
+
+}
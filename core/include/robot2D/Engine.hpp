@@ -20,6 +20,11 @@ namespace robot2D {
         std::string windowTitle;
         int maxFrameRate;
         WindowContext windowContext;
+
+        /// \brief Render on dedicated thread one frame behind simulation.
+        /// \details Application fills FramePacket in record instead of drawing in render,
+        /// guiUpdate and render are not called in this mode.
+        bool pipelinedRender;
     };
 
     class Engine {
@@ -31,6 +36,8 @@ namespace robot2D {
                  EngineConfiguration&& engineConfiguration);
     private:
         void setup();
+        void runPipelined(RenderWindow& renderWindow, float timePerFrame);
+        void processFrame(RenderWindow& renderWindow, float timePerFrame, float& timeProcessed);
     private:
         Application::Ptr m_application;
         Clock m_frameClock;
@@ -0,0 +1,41 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include <robot2D/Config.hpp>
+#include <robot2D/Core/Vector2.hpp>
+
+namespace robot2D {
+
+    /**
+     * \brief Builds signed distance field of coverage bitmap using exact euclidean distance transform.
+     * \details Field is padded by spread pixels on every side, so it's (size + 2 * spread) large.
+     * 128 lies on shape's edge, 255 is spread or more pixels inside and 0 is spread or more pixels outside.
+     * Function doesn't touch shared state and can run on any thread.
+     */
+    ROBOT2D_EXPORT_API void generateDistanceField(const std::uint8_t* coverage, const vec2i& size, int spread,
+                                                  std::vector<std::uint8_t>& field);
+
+}
@@ -1,21 +1,23 @@
 #pragma once
 
 #include <array>
-#include <unordered_map>
+#include <memory>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <utility>
 
-#include <robot2D/Graphics/Image.hpp>
+#include <robot2D/Core/Vector2.hpp>
 #include <robot2D/Graphics/VertexArray.hpp>
 
 namespace robot2D {
 
-    struct GlyphCharacter {
-        robot2D::vec2f size;
+    /// Rasterized glyph, rows go top to bottom.
+    struct GlyphBitmap {
+        robot2D::vec2i size;
         robot2D::vec2i bearing;
-        robot2D::vec2f indexPosition;
-        robot2D::vec2f bmpSize;
-
-        float advance;
-        float textureIndex;
+        float advance{0.F};
+        std::vector<std::uint8_t> pixels;
     };
 
     struct GlyphVertex {
@@ -27,32 +29,83 @@ namespace robot2D {
         std::array<GlyphVertex, 4> vertices;
     };
 
-    /// Not' thread safe because if load in thread, we create textures onto other thread
+    /// How glyphs of font are rendered.
+    enum class FontRenderMode {
+        /// Coverage rasterized for every character size.
+        Bitmap = 0,
+        /// Signed distance field generated once at Font::sdfGlyphSize and scaled to any size by text shader.
+        SDF
+    };
+
+    /// Glyphs are rasterized on demand by GlyphCache, so loading doesn't touch Graphics API.
+    /// Not thread safe: FreeType face is shared with clones.
     class Font {
     public:
+        /// Prepared distance fields by codepoint, they don't depend on face object and can be stored.
+        using SdfGlyphs = std::vector<std::pair<std::uint32_t, GlyphBitmap>>;
+
+        /// Size SDF glyphs are generated at.
+        static constexpr unsigned int sdfGlyphSize = 48;
+        /// Distance in pixels of sdfGlyphSize which SDF glyph covers around its edge.
+        static constexpr int sdfSpread = 6;
+        /// Printable ASCII, generated while SDF font loads.
+        static constexpr std::uint32_t sdfPreparedFirst = 32;
+        static constexpr std::uint32_t sdfPreparedLast = 126;
+
         Font();
         ~Font();
 
+        /// Shares FreeType face of font, face lives while any of its fonts does.
         bool clone(Font& font);
 
-        bool loadFromFile(const std::string& path, int charSize = 20);
+        /// In SDF mode printable ASCII glyphs are generated on worker threads during loading.
+        bool loadFromFile(const std::string& path, int charSize = 20,
+                          FontRenderMode renderMode = FontRenderMode::Bitmap);
+        /// Font file's bytes aren't copied, they must outlive font (asset pack entry, for example).
+        bool loadFromMemory(const void* data, std::size_t size, int charSize = 20,
+                            FontRenderMode renderMode = FontRenderMode::Bitmap);
+        /// SDF loading which reuses prepared glyphs: empty glyphs are filled by generated ones,
+        /// otherwise they're added to GlyphCache as is and distance transform is skipped.
+        bool loadFromFile(const std::string& path, int charSize, SdfGlyphs& glyphs);
+        bool loadFromMemory(const void* data, std::size_t size, int charSize, SdfGlyphs& glyphs);
+        /// Size of laid out text at default character size, '\n' starts new line.
         vec2f calculateSize(std::string&& text) const;
 
         const std::string& getPath() const { return m_path; }
-        std::unordered_map<int, GlyphQuad> getBufferCache(float scale) const;
-        const std::unordered_map<int, GlyphCharacter>& getGlyphCharacters() const;
-        const std::vector<std::unique_ptr<robot2D::Image>>& getImages() const;
+        /// Character size font was loaded with.
+        unsigned int getCharacterSize() const { return m_characterSize; }
+        FontRenderMode getRenderMode() const { return m_renderMode; }
+
+        /// Horizontal kerning between two codepoints at characterSize, 0 when font has no kerning table.
+        float getKerning(std::uint32_t left, std::uint32_t right, unsigned int characterSize) const;
+        /// Distance between baselines of neighbour lines at characterSize.
+        float getLineSpacing(unsigned int characterSize) const;
+
+        /// Renders codepoint at characterSize, glyph without pixels (space) has empty bitmap.
+        bool rasterizeGlyph(std::uint32_t codepoint, unsigned int characterSize, GlyphBitmap& bitmap) const;
+
+        /// Renders codepoint at sdfGlyphSize and turns it into distance field padded by sdfSpread.
+        bool rasterizeSdfGlyph(std::uint32_t codepoint, GlyphBitmap& bitmap) const;
     private:
+        friend class GlyphCache;
+        friend class TextLayoutCache;
+
         bool setup(const std::string& path, int charSize);
-        void setupAtlas();
+        bool setup(const void* data, std::size_t size, int charSize);
+        void setup(void* library, void* face, int charSize, FontRenderMode renderMode);
+        /// Forgets face, its glyphs are dropped from GlyphCache when it was the last owner.
+        void release();
+        void prepareSdfGlyphs(SdfGlyphs& glyphs);
+        /// Thread safe part of rasterizeSdfGlyph.
+        static void toDistanceField(GlyphBitmap& bitmap);
     private:
-        void* m_library{nullptr};
+        /// FreeType library and face, shared with clones.
+        std::shared_ptr<void> m_handle;
         void* m_face{nullptr};
 
-        std::vector<std::unique_ptr<robot2D::Image>> m_images;
-        std::unordered_map<int, GlyphCharacter> m_glyphCharacters;
+        unsigned int m_characterSize{0};
+        FontRenderMode m_renderMode{FontRenderMode::Bitmap};
         std::string m_path;
     };
 
 }
-
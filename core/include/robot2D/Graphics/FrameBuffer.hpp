@@ -24,10 +24,22 @@ source distribution.
 #include <memory>
 #include <vector>
 #include <robot2D/Core/Vector2.hpp>
+#include "Rect.hpp"
 
 namespace robot2D {
 
     using RenderID = uint32_t;
+    using ReadbackID = uint32_t;
+    constexpr ReadbackID invalidReadback = 0;
+
+    enum class ReadbackStatus {
+        /// GPU hasn't finished copy yet, ask again next frame.
+        Pending = 0,
+        /// Pixels were copied into result.
+        Ready,
+        /// Request is unknown or was overwritten by newer ones, it never becomes ready.
+        Dropped
+    };
 
     enum class FrameBufferTextureFormat {
         None = 0,
@@ -75,7 +87,22 @@ namespace robot2D {
         virtual ~FrameBuffer() = 0;
         virtual void Bind() = 0;
         virtual void unBind() = 0;
+        /// \brief Fills integer attachment with value, framebuffer has to be bound.
+        virtual void clearAttachment(RenderID attachmentIndex, int value) = 0;
+
+        /// \brief Reads integer pixel synchronously, stalls until GPU finishes all queued work.
         virtual int readPixel(RenderID attachmentIndex, vec2i mousePos) = 0;
+
+        /**
+         * \brief Queues non-blocking read of integer attachment area.
+         * \details Pixels are copied into GPU side buffer, result usually is ready one or two frames later.
+         * Only few requests are kept in flight, oldest ones are dropped when caller doesn't fetch them.
+         * Area is clamped to framebuffer, invalidReadback is returned when nothing is left.
+         */
+        virtual ReadbackID requestPixels(RenderID attachmentIndex, const IntRect& area) = 0;
+
+        /// \brief Copies finished request's pixels row by row from bottom, never waits for GPU.
+        virtual ReadbackStatus fetchPixels(ReadbackID readbackID, std::vector<int>& result) = 0;
         virtual void Invalidate() = 0;
         virtual void Resize(const robot2D::vec2u& newSize) = 0;
         virtual const RenderID& getFrameBufferRenderID(uint32_t index = 0) const = 0;
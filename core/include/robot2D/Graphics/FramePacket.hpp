@@ -0,0 +1,59 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <utility>
+
+#include <robot2D/Config.hpp>
+#include "Color.hpp"
+#include "View.hpp"
+#include "RenderCommandList.hpp"
+
+namespace robot2D {
+
+    /**
+     * \brief Everything render thread needs to draw one frame.
+     * \details In pipelined mode simulation fills packet in Application::record,
+     * after that packet belongs to render thread and is only read until it's returned for next frames.
+     */
+    struct ROBOT2D_EXPORT_API FramePacket {
+        /// Views by layer, applied before commands are submitted.
+        std::vector<std::pair<unsigned int, View>> views;
+        RenderCommandList commands;
+        Color clearColor{Color::Black};
+        /// Window's framebuffer size, render thread updates viewport when it changes.
+        vec2u framebufferSize{};
+
+        void setView(const View& view, unsigned int layerID = 1) {
+            views.emplace_back(layerID, view);
+        }
+
+        /// Keeps allocated memory for next frame.
+        void reset() {
+            views.clear();
+            commands.clear();
+            clearColor = Color::Black;
+        }
+    };
+
+}
@@ -0,0 +1,140 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#pragma once
+
+#include <mutex>
+#include <memory>
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <unordered_map>
+
+#include <robot2D/Config.hpp>
+#include "Font.hpp"
+#include "Image.hpp"
+#include "Texture.hpp"
+#include "SkylinePacker.hpp"
+
+namespace robot2D {
+
+    /// Glyph placed onto atlas page.
+    struct Glyph {
+        /// Positions are relative to pen at top line of text, uvs point into page.
+        GlyphQuad quad;
+        vec2f size;
+        float advance{0.F};
+        /// -1 when glyph has no pixels (space, for example).
+        int page{-1};
+    };
+
+    /// Reads codepoint starting at index and moves index past it, broken sequence gives U+FFFD.
+    ROBOT2D_EXPORT_API std::uint32_t decodeUtf8(const std::string& text, std::size_t& index);
+
+    /**
+     * \brief Process-wide glyph atlas shared by all texts.
+     * \details Glyphs are keyed by (font face, character size, codepoint) and rasterized on first request
+     * into RED pages packed by SkylinePacker, SDF fonts keep one glyph per codepoint for all sizes.
+     * Pages keep CPU copy and are uploaded lazily by getPageTexture,
+     * so glyphs can be requested from any thread, but textures are touched only on render thread.
+     * When all pages are used least recently used page is cleared as whole and generation grows,
+     * texts compare generation to know their geometry points to stale page.
+     */
+    class ROBOT2D_EXPORT_API GlyphCache {
+    public:
+        static constexpr unsigned int pageSize = 1024;
+        static constexpr unsigned int defaultMaxPages = 4;
+
+        static GlyphCache& getInstance();
+
+        GlyphCache(const GlyphCache& other) = delete;
+        GlyphCache& operator=(const GlyphCache& other) = delete;
+        GlyphCache(GlyphCache&& other) = delete;
+        GlyphCache& operator=(GlyphCache&& other) = delete;
+        ~GlyphCache();
+
+        /// Returns cached glyph or rasterizes it, false if font can't render codepoint.
+        /// SDF font's glyphs are shared by all sizes and scaled to characterSize.
+        bool getGlyph(const Font& font, unsigned int characterSize, std::uint32_t codepoint, Glyph& glyph);
+
+        /// Adds glyphs rendered outside of cache, SDF font's glyphs must come from Font::rasterizeSdfGlyph.
+        void addGlyphs(const Font& font, unsigned int characterSize,
+                       const std::vector<std::pair<std::uint32_t, GlyphBitmap>>& glyphs);
+
+        /// Uploads page's new glyphs and returns its texture. Call on render thread.
+        const Texture* getPageTexture(int page);
+
+        /// Drops glyphs of font, called when font is destroyed.
+        void removeFont(const Font& font);
+
+        void setMaxPages(unsigned int maxPages);
+        std::size_t getPagesCount() const;
+
+        /// Grows when cached glyphs become invalid.
+        std::uint64_t getGeneration() const;
+    private:
+        GlyphCache() = default;
+
+        struct Key {
+            const void* face;
+            unsigned int characterSize;
+            std::uint32_t codepoint;
+
+            bool operator==(const Key& other) const {
+                return face == other.face && characterSize == other.characterSize && codepoint == other.codepoint;
+            }
+        };
+
+        struct KeyHash {
+            std::size_t operator()(const Key& key) const;
+        };
+
+        struct Page {
+            Image image;
+            SkylinePacker packer{{pageSize, pageSize}, 1};
+            std::unique_ptr<Texture> texture;
+            std::vector<Key> glyphs;
+            /// Rows changed since last upload, [dirtyBegin, dirtyEnd).
+            int dirtyBegin{0};
+            int dirtyEnd{0};
+            std::uint64_t lastUse{0};
+        };
+
+        Key makeKey(const Font& font, unsigned int characterSize, std::uint32_t codepoint) const;
+        bool insertGlyph(const Font& font, const Key& key, unsigned int characterSize,
+                         const GlyphBitmap& bitmap, Glyph& glyph);
+        bool placeGlyph(const Key& key, const GlyphBitmap& bitmap, Glyph& glyph);
+        int findPage(const vec2u& size, IntRect& placed);
+        void clearPage(std::size_t index);
+        /// Distance from top line to baseline, taken from 'H' like old per-font atlas did.
+        float getBaseline(const Font& font, unsigned int characterSize);
+    private:
+        mutable std::mutex m_mutex;
+        std::unordered_map<Key, Glyph, KeyHash> m_glyphs;
+        std::unordered_map<Key, float, KeyHash> m_baselines;
+        std::vector<std::unique_ptr<Page>> m_pages;
+        unsigned int m_maxPages{defaultMaxPages};
+        std::uint64_t m_useTick{0};
+        std::uint64_t m_generation{0};
+    };
+
+}
@@ -30,8 +30,11 @@ source distribution.
 #include "RenderWindow.hpp"
 #include "Shader.hpp"
 #include "Texture.hpp"
+#include "TextureResidency.hpp"
+#include "TextureCompression.hpp"
 #include "ImageAtlas.hpp"
 #include "Transform.hpp"
 #include "Transformable.hpp"
 #include "View.hpp"
-#include "Vertex.hpp"
\ No newline at end of file
+#include "Vertex.hpp"
+#include "FramePacket.hpp"
\ No newline at end of file
@@ -21,9 +21,13 @@ source distribution.
 
 #pragma once
 
+#include <new>
 #include <string>
 #include <vector>
 #include <cstdint>
+#include <cstdlib>
+#include <utility>
+#include <type_traits>
 #include <robot2D/Core/Vector2.hpp>
 
 namespace robot2D {
@@ -39,6 +43,61 @@ namespace robot2D {
         ClampToEdge
     };
 
+    /**
+     * \brief Allocator of pixel buffers, memory comes from malloc as decoder's one.
+     * \details Allocator made with block returns it on first allocation, so decoded pixels are adopted
+     * by buffer without copy. Elements are default initialized, adopted pixels aren't overwritten
+     * and resize doesn't clear memory which is going to be filled anyway.
+     */
+    template<typename T>
+    class PixelAllocator {
+    public:
+        using value_type = T;
+        using is_always_equal = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+
+        PixelAllocator() = default;
+        /// Block should be allocated by malloc and hold all elements of first allocation.
+        explicit PixelAllocator(void* block) noexcept: m_block{static_cast<T*>(block)} {}
+        template<typename U>
+        PixelAllocator(const PixelAllocator<U>&) noexcept {}
+
+        T* allocate(std::size_t count) {
+            if(auto* block = std::exchange(m_block, nullptr))
+                return block;
+            auto* memory = static_cast<T*>(std::malloc(count * sizeof(T)));
+            if(!memory)
+                throw std::bad_alloc{};
+            return memory;
+        }
+
+        void deallocate(T* pointer, std::size_t) noexcept {
+            std::free(pointer);
+        }
+
+        template<typename U>
+        void construct(U* pointer) noexcept(std::is_nothrow_default_constructible_v<U>) {
+            ::new(static_cast<void*>(pointer)) U;
+        }
+
+        template<typename U, typename... Args>
+        void construct(U* pointer, Args&&... args) {
+            ::new(static_cast<void*>(pointer)) U(std::forward<Args>(args)...);
+        }
+
+        /// Copies never get adopted block.
+        PixelAllocator select_on_container_copy_construction() const { return {}; }
+
+        template<typename U>
+        bool operator==(const PixelAllocator<U>&) const noexcept { return true; }
+        template<typename U>
+        bool operator!=(const PixelAllocator<U>&) const noexcept { return false; }
+    private:
+        T* m_block{nullptr};
+    };
+
+    using PixelBuffer = std::vector<std::uint8_t, PixelAllocator<std::uint8_t>>;
+
     /**
      * \brief Stores Pixel Buffer in independ format.
      * \details Under robot2D::Texture using Image.
@@ -46,19 +105,31 @@ namespace robot2D {
      */
     class ROBOT2D_EXPORT_API Image {
     public:
+        /// Block of box filter is summed in 16 bits.
+        static constexpr unsigned int maxDownsampleFactor = 256;
+
         /// \brief Not create pixel buffer only initialize.
         /// \details To fill pixel buffer either use create method to create from own pixel buffer or
         /// load image from disk.
         Image();
+        Image(const Image& other) = default;
+        Image& operator=(const Image& other) = default;
+        /// Moved from image is empty.
+        Image(Image&& other) noexcept;
+        Image& operator=(Image&& other) noexcept;
         ~Image() = default;
 
         /**
          * \brief load image from disk.
+         * \details Decoded pixels become image's buffer without copy.
          * @param path absolute or relative path to file on disk.
          * @return Were loading process is success?
          */
         bool loadFromFile(const std::string& path, int desiredChannels = 0);
 
+        /// \brief decode image from encoded file's bytes, for example asset pack entry.
+        bool loadFromMemory(const void* data, std::size_t size, int desiredChannels = 0);
+
         /// Full size.
         const robot2D::vec2u& getSize() const;
 
@@ -71,7 +142,7 @@ namespace robot2D {
         const ImageParameter& getImageParameter() const;
 
         /// Returns pixelBuffer which not possible to modificate.
-        const std::vector<std::uint8_t>& getBuffer() const;
+        const PixelBuffer& getBuffer() const;
 
         /// Returns pixelBuffer which possible to modificate.
         std::uint8_t* getBuffer();
@@ -80,11 +151,25 @@ namespace robot2D {
         bool create(const vec2u& size, const void* data, const ImageColorFormat&,
                     const ImageParameter& parameter = ImageParameter::Repeat);
 
+        /// Takes filled buffer without copy, it should hold size.x * size.y pixels of colorFormat.
+        bool create(const vec2u& size, PixelBuffer&& pixels, const ImageColorFormat& colorFormat,
+                    const ImageParameter& parameter = ImageParameter::Repeat);
+
+        /// Half size copy made by 2x2 box filter, last odd row / column is repeated. Builds mip chains.
+        bool downsample(Image& target) const;
+
+        /// Box filter of factor x factor blocks, blocks cut by right or bottom edge average pixels they cover.
+        /// One pass for any factor up to maxDownsampleFactor, builds thumbnails of big images.
+        bool downsample(unsigned int factor, Image& target) const;
+
         /// Save onto disk by absolute or relative path.
         bool save(const std::string& path);
+    private:
+        /// Adopts decoded stb pixels.
+        void takePixels(unsigned char* pixels, int width, int height, int channels);
     private:
         vec2u m_size;
-        std::vector<std::uint8_t> m_pixels;
+        PixelBuffer m_pixels;
         ImageColorFormat m_colorFormat = ImageColorFormat::RED;
         ImageParameter m_imageParameter;
     };
@@ -20,30 +20,75 @@ source distribution.
 *********************************************************************/
 
 #pragma once
+
+#include <string>
+#include <vector>
+
 #include <robot2D/Config.hpp>
 #include "Rect.hpp"
 #include "Image.hpp"
 
 namespace robot2D {
+
+    struct ImageAtlasOptions {
+        /// Empty pixels between packed images, keeps filtering from bleeding neighbours.
+        unsigned int padding{1};
+        /// Cut fully transparent borders of RGBA images.
+        bool trim{true};
+        /// Atlas grows in power of two steps up to maxSize on each side.
+        unsigned int maxSize{4096};
+    };
+
+    /// Placement of source image inside packed atlas.
+    struct ImageAtlasEntry {
+        std::string name;
+        /// Trimmed pixels in atlas.
+        IntRect rect;
+        /// Top left of trimmed pixels inside source image.
+        vec2i offset;
+        vec2u sourceSize;
+    };
+
     class ROBOT2D_EXPORT_API ImageAtlas {
     public:
         ImageAtlas() = default;
         ~ImageAtlas() = default;
 
         bool loadFromFile(const std::string& path, vec2i itemSize);
+        /// Loads packed atlas saved by saveAtlas and saveManifest.
+        bool loadFromFile(const std::string& path, const std::string& manifestPath);
+
+        /// Places equally sized items on grid, row by row.
         bool createAtlas(const std::vector<robot2D::Image>& images,
                          robot2D::vec2i itemSize,
                          int itemsPerRow = 0);
 
+        /**
+         * \brief Packs images of any size by skyline bin packer.
+         * \details Trimming and pixels copying run on worker threads, images are copied row by row.
+         * @param names entry names, image's index is used when name is missing.
+         * @return false if images don't fit into options.maxSize.
+         */
+        bool packAtlas(const std::vector<robot2D::Image>& images,
+                       const std::vector<std::string>& names = {},
+                       const ImageAtlasOptions& options = {});
+
         bool saveAtlas(std::string path);
+        /// Text manifest: one entry per line, placement followed by name.
+        bool saveManifest(const std::string& path) const;
 
         IntRect getRect(int row, int column) const noexcept;
         IntRect getRect(vec2i index) const noexcept;
 
+        /// Entry of packed atlas by name, nullptr if there is no such.
+        const ImageAtlasEntry* getEntry(const std::string& name) const;
+        const std::vector<ImageAtlasEntry>& getEntries() const { return m_entries; }
+
         vec2i rectSize() const noexcept;
         const Image& getImage() const;
     private:
         vec2i m_rectSize;
         robot2D::Image m_atlasImage;
+        std::vector<ImageAtlasEntry> m_entries;
     };
-}
\ No newline at end of file
+}
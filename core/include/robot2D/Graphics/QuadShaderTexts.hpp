@@ -70,30 +70,45 @@ namespace robot2D {
 
             uniform sampler2D textureSamplers[16];
 
+            /// TexIndex is slot + 16 * sampling, sampling: 0 - color, 1 - glyph coverage, 2 - distance field
             void main()
             {
-                vec4 texColor = Color;
+                int index = int(TexIndex + 0.5);
+                int sampling = index / 16;
+                vec4 texel = vec4(1.0);
 
-                switch(int(TexIndex))
+                switch(index % 16)
                 {
-                    case  0: texColor = Color; break;
-                    case  1: texColor *= texture(textureSamplers[ 1], TexCoords); break;
-                    case  2: texColor *= texture(textureSamplers[ 2], TexCoords); break;
-                    case  3: texColor *= texture(textureSamplers[ 3], TexCoords); break;
-                    case  4: texColor *= texture(textureSamplers[ 4], TexCoords); break;
-                    case  5: texColor *= texture(textureSamplers[ 5], TexCoords); break;
-                    case  6: texColor *= texture(textureSamplers[ 6], TexCoords); break;
-                    case  7: texColor *= texture(textureSamplers[ 7], TexCoords); break;
-                    case  8: texColor *= texture(textureSamplers[ 8], TexCoords); break;
-                    case  9: texColor *= texture(textureSamplers[ 9], TexCoords); break;
-                    case 10: texColor *= texture(textureSamplers[10], TexCoords); break;
-                    case 11: texColor *= texture(textureSamplers[11], TexCoords); break;
-                    case 12: texColor *= texture(textureSamplers[12], TexCoords); break;
-                    case 13: texColor *= texture(textureSamplers[13], TexCoords); break;
-                    case 14: texColor *= texture(textureSamplers[14], TexCoords); break;
-                    case 15: texColor *= texture(textureSamplers[15], TexCoords); break;
+                    case  0: break;
+                    case  1: texel = texture(textureSamplers[ 1], TexCoords); break;
+                    case  2: texel = texture(textureSamplers[ 2], TexCoords); break;
+                    case  3: texel = texture(textureSamplers[ 3], TexCoords); break;
+                    case  4: texel = texture(textureSamplers[ 4], TexCoords); break;
+                    case  5: texel = texture(textureSamplers[ 5], TexCoords); break;
+                    case  6: texel = texture(textureSamplers[ 6], TexCoords); break;
+                    case  7: texel = texture(textureSamplers[ 7], TexCoords); break;
+                    case  8: texel = texture(textureSamplers[ 8], TexCoords); break;
+                    case  9: texel = texture(textureSamplers[ 9], TexCoords); break;
+                    case 10: texel = texture(textureSamplers[10], TexCoords); break;
+                    case 11: texel = texture(textureSamplers[11], TexCoords); break;
+                    case 12: texel = texture(textureSamplers[12], TexCoords); break;
+                    case 13: texel = texture(textureSamplers[13], TexCoords); break;
+                    case 14: texel = texture(textureSamplers[14], TexCoords); break;
+                    case 15: texel = texture(textureSamplers[15], TexCoords); break;
                 }
 
+                /// derivative is taken outside of branches, so it's defined for every fragment
+                float edgeWidth = max(fwidth(texel.r), 0.0001);
+                if(sampling == 1)
+                    texel = vec4(1.0, 1.0, 1.0, texel.r);
+                else if(sampling == 2)
+                    texel = vec4(1.0, 1.0, 1.0, smoothstep(0.5 - edgeWidth, 0.5 + edgeWidth, texel.r));
+
+                /// transparent part of glyph mustn't cover entity under it in picking buffer
+                if(sampling != 0 && texel.a == 0.0)
+                    discard;
+
+                vec4 texColor = Color * texel;
                 fragColor = texColor;
                 o_entityID = v_entityID;
             }
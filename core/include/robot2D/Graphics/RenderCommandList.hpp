@@ -0,0 +1,89 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#pragma once
+
+#include <array>
+#include <vector>
+#include <cstdint>
+
+#include <robot2D/Config.hpp>
+#include "RenderStates.hpp"
+#include "Vertex.hpp"
+
+namespace robot2D {
+
+    /**
+     * \brief CPU side recording of quads, which can be filled from any thread.
+     * \details Every thread owns own RenderCommandList, so recording needs no locks and no Graphics API.
+     * Vertices are transformed and colors converted while recording,
+     * RenderTarget::submit only merges lists by layer and sort key and copies them into batch. \n
+     * Quads with equal sort key keep order of lists in submit call and recording order inside list.
+     */
+    class ROBOT2D_EXPORT_API RenderCommandList {
+    public:
+        struct QuadCommand {
+            std::array<vec3f, 4> positions;
+            std::array<vec2f, 4> texCoords;
+            /// Already in Graphics API format.
+            Color color;
+            const Texture* texture{nullptr};
+            TextureSampling sampling{TextureSampling::Color};
+            int entityID{-1};
+            int sortKey{0};
+        };
+    public:
+        RenderCommandList() = default;
+        RenderCommandList(const RenderCommandList& other) = delete;
+        RenderCommandList& operator=(const RenderCommandList& other) = delete;
+        RenderCommandList(RenderCommandList&& other) = default;
+        RenderCommandList& operator=(RenderCommandList&& other) = default;
+        ~RenderCommandList() = default;
+
+        /// Preallocate quads for layer to avoid reallocations while recording.
+        void reserve(unsigned int layerID, std::size_t quadCount);
+
+        /// Drop recorded quads, keeps allocated memory for next frame.
+        void clear();
+
+        /// Record unit quad transformed by states, same as RenderTarget::draw(states).
+        void draw(const RenderStates& states, int sortKey = 0);
+
+        /// Record custom quad transformed by states.
+        void draw(const VertexData& quad, const RenderStates& states, int sortKey = 0);
+
+        /// Same as VertexData one, without allocation of quad.
+        void draw(const std::array<Vertex, 4>& quad, const RenderStates& states, int sortKey = 0);
+
+        /// Stable sort of each layer by sort key, call on recording thread when recording finished.
+        void sort();
+
+        const std::vector<QuadCommand>& getCommands(unsigned int layerID) const;
+        unsigned int getLayerCount() const { return static_cast<unsigned int>(m_layers.size()); }
+        std::size_t getQuadCount() const;
+    private:
+        std::vector<QuadCommand>& getLayer(unsigned int layerID);
+        void record(const Vertex* quad, const RenderStates& states, int sortKey);
+    private:
+        std::vector<std::vector<QuadCommand>> m_layers;
+    };
+
+}
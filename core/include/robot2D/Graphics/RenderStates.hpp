@@ -44,6 +44,17 @@ namespace robot2D {
         MinusAlphaOne
     };
 
+    /// How batch shader treats texel of quad's texture.
+    enum class TextureSampling {
+        /// Texel multiplies color.
+        Color = 0,
+        /// Red channel is glyph coverage, used as alpha.
+        Coverage,
+        /// Red channel is signed distance field with edge at 0.5, used as alpha.
+        DistanceField,
+        Count
+    };
+
     /// \brief Graphics API must know how to render your Entity / Buffer.
     struct ROBOT2D_EXPORT_API RenderInfo {
         /// How to render vertices
@@ -51,6 +62,12 @@ namespace robot2D {
 
         /// Value of specified indices for each Vertex.
         uint32_t indexCount = 0;
+
+        /// First index to draw from, lets several draws share one VertexArray.
+        uint32_t indexOffset = 0;
+
+        /// Instances to draw from VertexArray's instance buffer, 0 - non instanced draw.
+        uint32_t instanceCount = 0;
     };
 
     /**
@@ -78,10 +95,16 @@ namespace robot2D {
         /// Possible Blending options
         BlendMode blendMode;
 
+        /// Lets glyph atlases go through same batch as sprites.
+        TextureSampling textureSampling;
+
         unsigned int layerID;
 
         int entityID;
 
+        /// Custom shader of VertexArray draw gets layer's view as "projection" uniform when draw runs.
+        bool layerProjection;
+
         static const RenderStates Default;
     };
 }
\ No newline at end of file
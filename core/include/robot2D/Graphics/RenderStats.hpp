@@ -3,12 +3,27 @@
 //
 
 #pragma once
+#include <cstddef>
 #include <robot2D/Config.hpp>
 
 namespace robot2D {
 
+    /// \brief Why BatchRender had to flush before frame end.
+    enum class BatchBreakReason {
+        /// All texture slots of batch are used.
+        TextureSlots = 0,
+        /// Vertex buffer of batch is full.
+        BufferFull,
+        /// Custom VertexArray / shader needs own draw call.
+        StateChange,
+        Count
+    };
+
     /// \brief Provides current BatchRender statistics
     struct ROBOT2D_EXPORT_API RenderStats final {
+        static constexpr unsigned maxLayers = 5;
+        static constexpr unsigned breakReasonsCount = static_cast<unsigned>(BatchBreakReason::Count);
+
         /// How many time your GPU should process input buffer.
         unsigned drawCalls;
 
@@ -17,6 +32,27 @@ namespace robot2D {
 
         /// drawQuads * 4 ( quad = 4 vertices)
         unsigned drawVertices;
+
+        /// How many instances were submitted by instanced draw calls.
+        unsigned drawInstances;
+
+        /// Draw calls of each render layer.
+        unsigned layerDrawCalls[maxLayers];
+
+        /// Early batch flushes, index is BatchBreakReason.
+        unsigned batchBreaks[breakReasonsCount];
+
+        /// Bytes BatchRender sent to GPU buffers.
+        std::size_t uploadedBytes;
+
+        /// CPU milliseconds from beforeRender till afterRender, time to pack quads.
+        float recordTime;
+
+        /// CPU milliseconds spent in afterRender, upload and draw calls submit.
+        float submitTime;
+
+        /// GPU milliseconds of last finished render pass, comes from timer queries few frames later.
+        float gpuTime;
     };
 
 }
@@ -32,6 +32,7 @@ source distribution.
 #include "Color.hpp"
 #include "RenderContext.hpp"
 #include "VertexArray.hpp"
+#include "RenderCommandList.hpp"
 #include "robot2D/Core/WindowContext.hpp"
 #include "Matrix3D.hpp"
 
@@ -109,6 +110,11 @@ namespace robot2D {
 
         virtual void draw3D(const VertexArray::Ptr& vertexArray, RenderStates states) const;
 
+        /// \brief Merge command lists recorded on other threads into batch, call only on render thread.
+        /// \details Each list must be sorted (RenderCommandList::sort) before submit.
+        /// Quads with equal sort key are submitted in order of lists.
+        void submit(const std::vector<const RenderCommandList*>& commandLists);
+
         /// \brief Prepare render to current frame render
         virtual void beforeRender() const;
 
@@ -0,0 +1,74 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+#include <robot2D/Config.hpp>
+#include "Rect.hpp"
+
+namespace robot2D {
+
+    /**
+     * \brief Packs rectangles into fixed size area keeping only its top outline (skyline).
+     * \details Rectangle is placed by bottom-left rule: lowest top edge wins, narrower segment breaks ties.
+     * Single rectangles can't be freed, area is only reset as whole.
+     */
+    class ROBOT2D_EXPORT_API SkylinePacker {
+    public:
+        explicit SkylinePacker(const vec2u& size = {}, unsigned int padding = 0);
+        ~SkylinePacker() = default;
+
+        /// Forgets all packed rectangles and sets new area.
+        void reset(const vec2u& size);
+
+        /**
+         * \brief Finds place for rectangle.
+         * @param size rectangle's size without padding.
+         * @param placed filled with position and size of rectangle on success.
+         * @return false if area has no room left.
+         */
+        bool pack(const vec2u& size, IntRect& placed);
+
+        const vec2u& getSize() const { return m_size; }
+
+        /// Packed area divided by full area, padding is counted as used.
+        float getOccupancy() const;
+    private:
+        struct Segment {
+            int x;
+            int y;
+            int width;
+        };
+
+        /// Returns top of rectangle placed at segment index or -1 if it doesn't fit.
+        int fit(std::size_t index, int width, int height) const;
+        void place(std::size_t index, int x, int y, int width, int height);
+    private:
+        std::vector<Segment> m_skyline;
+        vec2u m_size;
+        unsigned int m_padding;
+        std::size_t m_usedArea{0};
+    };
+
+}
@@ -1,12 +1,17 @@
 #pragma once
 
+#include <array>
+#include <memory>
+#include <vector>
+#include <cstdint>
+
 #include <robot2D/Graphics/Vertex.hpp>
-#include <robot2D/Graphics/Shader.hpp>
 #include <robot2D/Graphics/View.hpp>
 #include <robot2D/Graphics/Drawable.hpp>
 
 #include "Font.hpp"
-#include "QuadBatchRender.hpp"
+#include "RenderCommandList.hpp"
+#include "TextLayout.hpp"
 
 namespace robot2D {
 
@@ -17,6 +22,7 @@ namespace robot2D {
         ~Text();
 
         void setFont(const Font& font);
+        /// UTF-8 text.
         void setText(const std::string& text);
         const std::string& getText() const;
 
@@ -26,6 +32,20 @@ namespace robot2D {
             return m_pos;
         }
 
+        /// 0 means font's default character size. SDF font renders any size from one set of glyphs.
+        void setCharacterSize(unsigned int characterSize);
+        unsigned int getCharacterSize() const;
+
+        /// Lines are wrapped on spaces to fit width, 0 disables wrapping.
+        void setMaxWidth(float maxWidth);
+        float getMaxWidth() const;
+
+        void setAlignment(TextAlignment alignment);
+        TextAlignment getAlignment() const;
+
+        /// Size of laid out text in local space.
+        vec2f getSize() const;
+
         void setScale(const float& scale);
         const float& getScale() const;
 
@@ -38,25 +58,19 @@ namespace robot2D {
         void scale(const vec2f& factor);
         void rotate(float angle);
     private:
-        void setupGL();
-
-        void beforeRender() const;
         void updateGeometry() const;
-        void afterRender(bool hardUpdate) const;
     private:
-        const Font* m_font;
+        const Font* m_font{nullptr};
         std::string m_text;
+        TextLayoutOptions m_options;
 
-        ShaderHandler m_textShader;
-
-        mutable bool m_initialized = false;
         mutable bool m_needupdate = false;
-        mutable bool m_scaled = false;
         mutable robot2D::Color m_color;
 
-        mutable std::unordered_map<int, GlyphQuad> m_bufferCache;
-        mutable QuadBatchRender<Vertex> quadBatchRender;
+        /// Shared with texts of same string, font and options.
+        mutable std::shared_ptr<const TextLayout> m_layout;
+        /// Glyphs go through RenderTarget's quad batch, together with sprites of same layer.
+        mutable RenderCommandList m_commands;
     };
 
 }
-
@@ -0,0 +1,139 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+#include <robot2D/Config.hpp>
+#include "Font.hpp"
+
+namespace robot2D {
+
+    enum class TextAlignment {
+        Left = 0,
+        Center,
+        Right
+    };
+
+    struct TextLayoutOptions {
+        /// 0 means font's default character size.
+        unsigned int characterSize{0};
+        /// Lines are wrapped on spaces to fit width, 0 disables wrapping.
+        float maxWidth{0.F};
+        TextAlignment alignment{TextAlignment::Left};
+        /// Multiplier of font's line spacing.
+        float lineSpacing{1.F};
+
+        bool operator==(const TextLayoutOptions& other) const {
+            return characterSize == other.characterSize && maxWidth == other.maxWidth
+                && alignment == other.alignment && lineSpacing == other.lineSpacing;
+        }
+    };
+
+    /// Glyph moved to its place in text.
+    struct LayoutGlyph {
+        /// Positions are relative to text's top left corner, uvs point into GlyphCache page.
+        GlyphQuad quad;
+        int page{-1};
+    };
+
+    /// Positioned glyphs of text, glyphs without pixels (spaces) aren't stored.
+    struct TextLayout {
+        std::vector<LayoutGlyph> glyphs;
+        vec2f size;
+        std::size_t linesCount{0};
+        /// GlyphCache generation before glyphs were taken, differs from current one when uvs may be stale.
+        std::uint64_t generation{0};
+    };
+
+    /**
+     * \brief Lays out UTF-8 text: kerning, '\n', word wrap and alignment.
+     * \details Word longer than maxWidth is broken between characters. Trailing spaces don't count to line's width.
+     */
+    ROBOT2D_EXPORT_API void layoutText(const Font& font, const std::string& text,
+                                       const TextLayoutOptions& options, TextLayout& layout);
+
+    /**
+     * \brief Shares layouts of same (text, font, options) between texts and frames.
+     * \details Layout is built again only when GlyphCache evicted page since it was built.
+     * Least recently used layouts are dropped above maxEntries.
+     */
+    class ROBOT2D_EXPORT_API TextLayoutCache {
+    public:
+        static constexpr std::size_t defaultMaxEntries = 512;
+
+        static TextLayoutCache& getInstance();
+
+        TextLayoutCache(const TextLayoutCache& other) = delete;
+        TextLayoutCache& operator=(const TextLayoutCache& other) = delete;
+        TextLayoutCache(TextLayoutCache&& other) = delete;
+        TextLayoutCache& operator=(TextLayoutCache&& other) = delete;
+        ~TextLayoutCache() = default;
+
+        /// Returned layout stays valid while caller holds it, even if cache drops it.
+        std::shared_ptr<const TextLayout> getLayout(const Font& font, const std::string& text,
+                                                    const TextLayoutOptions& options);
+
+        /// Drops layouts of font, called when font is destroyed.
+        void removeFont(const Font& font);
+
+        void setMaxEntries(std::size_t maxEntries);
+        std::size_t getEntriesCount() const;
+    private:
+        TextLayoutCache() = default;
+
+        struct Key {
+            const void* face;
+            std::string text;
+            TextLayoutOptions options;
+
+            bool operator==(const Key& other) const {
+                return face == other.face && options == other.options && text == other.text;
+            }
+        };
+
+        struct KeyHash {
+            std::size_t operator()(const Key& key) const;
+        };
+
+        struct Entry {
+            std::shared_ptr<TextLayout> layout;
+            std::list<const Key*>::iterator use;
+        };
+
+        void trim();
+    private:
+        mutable std::mutex m_mutex;
+        std::unordered_map<Key, Entry, KeyHash> m_entries;
+        /// Most recently used first, points to keys of m_entries.
+        std::list<const Key*> m_uses;
+        std::size_t m_maxEntries{defaultMaxEntries};
+    };
+
+}
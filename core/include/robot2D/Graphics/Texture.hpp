@@ -21,9 +21,27 @@ source distribution.
 
 #pragma once
 
+#include <string>
+#include <vector>
+#include <cstddef>
+
 #include "Image.hpp"
+#include "Rect.hpp"
+#include "TextureCompression.hpp"
 
 namespace robot2D {
+
+    /// How texture keeps its pixels, set before creating texture.
+    struct TextureOptions {
+        /// Full mip chain is generated after upload, minification samples it trilinearly.
+        bool mipmaps{false};
+        /// CPU copy of pixels stays after upload, needed by getImage, getPixels and saveToFile.
+        bool keepPixels{true};
+        /// Mips are streamed by TextureResidency by on-screen size, implies mipmaps.
+        /// CPU mip chain stays while RAM budget allows, texture loaded from file can read it again.
+        bool streamed{false};
+    };
+
     /**
      * \brief Graphics API format which have all information about pixel buffer.
      * \details Graphics API should know how to work with in pixel buffer \n
@@ -33,39 +51,97 @@ namespace robot2D {
     public:
         /// \brief Only initialize class object.
         Texture();
+        /// GL name and stream slot have single owner, texture is only moved.
+        Texture(const Texture& other) = delete;
+        Texture& operator=(const Texture& other) = delete;
+        Texture(Texture&& other) noexcept;
+        Texture& operator=(Texture&& other) noexcept;
         ~Texture();
 
-        /// Load Pixel buffer.
+        /// Load Pixel buffer, CompressedImage::extension files are uploaded as compressed blocks.
         bool loadFromFile(const std::string& path);
         bool saveToFile(const std::string& path);
 
-        /// Returns Pixel buffer.
+        /// Returns Pixel buffer, nullptr when CPU copy was dropped.
         const unsigned char* getPixels() const;
         unsigned char* getPixels();
 
+        /// Size of full resolution level, even if only smaller mips are resident.
         vec2u& getSize();
         const vec2u& getSize() const;
 
+        void setOptions(const TextureOptions& options) { m_options = options; }
+        const TextureOptions& getOptions() const { return m_options; }
+
         void create(const vec2u& size, const void* data, int texParam = 0,
                     const ImageColorFormat& colorFormat = ImageColorFormat::RGBA);
 
         void create(const Image& image);
+        /// Takes image's pixels without copy, image is left empty.
+        void create(Image&& image);
+
+        /// Uploads blocks of all levels without decoding, no CPU copy is kept and texture can't be streamed.
+        /// When driver can't sample format full resolution level is decoded to RGBA.
+        bool create(const CompressedImage& image);
+
+        /// Replaces area of created texture, pixels are tightly packed rows of texture's color format.
+        /// Only full resolution level is updated, texture should be created without mipmaps or compression.
+        void update(const IntRect& area, const void* pixels);
 
         const unsigned int& getID()const;
         unsigned int& getID();
 
-        const ImageColorFormat& getColorFormat() const { return m_image.getColorFormat(); }
+        const ImageColorFormat& getColorFormat() const { return m_colorFormat; }
         void bind(uint32_t slot);
 
-        const Image& getImage() const { return m_image; }
-        Image& getImage() { return m_image; }
+        /// Full resolution CPU copy, empty when it was dropped.
+        const Image& getImage() const;
+        Image& getImage();
+
+        /// Levels of GPU storage.
+        unsigned int getMipLevels() const { return m_mipLevels; }
+        /// Finest mip level on GPU, 0 is full resolution.
+        unsigned int getResidentMip() const { return m_residentMip; }
+        /// Mips count of full chain.
+        unsigned int getMipChainLength() const;
+
+        /// Bytes of GPU storage.
+        std::size_t getVideoBytes() const;
+        /// Bytes of CPU copies.
+        std::size_t getSystemBytes() const;
     private:
-        void bindBufferData(void* bufferData);
-        void setupGL();
+        friend class TextureResidency;
+
+        void setupGL(const vec2u& size, unsigned int levels);
+        void uploadLevel(unsigned int level, const vec2u& size, const void* pixels);
+        /// Creates GPU storage for first of m_mips by options.
+        void createFromMips();
+        /// Builds CPU mip chain from full resolution level.
+        void buildMipChain();
+        /// Recreates GPU storage from CPU mips starting at firstMip, they must be present.
+        bool makeResident(unsigned int firstMip);
+        /// Frees CPU mips finer than firstMip, they can be read again from file.
+        void releaseMips(unsigned int firstMip);
+        bool hasMips(unsigned int firstMip) const;
     private:
-        unsigned int m_texture = 20000;
-        std::vector<unsigned char> m_data;
-        Image m_image;
+        static constexpr unsigned int noTexture = 20000;
+
+        unsigned int m_texture = noTexture;
+        /// CPU mips, first one is full resolution. Dropped levels are empty.
+        std::vector<Image> m_mips;
+        vec2u m_size;
+        ImageColorFormat m_colorFormat{ImageColorFormat::RGBA};
         int m_texParam = 0;
+        TextureOptions m_options;
+        std::string m_path;
+
+        /// Set while GPU storage holds compressed blocks.
+        bool m_compressed{false};
+        CompressedFormat m_compressedFormat{CompressedFormat::BC3};
+
+        unsigned int m_mipLevels{0};
+        unsigned int m_residentMip{0};
+        /// Index in TextureResidency, -1 when texture isn't streamed.
+        int m_streamIndex{-1};
     };
-}
\ No newline at end of file
+}
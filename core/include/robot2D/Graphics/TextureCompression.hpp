@@ -0,0 +1,106 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include <robot2D/Config.hpp>
+#include "Image.hpp"
+
+namespace robot2D {
+
+    /// GPU block compressed formats, each one stores 4x4 pixel blocks.
+    enum class CompressedFormat: std::uint32_t {
+        /// DXT1, RGB with 1 bit alpha, 8 bytes per block.
+        BC1 = 1,
+        /// DXT5, RGBA, 16 bytes per block.
+        BC3,
+        /// RGBA, 16 bytes per block, encoder writes single subset mode 6 only.
+        BC7,
+        /// RGB, 8 bytes per block, encoder writes ETC1 compatible modes.
+        ETC2_RGB,
+        /// RGBA with EAC alpha, 16 bytes per block.
+        ETC2_RGBA
+    };
+
+    /// Bytes of one 4x4 block.
+    ROBOT2D_EXPORT_API std::size_t getBlockBytes(CompressedFormat format);
+
+    /// Bytes of image, partial blocks on right and bottom edges are whole ones.
+    ROBOT2D_EXPORT_API std::size_t getCompressedSize(CompressedFormat format, const vec2u& size);
+
+    /// Encodes image of any color format into blocks, RED is stored as grey.
+    /// Encoding is slow enough to be done offline, block rows are split between worker threads.
+    ROBOT2D_EXPORT_API bool compressImage(const Image& image, CompressedFormat format,
+                                          std::vector<std::uint8_t>& blocks);
+
+    /// Decodes blocks into RGBA image, fallback when GPU can't sample format.
+    /// BC7 blocks other than mode 6 aren't supported.
+    ROBOT2D_EXPORT_API bool decompressImage(CompressedFormat format, const vec2u& size,
+                                            const std::uint8_t* blocks, std::size_t bytes, Image& image);
+
+    /**
+     * \brief Block compressed mip chain ready for upload, saved by asset export.
+     * \details File is small container in spirit of KTX2: header with format, size and levels count,
+     * table of levels offsets and sizes, after that blocks of each level starting from full resolution.
+     * Loading doesn't decode anything, blocks are uploaded to GPU as is.
+     */
+    class ROBOT2D_EXPORT_API CompressedImage {
+    public:
+        struct Level {
+            vec2u size;
+            std::vector<std::uint8_t> blocks;
+        };
+
+        CompressedImage() = default;
+        ~CompressedImage() = default;
+
+        /// Encodes image and, when mipmaps is true, its box filtered mip chain.
+        bool create(const Image& image, CompressedFormat format, bool mipmaps = true);
+
+        bool loadFromFile(const std::string& path);
+        bool loadFromMemory(const void* data, std::size_t size);
+        bool saveToFile(const std::string& path) const;
+        bool saveToMemory(std::vector<std::uint8_t>& data) const;
+
+        /// Decodes level into RGBA image.
+        bool decompress(Image& image, unsigned int level = 0) const;
+
+        CompressedFormat getFormat() const { return m_format; }
+        const vec2u& getSize() const;
+        const std::vector<Level>& getLevels() const { return m_levels; }
+        bool empty() const { return m_levels.empty(); }
+        /// Bytes of all levels.
+        std::size_t getBytes() const;
+
+        /// File extension of saved container.
+        static constexpr const char* extension = ".rtex";
+    private:
+        CompressedFormat m_format{CompressedFormat::BC3};
+        std::vector<Level> m_levels;
+    };
+
+}
@@ -0,0 +1,130 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <limits>
+
+#include <robot2D/Config.hpp>
+#include <robot2D/Core/JobSystem.hpp>
+#include "Image.hpp"
+
+namespace robot2D {
+    class Texture;
+
+    /**
+     * \brief Streams mips of streamed textures in and out by their on-screen size and memory budgets.
+     * \details Renderer requests finest mip every drawn quad needs, update applies requests of last frame:
+     * textures which weren't drawn for a while drop to small mips, over video budget least recently used
+     * textures lose finest mips first. Mips missing on CPU are read from texture's file by background job.
+     * Over system budget CPU mips which aren't on GPU are dropped for textures which have file.
+     */
+    class ROBOT2D_EXPORT_API TextureResidency {
+    public:
+        static constexpr std::size_t defaultVideoBudget = 512u * 1024u * 1024u;
+        static constexpr std::size_t defaultSystemBudget = 512u * 1024u * 1024u;
+        /// Textures which weren't drawn keep mips at most this big.
+        static constexpr unsigned int minResidentSize = 64;
+        static constexpr std::uint64_t framesBeforeEviction = 120;
+        static constexpr unsigned int maxUploadsPerFrame = 4;
+        static constexpr unsigned int noRequest = std::numeric_limits<unsigned int>::max();
+
+        /// Mips of one texture from firstMip till end of chain, as budget fitting sees them.
+        struct MipChain {
+            vec2u size;
+            std::size_t bytesPerPixel{4};
+            unsigned int length{1};
+            unsigned int firstMip{0};
+            std::uint64_t lastUse{0};
+
+            std::size_t getBytes(unsigned int fromMip) const;
+        };
+
+        static TextureResidency& getInstance();
+
+        TextureResidency(const TextureResidency& other) = delete;
+        TextureResidency& operator=(const TextureResidency& other) = delete;
+        TextureResidency(TextureResidency&& other) = delete;
+        TextureResidency& operator=(TextureResidency&& other) = delete;
+        ~TextureResidency() = default;
+
+        void setVideoBudget(std::size_t bytes);
+        void setSystemBudget(std::size_t bytes);
+
+        /// Mip which shows texels of edge at screen pixels without minification.
+        static unsigned int mipForExtent(float texels, float pixels);
+
+        /// Raises firstMip of least recently used chains until all fit budget, bigger first among equally used.
+        /// Each pass drops one mip of every chain, so recently used ones lose detail last.
+        static void fitBudget(std::vector<MipChain>& chains, std::size_t budget);
+
+        /// Finest mip texture needs this frame, does nothing for not streamed texture.
+        /// Thread safe while no streamed texture is created or destroyed.
+        void requestMip(const Texture& texture, unsigned int mip);
+
+        /// Applies requests since last update. Call on render thread before drawing.
+        void update();
+
+        std::size_t getVideoBytes() const;
+        std::size_t getSystemBytes() const;
+        std::size_t getTexturesCount() const;
+    private:
+        friend class Texture;
+        TextureResidency() = default;
+
+        void add(Texture& texture);
+        void remove(Texture& texture);
+        /// Moved texture takes stream slot of source.
+        void relocate(Texture& from, Texture& to);
+
+        struct Stream {
+            Texture* texture{nullptr};
+            std::atomic<unsigned int> requestedMip{noRequest};
+            std::uint64_t lastUse{0};
+            unsigned int targetMip{0};
+            /// Background job which reads mip chain from texture's file into loadedChain.
+            JobHandle loading;
+            std::shared_ptr<std::vector<Image>> loadedChain{nullptr};
+        };
+
+        /// Coarsens targets of least recently used textures until they fit video budget.
+        void fitVideoBudget(const std::vector<Stream*>& streams);
+        void fitSystemBudget(const std::vector<Stream*>& streams);
+        static unsigned int getEvictedMip(const Texture& texture);
+    private:
+        mutable std::mutex m_mutex;
+        std::deque<Stream> m_streams;
+        std::vector<int> m_freeStreams;
+        std::size_t m_videoBudget{defaultVideoBudget};
+        std::size_t m_systemBudget{defaultSystemBudget};
+        std::size_t m_videoBytes{0};
+        std::size_t m_systemBytes{0};
+        std::uint64_t m_frame{0};
+    };
+
+}
@@ -43,9 +43,12 @@ namespace robot2D {
 
         virtual void setVertexBuffer(const VertexBuffer::Ptr vertexBuffer) = 0;
         virtual void setIndexBuffer(const IndexBuffer::Ptr indexBuffer) = 0;
+        /// Per instance attributes, advanced once per instance instead of once per vertex.
+        virtual void setInstanceBuffer(const VertexBuffer::Ptr instanceBuffer) = 0;
 
         virtual const VertexBuffer::Ptr getVertexBuffer() const = 0;
         virtual const IndexBuffer::Ptr getIndexBuffer() const = 0;
+        virtual const VertexBuffer::Ptr getInstanceBuffer() const = 0;
 
         /// Create VertexArray in Graphics API format.
         static Ptr Create();
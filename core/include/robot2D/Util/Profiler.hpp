@@ -0,0 +1,99 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <robot2D/Config.hpp>
+#include <robot2D/OptionConfig.hpp>
+
+namespace robot2D {
+
+    /**
+     * \brief Collects scoped CPU timings of all threads and exports them as Chrome trace.
+     * \details Every thread writes into own ring buffer, so recording takes no locks.
+     * Events are recorded only between beginCapture and endCapture, out of capture scope costs one atomic load.
+     * Result can be opened in chrome://tracing or ui.perfetto.dev.
+     */
+    class ROBOT2D_EXPORT_API Profiler {
+    public:
+        /// Events each thread keeps, oldest ones are overwritten.
+        static constexpr std::size_t threadBufferSize = 1 << 16;
+
+        Profiler() = delete;
+
+        static void beginCapture();
+        static void endCapture();
+        static bool isCapturing();
+
+        /// Captures next frames and writes trace to path, Engine marks frame ends.
+        static void captureFrames(unsigned int frames, const std::string& path);
+        static void frameEnd();
+
+        /// Name is shown in trace instead of thread id.
+        static void setThreadName(const std::string& name);
+
+        /// Writes events of last capture, capture still running is ended first.
+        static bool writeChromeTrace(const std::string& path);
+
+        /// Nanoseconds of monotonic clock.
+        static std::uint64_t now();
+
+        /// Name must outlive capture export, string literals or __func__ are expected.
+        static void record(const char* name, std::uint64_t start, std::uint64_t end);
+    };
+
+    /// \brief Records time between construction and destruction while Profiler captures.
+    class ProfileScope {
+    public:
+        explicit ProfileScope(const char* name):
+            m_name{name},
+            m_start{Profiler::isCapturing() ? Profiler::now() : 0} {}
+        ProfileScope(const ProfileScope& other) = delete;
+        ProfileScope& operator=(const ProfileScope& other) = delete;
+        ProfileScope(ProfileScope&& other) = delete;
+        ProfileScope& operator=(ProfileScope&& other) = delete;
+        ~ProfileScope() {
+            if(m_start != 0)
+                Profiler::record(m_name, m_start, Profiler::now());
+        }
+    private:
+        const char* m_name;
+        std::uint64_t m_start;
+    };
+
+}
+
+#define RB_PROFILE_CONCAT_IMPL(x, y) x##y
+#define RB_PROFILE_CONCAT(x, y) RB_PROFILE_CONCAT_IMPL(x, y)
+
+#ifdef RB_PROFILE
+    #define RB_PROFILE_SCOPE(name) ::robot2D::ProfileScope RB_PROFILE_CONCAT(rbProfileScope, __LINE__){name}
+    #define RB_PROFILE_FUNCTION() RB_PROFILE_SCOPE(__func__)
+    #define RB_PROFILE_THREAD(name) ::robot2D::Profiler::setThreadName(name)
+#else
+    #define RB_PROFILE_SCOPE(name)
+    #define RB_PROFILE_FUNCTION()
+    #define RB_PROFILE_THREAD(name)
+#endif
@@ -23,3 +23,4 @@ source distribution.
 
 #include "Logger.hpp"
 #include "ResourceHandler.hpp"
+#include "Profiler.hpp"
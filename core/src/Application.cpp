@@ -45,6 +45,10 @@ namespace robot2D {
         (void)deltaTime;
     }
 
+    void Application::record(FramePacket& packet) {
+        (void)packet;
+    }
+
     void Application::setWindow(RenderWindow* window) {
         if(window == nullptr)
             return;
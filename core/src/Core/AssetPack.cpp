@@ -0,0 +1,251 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#include <cstring>
+#include <fstream>
+
+#include <robot2D/Core/AssetPack.hpp>
+#include <robot2D/Util/Logger.hpp>
+#include "Lz4.hpp"
+
+namespace robot2D {
+    namespace {
+        struct PackHeader {
+            std::uint32_t magic;
+            std::uint16_t version;
+            std::uint16_t headerSize;
+            std::uint32_t entriesCount;
+            std::uint32_t reserved;
+            std::uint64_t indexOffset;
+            std::uint64_t fileSize;
+        };
+
+        /// Index record, followed by nameLength bytes of name.
+        struct IndexEntry {
+            std::uint64_t offset;
+            std::uint64_t storedSize;
+            std::uint64_t size;
+            std::uint32_t compression;
+            std::uint32_t nameLength;
+        };
+
+        static_assert(sizeof(PackHeader) == 32 && sizeof(IndexEntry) == 32);
+
+        std::uint64_t alignOffset(std::uint64_t offset) {
+            return (offset + AssetPack::blobAlignment - 1) & ~static_cast<std::uint64_t>(AssetPack::blobAlignment - 1);
+        }
+
+        bool readFile(const std::string& path, std::vector<std::uint8_t>& data) {
+            std::ifstream file{path, std::ios::binary | std::ios::ate};
+            if(!file.is_open())
+                return false;
+            data.resize(static_cast<std::size_t>(file.tellg()));
+            file.seekg(0);
+            file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+            return static_cast<bool>(file);
+        }
+    }
+
+    bool AssetPack::openFromFile(const std::string& path) {
+        close();
+        if(!m_file.openFromFile(path)) {
+            RB_CORE_ERROR("AssetPack: can't open {0}", path);
+            return false;
+        }
+
+        const auto* data = m_file.getData();
+        const auto size = m_file.getDataSize();
+        PackHeader header{};
+        if(size < sizeof(header)) {
+            RB_CORE_ERROR("AssetPack: {0} is too small", path);
+            close();
+            return false;
+        }
+        std::memcpy(&header, data, sizeof(header));
+        if(header.magic != magic || header.version > version || header.fileSize != size
+            || header.indexOffset < header.headerSize || header.indexOffset > size) {
+            RB_CORE_ERROR("AssetPack: {0} isn't supported asset pack", path);
+            close();
+            return false;
+        }
+
+        std::uint64_t position = header.indexOffset;
+        m_entries.reserve(header.entriesCount);
+        for(std::uint32_t i = 0; i < header.entriesCount; ++i) {
+            IndexEntry entry{};
+            if(size - position < sizeof(entry))
+                break;
+            std::memcpy(&entry, data + position, sizeof(entry));
+            position += sizeof(entry);
+            if(size - position < entry.nameLength || entry.offset > header.indexOffset
+                || entry.storedSize > header.indexOffset - entry.offset
+                || entry.compression > static_cast<std::uint32_t>(AssetCompression::LZ4))
+                break;
+
+            std::string name{reinterpret_cast<const char*>(data + position), entry.nameLength};
+            position += entry.nameLength;
+            m_entries.emplace(std::move(name), Entry{entry.offset, entry.storedSize, entry.size,
+                                                     static_cast<AssetCompression>(entry.compression)});
+        }
+
+        if(m_entries.size() != header.entriesCount) {
+            RB_CORE_ERROR("AssetPack: {0} has corrupted index", path);
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void AssetPack::close() {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_entries.clear();
+        m_decoded.clear();
+        m_file.close();
+    }
+
+    bool AssetPack::hasAsset(const std::string& name) const {
+        return m_entries.find(name) != m_entries.end();
+    }
+
+    AssetView AssetPack::getAsset(const std::string& name) {
+        auto found = m_entries.find(name);
+        if(found == m_entries.end())
+            return {};
+
+        const auto& entry = found -> second;
+        const auto* blob = m_file.getData() + entry.offset;
+        if(entry.compression == AssetCompression::None)
+            return { blob, static_cast<std::size_t>(entry.storedSize) };
+
+        std::lock_guard<std::mutex> lock{m_mutex};
+        auto decoded = m_decoded.find(name);
+        if(decoded != m_decoded.end())
+            return { decoded -> second.get(), static_cast<std::size_t>(entry.size) };
+
+        std::unique_ptr<std::uint8_t[]> buffer{new std::uint8_t[entry.size > 0 ? entry.size : 1]};
+        if(!priv::lz4Decompress(blob, static_cast<std::size_t>(entry.storedSize),
+                                buffer.get(), static_cast<std::size_t>(entry.size))) {
+            RB_CORE_ERROR("AssetPack: can't decompress {0}", name);
+            return {};
+        }
+        const auto* ptr = buffer.get();
+        m_decoded.emplace(name, std::move(buffer));
+        return { ptr, static_cast<std::size_t>(entry.size) };
+    }
+
+    bool AssetPack::openStream(const std::string& name, MemoryInputStream& stream) {
+        auto asset = getAsset(name);
+        if(!asset)
+            return false;
+        stream.open(asset.data, asset.size);
+        return true;
+    }
+
+    std::vector<std::string> AssetPack::getAssetNames() const {
+        std::vector<std::string> names;
+        names.reserve(m_entries.size());
+        for(const auto& entry: m_entries)
+            names.emplace_back(entry.first);
+        return names;
+    }
+
+    void AssetPackWriter::addFile(const std::string& name, const std::string& path, AssetCompression compression) {
+        m_sources.push_back({name, path, {}, compression});
+    }
+
+    void AssetPackWriter::addData(const std::string& name, std::vector<std::uint8_t>&& data,
+                                  AssetCompression compression) {
+        m_sources.push_back({name, {}, std::move(data), compression});
+    }
+
+    bool AssetPackWriter::saveToFile(const std::string& path, const ProgressCallback& progressCallback) {
+        std::ofstream file{path, std::ios::binary | std::ios::trunc};
+        if(!file.is_open()) {
+            RB_CORE_ERROR("AssetPackWriter: can't open {0}", path);
+            return false;
+        }
+
+        std::vector<IndexEntry> entries;
+        entries.reserve(m_sources.size());
+        std::vector<std::uint8_t> fileData;
+        std::vector<std::uint8_t> compressed;
+        const std::vector<std::uint8_t> padding(AssetPack::blobAlignment, 0);
+
+        std::uint64_t offset = sizeof(PackHeader);
+        /// header is written last, when index offset is known
+        file.write(reinterpret_cast<const char*>(padding.data()), sizeof(PackHeader));
+
+        for(std::size_t i = 0; i < m_sources.size(); ++i) {
+            auto& source = m_sources[i];
+            const std::vector<std::uint8_t>* data = &source.data;
+            if(!source.path.empty()) {
+                if(!readFile(source.path, fileData)) {
+                    RB_CORE_ERROR("AssetPackWriter: can't read {0}", source.path);
+                    return false;
+                }
+                data = &fileData;
+            }
+
+            const std::uint8_t* blob = data -> data();
+            std::size_t blobSize = data -> size();
+            auto compression = AssetCompression::None;
+            if(source.compression == AssetCompression::LZ4 && !data -> empty()) {
+                compressed.resize(priv::lz4CompressBound(data -> size()));
+                const auto compressedSize = priv::lz4Compress(data -> data(), data -> size(),
+                                                              compressed.data(), compressed.size());
+                if(compressedSize > 0 && compressedSize < data -> size()) {
+                    blob = compressed.data();
+                    blobSize = compressedSize;
+                    compression = AssetCompression::LZ4;
+                }
+            }
+
+            const auto alignedOffset = alignOffset(offset);
+            file.write(reinterpret_cast<const char*>(padding.data()), static_cast<std::streamsize>(alignedOffset - offset));
+            file.write(reinterpret_cast<const char*>(blob), static_cast<std::streamsize>(blobSize));
+            entries.push_back({ alignedOffset, blobSize, data -> size(), static_cast<std::uint32_t>(compression),
+                                static_cast<std::uint32_t>(source.name.size()) });
+            offset = alignedOffset + blobSize;
+
+            if(progressCallback && !progressCallback(i + 1, m_sources.size()))
+                return false;
+        }
+
+        PackHeader header{};
+        header.magic = AssetPack::magic;
+        header.version = AssetPack::version;
+        header.headerSize = sizeof(PackHeader);
+        header.entriesCount = static_cast<std::uint32_t>(entries.size());
+        header.indexOffset = offset;
+        for(std::size_t i = 0; i < entries.size(); ++i) {
+            file.write(reinterpret_cast<const char*>(&entries[i]), sizeof(IndexEntry));
+            file.write(m_sources[i].name.data(), static_cast<std::streamsize>(m_sources[i].name.size()));
+            offset += sizeof(IndexEntry) + m_sources[i].name.size();
+        }
+        header.fileSize = offset;
+
+        file.seekp(0);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        return static_cast<bool>(file);
+    }
+
+}
@@ -112,7 +112,7 @@ namespace robot2D::priv {
         if (!m_window)
         {
             glfwTerminate();
-            exit(1);
+            throw std::runtime_error("Can't create GLFW3 window");
         }
 
         /* Make the window's context current */
@@ -129,7 +129,11 @@ namespace robot2D::priv {
             throw std::runtime_error("Failed to initialize GLAD");
         }
 #endif
-        glViewport(0, 0, static_cast<int>(m_size.x), static_cast<int>(m_size.y));
+        int framebufferWidth = 0;
+        int framebufferHeight = 0;
+        glfwGetFramebufferSize(m_window, &framebufferWidth, &framebufferHeight);
+        m_framebufferSize = { static_cast<unsigned int>(framebufferWidth), static_cast<unsigned int>(framebufferHeight) };
+        glViewport(0, 0, framebufferWidth, framebufferHeight);
     }
 
     bool DesktopWindowImpl::isOpen() const {
@@ -151,6 +155,21 @@ namespace robot2D::priv {
         glfwPollEvents();
     }
 
+    void DesktopWindowImpl::swapBuffers() {
+        glfwSwapBuffers(m_window);
+    }
+
+    void DesktopWindowImpl::processEvents() {
+        glfwPollEvents();
+    }
+
+    void DesktopWindowImpl::setActive(bool flag) {
+        glfwMakeContextCurrent(flag ? m_window : nullptr);
+        /// swap interval belongs to current context
+        if(flag && m_context.vsync)
+            glfwSwapInterval(1);
+    }
+
     void DesktopWindowImpl::setup_callbacks() {
         if(m_window == nullptr)
             throw std::runtime_error("Window is nullptr");
@@ -242,9 +261,16 @@ namespace robot2D::priv {
         window -> m_event_queue.push(event);
     }
 
-    void DesktopWindowImpl::framebuffer_callback([[maybe_unused]] GLFWwindow* window, int width, int height)
-    {
-        glViewport(0, 0, width, height);
+    void DesktopWindowImpl::framebuffer_callback(GLFWwindow* wnd, int width, int height) {
+        auto window = static_cast<DesktopWindowImpl*>(glfwGetWindowUserPointer(wnd));
+        window -> m_framebufferSize = { static_cast<unsigned int>(width), static_cast<unsigned int>(height) };
+        /// in pipelined mode context lives on render thread, it applies size from FramePacket
+        if(glfwGetCurrentContext() == wnd)
+            glViewport(0, 0, width, height);
+    }
+
+    vec2u DesktopWindowImpl::getFramebufferSize() const {
+        return m_framebufferSize;
     }
 
     void DesktopWindowImpl::maximized_callback([[maybe_unused]] GLFWwindow* wnd, [[maybe_unused]] int state) {}
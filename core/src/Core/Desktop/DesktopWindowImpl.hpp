@@ -45,6 +45,10 @@ namespace robot2D::priv {
 
         void close() override;
         void display() override;
+        void swapBuffers() override;
+        void processEvents() override;
+        void setActive(bool flag) override;
+        vec2u getFramebufferSize() const override;
 
         bool isMousePressed(const Mouse& button)override;
         bool isKeyboardPressed(const Key& key)override;
@@ -92,6 +96,8 @@ namespace robot2D::priv {
         GLFWwindow* m_window;
         std::queue<Event> m_event_queue;
         vec2u m_size;
+        /// Updated by framebuffer callback on thread which processes events.
+        vec2u m_framebufferSize;
         std::string m_name;
         WindowContext m_context;
         bool m_cursorVisible;
@@ -23,6 +23,8 @@ source distribution.
 
 namespace robot2D {
 
+    InputStream::~InputStream() = default;
+
     void FileInputStream::FileCloser::operator()(std::FILE* file) {
         std::fclose(file);
     }
@@ -0,0 +1,113 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#include <robot2D/Core/Hash.hpp>
+
+namespace robot2D {
+    namespace {
+        constexpr std::uint64_t prime1 = 11400714785074694791ULL;
+        constexpr std::uint64_t prime2 = 14029467366897019727ULL;
+        constexpr std::uint64_t prime3 = 1609587929392839161ULL;
+        constexpr std::uint64_t prime4 = 9650029242287828579ULL;
+        constexpr std::uint64_t prime5 = 2870177450012600261ULL;
+
+        inline std::uint64_t rotateLeft(std::uint64_t value, int bits) {
+            return (value << bits) | (value >> (64 - bits));
+        }
+
+        /// Reference hash is defined on little endian reads.
+        inline std::uint64_t read64(const std::uint8_t* data) {
+            std::uint64_t value = 0;
+            for(int i = 7; i >= 0; --i)
+                value = (value << 8) | data[i];
+            return value;
+        }
+
+        inline std::uint32_t read32(const std::uint8_t* data) {
+            return static_cast<std::uint32_t>(data[0]) | (static_cast<std::uint32_t>(data[1]) << 8)
+                | (static_cast<std::uint32_t>(data[2]) << 16) | (static_cast<std::uint32_t>(data[3]) << 24);
+        }
+
+        inline std::uint64_t round(std::uint64_t accumulator, std::uint64_t input) {
+            accumulator += input * prime2;
+            return rotateLeft(accumulator, 31) * prime1;
+        }
+
+        inline std::uint64_t mergeRound(std::uint64_t hash, std::uint64_t accumulator) {
+            hash ^= round(0, accumulator);
+            return hash * prime1 + prime4;
+        }
+    }
+
+    std::uint64_t xxHash64(const void* data, std::size_t size, std::uint64_t seed) {
+        auto bytes = static_cast<const std::uint8_t*>(data);
+        const auto* end = bytes + size;
+        std::uint64_t hash;
+
+        if(size >= 32) {
+            std::uint64_t v1 = seed + prime1 + prime2;
+            std::uint64_t v2 = seed + prime2;
+            std::uint64_t v3 = seed;
+            std::uint64_t v4 = seed - prime1;
+
+            const auto* stripesEnd = end - 32;
+            do {
+                v1 = round(v1, read64(bytes));
+                v2 = round(v2, read64(bytes + 8));
+                v3 = round(v3, read64(bytes + 16));
+                v4 = round(v4, read64(bytes + 24));
+                bytes += 32;
+            } while(bytes <= stripesEnd);
+
+            hash = rotateLeft(v1, 1) + rotateLeft(v2, 7) + rotateLeft(v3, 12) + rotateLeft(v4, 18);
+            hash = mergeRound(hash, v1);
+            hash = mergeRound(hash, v2);
+            hash = mergeRound(hash, v3);
+            hash = mergeRound(hash, v4);
+        }
+        else
+            hash = seed + prime5;
+
+        hash += static_cast<std::uint64_t>(size);
+
+        for(; bytes + 8 <= end; bytes += 8) {
+            hash ^= round(0, read64(bytes));
+            hash = rotateLeft(hash, 27) * prime1 + prime4;
+        }
+        if(bytes + 4 <= end) {
+            hash ^= static_cast<std::uint64_t>(read32(bytes)) * prime1;
+            hash = rotateLeft(hash, 23) * prime2 + prime3;
+            bytes += 4;
+        }
+        for(; bytes < end; ++bytes) {
+            hash ^= static_cast<std::uint64_t>(*bytes) * prime5;
+            hash = rotateLeft(hash, 11) * prime1;
+        }
+
+        hash ^= hash >> 33;
+        hash *= prime2;
+        hash ^= hash >> 29;
+        hash *= prime3;
+        hash ^= hash >> 32;
+        return hash;
+    }
+
+}
@@ -0,0 +1,354 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#include <algorithm>
+#include <exception>
+#include <string>
+
+#include <robot2D/Core/JobSystem.hpp>
+#include <robot2D/Core/Clock.hpp>
+#include <robot2D/Util/Logger.hpp>
+#include <robot2D/Util/Profiler.hpp>
+
+#include "WorkStealingDeque.hpp"
+
+namespace robot2D {
+    namespace priv {
+        struct JobState {
+            JobSystem::Work work;
+            JobSystem::Completion completion;
+            JobPriority priority{JobPriority::Normal};
+
+            /// Starts from one, scheduling itself holds it until all dependencies are linked.
+            std::atomic<int> unfinishedDependencies{1};
+            std::atomic<bool> done{false};
+
+            /// Guards continuations and done transition.
+            std::mutex mutex;
+            std::vector<JobState*> continuations;
+
+            /// Keeps job alive while it's queued or executed.
+            std::shared_ptr<JobState> self;
+        };
+    }
+
+    namespace {
+        thread_local const JobSystem* currentJobSystem = nullptr;
+        thread_local int currentWorker = -1;
+    }
+
+    bool JobHandle::isDone() const {
+        return !m_state || m_state -> done.load(std::memory_order_acquire);
+    }
+
+    JobSystem::JobSystem(unsigned int workersCount) {
+        if(workersCount == 0) {
+            const auto hardwareThreads = std::thread::hardware_concurrency();
+            workersCount = std::max(1U, hardwareThreads > 1 ? hardwareThreads - 1 : 1U);
+        }
+
+        for(unsigned int i = 0; i < workersCount; ++i)
+            m_deques.emplace_back(std::make_unique<priv::WorkStealingDeque>());
+
+        m_running.store(true, std::memory_order_release);
+        for(unsigned int i = 0; i < workersCount; ++i)
+            m_workers.emplace_back(&JobSystem::workerThread, this, static_cast<int>(i));
+    }
+
+    JobSystem::~JobSystem() {
+        stop();
+    }
+
+    JobSystem& JobSystem::getInstance() {
+        static JobSystem instance;
+        return instance;
+    }
+
+    JobHandle JobSystem::schedule(Work&& work, Completion&& completion, JobPriority priority) {
+        return makeJob(std::move(work), std::move(completion), {}, priority);
+    }
+
+    JobHandle JobSystem::schedule(Work&& work, const std::vector<JobHandle>& dependencies,
+                                  Completion&& completion, JobPriority priority) {
+        return makeJob(std::move(work), std::move(completion), dependencies, priority);
+    }
+
+    JobHandle JobSystem::then(const JobHandle& parent, Work&& work, Completion&& completion, JobPriority priority) {
+        return makeJob(std::move(work), std::move(completion), { parent }, priority);
+    }
+
+    JobHandle JobSystem::makeJob(Work&& work, Completion&& completion, const std::vector<JobHandle>& dependencies,
+                                 JobPriority priority) {
+        auto state = std::make_shared<priv::JobState>();
+        state -> work = std::move(work);
+        state -> completion = std::move(completion);
+        state -> priority = priority;
+        state -> self = state;
+        m_pendingJobs.fetch_add(1, std::memory_order_acq_rel);
+
+        for(const auto& dependency: dependencies) {
+            if(!dependency.m_state)
+                continue;
+            auto& dependencyState = *dependency.m_state;
+            std::lock_guard<std::mutex> lock{dependencyState.mutex};
+            if(dependencyState.done.load(std::memory_order_acquire))
+                continue;
+            state -> unfinishedDependencies.fetch_add(1, std::memory_order_relaxed);
+            dependencyState.continuations.emplace_back(state.get());
+        }
+
+        if(state -> unfinishedDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            enqueue(state.get());
+        return JobHandle{state};
+    }
+
+    void JobSystem::enqueue(priv::JobState* job) {
+        const int workerIndex = currentWorkerIndex();
+        const bool local = job -> priority == JobPriority::Normal && workerIndex >= 0;
+        if(!local || !m_deques[workerIndex] -> push(job)) {
+            std::unique_lock<std::mutex> lock{m_sharedMutex};
+            /// workers are gone, job is done on calling thread, flag is set under same lock by stop
+            if(m_joined.load(std::memory_order_acquire)) {
+                lock.unlock();
+                execute(job, -1);
+                return;
+            }
+            m_sharedQueues[static_cast<std::size_t>(job -> priority)].emplace_back(job);
+        }
+
+        m_queuedJobs.fetch_add(1, std::memory_order_release);
+        {
+            /// empty lock orders notify after sleeping worker has checked predicate
+            std::lock_guard<std::mutex> lock{m_sleepMutex};
+        }
+        m_sleepCondition.notify_one();
+    }
+
+    priv::JobState* JobSystem::popShared(JobPriority priority) {
+        auto& queue = m_sharedQueues[static_cast<std::size_t>(priority)];
+        std::lock_guard<std::mutex> lock{m_sharedMutex};
+        if(queue.empty())
+            return nullptr;
+        auto* job = queue.front();
+        queue.pop_front();
+        return job;
+    }
+
+    bool JobSystem::takeQueued(priv::JobState* job) {
+        auto& queue = m_sharedQueues[static_cast<std::size_t>(job -> priority)];
+        {
+            std::lock_guard<std::mutex> lock{m_sharedMutex};
+            auto found = std::find(queue.begin(), queue.end(), job);
+            if(found == queue.end())
+                return false;
+            queue.erase(found);
+        }
+        m_queuedJobs.fetch_sub(1, std::memory_order_acq_rel);
+        return true;
+    }
+
+    priv::JobState* JobSystem::takeJob(int workerIndex) {
+        auto* job = popShared(JobPriority::Interactive);
+        if(!job && workerIndex >= 0)
+            job = m_deques[workerIndex] -> pop();
+        if(!job)
+            job = popShared(JobPriority::Normal);
+
+        const auto dequesCount = static_cast<int>(m_deques.size());
+        for(int i = 1; !job && i <= dequesCount; ++i) {
+            const int victim = (std::max(workerIndex, 0) + i) % dequesCount;
+            if(victim != workerIndex)
+                job = m_deques[victim] -> steal();
+        }
+
+        if(!job)
+            job = popShared(JobPriority::Background);
+
+        if(job)
+            m_queuedJobs.fetch_sub(1, std::memory_order_acq_rel);
+        return job;
+    }
+
+    void JobSystem::execute(priv::JobState* job, int workerIndex) {
+        {
+            RB_PROFILE_SCOPE("JobSystem::execute");
+            try {
+                if(job -> work)
+                    job -> work();
+            }
+            catch(const std::exception& exception) {
+                RB_CORE_ERROR("JobSystem: job has thrown exception: {}", exception.what());
+            }
+        }
+        finish(job, workerIndex);
+    }
+
+    void JobSystem::finish(priv::JobState* job, int workerIndex) {
+        (void)workerIndex;
+        std::vector<priv::JobState*> continuations;
+        {
+            std::lock_guard<std::mutex> lock{job -> mutex};
+            job -> done.store(true, std::memory_order_release);
+            continuations.swap(job -> continuations);
+        }
+
+        for(auto* continuation: continuations) {
+            if(continuation -> unfinishedDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                enqueue(continuation);
+        }
+
+        auto self = std::move(job -> self);
+        if(self -> completion) {
+            std::lock_guard<std::mutex> lock{m_completedMutex};
+            m_completedJobs[static_cast<std::size_t>(self -> priority)].emplace_back(std::move(self));
+        }
+        else
+            m_pendingJobs.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    void JobSystem::workerThread(int workerIndex) {
+        RB_PROFILE_THREAD("JobWorker " + std::to_string(workerIndex));
+        currentJobSystem = this;
+        currentWorker = workerIndex;
+
+        while(true) {
+            if(auto* job = takeJob(workerIndex)) {
+                execute(job, workerIndex);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock{m_sleepMutex};
+            m_sleepCondition.wait(lock, [this]() {
+                return m_queuedJobs.load(std::memory_order_acquire) > 0
+                    || !m_running.load(std::memory_order_acquire);
+            });
+            if(!m_running.load(std::memory_order_acquire) && m_queuedJobs.load(std::memory_order_acquire) <= 0)
+                break;
+        }
+
+        currentJobSystem = nullptr;
+        currentWorker = -1;
+    }
+
+    int JobSystem::currentWorkerIndex() const {
+        return currentJobSystem == this ? currentWorker : -1;
+    }
+
+    void JobSystem::wait(const JobHandle& handle) {
+        if(!handle.m_state)
+            return;
+
+        const int workerIndex = currentWorkerIndex();
+        auto* awaited = handle.m_state.get();
+        while(!awaited -> done.load(std::memory_order_acquire)) {
+            if(workerIndex >= 0) {
+                if(auto* job = takeJob(workerIndex)) {
+                    execute(job, workerIndex);
+                    continue;
+                }
+            }
+            /// frame thread must not pick up imports or editor tasks, it runs only job it waits for
+            else if(takeQueued(awaited)) {
+                execute(awaited, workerIndex);
+                continue;
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    void JobSystem::parallelFor(std::size_t count, std::size_t minChunkSize, const RangeWork& work,
+                                JobPriority priority) {
+        if(count == 0)
+            return;
+
+        const std::size_t threadsCount = m_workers.size() + 1;
+        const std::size_t chunkSize = std::max(std::max<std::size_t>(minChunkSize, 1),
+                                               (count + threadsCount - 1) / threadsCount);
+        std::vector<JobHandle> chunks;
+        for(std::size_t begin = chunkSize; begin < count; begin += chunkSize) {
+            const std::size_t end = std::min(count, begin + chunkSize);
+            chunks.emplace_back(schedule([&work, begin, end]() { work(begin, end); }, {}, priority));
+        }
+
+        work(0, std::min(count, chunkSize));
+        for(const auto& chunk: chunks)
+            wait(chunk);
+    }
+
+    std::size_t JobSystem::drainCompleted(Time budget) {
+        RB_PROFILE_FUNCTION();
+        Clock clock;
+        std::size_t drained = 0;
+
+        while(true) {
+            JobPtr job{nullptr};
+            {
+                std::lock_guard<std::mutex> lock{m_completedMutex};
+                for(auto& completedJobs: m_completedJobs) {
+                    if(completedJobs.empty())
+                        continue;
+                    job = std::move(completedJobs.front());
+                    completedJobs.pop_front();
+                    break;
+                }
+            }
+            if(!job)
+                break;
+
+            job -> completion();
+            m_pendingJobs.fetch_sub(1, std::memory_order_acq_rel);
+            ++drained;
+            if(clock.duration().asMicroSeconds() >= budget.asMicroSeconds())
+                break;
+        }
+
+        return drained;
+    }
+
+    void JobSystem::stop() {
+        if(!m_running.exchange(false, std::memory_order_acq_rel))
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock{m_sleepMutex};
+        }
+        m_sleepCondition.notify_all();
+        for(auto& worker: m_workers) {
+            if(worker.joinable())
+                worker.join();
+        }
+        {
+            std::lock_guard<std::mutex> lock{m_sharedMutex};
+            m_joined.store(true, std::memory_order_release);
+        }
+        /// jobs queued while workers were exiting have no one to take them
+        while(auto* job = takeJob(-1))
+            execute(job, -1);
+
+        std::lock_guard<std::mutex> lock{m_completedMutex};
+        for(auto& completedJobs: m_completedJobs) {
+            m_pendingJobs.fetch_sub(static_cast<int>(completedJobs.size()), std::memory_order_acq_rel);
+            completedJobs.clear();
+        }
+    }
+
+}
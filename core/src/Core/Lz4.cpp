@@ -0,0 +1,194 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#include <cstring>
+#include <vector>
+
+#include "Lz4.hpp"
+
+namespace robot2D::priv {
+    namespace {
+        constexpr std::size_t minMatch = 4;
+        /// Last match must start at least mfLimit bytes before end of block.
+        constexpr std::size_t mfLimit = 12;
+        /// Last lastLiterals bytes of block are always literals.
+        constexpr std::size_t lastLiterals = 5;
+        constexpr std::size_t maxOffset = 65535;
+        constexpr unsigned hashLog = 16;
+
+        std::uint32_t read32(const std::uint8_t* ptr) {
+            std::uint32_t value;
+            std::memcpy(&value, ptr, sizeof(value));
+            return value;
+        }
+
+        std::uint32_t hash(std::uint32_t sequence) {
+            return (sequence * 2654435761U) >> (32 - hashLog);
+        }
+
+        /// Writes 255-bytes tail of length which didn't fit into token.
+        bool writeLength(std::size_t length, std::uint8_t*& out, const std::uint8_t* outEnd) {
+            while(length >= 255) {
+                if(out >= outEnd)
+                    return false;
+                *out++ = 255;
+                length -= 255;
+            }
+            if(out >= outEnd)
+                return false;
+            *out++ = static_cast<std::uint8_t>(length);
+            return true;
+        }
+
+        bool readLength(std::size_t& length, const std::uint8_t*& in, const std::uint8_t* inEnd) {
+            std::uint8_t byte;
+            do {
+                if(in >= inEnd)
+                    return false;
+                byte = *in++;
+                length += byte;
+            } while(byte == 255);
+            return true;
+        }
+
+        bool writeSequence(const std::uint8_t* literals, std::size_t literalsCount,
+                           std::size_t offset, std::size_t matchLength,
+                           std::uint8_t*& out, const std::uint8_t* outEnd) {
+            if(out >= outEnd)
+                return false;
+            auto* token = out++;
+            *token = static_cast<std::uint8_t>((literalsCount >= 15 ? 15 : literalsCount) << 4);
+            if(literalsCount >= 15 && !writeLength(literalsCount - 15, out, outEnd))
+                return false;
+            if(static_cast<std::size_t>(outEnd - out) < literalsCount)
+                return false;
+            std::memcpy(out, literals, literalsCount);
+            out += literalsCount;
+
+            /// last sequence has only literals
+            if(matchLength == 0)
+                return true;
+
+            if(outEnd - out < 2)
+                return false;
+            *out++ = static_cast<std::uint8_t>(offset & 0xFF);
+            *out++ = static_cast<std::uint8_t>(offset >> 8);
+            const auto length = matchLength - minMatch;
+            *token |= static_cast<std::uint8_t>(length >= 15 ? 15 : length);
+            return length < 15 || writeLength(length - 15, out, outEnd);
+        }
+    }
+
+    std::size_t lz4CompressBound(std::size_t size) {
+        return size + size / 255 + 16;
+    }
+
+    std::size_t lz4Compress(const std::uint8_t* source, std::size_t sourceSize,
+                            std::uint8_t* destination, std::size_t destinationCapacity) {
+        auto* out = destination;
+        const auto* outEnd = destination + destinationCapacity;
+        std::size_t anchor = 0;
+
+        if(sourceSize > mfLimit) {
+            /// positions are stored + 1, zero means empty slot
+            std::vector<std::uint32_t> table(std::size_t{1} << hashLog, 0);
+            const std::size_t matchLimit = sourceSize - lastLiterals;
+            const std::size_t positionLimit = sourceSize - mfLimit;
+
+            std::size_t position = 0;
+            while(position < positionLimit) {
+                const auto sequence = read32(source + position);
+                auto& slot = table[hash(sequence)];
+                const std::size_t candidate = slot;
+                slot = static_cast<std::uint32_t>(position + 1);
+
+                if(candidate == 0 || position - (candidate - 1) > maxOffset
+                    || read32(source + candidate - 1) != sequence) {
+                    ++position;
+                    continue;
+                }
+
+                const std::size_t matchPosition = candidate - 1;
+                std::size_t length = minMatch;
+                while(position + length < matchLimit && source[matchPosition + length] == source[position + length])
+                    ++length;
+
+                if(!writeSequence(source + anchor, position - anchor, position - matchPosition, length, out, outEnd))
+                    return 0;
+                position += length;
+                anchor = position;
+            }
+        }
+
+        if(!writeSequence(source + anchor, sourceSize - anchor, 0, 0, out, outEnd))
+            return 0;
+        return static_cast<std::size_t>(out - destination);
+    }
+
+    bool lz4Decompress(const std::uint8_t* source, std::size_t sourceSize,
+                       std::uint8_t* destination, std::size_t destinationSize) {
+        const auto* in = source;
+        const auto* inEnd = source + sourceSize;
+        auto* out = destination;
+        const auto* outEnd = destination + destinationSize;
+
+        while(in < inEnd) {
+            const auto token = *in++;
+
+            std::size_t literalsCount = token >> 4;
+            if(literalsCount == 15 && !readLength(literalsCount, in, inEnd))
+                return false;
+            if(static_cast<std::size_t>(inEnd - in) < literalsCount
+                || static_cast<std::size_t>(outEnd - out) < literalsCount)
+                return false;
+            std::memcpy(out, in, literalsCount);
+            in += literalsCount;
+            out += literalsCount;
+
+            if(in == inEnd)
+                break;
+
+            if(inEnd - in < 2)
+                return false;
+            const std::size_t offset = static_cast<std::size_t>(in[0]) | (static_cast<std::size_t>(in[1]) << 8);
+            in += 2;
+            if(offset == 0 || offset > static_cast<std::size_t>(out - destination))
+                return false;
+
+            std::size_t matchLength = token & 0x0F;
+            if(matchLength == 15 && !readLength(matchLength, in, inEnd))
+                return false;
+            matchLength += minMatch;
+            if(static_cast<std::size_t>(outEnd - out) < matchLength)
+                return false;
+
+            /// match may overlap output, so it's copied forward byte by byte
+            const auto* match = out - offset;
+            for(std::size_t i = 0; i < matchLength; ++i)
+                out[i] = match[i];
+            out += matchLength;
+        }
+
+        return out == outEnd;
+    }
+
+}
@@ -0,0 +1,44 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace robot2D::priv {
+
+    /// Worst size of LZ4 block for input of given size.
+    std::size_t lz4CompressBound(std::size_t size);
+
+    /**
+     * \brief Compresses data into single LZ4 block, greedy matcher with 64 KB window.
+     * \return size of block or 0 if destination is too small.
+     */
+    std::size_t lz4Compress(const std::uint8_t* source, std::size_t sourceSize,
+                            std::uint8_t* destination, std::size_t destinationCapacity);
+
+    /// \brief Decodes LZ4 block, fails if block is corrupted or doesn't decode into exactly destinationSize bytes.
+    bool lz4Decompress(const std::uint8_t* source, std::size_t sourceSize,
+                       std::uint8_t* destination, std::size_t destinationSize);
+
+}
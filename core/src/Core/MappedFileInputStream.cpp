@@ -0,0 +1,138 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#include <robot2D/Core/MappedFileInputStream.hpp>
+
+#ifdef ROBOT2D_WINDOWS
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace robot2D {
+    namespace {
+        /// Empty file can't be mapped, but is still valid stream.
+        const std::uint8_t emptyFile[1] = {0};
+    }
+
+    MappedFileInputStream::~MappedFileInputStream() {
+        close();
+    }
+
+    bool MappedFileInputStream::openFromFile(const std::string& path) {
+        close();
+
+    #ifdef ROBOT2D_WINDOWS
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if(file == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER fileSize;
+        if(!GetFileSizeEx(file, &fileSize)) {
+            CloseHandle(file);
+            return false;
+        }
+        if(fileSize.QuadPart == 0) {
+            CloseHandle(file);
+            m_data = emptyFile;
+            m_stream.open(m_data, 0);
+            return true;
+        }
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if(!mapping)
+            return false;
+
+        auto* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if(!view) {
+            CloseHandle(mapping);
+            return false;
+        }
+        m_mapping = mapping;
+        m_data = static_cast<const std::uint8_t*>(view);
+        m_size = static_cast<std::size_t>(fileSize.QuadPart);
+    #else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if(fd < 0)
+            return false;
+
+        struct stat fileStat{};
+        if(fstat(fd, &fileStat) != 0) {
+            ::close(fd);
+            return false;
+        }
+        if(fileStat.st_size == 0) {
+            ::close(fd);
+            m_data = emptyFile;
+            m_stream.open(m_data, 0);
+            return true;
+        }
+
+        void* view = mmap(nullptr, static_cast<std::size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if(view == MAP_FAILED)
+            return false;
+        m_data = static_cast<const std::uint8_t*>(view);
+        m_size = static_cast<std::size_t>(fileStat.st_size);
+    #endif
+
+        m_stream.open(m_data, m_size);
+        return true;
+    }
+
+    void MappedFileInputStream::close() {
+        if(m_data && m_data != emptyFile) {
+        #ifdef ROBOT2D_WINDOWS
+            UnmapViewOfFile(m_data);
+            CloseHandle(static_cast<HANDLE>(m_mapping));
+        #else
+            munmap(const_cast<std::uint8_t*>(m_data), m_size);
+        #endif
+        }
+        m_data = nullptr;
+        m_size = 0;
+        m_mapping = nullptr;
+        m_stream.open(nullptr, 0);
+    }
+
+    std::uint64_t MappedFileInputStream::read(void* buffer, std::uint64_t size) {
+        return m_stream.read(buffer, size);
+    }
+
+    std::uint64_t MappedFileInputStream::seek(std::uint64_t position) {
+        return m_stream.seek(position);
+    }
+
+    std::uint64_t MappedFileInputStream::tell() {
+        return m_stream.tell();
+    }
+
+    std::uint64_t MappedFileInputStream::getSize() {
+        return m_stream.getSize();
+    }
+
+}
@@ -0,0 +1,70 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#include <algorithm>
+#include <cstring>
+
+#include <robot2D/Core/MemoryInputStream.hpp>
+
+namespace robot2D {
+
+    MemoryInputStream::MemoryInputStream(const void* data, std::size_t size) {
+        open(data, size);
+    }
+
+    void MemoryInputStream::open(const void* data, std::size_t size) {
+        m_data = static_cast<const std::uint8_t*>(data);
+        m_size = data ? size : 0;
+        m_position = 0;
+    }
+
+    std::uint64_t MemoryInputStream::read(void* buffer, std::uint64_t size) {
+        if(!m_data)
+            return -1;
+        const auto count = std::min<std::uint64_t>(size, m_size - m_position);
+        if(count > 0) {
+            std::memcpy(buffer, m_data + m_position, static_cast<std::size_t>(count));
+            m_position += static_cast<std::size_t>(count);
+        }
+        return count;
+    }
+
+    std::uint64_t MemoryInputStream::seek(std::uint64_t position) {
+        if(!m_data)
+            return -1;
+        m_position = static_cast<std::size_t>(std::min<std::uint64_t>(position, m_size));
+        return m_position;
+    }
+
+    std::uint64_t MemoryInputStream::tell() {
+        if(!m_data)
+            return -1;
+        return m_position;
+    }
+
+    std::uint64_t MemoryInputStream::getSize() {
+        if(!m_data)
+            return -1;
+        return m_size;
+    }
+
+}
@@ -66,6 +66,22 @@ namespace robot2D {
         m_windowImpl -> display();
     }
 
+    void Window::swapBuffers() {
+        m_windowImpl -> swapBuffers();
+    }
+
+    void Window::processEvents() {
+        m_windowImpl -> processEvents();
+    }
+
+    void Window::setActive(bool flag) {
+        m_windowImpl -> setActive(flag);
+    }
+
+    vec2u Window::getFramebufferSize() const {
+        return m_windowImpl -> getFramebufferSize();
+    }
+
     void Window::close() {
         m_windowImpl -> close();
     }
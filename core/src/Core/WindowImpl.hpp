@@ -52,6 +52,10 @@ namespace robot2D::priv {
         virtual void setTitle(const std::string& title) const = 0;
         virtual void close() = 0;
         virtual void display() = 0;
+        virtual void swapBuffers() = 0;
+        virtual void processEvents() = 0;
+        virtual void setActive(bool flag) = 0;
+        virtual vec2u getFramebufferSize() const = 0;
         virtual bool isMousePressed(const Mouse& button) = 0;
         virtual bool isKeyboardPressed(const Key& key) = 0;
         virtual bool isJoystickAvailable(const JoystickType& joystickType) = 0;
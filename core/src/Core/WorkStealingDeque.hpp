@@ -0,0 +1,105 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace robot2D::priv {
+    struct JobState;
+
+    /**
+     * \brief Fixed size Chase-Lev deque.
+     * \details Only owner thread calls push and pop, any thread may steal.
+     * Push fails when deque is full, caller puts job somewhere else.
+     */
+    class WorkStealingDeque {
+    public:
+        static constexpr std::int64_t capacity = 1 << 12;
+
+        WorkStealingDeque() {
+            for(auto& slot: m_buffer)
+                slot.store(nullptr, std::memory_order_relaxed);
+        }
+        WorkStealingDeque(const WorkStealingDeque& other) = delete;
+        WorkStealingDeque& operator=(const WorkStealingDeque& other) = delete;
+        WorkStealingDeque(WorkStealingDeque&& other) = delete;
+        WorkStealingDeque& operator=(WorkStealingDeque&& other) = delete;
+        ~WorkStealingDeque() = default;
+
+        bool push(JobState* job) {
+            const auto bottom = m_bottom.load(std::memory_order_relaxed);
+            const auto top = m_top.load(std::memory_order_acquire);
+            if(bottom - top >= capacity)
+                return false;
+
+            m_buffer[bottom & mask].store(job, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return true;
+        }
+
+        JobState* pop() {
+            const auto bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+            m_bottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            auto top = m_top.load(std::memory_order_relaxed);
+
+            if(top > bottom) {
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            auto* job = m_buffer[bottom & mask].load(std::memory_order_relaxed);
+            if(top == bottom) {
+                /// last job, race with thieves for it
+                if(!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                  std::memory_order_relaxed))
+                    job = nullptr;
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+            return job;
+        }
+
+        JobState* steal() {
+            auto top = m_top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const auto bottom = m_bottom.load(std::memory_order_acquire);
+            if(top >= bottom)
+                return nullptr;
+
+            auto* job = m_buffer[top & mask].load(std::memory_order_relaxed);
+            if(!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                return nullptr;
+            return job;
+        }
+    private:
+        static constexpr std::int64_t mask = capacity - 1;
+
+        alignas(64) std::atomic<std::int64_t> m_top{0};
+        alignas(64) std::atomic<std::int64_t> m_bottom{0};
+        std::array<std::atomic<JobState*>, capacity> m_buffer;
+    };
+
+}
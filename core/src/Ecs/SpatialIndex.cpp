@@ -0,0 +1,424 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include <robot2D/Ecs/SpatialIndex.hpp>
+
+namespace robot2D::ecs {
+
+    namespace {
+        constexpr float displacementMultiplier = 2.F;
+    }
+
+    SpatialIndex::AABB SpatialIndex::AABB::combine(const AABB& left, const AABB& right) {
+        return { std::min(left.minX, right.minX), std::min(left.minY, right.minY),
+                 std::max(left.maxX, right.maxX), std::max(left.maxY, right.maxY) };
+    }
+
+    SpatialIndex::AABB SpatialIndex::AABB::fromRect(const FloatRect& rect) {
+        if(rect.isRotated()) {
+            /// rotated rect is covered by circle of its half diagonal
+            const auto center = rect.centerPoint();
+            const float radius = std::sqrt(rect.width * rect.width + rect.height * rect.height) / 2.F;
+            return { center.x - radius, center.y - radius, center.x + radius, center.y + radius };
+        }
+        return { std::min(rect.lx, rect.lx + rect.width), std::min(rect.ly, rect.ly + rect.height),
+                 std::max(rect.lx, rect.lx + rect.width), std::max(rect.ly, rect.ly + rect.height) };
+    }
+
+    SpatialIndex::SpatialIndex(float fatMargin): m_fatMargin{fatMargin} {}
+
+    SpatialIndex::ProxyID SpatialIndex::createProxy(const FloatRect& rect, Entity entity) {
+        const auto proxyID = allocateNode();
+        auto& link = m_links[proxyID];
+        link.aabb = AABB::fromRect(rect);
+        link.entity = entity;
+        link.height = 0;
+        m_nodes[proxyID].fatAABB = makeFat(link.aabb, {});
+
+        insertLeaf(proxyID);
+        ++m_proxyCount;
+        return proxyID;
+    }
+
+    void SpatialIndex::destroyProxy(ProxyID proxyID) {
+        assert(proxyID >= 0 && proxyID < static_cast<ProxyID>(m_nodes.size()) && "ProxyID out of range");
+        assert(m_nodes[proxyID].isLeaf() && "ProxyID must be leaf");
+
+        removeLeaf(proxyID);
+        freeNode(proxyID);
+        --m_proxyCount;
+    }
+
+    bool SpatialIndex::moveProxy(ProxyID proxyID, const FloatRect& rect, const vec2f& displacement) {
+        assert(proxyID >= 0 && proxyID < static_cast<ProxyID>(m_nodes.size()) && "ProxyID out of range");
+        assert(m_nodes[proxyID].isLeaf() && "ProxyID must be leaf");
+
+        auto& aabb = m_links[proxyID].aabb;
+        aabb = AABB::fromRect(rect);
+        const auto fatAABB = makeFat(aabb, displacement);
+
+        const auto& treeAABB = m_nodes[proxyID].fatAABB;
+        if(treeAABB.contains(aabb)) {
+            /// proxy fattened by big jump is shrunk, otherwise it would stay oversized in tree forever
+            const float hugeMargin = 4.F * m_fatMargin;
+            const AABB hugeAABB{ fatAABB.minX - hugeMargin, fatAABB.minY - hugeMargin,
+                                 fatAABB.maxX + hugeMargin, fatAABB.maxY + hugeMargin };
+            if(hugeAABB.contains(treeAABB))
+                return false;
+        }
+
+        removeLeaf(proxyID);
+        m_nodes[proxyID].fatAABB = fatAABB;
+        insertLeaf(proxyID);
+        return true;
+    }
+
+    void SpatialIndex::clear() {
+        m_nodes.clear();
+        m_links.clear();
+        m_root = nullProxy;
+        m_freeList = nullProxy;
+        m_proxyCount = 0;
+    }
+
+    void SpatialIndex::query(const FloatRect& rect, std::vector<Entity>& result) const {
+        query(rect, [this, &result](ProxyID proxyID) {
+            result.push_back(m_links[proxyID].entity);
+            return true;
+        });
+    }
+
+    void SpatialIndex::query(const vec2f& point, std::vector<Entity>& result) const {
+        const AABB pointAABB{point.x, point.y, point.x, point.y};
+        traverse([&pointAABB](const AABB& fatAABB) { return fatAABB.overlaps(pointAABB); },
+                 [this, &pointAABB, &result](ProxyID proxyID) {
+            const auto& link = m_links[proxyID];
+            if(link.aabb.overlaps(pointAABB))
+                result.push_back(link.entity);
+            return true;
+        });
+    }
+
+    void SpatialIndex::rayCast(const vec2f& from, const vec2f& to, std::vector<RayHit>& result) const {
+        const vec2f direction = to - from;
+
+        /// slab test, fraction is entry point on segment
+        auto intersects = [&from, &direction](const AABB& aabb, float& fraction) {
+            float tMin = 0.F;
+            float tMax = 1.F;
+            const float origin[2] = { from.x, from.y };
+            const float delta[2] = { direction.x, direction.y };
+            const float boxMin[2] = { aabb.minX, aabb.minY };
+            const float boxMax[2] = { aabb.maxX, aabb.maxY };
+
+            for(int axis = 0; axis < 2; ++axis) {
+                if(std::abs(delta[axis]) < 1e-6F) {
+                    if(origin[axis] < boxMin[axis] || origin[axis] > boxMax[axis])
+                        return false;
+                    continue;
+                }
+                const float inverse = 1.F / delta[axis];
+                float t1 = (boxMin[axis] - origin[axis]) * inverse;
+                float t2 = (boxMax[axis] - origin[axis]) * inverse;
+                if(t1 > t2)
+                    std::swap(t1, t2);
+                tMin = std::max(tMin, t1);
+                tMax = std::min(tMax, t2);
+                if(tMin > tMax)
+                    return false;
+            }
+            fraction = tMin;
+            return true;
+        };
+
+        const auto firstHit = result.size();
+        traverse([&intersects](const AABB& fatAABB) {
+                     float fraction;
+                     return intersects(fatAABB, fraction);
+                 },
+                 [this, &intersects, &result](ProxyID proxyID) {
+            const auto& link = m_links[proxyID];
+            float fraction;
+            if(intersects(link.aabb, fraction))
+                result.push_back({link.entity, fraction});
+            return true;
+        });
+
+        std::sort(result.begin() + static_cast<std::ptrdiff_t>(firstHit), result.end(),
+                  [](const RayHit& left, const RayHit& right) {
+            return left.fraction < right.fraction;
+        });
+    }
+
+    FloatRect SpatialIndex::getFatRect(ProxyID proxyID) const {
+        const auto& aabb = m_nodes[proxyID].fatAABB;
+        return { aabb.minX, aabb.minY, aabb.maxX - aabb.minX, aabb.maxY - aabb.minY };
+    }
+
+    SpatialIndex::ProxyID SpatialIndex::allocateNode() {
+        if(m_freeList == nullProxy) {
+            m_nodes.emplace_back();
+            m_links.emplace_back();
+            return static_cast<ProxyID>(m_nodes.size() - 1);
+        }
+
+        const auto nodeID = m_freeList;
+        m_freeList = m_links[nodeID].parent;
+        m_nodes[nodeID] = Node{};
+        m_links[nodeID] = NodeLink{};
+        return nodeID;
+    }
+
+    void SpatialIndex::freeNode(ProxyID nodeID) {
+        m_nodes[nodeID] = Node{};
+        auto& link = m_links[nodeID];
+        link = NodeLink{};
+        link.parent = m_freeList;
+        m_freeList = nodeID;
+    }
+
+    SpatialIndex::AABB SpatialIndex::makeFat(const AABB& aabb, const vec2f& displacement) const {
+        AABB fatAABB{ aabb.minX - m_fatMargin, aabb.minY - m_fatMargin,
+                      aabb.maxX + m_fatMargin, aabb.maxY + m_fatMargin };
+
+        const float dx = displacementMultiplier * displacement.x;
+        const float dy = displacementMultiplier * displacement.y;
+        if(dx < 0.F)
+            fatAABB.minX += dx;
+        else
+            fatAABB.maxX += dx;
+        if(dy < 0.F)
+            fatAABB.minY += dy;
+        else
+            fatAABB.maxY += dy;
+
+        return fatAABB;
+    }
+
+    void SpatialIndex::refit(ProxyID index) {
+        while(index != nullProxy) {
+            index = balance(index);
+
+            auto& node = m_nodes[index];
+            auto& link = m_links[index];
+            node.fatAABB = AABB::combine(m_nodes[node.child1].fatAABB, m_nodes[node.child2].fatAABB);
+            link.height = 1 + std::max(m_links[node.child1].height, m_links[node.child2].height);
+
+            index = link.parent;
+        }
+    }
+
+    void SpatialIndex::insertLeaf(ProxyID leaf) {
+        if(m_root == nullProxy) {
+            m_root = leaf;
+            m_links[leaf].parent = nullProxy;
+            return;
+        }
+
+        /// find best sibling by perimeter cost
+        const auto leafAABB = m_nodes[leaf].fatAABB;
+        auto index = m_root;
+        while(!m_nodes[index].isLeaf()) {
+            const auto& node = m_nodes[index];
+            const auto child1 = node.child1;
+            const auto child2 = node.child2;
+
+            const float area = node.fatAABB.perimeter();
+            const float combinedArea = AABB::combine(node.fatAABB, leafAABB).perimeter();
+
+            const float cost = 2.F * combinedArea;
+            const float inheritanceCost = 2.F * (combinedArea - area);
+
+            auto childCost = [this, &leafAABB, inheritanceCost](ProxyID childID) {
+                const auto& child = m_nodes[childID];
+                const float newArea = AABB::combine(leafAABB, child.fatAABB).perimeter();
+                if(child.isLeaf())
+                    return newArea + inheritanceCost;
+                return newArea - child.fatAABB.perimeter() + inheritanceCost;
+            };
+
+            const float cost1 = childCost(child1);
+            const float cost2 = childCost(child2);
+            if(cost < cost1 && cost < cost2)
+                break;
+
+            index = cost1 < cost2 ? child1 : child2;
+        }
+
+        const auto sibling = index;
+        const auto oldParent = m_links[sibling].parent;
+        const auto newParent = allocateNode();
+
+        m_nodes[newParent].fatAABB = AABB::combine(leafAABB, m_nodes[sibling].fatAABB);
+        m_nodes[newParent].child1 = sibling;
+        m_nodes[newParent].child2 = leaf;
+        m_links[newParent].parent = oldParent;
+        m_links[newParent].height = m_links[sibling].height + 1;
+
+        if(oldParent != nullProxy) {
+            auto& oldParentNode = m_nodes[oldParent];
+            if(oldParentNode.child1 == sibling)
+                oldParentNode.child1 = newParent;
+            else
+                oldParentNode.child2 = newParent;
+        }
+        else
+            m_root = newParent;
+        m_links[sibling].parent = newParent;
+        m_links[leaf].parent = newParent;
+
+        refit(newParent);
+    }
+
+    void SpatialIndex::removeLeaf(ProxyID leaf) {
+        if(leaf == m_root) {
+            m_root = nullProxy;
+            return;
+        }
+
+        const auto parent = m_links[leaf].parent;
+        const auto grandParent = m_links[parent].parent;
+        const auto& parentNode = m_nodes[parent];
+        const auto sibling = parentNode.child1 == leaf ? parentNode.child2 : parentNode.child1;
+
+        if(grandParent == nullProxy) {
+            m_root = sibling;
+            m_links[sibling].parent = nullProxy;
+            freeNode(parent);
+            return;
+        }
+
+        auto& grandParentNode = m_nodes[grandParent];
+        if(grandParentNode.child1 == parent)
+            grandParentNode.child1 = sibling;
+        else
+            grandParentNode.child2 = sibling;
+        m_links[sibling].parent = grandParent;
+        freeNode(parent);
+
+        refit(grandParent);
+    }
+
+    /// Rotates higher child up if subtree of A is imbalanced, returns new subtree root.
+    SpatialIndex::ProxyID SpatialIndex::balance(ProxyID iA) {
+        auto& A = m_nodes[iA];
+        auto& linkA = m_links[iA];
+        if(A.isLeaf() || linkA.height < 2)
+            return iA;
+
+        const auto iB = A.child1;
+        const auto iC = A.child2;
+        auto& B = m_nodes[iB];
+        auto& C = m_nodes[iC];
+        auto& linkB = m_links[iB];
+        auto& linkC = m_links[iC];
+
+        const int balanceFactor = linkC.height - linkB.height;
+
+        auto replaceInParent = [this, iA](ProxyID parent, ProxyID newChild) {
+            if(parent == nullProxy) {
+                m_root = newChild;
+                return;
+            }
+            auto& parentNode = m_nodes[parent];
+            if(parentNode.child1 == iA)
+                parentNode.child1 = newChild;
+            else
+                parentNode.child2 = newChild;
+        };
+
+        if(balanceFactor > 1) {
+            const auto iF = C.child1;
+            const auto iG = C.child2;
+            const auto& F = m_nodes[iF];
+            const auto& G = m_nodes[iG];
+            const auto& linkF = m_links[iF];
+            const auto& linkG = m_links[iG];
+
+            C.child1 = iA;
+            linkC.parent = linkA.parent;
+            linkA.parent = iC;
+            replaceInParent(linkC.parent, iC);
+
+            if(linkF.height > linkG.height) {
+                C.child2 = iF;
+                A.child2 = iG;
+                m_links[iG].parent = iA;
+                A.fatAABB = AABB::combine(B.fatAABB, G.fatAABB);
+                C.fatAABB = AABB::combine(A.fatAABB, F.fatAABB);
+                linkA.height = 1 + std::max(linkB.height, linkG.height);
+                linkC.height = 1 + std::max(linkA.height, linkF.height);
+            }
+            else {
+                C.child2 = iG;
+                A.child2 = iF;
+                m_links[iF].parent = iA;
+                A.fatAABB = AABB::combine(B.fatAABB, F.fatAABB);
+                C.fatAABB = AABB::combine(A.fatAABB, G.fatAABB);
+                linkA.height = 1 + std::max(linkB.height, linkF.height);
+                linkC.height = 1 + std::max(linkA.height, linkG.height);
+            }
+            return iC;
+        }
+
+        if(balanceFactor < -1) {
+            const auto iD = B.child1;
+            const auto iE = B.child2;
+            const auto& D = m_nodes[iD];
+            const auto& E = m_nodes[iE];
+            const auto& linkD = m_links[iD];
+            const auto& linkE = m_links[iE];
+
+            B.child1 = iA;
+            linkB.parent = linkA.parent;
+            linkA.parent = iB;
+            replaceInParent(linkB.parent, iB);
+
+            if(linkD.height > linkE.height) {
+                B.child2 = iD;
+                A.child1 = iE;
+                m_links[iE].parent = iA;
+                A.fatAABB = AABB::combine(C.fatAABB, E.fatAABB);
+                B.fatAABB = AABB::combine(A.fatAABB, D.fatAABB);
+                linkA.height = 1 + std::max(linkC.height, linkE.height);
+                linkB.height = 1 + std::max(linkA.height, linkD.height);
+            }
+            else {
+                B.child2 = iE;
+                A.child1 = iD;
+                m_links[iD].parent = iA;
+                A.fatAABB = AABB::combine(C.fatAABB, D.fatAABB);
+                B.fatAABB = AABB::combine(A.fatAABB, E.fatAABB);
+                linkA.height = 1 + std::max(linkC.height, linkD.height);
+                linkB.height = 1 + std::max(linkA.height, linkE.height);
+            }
+            return iB;
+        }
+
+        return iA;
+    }
+
+}
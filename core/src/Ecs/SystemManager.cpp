@@ -22,6 +22,7 @@ source distribution.
 #include <robot2D/Ecs/SystemManager.hpp>
 #include <robot2D/Ecs/EntityManager.hpp>
 #include <robot2D/Ecs/Scene.hpp>
+#include <robot2D/Util/Profiler.hpp>
 
 namespace robot2D::ecs {
     SystemManager::SystemManager(
@@ -43,8 +44,11 @@ namespace robot2D::ecs {
     }
 
     void SystemManager::update(float dt) {
-        for(auto& system: m_systems)
+        RB_PROFILE_SCOPE("SystemManager::update");
+        for(auto& system: m_systems) {
+            RB_PROFILE_SCOPE(system -> m_systemId.name());
             system -> update(dt);
+        }
     }
 
     void SystemManager::addEntity(Entity entity) {
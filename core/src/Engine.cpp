@@ -21,6 +21,9 @@ source distribution.
 
 #include <robot2D/Engine.hpp>
 #include <robot2D/Util/Logger.hpp>
+#include <robot2D/Util/Profiler.hpp>
+
+#include "RenderThread.hpp"
 
 namespace robot2D {
     void robot2DInit() {
@@ -33,7 +36,8 @@ namespace robot2D {
     windowSize{800, 600},
     windowTitle{"Robot2D Engine"},
     maxFrameRate{60},
-    windowContext{WindowContext::Default}
+    windowContext{WindowContext::Default},
+    pipelinedRender{false}
     {}
 
     EngineConfiguration::EngineConfiguration(
@@ -45,7 +49,8 @@ namespace robot2D {
             windowSize{size},
             windowTitle{title},
             maxFrameRate{FrameRate},
-            windowContext{Context}
+            windowContext{Context},
+            pipelinedRender{false}
             {}
 
     Engine::Engine():
@@ -71,28 +76,69 @@ namespace robot2D {
         m_application -> setWindow(&renderWindow);
 
         setup();
+        RB_PROFILE_THREAD("Main");
+        if(engineConfiguration.pipelinedRender) {
+            runPipelined(renderWindow, timePerFrame);
+            m_application -> destroy();
+            return;
+        }
+
         while (m_application -> isRunning() &&
                 renderWindow.isOpen()) {
             float delta = m_frameClock.restart().asSeconds();
             timeProcessed += delta;
+            processFrame(renderWindow, timePerFrame, timeProcessed);
 
-            while (timeProcessed >= timePerFrame) {
-                timeProcessed -= timePerFrame;
-                Event event{};
-                while(renderWindow.pollEvents(event)) {
-                    m_application -> handleEvents(event);
-                }
-                m_application -> handleMessages();
-                m_application -> update(timePerFrame);
+            {
+                RB_PROFILE_SCOPE("Application::render");
+                m_application -> guiUpdate(delta);
+                m_application -> render();
             }
-
-            m_application -> guiUpdate(delta);
-            m_application -> render();
+            Profiler::frameEnd();
         }
 
         m_application -> destroy();
     }
 
+    void Engine::processFrame(RenderWindow& renderWindow, float timePerFrame, float& timeProcessed) {
+        RB_PROFILE_SCOPE("Engine::processFrame");
+        while (timeProcessed >= timePerFrame) {
+            timeProcessed -= timePerFrame;
+            Event event{};
+            while(renderWindow.pollEvents(event)) {
+                m_application -> handleEvents(event);
+            }
+            m_application -> handleMessages();
+            m_application -> update(timePerFrame);
+        }
+    }
+
+    void Engine::runPipelined(RenderWindow& renderWindow, float timePerFrame) {
+        float timeProcessed = 0.F;
+        priv::RenderThread renderThread{renderWindow};
+        renderThread.start();
+
+        while (m_application -> isRunning() &&
+               renderWindow.isOpen()) {
+            float delta = m_frameClock.restart().asSeconds();
+            timeProcessed += delta;
+
+            renderWindow.processEvents();
+            processFrame(renderWindow, timePerFrame, timeProcessed);
+
+            auto& packet = renderThread.beginFrame();
+            packet.framebufferSize = renderWindow.getFramebufferSize();
+            {
+                RB_PROFILE_SCOPE("Application::record");
+                m_application -> record(packet);
+            }
+            renderThread.endFrame();
+            Profiler::frameEnd();
+        }
+
+        renderThread.stop();
+    }
+
     int constructEngine(Application::Ptr application,
                          EngineConfiguration&& engineConfiguration) {
         Engine engine;
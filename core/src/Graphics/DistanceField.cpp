@@ -0,0 +1,120 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include <robot2D/Graphics/DistanceField.hpp>
+
+namespace robot2D {
+    namespace {
+        constexpr float infinity = 1e20F;
+
+        /// Felzenszwalb-Huttenlocher squared distance transform of one row or column.
+        void transformLine(const float* source, int count, float* distances, int* parabolas, float* bounds) {
+            auto intersection = [source](int q, int v) {
+                return ((source[q] + static_cast<float>(q * q)) - (source[v] + static_cast<float>(v * v)))
+                       / static_cast<float>(2 * q - 2 * v);
+            };
+
+            int k = 0;
+            parabolas[0] = 0;
+            bounds[0] = -std::numeric_limits<float>::infinity();
+            bounds[1] = std::numeric_limits<float>::infinity();
+            for(int q = 1; q < count; ++q) {
+                float s = intersection(q, parabolas[k]);
+                while(s <= bounds[k]) {
+                    --k;
+                    s = intersection(q, parabolas[k]);
+                }
+                ++k;
+                parabolas[k] = q;
+                bounds[k] = s;
+                bounds[k + 1] = std::numeric_limits<float>::infinity();
+            }
+
+            k = 0;
+            for(int q = 0; q < count; ++q) {
+                while(bounds[k + 1] < static_cast<float>(q))
+                    ++k;
+                const int v = parabolas[k];
+                distances[q] = static_cast<float>((q - v) * (q - v)) + source[v];
+            }
+        }
+
+        /// In-place squared distance of every cell to nearest zero cell.
+        void transform(std::vector<float>& grid, int width, int height) {
+            const int longest = std::max(width, height);
+            std::vector<float> source(longest);
+            std::vector<float> distances(longest);
+            std::vector<int> parabolas(longest);
+            std::vector<float> bounds(longest + 1);
+
+            for(int x = 0; x < width; ++x) {
+                for(int y = 0; y < height; ++y)
+                    source[y] = grid[y * width + x];
+                transformLine(source.data(), height, distances.data(), parabolas.data(), bounds.data());
+                for(int y = 0; y < height; ++y)
+                    grid[y * width + x] = distances[y];
+            }
+
+            for(int y = 0; y < height; ++y) {
+                std::copy_n(grid.begin() + y * width, width, source.begin());
+                transformLine(source.data(), width, distances.data(), parabolas.data(), bounds.data());
+                std::copy_n(distances.begin(), width, grid.begin() + y * width);
+            }
+        }
+    }
+
+    void generateDistanceField(const std::uint8_t* coverage, const vec2i& size, int spread,
+                               std::vector<std::uint8_t>& field) {
+        spread = std::max(spread, 1);
+        const int width = size.x + 2 * spread;
+        const int height = size.y + 2 * spread;
+        const auto cells = static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
+
+        std::vector<float> outside(cells, infinity);
+        std::vector<float> inside(cells, 0.F);
+        for(int y = 0; y < size.y; ++y) {
+            for(int x = 0; x < size.x; ++x) {
+                if(coverage[y * size.x + x] < 128)
+                    continue;
+                const auto cell = static_cast<std::size_t>((y + spread) * width + x + spread);
+                outside[cell] = 0.F;
+                inside[cell] = infinity;
+            }
+        }
+
+        transform(outside, width, height);
+        transform(inside, width, height);
+
+        field.resize(cells);
+        const float scale = 127.F / static_cast<float>(spread);
+        for(std::size_t i = 0; i < cells; ++i) {
+            /// cell centers are half pixel away from edge on both sides
+            const float distance = outside[i] > 0.F ? -(std::sqrt(outside[i]) - 0.5F) : std::sqrt(inside[i]) - 0.5F;
+            const float value = 128.F + distance * scale;
+            field[i] = static_cast<std::uint8_t>(std::clamp(value, 0.F, 255.F));
+        }
+    }
+
+}
@@ -1,40 +1,110 @@
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+#include <robot2D/Core/JobSystem.hpp>
 #include <robot2D/Util/Logger.hpp>
 #include <robot2D/Graphics/Font.hpp>
+#include <robot2D/Graphics/GlyphCache.hpp>
+#include <robot2D/Graphics/TextLayout.hpp>
+#include <robot2D/Graphics/DistanceField.hpp>
+#include <robot2D/Util/Profiler.hpp>
 
 #include <ft2build.h>
 #include FT_FREETYPE_H
 
 namespace robot2D {
 
-    constexpr unsigned int TextureAtlasSize = 512;
+    namespace {
+        /// Distance transform of one glyph is short, smaller jobs cost more than they save.
+        constexpr std::size_t minSdfGlyphsPerJob = 8;
+    }
 
     Font::Font() = default;
 
     Font::~Font() {
-        auto face = static_cast<FT_Face>(m_face);
-        if(face)
-            FT_Done_Face(face);
-
-        auto library = static_cast<FT_Library>(m_library);
-        if(library)
-            FT_Done_FreeType(library);
+        release();
+    }
 
+    void Font::release() {
+        if(m_handle && m_handle.use_count() == 1) {
+            GlyphCache::getInstance().removeFont(*this);
+            TextLayoutCache::getInstance().removeFont(*this);
+        }
+        m_handle.reset();
         m_face = nullptr;
-        m_library = nullptr;
     }
 
-    const std::unordered_map<int, GlyphCharacter>& Font::getGlyphCharacters() const {
-        return m_glyphCharacters;
+    bool Font::loadFromFile(const std::string& path, int charSize, FontRenderMode renderMode) {
+        if(!setup(path, charSize))
+            return false;
+        m_renderMode = renderMode;
+        if(m_renderMode == FontRenderMode::SDF) {
+            SdfGlyphs glyphs;
+            prepareSdfGlyphs(glyphs);
+        }
+        return true;
     }
 
-    const std::vector<std::unique_ptr<robot2D::Image>>& Font::getImages() const {
-        return m_images;
+    bool Font::loadFromMemory(const void* data, std::size_t size, int charSize, FontRenderMode renderMode) {
+        if(!setup(data, size, charSize))
+            return false;
+        m_renderMode = renderMode;
+        if(m_renderMode == FontRenderMode::SDF) {
+            SdfGlyphs glyphs;
+            prepareSdfGlyphs(glyphs);
+        }
+        return true;
     }
 
-    bool Font::loadFromFile(const std::string& path, int charSize) {
+    bool Font::loadFromFile(const std::string& path, int charSize, SdfGlyphs& glyphs) {
         if(!setup(path, charSize))
             return false;
-        setupAtlas();
+        m_renderMode = FontRenderMode::SDF;
+        prepareSdfGlyphs(glyphs);
+        return true;
+    }
+
+    bool Font::loadFromMemory(const void* data, std::size_t size, int charSize, SdfGlyphs& glyphs) {
+        if(!setup(data, size, charSize))
+            return false;
+        m_renderMode = FontRenderMode::SDF;
+        prepareSdfGlyphs(glyphs);
+        return true;
+    }
+
+    void Font::setup(void* library, void* face, int charSize, FontRenderMode renderMode) {
+        release();
+        auto ftLibrary = static_cast<FT_Library>(library);
+        m_handle = std::shared_ptr<void>(face, [ftLibrary](void* handle) {
+            FT_Done_Face(static_cast<FT_Face>(handle));
+            FT_Done_FreeType(ftLibrary);
+        });
+        m_face = face;
+        m_characterSize = static_cast<unsigned int>(charSize);
+        m_renderMode = renderMode;
+    }
+
+    bool Font::setup(const void* data, std::size_t size, int charSize) {
+        FT_Library library;
+        FT_Face face;
+
+        if (FT_Init_FreeType(&library)) {
+            RB_CORE_ERROR("ERROR::FREETYPE: Could not init FreeType Library");
+            return false;
+        }
+
+        if (FT_New_Memory_Face(library, static_cast<const FT_Byte*>(data), static_cast<FT_Long>(size), 0, &face)) {
+            RB_CORE_ERROR("ERROR::FREETYPE: Failed to load font from memory");
+            FT_Done_FreeType(library);
+            return false;
+        }
+
+        FT_Set_Pixel_Sizes(face, 0, charSize);
+
+        setup(library, face, charSize, FontRenderMode::Bitmap);
+        m_path.clear();
+
         return true;
     }
 
@@ -49,207 +119,131 @@ namespace robot2D {
 
         if (FT_New_Face(library, path.c_str(), 0, &face)) {
             RB_CORE_ERROR("ERROR::FREETYPE: Failed to load font");
+            FT_Done_FreeType(library);
             return false;
         }
 
         FT_Set_Pixel_Sizes(face, 0, charSize);
 
-        m_library = library;
-        m_face = face;
+        setup(library, face, charSize, FontRenderMode::Bitmap);
         m_path = path;
 
         return true;
     }
 
-    void Font::setupAtlas() {
-        unsigned int CHARACTERS_TEXTURE_SIZE = TextureAtlasSize;
-
-        auto face = (FT_Face)m_face;
-        assert(face != nullptr && "Font Face can't be nullptr");
-
-        std::vector<unsigned char> textureData(CHARACTERS_TEXTURE_SIZE * CHARACTERS_TEXTURE_SIZE, 0);
-        std::unique_ptr<robot2D::Image> image = std::make_unique<robot2D::Image>();
-
-        auto currentPixelPositionRow = 0;
-        auto currentPixelPositionCol = 0;
-        auto rowHeight = 0;
-        auto currentRenderIndex = 0;
-
-        auto finalizeTexture = [this,  &image, &textureData](bool createNext)
-        {
-            image -> create(
-                {TextureAtlasSize, TextureAtlasSize},
-                textureData.data(),
-                robot2D::ImageColorFormat::RED,
-                robot2D::ImageParameter::ClampToEdge
-            );
-
-
-            m_images.push_back(std::move(image));
-            if (createNext)
-            {
-                image = std::make_unique<robot2D::Image>();
-                memset(textureData.data(), 0, textureData.size());
-            }
-        };
-
-        // Character Range //
-        unsigned int start = 32;
-        unsigned int end = 127;
-
-        for (auto it = start; it <= end;)
-        {
-            FT_Load_Glyph(face, FT_Get_Char_Index(face, it), FT_LOAD_DEFAULT);
-            FT_Render_Glyph(face->glyph, FT_RENDER_MODE_NORMAL);
-
-            const auto* ptrBitmap = &face->glyph->bitmap;
-            const int bmpWidth = static_cast<int>(ptrBitmap->width);
-            const int bmpHeight = static_cast<int>(ptrBitmap->rows);
-            const auto rowsLeft = CHARACTERS_TEXTURE_SIZE - currentPixelPositionRow;
-            const auto colsLeft = CHARACTERS_TEXTURE_SIZE - currentPixelPositionCol;
-
-            rowHeight = std::max(rowHeight, static_cast<int>(bmpHeight));
-
-            if (colsLeft < bmpWidth)
-            {
-                currentPixelPositionCol = 0;
-                currentPixelPositionRow += rowHeight + 1;
-                rowHeight = 0;
-                continue;
-            }
-
-            if (rowsLeft < bmpHeight)
-            {
-                finalizeTexture(true);
-                currentPixelPositionCol = 0;
-                currentPixelPositionRow = 0;
-                rowHeight = 0;
-                continue;
-            }
-
-            auto& charProps = m_glyphCharacters[static_cast<int>(it)];
-            charProps.size = {
-                    static_cast<float>(face -> glyph-> metrics.width >> 6),
-                    static_cast<float>(face -> glyph-> metrics.height >> 6)
-            };
-
-            charProps.bearing = {
-                    static_cast<int>(face->glyph->metrics.horiBearingX >> 6),
-                    static_cast<int>(face->glyph->metrics.horiBearingY >> 6)
-            };
-
-            charProps.advance = static_cast<float>(face->glyph->metrics.horiAdvance >> 6);
-
-            if (bmpWidth == 0 && bmpHeight == 0) {
-                charProps.textureIndex = -1;
-                ++it;
-                continue;
-            }
-
-            for (auto i = 0; i < bmpHeight; i++)
-            {
-                int globalRow = currentPixelPositionRow + i;
-                int reversedRow = bmpHeight - i - 1;
-                memcpy(textureData.data() + globalRow * 512 + currentPixelPositionCol,
-                       ptrBitmap->buffer + reversedRow * bmpWidth, bmpWidth);
-            }
-
-
-            charProps.bmpSize = { static_cast<float>(bmpWidth),
-                                  static_cast<float>(bmpHeight) };
-
-            charProps.indexPosition = {static_cast<float>(currentPixelPositionCol),
-                                       static_cast<float>(currentPixelPositionRow) };
-            charProps.textureIndex = static_cast<float>(m_images.size());
-
-            currentPixelPositionCol += bmpWidth + 1;
-            currentRenderIndex += 4;
-            ++it;
-        }
+    bool Font::rasterizeGlyph(std::uint32_t codepoint, unsigned int characterSize, GlyphBitmap& bitmap) const {
+        auto face = static_cast<FT_Face>(m_face);
+        if(!face)
+            return false;
 
-        // If there is a leftover texture after preparing the characters, add it to the list of textures
-        if (currentPixelPositionRow > 0 || currentPixelPositionCol > 0) {
-            finalizeTexture(false);
+        FT_Set_Pixel_Sizes(face, 0, characterSize);
+        if(FT_Load_Glyph(face, FT_Get_Char_Index(face, codepoint), FT_LOAD_DEFAULT)
+            || FT_Render_Glyph(face -> glyph, FT_RENDER_MODE_NORMAL)) {
+            RB_CORE_WARN("FREETYPE: Can't render glyph {0}", codepoint);
+            return false;
         }
+
+        const auto& metrics = face -> glyph -> metrics;
+        const auto& ftBitmap = face -> glyph -> bitmap;
+        bitmap.size = { static_cast<int>(ftBitmap.width), static_cast<int>(ftBitmap.rows) };
+        bitmap.bearing = { static_cast<int>(metrics.horiBearingX >> 6), static_cast<int>(metrics.horiBearingY >> 6) };
+        bitmap.advance = static_cast<float>(metrics.horiAdvance >> 6);
+
+        bitmap.pixels.resize(static_cast<std::size_t>(bitmap.size.x) * static_cast<std::size_t>(bitmap.size.y));
+        for(int row = 0; row < bitmap.size.y; ++row)
+            std::memcpy(bitmap.pixels.data() + row * bitmap.size.x,
+                        ftBitmap.buffer + row * ftBitmap.pitch, bitmap.size.x);
+        return true;
+    }
+
+    float Font::getKerning(std::uint32_t left, std::uint32_t right, unsigned int characterSize) const {
+        auto face = static_cast<FT_Face>(m_face);
+        if(!face || !FT_HAS_KERNING(face) || face -> units_per_EM == 0)
+            return 0.F;
+
+        /// unscaled kerning doesn't depend on face's current size, so rasterized glyphs aren't affected
+        FT_Vector kerning;
+        if(FT_Get_Kerning(face, FT_Get_Char_Index(face, left), FT_Get_Char_Index(face, right),
+                          FT_KERNING_UNSCALED, &kerning))
+            return 0.F;
+
+        const float value = static_cast<float>(kerning.x) * static_cast<float>(characterSize)
+                / static_cast<float>(face -> units_per_EM);
+        /// bitmap glyphs are placed on whole pixels
+        return m_renderMode == FontRenderMode::Bitmap ? std::round(value) : value;
     }
 
-    std::unordered_map<int, GlyphQuad> Font::getBufferCache(float scale) const  {
-        std::unordered_map<int, GlyphQuad> m_bufferCache;
-
-        float maxBearing = static_cast<float>(m_glyphCharacters.at('H').bearing.y);
-        float textureSize = TextureAtlasSize;
-
-        // OpenGL Texture Coords 3210
-        // Real World Texture Coords 0123
-        for(const auto& glyphCharacter: m_glyphCharacters) {
-            const auto& glyphProperties = glyphCharacter.second;
-
-            float x = static_cast<float>(glyphProperties.bearing.x) * scale;
-            float y = (maxBearing - static_cast<float>(glyphProperties.bearing.y)) * scale;
-            float w = glyphProperties.bmpSize.x * scale;
-            float h = glyphProperties.bmpSize.y * scale;
-
-            GlyphVertex vertex0;
-            GlyphVertex vertex1;
-            GlyphVertex vertex2;
-            GlyphVertex vertex3;
-
-            vertex0.position = { x, y };
-            vertex0.uvs = {
-                    (glyphProperties.indexPosition.x) / textureSize,
-                    (glyphProperties.indexPosition.y + glyphProperties.bmpSize.y) / textureSize
-            };
-            vertex1.position = {x + w, y};
-            vertex1.uvs = {
-                    (glyphProperties.indexPosition.x + glyphProperties.bmpSize.x) / textureSize,
-                    (glyphProperties.indexPosition.y + glyphProperties.bmpSize.y) / textureSize
-            };
-
-            vertex2.position = {x + w, y + h};
-            vertex2.uvs = {
-                    (glyphProperties.indexPosition.x + glyphProperties.bmpSize.x) / textureSize,
-                    (glyphProperties.indexPosition.y) / textureSize
-            };
-            vertex3.position = { x, y + h};
-            vertex3.uvs = {
-                    glyphProperties.indexPosition.x / textureSize,
-                    (glyphProperties.indexPosition.y) / textureSize
-            };
-
-
-            GlyphQuad glyphQuad;
-            glyphQuad.vertices[0] = vertex0;
-            glyphQuad.vertices[1] = vertex1;
-            glyphQuad.vertices[2] = vertex2;
-            glyphQuad.vertices[3] = vertex3;
-
-            m_bufferCache.insert(std::pair<int, GlyphQuad>(glyphCharacter.first, glyphQuad));
+    float Font::getLineSpacing(unsigned int characterSize) const {
+        auto face = static_cast<FT_Face>(m_face);
+        if(!face || face -> units_per_EM == 0)
+            return static_cast<float>(characterSize);
+        const float value = static_cast<float>(face -> height) * static_cast<float>(characterSize)
+                / static_cast<float>(face -> units_per_EM);
+        return m_renderMode == FontRenderMode::Bitmap ? std::round(value) : value;
+    }
+
+    bool Font::rasterizeSdfGlyph(std::uint32_t codepoint, GlyphBitmap& bitmap) const {
+        if(!rasterizeGlyph(codepoint, sdfGlyphSize, bitmap))
+            return false;
+        toDistanceField(bitmap);
+        return true;
+    }
+
+    void Font::toDistanceField(GlyphBitmap& bitmap) {
+        if(bitmap.size.x == 0 || bitmap.size.y == 0)
+            return;
+
+        std::vector<std::uint8_t> field;
+        generateDistanceField(bitmap.pixels.data(), bitmap.size, sdfSpread, field);
+        bitmap.pixels = std::move(field);
+        bitmap.size += vec2i{ 2 * sdfSpread, 2 * sdfSpread };
+        bitmap.bearing.x -= sdfSpread;
+        bitmap.bearing.y += sdfSpread;
+    }
+
+    void Font::prepareSdfGlyphs(SdfGlyphs& glyphs) {
+        RB_PROFILE_FUNCTION();
+
+        if(!glyphs.empty()) {
+            GlyphCache::getInstance().addGlyphs(*this, sdfGlyphSize, glyphs);
+            return;
+        }
+
+        /// FreeType face isn't thread safe, only distance transform goes to workers
+        glyphs.reserve(sdfPreparedLast - sdfPreparedFirst + 1);
+        for(auto codepoint = sdfPreparedFirst; codepoint <= sdfPreparedLast; ++codepoint) {
+            GlyphBitmap bitmap;
+            if(rasterizeGlyph(codepoint, sdfGlyphSize, bitmap))
+                glyphs.emplace_back(codepoint, std::move(bitmap));
         }
 
-        return m_bufferCache;
+        JobSystem::getInstance().parallelFor(glyphs.size(), minSdfGlyphsPerJob, [&glyphs](std::size_t begin, std::size_t end) {
+            for(std::size_t i = begin; i < end; ++i)
+                toDistanceField(glyphs[i].second);
+        });
+
+        GlyphCache::getInstance().addGlyphs(*this, sdfGlyphSize, glyphs);
     }
 
     vec2f Font::calculateSize(std::string&& text) const {
-        if(text.empty() || m_glyphCharacters.empty())
+        if(text.empty() || !m_face)
             return {};
 
-        vec2f textSize{};
-        for(const auto& c: text) {
-            auto& currGlyph = m_glyphCharacters.at(c);
-            textSize.x += currGlyph.advance;
-            textSize.y = std::max(textSize.y, currGlyph.bmpSize.y);
-        }
-
-        return textSize;
+        TextLayoutOptions options;
+        options.characterSize = m_characterSize;
+        TextLayout layout;
+        layoutText(*this, text, options, layout);
+        return layout.size;
     }
 
     bool Font::clone(Font& font) {
+        if(m_handle == font.m_handle)
+            return true;
+        release();
+        m_handle = font.m_handle;
         m_face = font.m_face;
-        m_library = font.m_library;
-        m_glyphCharacters = font.m_glyphCharacters;
-        m_images.clear();
-        for(auto& image: font.m_images)
-            m_images.push_back(std::move(image));
+        m_characterSize = font.m_characterSize;
+        m_renderMode = font.m_renderMode;
         m_path = font.m_path;
         return true;
     }
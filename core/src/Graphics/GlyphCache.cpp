@@ -0,0 +1,341 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#include <cstring>
+#include <algorithm>
+#include <functional>
+
+#include <robot2D/Util/Logger.hpp>
+#include <robot2D/Graphics/GlyphCache.hpp>
+
+namespace robot2D {
+    namespace {
+        constexpr std::uint32_t replacementCodepoint = 0xFFFD;
+    }
+
+    std::uint32_t decodeUtf8(const std::string& text, std::size_t& index) {
+        const auto lead = static_cast<unsigned char>(text[index++]);
+        if(lead < 0x80)
+            return lead;
+
+        int trailing = 0;
+        std::uint32_t codepoint = 0;
+        if((lead & 0xE0) == 0xC0) {
+            trailing = 1;
+            codepoint = lead & 0x1F;
+        }
+        else if((lead & 0xF0) == 0xE0) {
+            trailing = 2;
+            codepoint = lead & 0x0F;
+        }
+        else if((lead & 0xF8) == 0xF0) {
+            trailing = 3;
+            codepoint = lead & 0x07;
+        }
+        else
+            return replacementCodepoint;
+
+        for(int i = 0; i < trailing; ++i) {
+            if(index >= text.size())
+                return replacementCodepoint;
+            const auto next = static_cast<unsigned char>(text[index]);
+            if((next & 0xC0) != 0x80)
+                return replacementCodepoint;
+            codepoint = (codepoint << 6) | (next & 0x3F);
+            ++index;
+        }
+
+        if(codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF))
+            return replacementCodepoint;
+        return codepoint;
+    }
+
+    std::size_t GlyphCache::KeyHash::operator()(const Key& key) const {
+        std::size_t hash = std::hash<const void*>{}(key.face);
+        hash ^= std::hash<std::uint64_t>{}((static_cast<std::uint64_t>(key.characterSize) << 32) | key.codepoint)
+                + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+
+    GlyphCache& GlyphCache::getInstance() {
+        static GlyphCache glyphCache;
+        return glyphCache;
+    }
+
+    GlyphCache::~GlyphCache() {
+        /// Graphics context is already destroyed at exit, textures go away with it.
+        for(auto& page: m_pages)
+            (void)page -> texture.release();
+    }
+
+    GlyphCache::Key GlyphCache::makeKey(const Font& font, unsigned int characterSize, std::uint32_t codepoint) const {
+        /// zero size can't be requested, so it marks size independent SDF glyphs
+        if(font.getRenderMode() == FontRenderMode::SDF)
+            characterSize = 0;
+        return {font.m_face, characterSize, codepoint};
+    }
+
+    bool GlyphCache::getGlyph(const Font& font, unsigned int characterSize, std::uint32_t codepoint, Glyph& glyph) {
+        if(!font.m_face || characterSize == 0)
+            return false;
+
+        const bool sdf = font.getRenderMode() == FontRenderMode::SDF;
+        const unsigned int glyphSize = sdf ? Font::sdfGlyphSize : characterSize;
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            ++m_useTick;
+
+            const Key key = makeKey(font, glyphSize, codepoint);
+            auto found = m_glyphs.find(key);
+            if(found != m_glyphs.end()) {
+                if(found -> second.page >= 0)
+                    m_pages[found -> second.page] -> lastUse = m_useTick;
+                glyph = found -> second;
+            }
+            else {
+                GlyphBitmap bitmap;
+                const bool rendered = sdf ? font.rasterizeSdfGlyph(codepoint, bitmap)
+                                          : font.rasterizeGlyph(codepoint, glyphSize, bitmap);
+                if(!rendered || !insertGlyph(font, key, glyphSize, bitmap, glyph))
+                    return false;
+            }
+        }
+
+        if(glyphSize != characterSize) {
+            const float scale = static_cast<float>(characterSize) / static_cast<float>(glyphSize);
+            for(auto& vertex: glyph.quad.vertices)
+                vertex.position *= scale;
+            glyph.size *= scale;
+            glyph.advance *= scale;
+        }
+        return true;
+    }
+
+    void GlyphCache::addGlyphs(const Font& font, unsigned int characterSize,
+                               const std::vector<std::pair<std::uint32_t, GlyphBitmap>>& glyphs) {
+        if(!font.m_face || characterSize == 0)
+            return;
+
+        std::lock_guard<std::mutex> lock{m_mutex};
+        ++m_useTick;
+        for(const auto& [codepoint, bitmap]: glyphs) {
+            const Key key = makeKey(font, characterSize, codepoint);
+            if(m_glyphs.find(key) != m_glyphs.end())
+                continue;
+            Glyph glyph;
+            insertGlyph(font, key, characterSize, bitmap, glyph);
+        }
+    }
+
+    bool GlyphCache::insertGlyph(const Font& font, const Key& key, unsigned int characterSize,
+                                 const GlyphBitmap& bitmap, Glyph& glyph) {
+        const float baseline = getBaseline(font, characterSize);
+        glyph = {};
+        glyph.advance = bitmap.advance;
+
+        const float x = static_cast<float>(bitmap.bearing.x);
+        const float y = baseline - static_cast<float>(bitmap.bearing.y);
+        const vec2f quadSize{ static_cast<float>(bitmap.size.x), static_cast<float>(bitmap.size.y) };
+        auto& vertices = glyph.quad.vertices;
+        vertices[0].position = { x, y };
+        vertices[1].position = { x + quadSize.x, y };
+        vertices[2].position = { x + quadSize.x, y + quadSize.y };
+        vertices[3].position = { x, y + quadSize.y };
+
+        glyph.size = quadSize;
+        /// distance field's padding isn't part of glyph
+        if(key.characterSize == 0 && bitmap.size.x > 0 && bitmap.size.y > 0)
+            glyph.size -= vec2f{ 2.F * Font::sdfSpread, 2.F * Font::sdfSpread };
+
+        if(bitmap.size.x > 0 && bitmap.size.y > 0 && !placeGlyph(key, bitmap, glyph))
+            return false;
+
+        m_glyphs.emplace(key, glyph);
+        return true;
+    }
+
+    bool GlyphCache::placeGlyph(const Key& key, const GlyphBitmap& bitmap, Glyph& glyph) {
+        const vec2u size{ static_cast<unsigned int>(bitmap.size.x), static_cast<unsigned int>(bitmap.size.y) };
+        IntRect placed;
+        const int pageIndex = findPage(size, placed);
+        if(pageIndex < 0) {
+            RB_CORE_WARN("GlyphCache: glyph {0} of size {1}x{2} doesn't fit into atlas page",
+                         key.codepoint, size.x, size.y);
+            return false;
+        }
+
+        auto& page = *m_pages[pageIndex];
+        /// rows are stored bottom to top, as textures are sampled
+        auto* pixels = page.image.getBuffer();
+        for(int row = 0; row < bitmap.size.y; ++row) {
+            const int reversedRow = bitmap.size.y - row - 1;
+            std::memcpy(pixels + (placed.ly + row) * pageSize + placed.lx,
+                        bitmap.pixels.data() + reversedRow * bitmap.size.x, bitmap.size.x);
+        }
+
+        if(page.dirtyBegin == page.dirtyEnd) {
+            page.dirtyBegin = placed.ly;
+            page.dirtyEnd = placed.ly + placed.height;
+        }
+        else {
+            page.dirtyBegin = std::min(page.dirtyBegin, placed.ly);
+            page.dirtyEnd = std::max(page.dirtyEnd, placed.ly + placed.height);
+        }
+        page.glyphs.push_back(key);
+        page.lastUse = m_useTick;
+
+        // OpenGL Texture Coords 3210
+        // Real World Texture Coords 0123
+        const float textureSize = static_cast<float>(pageSize);
+        const float left = static_cast<float>(placed.lx) / textureSize;
+        const float right = static_cast<float>(placed.lx + placed.width) / textureSize;
+        const float bottom = static_cast<float>(placed.ly) / textureSize;
+        const float top = static_cast<float>(placed.ly + placed.height) / textureSize;
+
+        auto& vertices = glyph.quad.vertices;
+        vertices[0].uvs = { left, top };
+        vertices[1].uvs = { right, top };
+        vertices[2].uvs = { right, bottom };
+        vertices[3].uvs = { left, bottom };
+        glyph.page = pageIndex;
+        return true;
+    }
+
+    int GlyphCache::findPage(const vec2u& size, IntRect& placed) {
+        for(std::size_t i = 0; i < m_pages.size(); ++i) {
+            if(m_pages[i] -> packer.pack(size, placed))
+                return static_cast<int>(i);
+        }
+
+        std::size_t index = m_pages.size();
+        if(m_pages.size() < m_maxPages) {
+            auto page = std::make_unique<Page>();
+            std::vector<std::uint8_t> empty(static_cast<std::size_t>(pageSize) * pageSize, 0);
+            page -> image.create({pageSize, pageSize}, empty.data(),
+                                 ImageColorFormat::RED, ImageParameter::ClampToEdge);
+            m_pages.push_back(std::move(page));
+        }
+        else {
+            index = 0;
+            for(std::size_t i = 1; i < m_pages.size(); ++i) {
+                if(m_pages[i] -> lastUse < m_pages[index] -> lastUse)
+                    index = i;
+            }
+            clearPage(index);
+        }
+
+        if(index >= m_pages.size() || !m_pages[index] -> packer.pack(size, placed))
+            return -1;
+        return static_cast<int>(index);
+    }
+
+    void GlyphCache::clearPage(std::size_t index) {
+        auto& page = *m_pages[index];
+        for(const auto& key: page.glyphs)
+            m_glyphs.erase(key);
+        page.glyphs.clear();
+        page.packer.reset({pageSize, pageSize});
+        std::memset(page.image.getBuffer(), 0, static_cast<std::size_t>(pageSize) * pageSize);
+        page.dirtyBegin = 0;
+        page.dirtyEnd = static_cast<int>(pageSize);
+        ++m_generation;
+    }
+
+    float GlyphCache::getBaseline(const Font& font, unsigned int characterSize) {
+        const Key key{font.m_face, characterSize, 0};
+        auto found = m_baselines.find(key);
+        if(found != m_baselines.end())
+            return found -> second;
+
+        GlyphBitmap bitmap;
+        float baseline = static_cast<float>(characterSize);
+        if(font.rasterizeGlyph('H', characterSize, bitmap))
+            baseline = static_cast<float>(bitmap.bearing.y);
+        m_baselines.emplace(key, baseline);
+        return baseline;
+    }
+
+    const Texture* GlyphCache::getPageTexture(int page) {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        if(page < 0 || static_cast<std::size_t>(page) >= m_pages.size())
+            return nullptr;
+
+        auto& atlasPage = *m_pages[page];
+        if(!atlasPage.texture) {
+            atlasPage.texture = std::make_unique<Texture>();
+            atlasPage.texture -> create(atlasPage.image);
+        }
+        else if(atlasPage.dirtyBegin != atlasPage.dirtyEnd) {
+            const int rows = atlasPage.dirtyEnd - atlasPage.dirtyBegin;
+            atlasPage.texture -> update({0, atlasPage.dirtyBegin, static_cast<int>(pageSize), rows},
+                                        atlasPage.image.getBuffer() + atlasPage.dirtyBegin * pageSize);
+        }
+        atlasPage.dirtyBegin = atlasPage.dirtyEnd = 0;
+
+        return atlasPage.texture.get();
+    }
+
+    void GlyphCache::removeFont(const Font& font) {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        for(auto it = m_baselines.begin(); it != m_baselines.end();) {
+            if(it -> first.face == font.m_face)
+                it = m_baselines.erase(it);
+            else
+                ++it;
+        }
+
+        bool removed = false;
+        for(auto& page: m_pages) {
+            auto& glyphs = page -> glyphs;
+            glyphs.erase(std::remove_if(glyphs.begin(), glyphs.end(),
+                                        [&font](const Key& key) { return key.face == font.m_face; }),
+                         glyphs.end());
+        }
+        for(auto it = m_glyphs.begin(); it != m_glyphs.end();) {
+            if(it -> first.face == font.m_face) {
+                it = m_glyphs.erase(it);
+                removed = true;
+            }
+            else
+                ++it;
+        }
+
+        /// face address can be reused by next font, so texts must not keep old glyphs
+        if(removed)
+            ++m_generation;
+    }
+
+    void GlyphCache::setMaxPages(unsigned int maxPages) {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_maxPages = std::max(1U, maxPages);
+    }
+
+    std::size_t GlyphCache::getPagesCount() const {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return m_pages.size();
+    }
+
+    std::uint64_t GlyphCache::getGeneration() const {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return m_generation;
+    }
+
+}
@@ -19,6 +19,20 @@ and must not be misrepresented as being the original software.
 source distribution.
 *********************************************************************/
 
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define ROBOT2D_IMAGE_SSE
+    #include <emmintrin.h>
+#endif
+
+/// decoded pixels are adopted by PixelBuffer, which frees them by std::free
+#define STBI_MALLOC(size) std::malloc(size)
+#define STBI_REALLOC(pointer, size) std::realloc(pointer, size)
+#define STBI_FREE(pointer) std::free(pointer)
 #include "internal/stb_image.h"
 #include "internal/stb_image_write.h"
 
@@ -30,6 +44,25 @@ namespace robot2D {
 
     Image::Image(): m_pixels() {}
 
+    Image::Image(Image&& other) noexcept:
+        m_size{std::exchange(other.m_size, {})},
+        m_pixels{std::move(other.m_pixels)},
+        m_colorFormat{other.m_colorFormat},
+        m_imageParameter{other.m_imageParameter} {
+        other.m_pixels.clear();
+    }
+
+    Image& Image::operator=(Image&& other) noexcept {
+        if(this == &other)
+            return *this;
+        m_size = std::exchange(other.m_size, {});
+        m_pixels = std::move(other.m_pixels);
+        other.m_pixels.clear();
+        m_colorFormat = other.m_colorFormat;
+        m_imageParameter = other.m_imageParameter;
+        return *this;
+    }
+
     bool Image::loadFromFile(const std::string& path, int desiredChannels) {
         m_pixels.clear();
 
@@ -39,20 +72,7 @@ namespace robot2D {
         unsigned char* ptr = stbi_load(path.c_str(), &width, &height, &channels, desiredChannels);
         if (ptr)
         {
-            // Assign the image properties
-            m_size.x = static_cast<unsigned int>(width);
-            m_size.y = static_cast<unsigned int>(height);
-
-            if (width > 0 && height > 0)
-            {
-                // Copy the loaded pixels to the pixel buffer
-                m_pixels.resize(static_cast<std::size_t>(width * height * channels));
-                memcpy(m_pixels.data(), ptr, m_pixels.size());
-            }
-
-            // Free the loaded pixels (they are now in our own pixel buffer)
-            stbi_image_free(ptr);
-            m_colorFormat = static_cast<ImageColorFormat>(channels);
+            takePixels(ptr, width, height, desiredChannels == 0 ? channels : desiredChannels);
             return true;
         }
         else
@@ -63,6 +83,36 @@ namespace robot2D {
         }
     }
 
+    bool Image::loadFromMemory(const void* data, std::size_t size, int desiredChannels) {
+        m_pixels.clear();
+
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+        unsigned char* ptr = stbi_load_from_memory(static_cast<const stbi_uc*>(data), static_cast<int>(size),
+                                                   &width, &height, &channels, desiredChannels);
+        if(!ptr) {
+            RB_CORE_ERROR("Failed to load image from memory. Reason: {0}", std::string{stbi_failure_reason()});
+            return false;
+        }
+        takePixels(ptr, width, height, desiredChannels == 0 ? channels : desiredChannels);
+        return true;
+    }
+
+    void Image::takePixels(unsigned char* pixels, int width, int height, int channels) {
+        // Assign the image properties
+        m_size.x = static_cast<unsigned int>(width);
+        m_size.y = static_cast<unsigned int>(height);
+
+        const auto bytes = static_cast<std::size_t>(width) * static_cast<std::size_t>(height)
+                * static_cast<std::size_t>(channels);
+        if(bytes > 0)
+            m_pixels = PixelBuffer(bytes, PixelAllocator<std::uint8_t>{pixels});
+        else
+            stbi_image_free(pixels);
+        m_colorFormat = static_cast<ImageColorFormat>(channels);
+    }
+
     const robot2D::vec2u& Image::getSize() const {
         return m_size;
     }
@@ -75,7 +125,7 @@ namespace robot2D {
         return m_colorFormat;
     }
 
-    const std::vector<unsigned char>& Image::getBuffer() const {
+    const PixelBuffer& Image::getBuffer() const {
         return m_pixels;
     }
 
@@ -105,10 +155,111 @@ namespace robot2D {
         }
         m_pixels.resize(size.x * size.y * channels);
         if(data == nullptr) {
+            std::fill(m_pixels.begin(), m_pixels.end(), 0);
             RB_CORE_CRITICAL("Can't Create Image in buffer is nullptr");
             return false;
         }
-        memcpy(m_pixels.data(), data, m_pixels.size());
+        std::memcpy(m_pixels.data(), data, m_pixels.size());
+        return true;
+    }
+
+    bool Image::create(const vec2u& size, PixelBuffer&& pixels, const ImageColorFormat& colorFormat,
+                       const ImageParameter& parameter) {
+        if(pixels.size() != static_cast<std::size_t>(size.x) * size.y * static_cast<std::size_t>(colorFormat)) {
+            RB_CORE_ERROR("Can't Create Image, buffer of {0} bytes doesn't match size {1}x{2}",
+                          pixels.size(), size.x, size.y);
+            return false;
+        }
+        m_pixels = std::move(pixels);
+        m_size = size;
+        m_colorFormat = colorFormat;
+        m_imageParameter = parameter;
+        return true;
+    }
+
+    bool Image::downsample(Image& target) const {
+        if(m_pixels.empty() || (m_size.x <= 1 && m_size.y <= 1))
+            return false;
+
+        const auto channels = static_cast<std::size_t>(m_colorFormat);
+        const vec2u size{std::max(1U, m_size.x / 2), std::max(1U, m_size.y / 2)};
+        target.m_size = size;
+        target.m_colorFormat = m_colorFormat;
+        target.m_imageParameter = m_imageParameter;
+        target.m_pixels.resize(static_cast<std::size_t>(size.x) * size.y * channels);
+
+        for(unsigned int y = 0; y < size.y; ++y) {
+            const auto* top = m_pixels.data() + static_cast<std::size_t>(std::min(2 * y, m_size.y - 1)) * m_size.x * channels;
+            const auto* bottom = m_pixels.data() + static_cast<std::size_t>(std::min(2 * y + 1, m_size.y - 1)) * m_size.x * channels;
+            auto* to = target.m_pixels.data() + static_cast<std::size_t>(y) * size.x * channels;
+            for(unsigned int x = 0; x < size.x; ++x) {
+                const auto left = std::min(2 * x, m_size.x - 1) * channels;
+                const auto right = std::min(2 * x + 1, m_size.x - 1) * channels;
+                for(std::size_t channel = 0; channel < channels; ++channel) {
+                    const unsigned int sum = top[left + channel] + top[right + channel]
+                            + bottom[left + channel] + bottom[right + channel];
+                    *to++ = static_cast<std::uint8_t>((sum + 2) / 4);
+                }
+            }
+        }
+
+        return true;
+    }
+
+    bool Image::downsample(unsigned int factor, Image& target) const {
+        if(m_pixels.empty() || factor < 2 || factor > maxDownsampleFactor)
+            return false;
+
+        const auto channels = static_cast<std::size_t>(m_colorFormat);
+        const vec2u size{(m_size.x + factor - 1) / factor, (m_size.y + factor - 1) / factor};
+        const std::size_t rowBytes = static_cast<std::size_t>(m_size.x) * channels;
+
+        PixelBuffer pixels(static_cast<std::size_t>(size.x) * size.y * channels);
+        /// factor rows of bytes fit into 16 bits: 256 * 255 < 65536
+        std::vector<std::uint16_t> sums(rowBytes);
+        auto* to = pixels.data();
+
+        for(unsigned int y = 0; y < size.y; ++y) {
+            const unsigned int firstRow = y * factor;
+            const unsigned int rows = std::min(factor, m_size.y - firstRow);
+            std::fill(sums.begin(), sums.end(), std::uint16_t{0});
+
+            /// columns are summed over whole rows first, that part is contiguous and vectorized
+            for(unsigned int row = 0; row < rows; ++row) {
+                const auto* from = m_pixels.data() + static_cast<std::size_t>(firstRow + row) * rowBytes;
+                std::size_t i = 0;
+#ifdef ROBOT2D_IMAGE_SSE
+                const __m128i zero = _mm_setzero_si128();
+                for(; i + 16 <= rowBytes; i += 16) {
+                    const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(from + i));
+                    auto* low = reinterpret_cast<__m128i*>(sums.data() + i);
+                    auto* high = reinterpret_cast<__m128i*>(sums.data() + i + 8);
+                    _mm_storeu_si128(low, _mm_add_epi16(_mm_loadu_si128(low), _mm_unpacklo_epi8(bytes, zero)));
+                    _mm_storeu_si128(high, _mm_add_epi16(_mm_loadu_si128(high), _mm_unpackhi_epi8(bytes, zero)));
+                }
+#endif
+                for(; i < rowBytes; ++i)
+                    sums[i] = static_cast<std::uint16_t>(sums[i] + from[i]);
+            }
+
+            for(unsigned int x = 0; x < size.x; ++x) {
+                const unsigned int firstColumn = x * factor;
+                const unsigned int columns = std::min(factor, m_size.x - firstColumn);
+                const unsigned int count = rows * columns;
+                const auto* column = sums.data() + static_cast<std::size_t>(firstColumn) * channels;
+                for(std::size_t channel = 0; channel < channels; ++channel) {
+                    unsigned int sum = 0;
+                    for(unsigned int i = 0; i < columns; ++i)
+                        sum += column[i * channels + channel];
+                    *to++ = static_cast<std::uint8_t>((sum + count / 2) / count);
+                }
+            }
+        }
+
+        target.m_pixels = std::move(pixels);
+        target.m_size = size;
+        target.m_colorFormat = m_colorFormat;
+        target.m_imageParameter = m_imageParameter;
         return true;
     }
 
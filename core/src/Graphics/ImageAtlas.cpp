@@ -19,103 +19,266 @@ and must not be misrepresented as being the original software.
 source distribution.
 *********************************************************************/
 
+#include <cmath>
+#include <numeric>
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+
 #include "internal/stb_image_write.h"
+#include <robot2D/Core/JobSystem.hpp>
 #include <robot2D/Graphics/ImageAtlas.hpp>
+#include <robot2D/Graphics/SkylinePacker.hpp>
 #include <robot2D/Util/Logger.hpp>
+#include <robot2D/Util/Profiler.hpp>
 
 namespace robot2D {
+    namespace {
+        constexpr int channelsNum = 4;
+        constexpr std::size_t minImagesPerThread = 16;
+        constexpr const char* manifestHeader = "robot2D-atlas";
+        constexpr int manifestVersion = 1;
+
+        /// Runs func(index) for [0, count), big counts are split between job workers.
+        template<typename Func>
+        void parallelFor(std::size_t count, Func&& func) {
+            JobSystem::getInstance().parallelFor(count, minImagesPerThread, [&func](std::size_t begin, std::size_t end) {
+                for(std::size_t index = begin; index < end; ++index)
+                    func(index);
+            });
+        }
+
+        /// Copies area of source into RGBA atlas at position, RGBA rows are copied whole.
+        void blit(const Image& source, const IntRect& area,
+                  std::uint8_t* atlas, unsigned int atlasWidth, const vec2i& position) {
+            const auto& sourceSize = source.getSize();
+            const int channels = static_cast<int>(source.getColorFormat());
+            const auto* pixels = source.getBuffer().data();
+
+            for(int row = 0; row < area.height; ++row) {
+                const auto* from = pixels + (static_cast<std::size_t>(area.ly + row) * sourceSize.x + area.lx) * channels;
+                auto* to = atlas + (static_cast<std::size_t>(position.y + row) * atlasWidth + position.x) * channelsNum;
+                if(channels == channelsNum) {
+                    std::memcpy(to, from, static_cast<std::size_t>(area.width) * channelsNum);
+                    continue;
+                }
+
+                for(int column = 0; column < area.width; ++column, from += channels, to += channelsNum) {
+                    to[0] = from[0];
+                    to[1] = channels == RGB ? from[1] : from[0];
+                    to[2] = channels == RGB ? from[2] : from[0];
+                    to[3] = 255;
+                }
+            }
+        }
+
+        /// Smallest area holding all not transparent pixels, whole image if it has no alpha.
+        IntRect opaqueArea(const Image& image) {
+            const auto& size = image.getSize();
+            const IntRect full{0, 0, static_cast<int>(size.x), static_cast<int>(size.y)};
+            if(image.getColorFormat() != RGBA)
+                return full;
+
+            const auto* pixels = image.getBuffer().data();
+            int left = full.width, top = full.height, right = -1, bottom = -1;
+            for(int row = 0; row < full.height; ++row) {
+                const auto* alpha = pixels + static_cast<std::size_t>(row) * size.x * channelsNum + 3;
+                int first = -1, last = -1;
+                for(int column = 0; column < full.width; ++column) {
+                    if(alpha[column * channelsNum] != 0) {
+                        if(first < 0)
+                            first = column;
+                        last = column;
+                    }
+                }
+                if(first < 0)
+                    continue;
+                left = std::min(left, first);
+                right = std::max(right, last);
+                top = std::min(top, row);
+                bottom = row;
+            }
+
+            /// fully transparent image keeps one pixel, so it still has place in atlas
+            if(right < 0)
+                return {0, 0, std::min(1, full.width), std::min(1, full.height)};
+            return {left, top, right - left + 1, bottom - top + 1};
+        }
+
+        unsigned int nextPowerOfTwo(unsigned int value) {
+            unsigned int result = 1;
+            while(result < value)
+                result <<= 1;
+            return result;
+        }
+    }
+
     bool ImageAtlas::loadFromFile(const std::string& path, vec2i itemSize) {
         if(!m_atlasImage.loadFromFile(path)) {
             RB_CORE_ERROR("Can't load ImageAtlas by path {0}", path);
             return false;
         }
         m_rectSize = itemSize;
+        m_entries.clear();
         return true;
     }
 
-    bool ImageAtlas::createAtlas(const std::vector<robot2D::Image>& images,
-                                 robot2D::vec2i itemSize,
-                                 int itemsPerRow) {
-        constexpr int channelsNum = 4;
-        int textureIndex = 1;
-        int rowIndex = 0;
-
-        robot2D::vec2i textureSize;
-        robot2D::vec2u offset{0, 0};
-
-        auto sz = images.size();
+    bool ImageAtlas::loadFromFile(const std::string& path, const std::string& manifestPath) {
+        std::ifstream file{manifestPath};
+        if(!file.is_open()) {
+            RB_CORE_ERROR("Can't open ImageAtlas manifest by path {0}", manifestPath);
+            return false;
+        }
 
-        if(itemsPerRow == 0)
-            itemsPerRow = static_cast<int>(sz) / 2;
+        std::string header;
+        int version = 0;
+        vec2u size;
+        file >> header >> version >> size.x >> size.y;
+        if(!file || header != manifestHeader || version != manifestVersion) {
+            RB_CORE_ERROR("ImageAtlas manifest {0} has unknown format", manifestPath);
+            return false;
+        }
 
-        textureSize.x = itemSize.x * (sz > itemsPerRow ? itemsPerRow : sz);
-        textureSize.y = itemSize.y * (sz > itemsPerRow ? (sz % itemsPerRow == 0 ? sz / itemsPerRow
-                                                                                : sz / itemsPerRow + 1) : 1);
+        std::vector<ImageAtlasEntry> entries;
+        ImageAtlasEntry entry;
+        while(file >> entry.rect.lx >> entry.rect.ly >> entry.rect.width >> entry.rect.height
+                   >> entry.offset.x >> entry.offset.y >> entry.sourceSize.x >> entry.sourceSize.y) {
+            /// name is rest of line, it may contain spaces
+            file.get();
+            std::getline(file, entry.name);
+            entries.emplace_back(entry);
+        }
 
-        std::unique_ptr<unsigned char[]> pixelBuffer =
-                std::make_unique<unsigned char[]>(textureSize.x *  textureSize.y * channelsNum);
+        if(!m_atlasImage.loadFromFile(path, channelsNum)) {
+            RB_CORE_ERROR("Can't load ImageAtlas by path {0}", path);
+            return false;
+        }
+        if(m_atlasImage.getSize() != size)
+            RB_CORE_WARN("ImageAtlas {0} size differs from its manifest", path);
 
+        m_entries = std::move(entries);
+        m_rectSize = {};
+        return true;
+    }
 
-        if(!pixelBuffer) {
-            RB_CORE_ERROR("Can't allocate pixelBuffer for ImageAtlas");
+    bool ImageAtlas::createAtlas(const std::vector<robot2D::Image>& images,
+                                 robot2D::vec2i itemSize,
+                                 int itemsPerRow) {
+        RB_PROFILE_FUNCTION();
+        const int count = static_cast<int>(images.size());
+        if(count == 0 || itemSize.x <= 0 || itemSize.y <= 0) {
+            RB_CORE_ERROR("ImageAtlas needs images and item size to create atlas");
             return false;
         }
 
-        for(const auto& image: images) {
-            auto sourceSize = image.getSize();
-            auto* source = image.getBuffer().data();
-
-            if(!source) {
-                RB_CORE_ERROR("Can't get source's pixelBuffer");
-                return false;
-            }
+        if(itemsPerRow <= 0)
+            itemsPerRow = std::max(1, count / 2);
+        itemsPerRow = std::min(itemsPerRow, count);
+        const int rowsCount = (count + itemsPerRow - 1) / itemsPerRow;
+        const vec2u textureSize{static_cast<unsigned int>(itemSize.x * itemsPerRow),
+                                static_cast<unsigned int>(itemSize.y * rowsCount)};
+
+        std::vector<ImageAtlasEntry> entries(images.size());
+        for(int index = 0; index < count; ++index) {
+            const auto& sourceSize = images[index].getSize();
+            auto& entry = entries[index];
+            entry.name = std::to_string(index);
+            entry.sourceSize = sourceSize;
+            entry.rect = { (index % itemsPerRow) * itemSize.x, (index / itemsPerRow) * itemSize.y,
+                           std::min(itemSize.x, static_cast<int>(sourceSize.x)),
+                           std::min(itemSize.y, static_cast<int>(sourceSize.y)) };
+        }
 
-            for(int sourceY = 0; sourceY < static_cast<int>(sourceSize.y); ++sourceY) {
-                for(int sourceX = 0; sourceX < static_cast<int>(sourceSize.x); ++sourceX) {
-                    int from, to;
-                    if(sourceSize.x == sourceSize.y) {
-                        int fromY = static_cast<int>(sourceY * sourceSize.y * channelsNum);
-                        int toY = static_cast<int>(sourceY + offset.y) * textureSize.x * channelsNum;
+        PixelBuffer pixels(static_cast<std::size_t>(textureSize.x) * textureSize.y * channelsNum, 0);
+        parallelFor(images.size(), [&](std::size_t index) {
+            const auto& rect = entries[index].rect;
+            blit(images[index], {0, 0, rect.width, rect.height}, pixels.data(), textureSize.x, {rect.lx, rect.ly});
+        });
 
-                        int fromX = (sourceX * channelsNum);
-                        int toX = static_cast<int>(sourceX + offset.x) * channelsNum;
+        m_rectSize = itemSize;
+        m_entries = std::move(entries);
+        if(!m_atlasImage.create(textureSize, std::move(pixels), ImageColorFormat::RGBA)) {
+            RB_CORE_ERROR("Can't create image atlas");
+            return false;
+        }
 
-                        from = fromY + fromX;
-                        to = toY + toX;
-                    }
-                    else {
-                        int fromY = static_cast<int>(sourceY * sourceSize.x * channelsNum);
-                        int toY = static_cast<int>(sourceY + offset.y) * textureSize.x * channelsNum;
+        return true;
+    }
 
-                        int fromX = (sourceX * channelsNum);
-                        int toX = static_cast<int>(sourceX + offset.x) * channelsNum;
+    bool ImageAtlas::packAtlas(const std::vector<robot2D::Image>& images,
+                               const std::vector<std::string>& names,
+                               const ImageAtlasOptions& options) {
+        RB_PROFILE_FUNCTION();
+        if(images.empty()) {
+            RB_CORE_ERROR("ImageAtlas has no images to pack");
+            return false;
+        }
 
-                        from = fromY + fromX;
-                        to = toY + toX;
-                    }
+        std::vector<ImageAtlasEntry> entries(images.size());
+        std::vector<IntRect> areas(images.size());
+        parallelFor(images.size(), [&](std::size_t index) {
+            const auto& image = images[index];
+            areas[index] = options.trim ? opaqueArea(image)
+                    : IntRect{0, 0, static_cast<int>(image.getSize().x), static_cast<int>(image.getSize().y)};
+            auto& entry = entries[index];
+            entry.name = index < names.size() ? names[index] : std::to_string(index);
+            entry.sourceSize = image.getSize();
+            entry.offset = { areas[index].lx, areas[index].ly };
+        });
+
+        /// taller images first keep skyline flat
+        std::vector<std::size_t> order(images.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&areas](std::size_t left, std::size_t right) {
+            if(areas[left].height != areas[right].height)
+                return areas[left].height > areas[right].height;
+            return areas[left].width > areas[right].width;
+        });
+
+        std::size_t usedArea = 0;
+        unsigned int minSide = 1;
+        for(const auto& area: areas) {
+            usedArea += static_cast<std::size_t>(area.width + options.padding) * (area.height + options.padding);
+            minSide = std::max(minSide, static_cast<unsigned int>(std::max(area.width, area.height)) + options.padding);
+        }
+        const auto side = nextPowerOfTwo(std::max(minSide,
+                static_cast<unsigned int>(std::ceil(std::sqrt(static_cast<double>(usedArea))))));
+        vec2u atlasSize{side, side};
 
-                    for(int channel = 0; channel < channelsNum; ++channel) {
-                        pixelBuffer[to + channel] = source[from + channel];
-                    }
+        while(true) {
+            if(atlasSize.x > options.maxSize || atlasSize.y > options.maxSize) {
+                RB_CORE_ERROR("ImageAtlas: {0} images don't fit into {1}x{1}", images.size(), options.maxSize);
+                return false;
+            }
 
-                    if ((sourceY % 64) == 0) {
-                        printf("\r Pack status %d%%....", 100 * sourceY / sourceSize.y);
-                    }
+            SkylinePacker packer{atlasSize, options.padding};
+            bool packed = true;
+            for(const auto index: order) {
+                const vec2u size{ static_cast<unsigned int>(areas[index].width),
+                                  static_cast<unsigned int>(areas[index].height) };
+                if(!packer.pack(size, entries[index].rect)) {
+                    packed = false;
+                    break;
                 }
             }
+            if(packed)
+                break;
 
-            offset.x += sourceSize.x;
-            ++textureIndex;
-            ++rowIndex;
-            if(rowIndex == itemsPerRow) {
-                offset.y += sourceSize.y;
-                offset.x = 0;
-                rowIndex = 0;
-            }
+            if(atlasSize.x <= atlasSize.y)
+                atlasSize.x *= 2;
+            else
+                atlasSize.y *= 2;
         }
 
-        m_rectSize = itemSize;
-        if(!m_atlasImage.create(textureSize.as<unsigned >(), pixelBuffer.get(), ImageColorFormat::RGBA)) {
+        PixelBuffer pixels(static_cast<std::size_t>(atlasSize.x) * atlasSize.y * channelsNum, 0);
+        parallelFor(images.size(), [&](std::size_t index) {
+            const auto& rect = entries[index].rect;
+            blit(images[index], areas[index], pixels.data(), atlasSize.x, {rect.lx, rect.ly});
+        });
+
+        m_rectSize = {};
+        m_entries = std::move(entries);
+        if(!m_atlasImage.create(atlasSize, std::move(pixels), ImageColorFormat::RGBA)) {
             RB_CORE_ERROR("Can't create image atlas");
             return false;
         }
@@ -138,6 +301,13 @@ namespace robot2D {
         return getRect(index.x, index.y);
     }
 
+    const ImageAtlasEntry* ImageAtlas::getEntry(const std::string& name) const {
+        auto found = std::find_if(m_entries.begin(), m_entries.end(), [&name](const ImageAtlasEntry& entry) {
+            return entry.name == name;
+        });
+        return found == m_entries.end() ? nullptr : &(*found);
+    }
+
     vec2i ImageAtlas::rectSize() const noexcept{
         return m_rectSize;
     }
@@ -164,4 +334,22 @@ namespace robot2D {
         return true;
     }
 
-}
\ No newline at end of file
+    bool ImageAtlas::saveManifest(const std::string& path) const {
+        std::ofstream file{path};
+        if(!file.is_open()) {
+            RB_CORE_ERROR("Can't write ImageAtlas manifest by path {0}", path);
+            return false;
+        }
+
+        const auto& size = m_atlasImage.getSize();
+        file << manifestHeader << ' ' << manifestVersion << ' ' << size.x << ' ' << size.y << '\n';
+        for(const auto& entry: m_entries) {
+            file << entry.rect.lx << ' ' << entry.rect.ly << ' ' << entry.rect.width << ' ' << entry.rect.height << ' '
+                 << entry.offset.x << ' ' << entry.offset.y << ' '
+                 << entry.sourceSize.x << ' ' << entry.sourceSize.y << ' ' << entry.name << '\n';
+        }
+
+        return static_cast<bool>(file);
+    }
+
+}
@@ -18,6 +18,8 @@ and must not be misrepresented as being the original software.
 3. This notice may nocountt be removed or altered from any
 source distribution.
 *********************************************************************/
+#include <algorithm>
+
 #include <robot2D/Graphics/GL.hpp>
 #include <robot2D/Graphics/RenderAPI.hpp>
 
@@ -109,6 +111,7 @@ namespace robot2D::priv {
     }
 
     OpenGLFrameBuffer::~OpenGLFrameBuffer() {
+        dropReadbacks(true);
         deleteGLStuff();
     }
 
@@ -123,6 +126,7 @@ namespace robot2D::priv {
 
     void OpenGLFrameBuffer::Invalidate() {
         if(m_renderID != 0) {
+            dropReadbacks(false);
             deleteGLStuff();
         }
 
@@ -223,4 +227,102 @@ namespace robot2D::priv {
         glCall(glReadPixels, mousePos.x, mousePos.y, 1, 1, GL_RED_INTEGER, GL_INT, &pixelData);
         return pixelData;
     }
-}
\ No newline at end of file
+
+    void OpenGLFrameBuffer::clearAttachment(RenderID attachmentIndex, int value) {
+        if(attachmentIndex >= m_colorAttachments.size())
+            return;
+        glCall(glClearBufferiv, GL_COLOR, static_cast<GLint>(attachmentIndex), &value);
+    }
+
+    ReadbackID OpenGLFrameBuffer::requestPixels(RenderID attachmentIndex, const IntRect& area) {
+        const int left = std::max(0, std::min(area.lx, area.lx + area.width));
+        const int bottom = std::max(0, std::min(area.ly, area.ly + area.height));
+        const int right = std::min(m_specification.size.x, std::max(area.lx, area.lx + area.width));
+        const int top = std::min(m_specification.size.y, std::max(area.ly, area.ly + area.height));
+        if(right <= left || top <= bottom || attachmentIndex >= m_colorAttachments.size())
+            return invalidReadback;
+
+        auto& readback = m_readbacks[m_nextReadback];
+        m_nextReadback = (m_nextReadback + 1) % readbackRingSize;
+        /// nobody fetched oldest request, it's dropped
+        if(readback.fence) {
+            glDeleteSync(readback.fence);
+            readback.fence = nullptr;
+        }
+
+        if(readback.pixelBuffer == 0)
+            glCall(glGenBuffers, 1, &readback.pixelBuffer);
+
+        readback.pixelsCount = static_cast<std::size_t>(right - left) * static_cast<std::size_t>(top - bottom);
+        const std::size_t bytes = readback.pixelsCount * sizeof(int);
+        glCall(glBindBuffer, GL_PIXEL_PACK_BUFFER, readback.pixelBuffer);
+        if(readback.capacity < bytes) {
+            glCall(glBufferData, GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, GL_STREAM_READ);
+            readback.capacity = bytes;
+        }
+
+        GLint previousReadFrameBuffer = 0;
+        glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previousReadFrameBuffer);
+        glCall(glBindFramebuffer, GL_READ_FRAMEBUFFER, m_renderID);
+        glCall(glReadBuffer, GL_COLOR_ATTACHMENT0 + attachmentIndex);
+        /// with bound pack buffer last argument is offset, so call returns without waiting for GPU
+        glCall(glReadPixels, left, bottom, right - left, top - bottom, GL_RED_INTEGER, GL_INT, nullptr);
+        readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        glCall(glBindFramebuffer, GL_READ_FRAMEBUFFER, static_cast<GLuint>(previousReadFrameBuffer));
+        glCall(glBindBuffer, GL_PIXEL_PACK_BUFFER, 0);
+
+        if(++m_lastReadbackID == invalidReadback)
+            ++m_lastReadbackID;
+        readback.id = m_lastReadbackID;
+        return readback.id;
+    }
+
+    ReadbackStatus OpenGLFrameBuffer::fetchPixels(ReadbackID readbackID, std::vector<int>& result) {
+        if(readbackID == invalidReadback)
+            return ReadbackStatus::Dropped;
+
+        auto found = std::find_if(m_readbacks.begin(), m_readbacks.end(), [readbackID](const Readback& readback) {
+            return readback.id == readbackID && readback.fence;
+        });
+        if(found == m_readbacks.end())
+            return ReadbackStatus::Dropped;
+
+        auto& readback = *found;
+        const auto waitStatus = glClientWaitSync(readback.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        if(waitStatus == GL_TIMEOUT_EXPIRED)
+            return ReadbackStatus::Pending;
+
+        glDeleteSync(readback.fence);
+        readback.fence = nullptr;
+        readback.id = invalidReadback;
+        if(waitStatus == GL_WAIT_FAILED)
+            return ReadbackStatus::Dropped;
+
+        const std::size_t bytes = readback.pixelsCount * sizeof(int);
+        glCall(glBindBuffer, GL_PIXEL_PACK_BUFFER, readback.pixelBuffer);
+        const auto* pixels = static_cast<const int*>(glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0,
+                                                                      static_cast<GLsizeiptr>(bytes),
+                                                                      GL_MAP_READ_BIT));
+        auto status = ReadbackStatus::Dropped;
+        if(pixels) {
+            result.assign(pixels, pixels + readback.pixelsCount);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            status = ReadbackStatus::Ready;
+        }
+        glCall(glBindBuffer, GL_PIXEL_PACK_BUFFER, 0);
+        return status;
+    }
+
+    void OpenGLFrameBuffer::dropReadbacks(bool releaseBuffers) {
+        for(auto& readback: m_readbacks) {
+            if(readback.fence)
+                glDeleteSync(readback.fence);
+            readback.fence = nullptr;
+            readback.id = invalidReadback;
+            if(releaseBuffers && readback.pixelBuffer != 0) {
+                glCall(glDeleteBuffers, 1, &readback.pixelBuffer);
+                readback = {};
+            }
+        }
+    }
+}
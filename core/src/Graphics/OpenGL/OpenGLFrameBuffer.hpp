@@ -21,6 +21,9 @@ source distribution.
 
 #pragma once
 
+#include <array>
+
+#include <robot2D/Graphics/GL.hpp>
 #include <robot2D/Graphics/FrameBuffer.hpp>
 
 namespace robot2D::priv {
@@ -33,7 +36,10 @@ namespace robot2D::priv {
         void unBind() override;
         void Invalidate() override;
 
+        void clearAttachment(RenderID attachmentIndex, int value) override;
         int readPixel(RenderID attachmentIndex, vec2i mousePos) override;
+        ReadbackID requestPixels(RenderID attachmentIndex, const IntRect& area) override;
+        ReadbackStatus fetchPixels(ReadbackID readbackID, std::vector<int>& result) override;
 
         void Resize(const robot2D::vec2u& newSize) override;
         const RenderID& getFrameBufferRenderID(uint32_t index = 0) const override;
@@ -42,7 +48,19 @@ namespace robot2D::priv {
         FrameBufferSpecification& getSpecification() override;
     private:
         void deleteGLStuff();
+        /// Forgets requests in flight, pixel buffers are released only when releaseBuffers is set.
+        void dropReadbacks(bool releaseBuffers);
     private:
+        /// Pixel pack buffer with fence, GPU copies into it while CPU goes on.
+        struct Readback {
+            RenderID pixelBuffer{0};
+            GLsync fence{nullptr};
+            std::size_t capacity{0};
+            std::size_t pixelsCount{0};
+            ReadbackID id{invalidReadback};
+        };
+        static constexpr std::size_t readbackRingSize = 3;
+
         FrameBufferSpecification m_specification;
         RenderID m_renderID;
 
@@ -51,5 +69,9 @@ namespace robot2D::priv {
 
         std::vector<RenderID> m_colorAttachments;
         RenderID m_depthAttachment;
+
+        std::array<Readback, readbackRingSize> m_readbacks;
+        std::size_t m_nextReadback{0};
+        ReadbackID m_lastReadbackID{invalidReadback};
     };
 }
\ No newline at end of file
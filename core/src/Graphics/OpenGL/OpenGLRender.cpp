@@ -21,15 +21,20 @@ source distribution.
 
 #include <stdexcept>
 #include <cassert>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 
 #include <robot2D/Graphics/GL.hpp>
 #include <robot2D/Graphics/Texture.hpp>
+#include <robot2D/Graphics/TextureResidency.hpp>
 #include <robot2D/Graphics/Buffer.hpp>
 #include <robot2D/Graphics/VertexArray.hpp>
 #include <robot2D/Graphics/RenderAPI.hpp>
 #include <robot2D/Graphics/QuadShaderTexts.hpp>
 
 #include <robot2D/Util/Logger.hpp>
+#include <robot2D/Util/Profiler.hpp>
 #include <robot2D/Config.hpp>
 
 #include "OpenGLRender.hpp"
@@ -40,7 +45,7 @@ namespace robot2D::priv {
     constexpr short quadVertexSize = 4;
     constexpr short maxTextureSlots = 16;
     constexpr unsigned int defaultLayerID = 1;
-    constexpr unsigned int maxLayers = 5;
+    constexpr unsigned int maxLayers = RenderStats::maxLayers;
     constexpr unsigned int defaultLayersValue = 2;
     ///////////////////// Consts /////////////////////
 
@@ -230,6 +235,7 @@ namespace robot2D::priv {
 
     void OpenGLRender::setup() {
         setupOpenGL();
+        glGenQueries(gpuTimerQueriesCount, m_timerQueries.data());
 
         m_default.reset(FloatRect(0.F, 0.F,
                                   static_cast<float>(m_size.x),
@@ -242,6 +248,7 @@ namespace robot2D::priv {
     void OpenGLRender::destroy() {
         for(auto& it: m_renderLayers)
             it.destroy();
+        glDeleteQueries(gpuTimerQueriesCount, m_timerQueries.data());
     }
 
     void OpenGLRender::setView(const View& view, unsigned int layerID) {
@@ -335,17 +342,41 @@ namespace robot2D::priv {
 
 
     void OpenGLRender::beforeRender() const {
+        /// mips change before any quad of frame refers to texture
+        TextureResidency::getInstance().update();
         memset(&m_stats, 0, sizeof(RenderStats));
-        for(auto& it: m_renderLayers)
-            it.m_renderBuffer.quadBufferPtr = it.m_renderBuffer.quadBuffer;
+        collectGpuTime();
+        /// query spans whole frame, batches flushed while recording are measured too
+        if(!m_timerQueryActive && !m_timerQueryPending[m_timerQueryIndex]) {
+            glBeginQuery(GL_TIME_ELAPSED, m_timerQueries[m_timerQueryIndex]);
+            m_timerQueryActive = true;
+        }
+        resetBatches();
+        m_phaseClock.restart();
     }
 
     void OpenGLRender::afterRender() const {
+        m_stats.recordTime = m_phaseClock.restart().asMilliSeconds();
+
+        uploadLayers();
+
+        if(m_timerQueryActive) {
+            glEndQuery(GL_TIME_ELAPSED);
+            m_timerQueryPending[m_timerQueryIndex] = true;
+            m_timerQueryIndex = (m_timerQueryIndex + 1) % gpuTimerQueriesCount;
+            m_timerQueryActive = false;
+        }
+
+        m_stats.submitTime = m_phaseClock.restart().asMilliSeconds();
+    }
+
+    void OpenGLRender::uploadLayers() const {
         unsigned int index = 0;
         for(auto& it: m_renderLayers) {
             auto size = uint32_t((uint8_t *) it.m_renderBuffer.quadBufferPtr
                                  - (uint8_t *) it.m_renderBuffer.quadBuffer);
             it.m_renderBuffer.vertexBuffer -> setData(it.m_renderBuffer.quadBuffer, size);
+            m_stats.uploadedBytes += size;
 
             if(index == 1)
                 flushRender(index);
@@ -353,7 +384,39 @@ namespace robot2D::priv {
         }
     }
 
+    void OpenGLRender::resetBatches() const {
+        for(auto& it: m_renderLayers)
+            it.m_renderBuffer.quadBufferPtr = it.m_renderBuffer.quadBuffer;
+    }
+
+    void OpenGLRender::flushBatch(BatchBreakReason reason) const {
+        m_stats.batchBreaks[static_cast<unsigned>(reason)]++;
+        uploadLayers();
+        resetBatches();
+    }
+
+    void OpenGLRender::collectGpuTime() const {
+        /// oldest query first, so newest finished result wins
+        for(unsigned int i = 0; i < gpuTimerQueriesCount; ++i) {
+            auto query = (m_timerQueryIndex + i) % gpuTimerQueriesCount;
+            if(!m_timerQueryPending[query])
+                continue;
+
+            GLint available = 0;
+            glGetQueryObjectiv(m_timerQueries[query], GL_QUERY_RESULT_AVAILABLE, &available);
+            if(!available)
+                continue;
+
+            GLuint64 elapsed = 0;
+            glGetQueryObjectui64v(m_timerQueries[query], GL_QUERY_RESULT, &elapsed);
+            m_lastGpuTime = static_cast<float>(static_cast<double>(elapsed) / 1000000.0);
+            m_timerQueryPending[query] = false;
+        }
+        m_stats.gpuTime = m_lastGpuTime;
+    }
+
     void OpenGLRender::flushRender(unsigned int layerID) const {
+        RB_PROFILE_SCOPE("OpenGLRender::flushRender");
         auto& m_renderBuffer = m_renderLayers[layerID].m_renderBuffer;
         auto& m_quadShader = m_renderLayers[layerID].m_quadShader;
 
@@ -390,6 +453,7 @@ namespace robot2D::priv {
         m_renderBuffer.indexCount = 0;
         m_renderBuffer.textureSlotIndex = 1;
         m_stats.drawCalls++;
+        m_stats.layerDrawCalls[layerID]++;
 
         if(view.isClipping())
             glDisable(GL_SCISSOR_TEST);
@@ -464,23 +528,71 @@ namespace robot2D::priv {
         // Rendering quads only not supported
         assert(data.size() == quadVertexSize && "Supports only Quad Vertex Data.");
 
-        int layerID = states.layerID;
-        if(m_renderLayers.size() <= states.layerID)
+        vec3f positions[quadVertexSize];
+        vec2f texCoords[quadVertexSize];
+        for (int i = 0; i < quadVertexSize; ++i) {
+            positions[i] = data[i].position;
+            texCoords[i] = data[i].texCoords;
+        }
+
+        pushQuad(states.layerID, positions, texCoords, states.color.toGL(), states.texture,
+                 states.textureSampling, states.entityID);
+    }
+
+    void OpenGLRender::submit(const std::vector<const RenderCommandList*>& commandLists) const {
+        unsigned int layerCount = 0;
+        for(const auto* list: commandLists)
+            layerCount = std::max(layerCount, list -> getLayerCount());
+
+        std::vector<std::size_t> cursors(commandLists.size());
+        for(unsigned int layerID = 0; layerID < layerCount; ++layerID) {
+            std::fill(cursors.begin(), cursors.end(), 0);
+
+            /// k-way merge of sorted lists, equal keys keep lists order
+            while(true) {
+                const RenderCommandList::QuadCommand* next = nullptr;
+                std::size_t nextList = 0;
+                for(std::size_t i = 0; i < commandLists.size(); ++i) {
+                    if(layerID >= commandLists[i] -> getLayerCount())
+                        continue;
+                    const auto& commands = commandLists[i] -> getCommands(layerID);
+                    if(cursors[i] >= commands.size())
+                        continue;
+                    const auto& command = commands[cursors[i]];
+                    if(!next || command.sortKey < next -> sortKey) {
+                        next = &command;
+                        nextList = i;
+                    }
+                }
+
+                if(!next)
+                    break;
+                ++cursors[nextList];
+                pushQuad(layerID, next -> positions.data(), next -> texCoords.data(),
+                         next -> color, next -> texture, next -> sampling, next -> entityID);
+            }
+        }
+    }
+
+    void OpenGLRender::pushQuad(unsigned int layer, const vec3f* positions, const vec2f* texCoords,
+                                const Color& color, const Texture* texture, TextureSampling sampling,
+                                int entityID) const {
+        unsigned int layerID = layer;
+        if(m_renderLayers.size() <= layer)
             layerID = m_renderLayers.size() - 1;
 
         auto& m_renderBuffer = m_renderLayers[layerID].m_renderBuffer;
 
         if(m_renderBuffer.indexCount >= m_renderBuffer.maxIndicesCount) {
             RB_CORE_INFO("INDEX COUNT > MAX, VALUE : {0}", m_renderBuffer.indexCount);
-            afterRender();
-            beforeRender();
+            flushBatch(BatchBreakReason::BufferFull);
         }
 
         float textureIndex = 0.F;
-        if(states.texture) {
+        if(texture) {
             for (uint32_t i = 1; i < m_renderBuffer.textureSlotIndex; i++)
             {
-                if (m_renderBuffer.textureSlots[i] == states.texture -> getID())
+                if (m_renderBuffer.textureSlots[i] == texture -> getID())
                 {
                     textureIndex = static_cast<float>(i);
                     break;
@@ -489,28 +601,56 @@ namespace robot2D::priv {
 
             if (textureIndex == 0.F)
             {
-                if (m_renderBuffer.textureSlotIndex >= maxTextureSlots) {
-                    afterRender();
-                    beforeRender();
-                }
+                if (m_renderBuffer.textureSlotIndex >= maxTextureSlots)
+                    flushBatch(BatchBreakReason::TextureSlots);
 
                 textureIndex = (float)m_renderBuffer.textureSlotIndex;
-                m_renderBuffer.textureSlots[m_renderBuffer.textureSlotIndex] = states.texture -> getID();
+                m_renderBuffer.textureSlots[m_renderBuffer.textureSlotIndex] = texture -> getID();
                 m_renderBuffer.textureSlotIndex++;
             }
         }
 
+        if(texture && texture -> getOptions().streamed)
+            requestTextureMip(layerID, positions, texCoords, *texture);
+
+        /// shader splits index back into slot and sampling
+        if(textureIndex != 0.F)
+            textureIndex += static_cast<float>(static_cast<int>(sampling) * maxTextureSlots);
+
         for (int i = 0; i < quadVertexSize; ++i) {
-            m_renderBuffer.quadBufferPtr -> Position = data[i].position;
-            m_renderBuffer.quadBufferPtr -> color = states.color.toGL();
+            m_renderBuffer.quadBufferPtr -> Position = positions[i];
+            m_renderBuffer.quadBufferPtr -> color = color;
             m_renderBuffer.quadBufferPtr -> textureIndex = textureIndex;
-            m_renderBuffer.quadBufferPtr -> TextureCoords = data[i].texCoords;
-            m_renderBuffer.quadBufferPtr -> entityID = states.entityID;
+            m_renderBuffer.quadBufferPtr -> TextureCoords = texCoords[i];
+            m_renderBuffer.quadBufferPtr -> entityID = entityID;
             m_renderBuffer.quadBufferPtr++;
         }
 
         m_renderBuffer.indexCount += 6;
         m_stats.drawQuads++;
+        m_stats.drawVertices += quadVertexSize;
+    }
+
+    void OpenGLRender::requestTextureMip(unsigned int layerID, const vec3f* positions, const vec2f* texCoords,
+                                         const Texture& texture) const {
+        const auto& viewSize = m_renderLayers[layerID].m_view.getSize();
+        if(viewSize.x == 0.F || viewSize.y == 0.F)
+            return;
+        const vec2f pixelsPerUnit = { static_cast<float>(m_size.x) / viewSize.x,
+                                      static_cast<float>(m_size.y) / viewSize.y };
+        const auto& textureSize = texture.getSize();
+
+        /// both quad's edges, finest mip of them is needed
+        unsigned int mip = TextureResidency::noRequest;
+        for(int corner: {1, 3}) {
+            const float pixels = std::hypot((positions[corner].x - positions[0].x) * pixelsPerUnit.x,
+                                            (positions[corner].y - positions[0].y) * pixelsPerUnit.y);
+            const float texels = std::hypot((texCoords[corner].x - texCoords[0].x) * static_cast<float>(textureSize.x),
+                                            (texCoords[corner].y - texCoords[0].y) * static_cast<float>(textureSize.y));
+            mip = std::min(mip, TextureResidency::mipForExtent(texels, pixels));
+        }
+        if(mip != TextureResidency::noRequest)
+            TextureResidency::getInstance().requestMip(texture, mip);
     }
 
     void OpenGLRender::render(const VertexArray::Ptr& vertexArray, RenderStates states) const {
@@ -522,6 +662,11 @@ namespace robot2D::priv {
     }
 
     void OpenGLRender::renderCache(unsigned int layerID) const {
+        /// state left by batch draw: quad shader, no custom texture and default blending
+        const ShaderHandler* boundShader = nullptr;
+        unsigned int boundTexture = 0;
+        BlendMode boundBlend = BlendMode::None;
+
         for(const auto& it: m_renderLayers[layerID].m_vertexArrayCache) {
             if(!it.m_vertexArray)
                 continue;
@@ -529,6 +674,14 @@ namespace robot2D::priv {
             auto& states = it.m_states;
             auto& vertexArray = it.m_vertexArray;
 
+            const unsigned int textureID = states.texture ? states.texture -> getID() : 0;
+            if(states.shader != boundShader || textureID != boundTexture || states.blendMode != boundBlend) {
+                m_stats.batchBreaks[static_cast<unsigned>(BatchBreakReason::StateChange)]++;
+                boundShader = states.shader;
+                boundTexture = textureID;
+                boundBlend = states.blendMode;
+            }
+
             switch(states.blendMode) {
                 default:
                     break;
@@ -543,8 +696,12 @@ namespace robot2D::priv {
             auto currentShader = states.shader;
             if(currentShader == nullptr)
                 m_renderLayers[layerID].m_quadShader.use();
-            else
+            else {
                 currentShader -> use();
+                if(states.layerProjection)
+                    currentShader -> setMatrix(m_shaderKeys.at(ShaderKey::Projection),
+                                               m_renderLayers[layerID].m_view.getTransform().get_matrix());
+            }
             if(states.texture) {
                 if (m_renderApi == RenderApi::OpenGL4_3) {
                     glActiveTexture(GL_TEXTURE0);
@@ -575,10 +732,24 @@ namespace robot2D::priv {
             GLsizei drawIndexCount = states.renderInfo.indexCount ? static_cast<GLsizei>(states.renderInfo.indexCount)
                                                                   : static_cast<GLsizei>(vertexArray -> getIndexBuffer() -> getSize() / 4);
 
-            glDrawElements(drawMode,
-                           drawIndexCount,
-                           GL_UNSIGNED_INT,
-                           nullptr);
+            const auto* indexOffset = reinterpret_cast<const void*>(
+                    static_cast<std::uintptr_t>(states.renderInfo.indexOffset) * sizeof(std::uint32_t));
+
+            if(states.renderInfo.instanceCount > 0 && vertexArray -> getInstanceBuffer()) {
+                glDrawElementsInstanced(drawMode,
+                                        drawIndexCount,
+                                        GL_UNSIGNED_INT,
+                                        indexOffset,
+                                        static_cast<GLsizei>(states.renderInfo.instanceCount));
+                m_stats.drawInstances += states.renderInfo.instanceCount;
+            }
+            else
+                glDrawElements(drawMode,
+                               drawIndexCount,
+                               GL_UNSIGNED_INT,
+                               indexOffset);
+            m_stats.drawCalls++;
+            m_stats.layerDrawCalls[layerID]++;
             vertexArray -> unBind();
             glBindTexture(GL_TEXTURE_2D, 0);
             glActiveTexture(GL_TEXTURE0);
@@ -21,9 +21,11 @@ source distribution.
 
 #pragma once
 
+#include <array>
 #include <unordered_map>
 #include <vector>
 
+#include <robot2D/Core/Clock.hpp>
 #include <robot2D/Graphics/RenderStates.hpp>
 #include <robot2D/Graphics/Shader.hpp>
 #include <robot2D/Graphics/View.hpp>
@@ -55,6 +57,7 @@ namespace robot2D {
             void render(const Vertex3DData& data, const RenderStates& states) const override;
             void render(const VertexArray::Ptr& vertexArray, RenderStates states) const override;
             void render3D(const VertexArray::Ptr& vertexArray, RenderStates states) const override;
+            void submit(const std::vector<const RenderCommandList*>& commandLists) const override;
 
             void setView(const View& view, unsigned int layerID) override;
             void setView3D(const Matrix3D& projection, const Matrix3D& view) override;
@@ -80,10 +83,37 @@ namespace robot2D {
 
             void setupLayer();
             void renderCache(unsigned int layerID) const;
+
+            /// Send batches of all layers to GPU and draw them.
+            void uploadLayers() const;
+            void resetBatches() const;
+            /// Flush in middle of frame, reason goes to stats.
+            void flushBatch(BatchBreakReason reason) const;
+            /// Read finished timer queries without waiting GPU.
+            void collectGpuTime() const;
+
+            /// Copy ready vertices into layer's batch, flushes batch when it's full.
+            void pushQuad(unsigned int layer, const vec3f* positions, const vec2f* texCoords,
+                          const Color& color, const Texture* texture, TextureSampling sampling,
+                          int entityID) const;
+
+            /// Tells TextureResidency mip which quad needs at its on-screen size.
+            void requestTextureMip(unsigned int layerID, const vec3f* positions, const vec2f* texCoords,
+                                   const Texture& texture) const;
         private:
             mutable std::vector<RenderLayer> m_renderLayers;
             View m_default;
             mutable RenderStats m_stats;
+            mutable Clock m_phaseClock;
+
+            /// Ring of timer queries, results are read few frames later to avoid stalls.
+            static constexpr unsigned int gpuTimerQueriesCount = 4;
+            std::array<unsigned int, gpuTimerQueriesCount> m_timerQueries{};
+            mutable std::array<bool, gpuTimerQueriesCount> m_timerQueryPending{};
+            mutable unsigned int m_timerQueryIndex{0};
+            /// Set between beforeRender and afterRender when frame is measured.
+            mutable bool m_timerQueryActive{false};
+            mutable float m_lastGpuTime{0.F};
             RenderApi m_renderApi;
             RenderDimensionType m_dimensionType;
 
@@ -69,10 +69,20 @@ namespace robot2D {
     }
 
     void OpenGLVertexArray::setVertexBuffer(const VertexBuffer::Ptr vertexBuffer) {
+        setupAttributes(vertexBuffer, 0);
+        m_vertexBuffer = vertexBuffer;
+    }
+
+    void OpenGLVertexArray::setInstanceBuffer(const VertexBuffer::Ptr instanceBuffer) {
+        setupAttributes(instanceBuffer, 1);
+        m_instanceBuffer = instanceBuffer;
+    }
+
+    void OpenGLVertexArray::setupAttributes(const VertexBuffer::Ptr& buffer, unsigned int divisor) {
         Bind();
-        vertexBuffer -> Bind();
+        buffer -> Bind();
 
-        const auto& layout = vertexBuffer -> getAttributeLayout();
+        const auto& layout = buffer -> getAttributeLayout();
 
         for(const auto& it: layout) {
             switch (it.type) {
@@ -87,6 +97,8 @@ namespace robot2D {
                                           it.normalized ? GL_TRUE : GL_FALSE,
                                           layout.getStride(),
                                           (const void *) it.offset);
+                    if(divisor)
+                        glVertexAttribDivisor(m_vertexIndex, divisor);
                     m_vertexIndex++;
                     break;
                 }
@@ -102,6 +114,8 @@ namespace robot2D {
                                            ElementTypeToOpenGL(it.type),
                                            layout.getStride(),
                                            (const void *) it.offset);
+                    if(divisor)
+                        glVertexAttribDivisor(m_vertexIndex, divisor);
                     m_vertexIndex++;
                     break;
                 }
@@ -124,8 +138,6 @@ namespace robot2D {
                 }
             }
         }
-
-        m_vertexBuffer = vertexBuffer;
     }
 
     void OpenGLVertexArray::setIndexBuffer(const IndexBuffer::Ptr indexBuffer) {
@@ -141,4 +153,8 @@ namespace robot2D {
     const IndexBuffer::Ptr OpenGLVertexArray::getIndexBuffer() const {
         return m_indexBuffer;
     }
+
+    const VertexBuffer::Ptr OpenGLVertexArray::getInstanceBuffer() const {
+        return m_instanceBuffer;
+    }
 }
\ No newline at end of file
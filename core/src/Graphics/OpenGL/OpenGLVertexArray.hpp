@@ -33,10 +33,15 @@ namespace robot2D {
         virtual void unBind() override;
         virtual void setVertexBuffer(const VertexBuffer::Ptr vertexBuffer) override;
         virtual void setIndexBuffer(const IndexBuffer::Ptr indexBuffer) override;
+        virtual void setInstanceBuffer(const VertexBuffer::Ptr instanceBuffer) override;
         virtual const VertexBuffer::Ptr getVertexBuffer() const override;
         virtual const IndexBuffer::Ptr getIndexBuffer() const override;
+        virtual const VertexBuffer::Ptr getInstanceBuffer() const override;
+    private:
+        void setupAttributes(const VertexBuffer::Ptr& buffer, unsigned int divisor);
     private:
         VertexBuffer::Ptr m_vertexBuffer;
+        VertexBuffer::Ptr m_instanceBuffer;
         IndexBuffer::Ptr m_indexBuffer;
         unsigned int m_VAO;
         unsigned int m_vertexIndex;
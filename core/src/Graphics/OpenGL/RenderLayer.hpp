@@ -18,6 +18,10 @@ namespace robot2D {
         // TODO: @a.raag Maybe move out layer creation from Render?
         struct RenderLayer {
             RenderLayer() = default;
+            RenderLayer(const RenderLayer& other) = delete;
+            RenderLayer& operator=(const RenderLayer& other) = delete;
+            RenderLayer(RenderLayer&& other) = default;
+            RenderLayer& operator=(RenderLayer&& other) = default;
             ~RenderLayer();
 
             void destroy();
@@ -0,0 +1,115 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#include <cassert>
+#include <algorithm>
+
+#include <robot2D/Graphics/RenderCommandList.hpp>
+
+namespace robot2D {
+
+    namespace {
+        constexpr int quadVertexSize = 4;
+
+        const vec2f unitQuadPositions[quadVertexSize] = { { 0.0f, 0.0f },
+                                                          { 1.0f, 0.0f },
+                                                          { 1.0f, 1.0f },
+                                                          { 0.0f, 1.0f } };
+
+        const vec2f unitQuadTextureCoords[quadVertexSize] = { { 0.0f, 0.0f },
+                                                              { 1.0f, 0.0f },
+                                                              { 1.0f, 1.0f },
+                                                              { 0.0f, 1.0f } };
+    }
+
+    void RenderCommandList::reserve(unsigned int layerID, std::size_t quadCount) {
+        getLayer(layerID).reserve(quadCount);
+    }
+
+    void RenderCommandList::clear() {
+        for(auto& layer: m_layers)
+            layer.clear();
+    }
+
+    void RenderCommandList::draw(const RenderStates& states, int sortKey) {
+        auto& command = getLayer(states.layerID).emplace_back();
+        for(int i = 0; i < quadVertexSize; ++i) {
+            auto point = states.transform.transformPoint(unitQuadPositions[i]);
+            command.positions[i] = { point.x, point.y, 0.F };
+            command.texCoords[i] = unitQuadTextureCoords[i];
+        }
+        command.color = states.color.toGL();
+        command.texture = states.texture;
+        command.sampling = states.textureSampling;
+        command.entityID = states.entityID;
+        command.sortKey = sortKey;
+    }
+
+    void RenderCommandList::draw(const VertexData& quad, const RenderStates& states, int sortKey) {
+        assert(quad.size() == quadVertexSize && "Supports only Quad Vertex Data.");
+        record(quad.data(), states, sortKey);
+    }
+
+    void RenderCommandList::draw(const std::array<Vertex, 4>& quad, const RenderStates& states, int sortKey) {
+        record(quad.data(), states, sortKey);
+    }
+
+    void RenderCommandList::record(const Vertex* quad, const RenderStates& states, int sortKey) {
+        auto& command = getLayer(states.layerID).emplace_back();
+        for(int i = 0; i < quadVertexSize; ++i) {
+            auto point = states.transform.transformPoint(quad[i].position);
+            command.positions[i] = { point.x, point.y, 0.F };
+            command.texCoords[i] = quad[i].texCoords;
+        }
+        command.color = states.color.toGL();
+        command.texture = states.texture;
+        command.sampling = states.textureSampling;
+        command.entityID = states.entityID;
+        command.sortKey = sortKey;
+    }
+
+    void RenderCommandList::sort() {
+        for(auto& layer: m_layers) {
+            std::stable_sort(layer.begin(), layer.end(), [](const QuadCommand& left, const QuadCommand& right) {
+                return left.sortKey < right.sortKey;
+            });
+        }
+    }
+
+    const std::vector<RenderCommandList::QuadCommand>& RenderCommandList::getCommands(unsigned int layerID) const {
+        assert(layerID < m_layers.size() && "LayerID out of recorded layers range");
+        return m_layers[layerID];
+    }
+
+    std::size_t RenderCommandList::getQuadCount() const {
+        std::size_t count = 0;
+        for(const auto& layer: m_layers)
+            count += layer.size();
+        return count;
+    }
+
+    std::vector<RenderCommandList::QuadCommand>& RenderCommandList::getLayer(unsigned int layerID) {
+        if(layerID >= m_layers.size())
+            m_layers.resize(layerID + 1);
+        return m_layers[layerID];
+    }
+
+}
@@ -26,6 +26,7 @@ source distribution.
 #include <robot2D/Graphics/View.hpp>
 #include <robot2D/Graphics/Vertex.hpp>
 #include <robot2D/Graphics/RenderStats.hpp>
+#include <robot2D/Graphics/RenderCommandList.hpp>
 #include "robot2D/Graphics/VertexArray.hpp"
 #include "robot2D/Graphics/Matrix3D.hpp"
 #include <robot2D/Graphics/Drawable.hpp>
@@ -49,6 +50,7 @@ namespace robot2D {
             virtual void render(const Vertex3DData& data, const RenderStates& states) const = 0;
             virtual void render(const VertexArray::Ptr& vertexArray, RenderStates states) const = 0;
             virtual void render3D(const VertexArray::Ptr& vertexArray, RenderStates states) const = 0;
+            virtual void submit(const std::vector<const RenderCommandList*>& commandLists) const = 0;
 
             virtual void setView(const View& view, unsigned int layerID) = 0;
             virtual const View& getView(unsigned int layerID) = 0;
@@ -30,9 +30,11 @@ namespace robot2D{
     color(robot2D::Color::White),
     transform(),
     renderInfo(),
+    blendMode{BlendMode::None},
+    textureSampling{TextureSampling::Color},
     layerID(1),
     entityID(-1),
-    blendMode{BlendMode::None}
+    layerProjection(false)
     {}
 
 }
\ No newline at end of file
@@ -166,6 +166,10 @@ namespace robot2D {
         m_render -> render3D(vertexArray, states);
     }
 
+    void RenderTarget::submit(const std::vector<const RenderCommandList*>& commandLists) {
+        m_render -> submit(commandLists);
+    }
+
     void RenderTarget::setRawView(float *rawMatrix) {
         m_render -> setRawView(rawMatrix);
     }
@@ -0,0 +1,126 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#include <limits>
+#include <algorithm>
+#include <robot2D/Graphics/SkylinePacker.hpp>
+
+namespace robot2D {
+
+    SkylinePacker::SkylinePacker(const vec2u& size, unsigned int padding):
+        m_padding{padding} {
+        reset(size);
+    }
+
+    void SkylinePacker::reset(const vec2u& size) {
+        m_size = size;
+        m_usedArea = 0;
+        m_skyline.clear();
+        if(size.x > 0 && size.y > 0)
+            m_skyline.push_back({0, 0, static_cast<int>(size.x)});
+    }
+
+    int SkylinePacker::fit(std::size_t index, int width, int height) const {
+        const int x = m_skyline[index].x;
+        if(x + width > static_cast<int>(m_size.x))
+            return -1;
+
+        int y = 0;
+        int widthLeft = width;
+        while(widthLeft > 0) {
+            if(index >= m_skyline.size())
+                return -1;
+            y = std::max(y, m_skyline[index].y);
+            if(y + height > static_cast<int>(m_size.y))
+                return -1;
+            widthLeft -= m_skyline[index].width;
+            ++index;
+        }
+        return y;
+    }
+
+    bool SkylinePacker::pack(const vec2u& size, IntRect& placed) {
+        if(size.x == 0 || size.y == 0)
+            return false;
+
+        const int width = static_cast<int>(size.x + m_padding);
+        const int height = static_cast<int>(size.y + m_padding);
+
+        std::size_t bestIndex = m_skyline.size();
+        int bestTop = std::numeric_limits<int>::max();
+        int bestWidth = std::numeric_limits<int>::max();
+        for(std::size_t i = 0; i < m_skyline.size(); ++i) {
+            const int y = fit(i, width, height);
+            if(y < 0)
+                continue;
+            const int top = y + height;
+            if(top < bestTop || (top == bestTop && m_skyline[i].width < bestWidth)) {
+                bestIndex = i;
+                bestTop = top;
+                bestWidth = m_skyline[i].width;
+            }
+        }
+
+        if(bestIndex == m_skyline.size())
+            return false;
+
+        const int x = m_skyline[bestIndex].x;
+        const int y = bestTop - height;
+        place(bestIndex, x, y, width, height);
+
+        placed = {x, y, static_cast<int>(size.x), static_cast<int>(size.y)};
+        m_usedArea += static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
+        return true;
+    }
+
+    void SkylinePacker::place(std::size_t index, int x, int y, int width, int height) {
+        m_skyline.insert(m_skyline.begin() + static_cast<std::ptrdiff_t>(index), {x, y + height, width});
+
+        /// segments covered by new one are shrunk or removed
+        for(std::size_t i = index + 1; i < m_skyline.size();) {
+            auto& previous = m_skyline[i - 1];
+            auto& segment = m_skyline[i];
+            const int shrink = previous.x + previous.width - segment.x;
+            if(shrink <= 0)
+                break;
+            segment.x += shrink;
+            segment.width -= shrink;
+            if(segment.width > 0)
+                break;
+            m_skyline.erase(m_skyline.begin() + static_cast<std::ptrdiff_t>(i));
+        }
+
+        for(std::size_t i = 0; i + 1 < m_skyline.size();) {
+            if(m_skyline[i].y == m_skyline[i + 1].y) {
+                m_skyline[i].width += m_skyline[i + 1].width;
+                m_skyline.erase(m_skyline.begin() + static_cast<std::ptrdiff_t>(i + 1));
+            }
+            else
+                ++i;
+        }
+    }
+
+    float SkylinePacker::getOccupancy() const {
+        const auto area = static_cast<float>(m_size.x) * static_cast<float>(m_size.y);
+        return area > 0.F ? static_cast<float>(m_usedArea) / area : 0.F;
+    }
+
+}
@@ -1,53 +1,51 @@
-#include <robot2D/Graphics/GL.hpp>
+#include <algorithm>
+
 #include <robot2D/Graphics/RenderTarget.hpp>
 #include <robot2D/Graphics/Text.hpp>
+#include <robot2D/Graphics/GlyphCache.hpp>
 
 namespace robot2D {
 
-    constexpr const char* textVertShader = R"(
-    #version 330 core
-    layout(location = 0) in vec2 position;
-    layout(location = 1) in vec2 uv;
-    layout(location = 2) in vec4 color;
-
-    out vec2 textureCoords;
-    out vec4 outputColor;
-    uniform mat4 projection;
+    Text::Text() = default;
+    Text::~Text() = default;
 
-    void main() {
-        outputColor = color;
-        textureCoords = uv;
-        gl_Position = projection * vec4(position, 0.0, 1.0);
+    void Text::setFont(const Font& font) {
+        m_font = &font;
+        m_needupdate = true;
     }
-)";
 
-    constexpr const char* textFragShader = R"(
-    #version 330 core
+    void Text::setCharacterSize(unsigned int characterSize) {
+        m_options.characterSize = characterSize;
+        m_needupdate = true;
+    }
 
-    out vec4 fragColor;
-    in vec2 textureCoords;
-    in vec4 outputColor;
+    unsigned int Text::getCharacterSize() const {
+        if(m_options.characterSize == 0 && m_font)
+            return m_font -> getCharacterSize();
+        return m_options.characterSize;
+    }
 
-    uniform sampler2D textSampler;
+    void Text::setMaxWidth(float maxWidth) {
+        m_options.maxWidth = maxWidth;
+        m_needupdate = true;
+    }
 
-    void main() {
-        vec4 texel = texture(textSampler, textureCoords);
-        texel = vec4(texel.r, texel.r, texel.r, texel.r);
-        if(texel.a == 0.0) {
-            discard;
-        }
-        fragColor = texel * outputColor;
+    float Text::getMaxWidth() const {
+        return m_options.maxWidth;
     }
-)";
 
+    void Text::setAlignment(TextAlignment alignment) {
+        m_options.alignment = alignment;
+        m_needupdate = true;
+    }
 
-    Text::Text() = default;
-    Text::~Text() = default;
+    TextAlignment Text::getAlignment() const {
+        return m_options.alignment;
+    }
 
-    void Text::setFont(const Font& font) {
-        m_font = &font;
-        if(!m_initialized)
-            setupGL();
+    vec2f Text::getSize() const {
+        updateGeometry();
+        return m_layout ? m_layout -> size : vec2f{};
     }
 
     void Text::setText(const std::string& text) {
@@ -65,119 +63,54 @@ namespace robot2D {
     }
 
     void Text::setScale(const float& scale) {
+        (void)scale;
         m_needupdate = true;
-        m_scaled = true;
-    }
-
-    void Text::setupGL() {
-        quadBatchRender.initalize({{
-                {robot2D::ElementType::Float2, "Position"},
-                {robot2D::ElementType::Float2, "UVS"},
-                {robot2D::ElementType::Float4, "Color"},
-            }});
-
-        m_textShader.createShader(robot2D::ShaderType::Vertex, textVertShader, false);
-        m_textShader.createShader(robot2D::ShaderType::Fragment, textFragShader, false);
-        m_textShader.use();
-        m_textShader.set("textSampler", 0);
-        m_textShader.unUse();
-
-        m_initialized = true;
-    }
-
-    void Text::beforeRender() const {
-        quadBatchRender.preProcessBatching();
     }
 
     void Text::updateGeometry() const {
-        if (!m_font || !m_needupdate)
+        if(!m_font)
+            return;
+        const auto generation = GlyphCache::getInstance().getGeneration();
+        if(!m_needupdate && m_layout && m_layout -> generation == generation)
             return;
 
-        if (m_bufferCache.empty() || m_scaled) {
-            m_bufferCache = m_font -> getBufferCache(1.F);
-            m_scaled = false;
-        }
-
-        const auto& glyphCharacters = m_font -> getGlyphCharacters();
-
-        quadBatchRender.refresh();
-        robot2D::vec2f copyPos = m_pos;
-        for (const auto& s: m_text) {
-            auto& preQuad = m_bufferCache[s];
-
-            for (int it = 0; it < 4; ++it) {
-                Vertex vertex;
-                vertex.position = getTransform() * preQuad.vertices[it].position;
-                vertex.texCoords = preQuad.vertices[it].uvs;
-                vertex.color = m_color.toGL();
-                quadBatchRender.pack(std::move(vertex));
-            }
-
-            m_pos.x += glyphCharacters.at(s).advance;
-            m_update_transform = true;
-        }
-        m_pos = copyPos;
-
-        quadBatchRender.processBatching();
+        m_layout = TextLayoutCache::getInstance().getLayout(*m_font, m_text, m_options);
         m_needupdate = false;
     }
 
-    void Text::afterRender(bool hardUpdate) const {
-        if (hardUpdate) {
-            quadBatchRender.processBatching();
-        }
-
-        unsigned int index = 0;
-//        const auto& textures = m_font -> getTextures();
-//
-//        for (const auto& texture: textures) {
-//            texture -> bind(index);
-//            ++index;
-//        }
-
-        quadBatchRender.Bind();
-        glDrawElements(GL_TRIANGLES,
-                       quadBatchRender.getIndexCount(),
-                       GL_UNSIGNED_INT,
-                       nullptr);
-        quadBatchRender.unBind();
-
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, 0);
-        if (hardUpdate) {
-            quadBatchRender.refresh();
-        }
-    }
-
     const std::string& Text::getText() const {
         return m_text;
     }
 
     void Text::draw(RenderTarget& target, RenderStates states) const {
-        m_textShader.use();
-        m_textShader.setMatrix("projection", target.getView().getTransform().get_matrix());
-        m_textShader.unUse();
-
-        if (m_needupdate)
-            beforeRender();
-
-        if (quadBatchRender.needRefresh()) {
-            afterRender(true);
-            beforeRender();
-        }
-
         updateGeometry();
 
-        states.shader = const_cast<ShaderHandler*>(&m_textShader);
-        //states.texture = m_font -> getTextures()[0].get();
-        states.renderInfo.indexCount = quadBatchRender.getIndexCount();
-        target.draw(quadBatchRender.getVertexArray(), states);
-
-        //afterRender(false);
+        states.transform *= getTransform();
+        states.color = m_color;
+        states.textureSampling = (m_font && m_font -> getRenderMode() == FontRenderMode::SDF) ?
+                TextureSampling::DistanceField : TextureSampling::Coverage;
+
+        auto& glyphCache = GlyphCache::getInstance();
+        m_commands.clear();
+        if(m_layout) {
+            std::array<Vertex, 4> quad;
+            for(const auto& glyph: m_layout -> glyphs) {
+                states.texture = glyphCache.getPageTexture(glyph.page);
+                if(!states.texture)
+                    continue;
+                for(std::size_t it = 0; it < quad.size(); ++it) {
+                    quad[it].position = glyph.quad.vertices[it].position;
+                    quad[it].texCoords = glyph.quad.vertices[it].uvs;
+                }
+                m_commands.draw(quad, states);
+            }
+        }
+        target.submit({&m_commands});
     }
 
     void Text::setColor(const Color& color) {
         m_color = color;
+        m_needupdate = true;
     }
 
     const robot2D::Color& Text::getColor() const {
@@ -0,0 +1,242 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#include <cmath>
+#include <algorithm>
+#include <functional>
+
+#include <robot2D/Graphics/TextLayout.hpp>
+#include <robot2D/Graphics/GlyphCache.hpp>
+
+namespace robot2D {
+
+    namespace {
+        struct Line {
+            std::size_t firstGlyph;
+            float width;
+        };
+
+        bool isSpace(std::uint32_t codepoint) {
+            return codepoint == ' ' || codepoint == '\t';
+        }
+
+        void moveGlyph(LayoutGlyph& glyph, const vec2f& offset) {
+            for(auto& vertex: glyph.quad.vertices)
+                vertex.position += offset;
+        }
+    }
+
+    void layoutText(const Font& font, const std::string& text, const TextLayoutOptions& options, TextLayout& layout) {
+        auto& glyphCache = GlyphCache::getInstance();
+        layout.glyphs.clear();
+        layout.size = {};
+        layout.linesCount = 0;
+        layout.generation = glyphCache.getGeneration();
+        if(text.empty())
+            return;
+
+        const unsigned int characterSize = options.characterSize == 0 ? font.getCharacterSize()
+                                                                       : options.characterSize;
+        const float lineHeight = font.getLineSpacing(characterSize) * options.lineSpacing;
+        const bool wrap = options.maxWidth > 0.F;
+
+        std::vector<Line> lines;
+        std::size_t lineFirst = 0;
+        float pen = 0.F;
+        /// pen after line's last non space glyph
+        float lineWidth = 0.F;
+        float lineTop = 0.F;
+        std::uint32_t previous = 0;
+
+        /// last space of line: wrapped word starts at breakGlyph and wordStart
+        bool hasBreak = false;
+        std::size_t breakGlyph = 0;
+        float breakWidth = 0.F;
+        float wordStart = 0.F;
+
+        auto startLine = [&](std::size_t firstGlyph, float width) {
+            lines.push_back({lineFirst, width});
+            lineFirst = firstGlyph;
+            lineTop += lineHeight;
+            previous = 0;
+            hasBreak = false;
+        };
+
+        std::size_t index = 0;
+        while(index < text.size()) {
+            const auto codepoint = decodeUtf8(text, index);
+            if(codepoint == '\n') {
+                startLine(layout.glyphs.size(), lineWidth);
+                pen = 0.F;
+                lineWidth = 0.F;
+                continue;
+            }
+            if(codepoint == '\r')
+                continue;
+
+            Glyph glyph;
+            if(!glyphCache.getGlyph(font, characterSize, codepoint, glyph))
+                continue;
+
+            if(previous != 0)
+                pen += font.getKerning(previous, codepoint, characterSize);
+            previous = codepoint;
+
+            const bool space = isSpace(codepoint);
+            if(wrap && !space && lineWidth > 0.F && pen + glyph.advance > options.maxWidth) {
+                if(hasBreak) {
+                    /// current word goes to next line
+                    for(auto it = breakGlyph; it < layout.glyphs.size(); ++it)
+                        moveGlyph(layout.glyphs[it], {-wordStart, lineHeight});
+                    startLine(breakGlyph, breakWidth);
+                    pen -= wordStart;
+                    lineWidth = std::max(0.F, lineWidth - wordStart);
+                }
+                else {
+                    /// word doesn't fit into whole line, so it's broken here
+                    startLine(layout.glyphs.size(), lineWidth);
+                    pen = 0.F;
+                    lineWidth = 0.F;
+                }
+                previous = codepoint;
+            }
+
+            if(glyph.page >= 0) {
+                auto& placed = layout.glyphs.emplace_back();
+                placed.quad = glyph.quad;
+                placed.page = glyph.page;
+                moveGlyph(placed, {pen, lineTop});
+            }
+            pen += glyph.advance;
+
+            if(space) {
+                if(!hasBreak || breakGlyph != layout.glyphs.size())
+                    breakWidth = lineWidth;
+                hasBreak = true;
+                breakGlyph = layout.glyphs.size();
+                wordStart = pen;
+            }
+            else
+                lineWidth = pen;
+        }
+        lines.push_back({lineFirst, lineWidth});
+
+        layout.linesCount = lines.size();
+        for(const auto& line: lines)
+            layout.size.x = std::max(layout.size.x, line.width);
+        layout.size.y = lineHeight * static_cast<float>(lines.size());
+
+        if(options.alignment == TextAlignment::Left)
+            return;
+
+        const float boxWidth = wrap ? options.maxWidth : layout.size.x;
+        const float factor = options.alignment == TextAlignment::Center ? 0.5F : 1.F;
+        for(std::size_t it = 0; it < lines.size(); ++it) {
+            float offset = (boxWidth - lines[it].width) * factor;
+            if(font.getRenderMode() == FontRenderMode::Bitmap)
+                offset = std::floor(offset);
+            const std::size_t end = it + 1 < lines.size() ? lines[it + 1].firstGlyph : layout.glyphs.size();
+            for(auto glyph = lines[it].firstGlyph; glyph < end; ++glyph)
+                moveGlyph(layout.glyphs[glyph], {offset, 0.F});
+        }
+    }
+
+    std::size_t TextLayoutCache::KeyHash::operator()(const Key& key) const {
+        std::size_t hash = std::hash<std::string>{}(key.text);
+        auto combine = [&hash](std::size_t value) {
+            hash ^= value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+        };
+        combine(std::hash<const void*>{}(key.face));
+        combine(std::hash<unsigned int>{}(key.options.characterSize));
+        combine(std::hash<float>{}(key.options.maxWidth));
+        combine(std::hash<float>{}(key.options.lineSpacing));
+        combine(static_cast<std::size_t>(key.options.alignment));
+        return hash;
+    }
+
+    TextLayoutCache& TextLayoutCache::getInstance() {
+        static TextLayoutCache instance;
+        return instance;
+    }
+
+    std::shared_ptr<const TextLayout> TextLayoutCache::getLayout(const Font& font, const std::string& text,
+                                                                 const TextLayoutOptions& options) {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        const auto generation = GlyphCache::getInstance().getGeneration();
+
+        Key key{font.m_face, text, options};
+        auto found = m_entries.find(key);
+        if(found != m_entries.end()) {
+            auto& entry = found -> second;
+            m_uses.splice(m_uses.begin(), m_uses, entry.use);
+            if(entry.layout -> generation != generation) {
+                /// holders of old layout keep it, new one replaces it in cache
+                auto layout = std::make_shared<TextLayout>();
+                layoutText(font, text, options, *layout);
+                entry.layout = std::move(layout);
+            }
+            return entry.layout;
+        }
+
+        auto layout = std::make_shared<TextLayout>();
+        layoutText(font, text, options, *layout);
+        auto inserted = m_entries.emplace(std::move(key), Entry{layout, {}}).first;
+        m_uses.push_front(&inserted -> first);
+        inserted -> second.use = m_uses.begin();
+        trim();
+
+        return layout;
+    }
+
+    void TextLayoutCache::removeFont(const Font& font) {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        for(auto it = m_entries.begin(); it != m_entries.end();) {
+            if(it -> first.face == font.m_face) {
+                m_uses.erase(it -> second.use);
+                it = m_entries.erase(it);
+            }
+            else
+                ++it;
+        }
+    }
+
+    void TextLayoutCache::setMaxEntries(std::size_t maxEntries) {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_maxEntries = std::max<std::size_t>(1, maxEntries);
+        trim();
+    }
+
+    std::size_t TextLayoutCache::getEntriesCount() const {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return m_entries.size();
+    }
+
+    void TextLayoutCache::trim() {
+        while(m_entries.size() > m_maxEntries) {
+            auto found = m_entries.find(*m_uses.back());
+            m_uses.pop_back();
+            if(found != m_entries.end())
+                m_entries.erase(found);
+        }
+    }
+
+}
@@ -19,9 +19,16 @@ and must not be misrepresented as being the original software.
 source distribution.
 *********************************************************************/
 
+#include <cmath>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+
 #include <robot2D/Graphics/GL.hpp>
 #include <robot2D/Graphics/Texture.hpp>
+#include <robot2D/Graphics/TextureResidency.hpp>
 #include <robot2D/Graphics/RenderAPI.hpp>
+#include <robot2D/Util/Logger.hpp>
 
 namespace robot2D {
     GLenum convertColorType(const ImageColorFormat& format) {
@@ -36,30 +43,133 @@ namespace robot2D {
         return GL_RGB;
     }
 
+    namespace {
+        GLenum convertInternalFormat(const ImageColorFormat& format) {
+            switch(format) {
+                case ImageColorFormat::RED:
+                    return GL_R8;
+                case ImageColorFormat::RGB:
+                    return GL_RGB8;
+                case ImageColorFormat::RGBA:
+                    return GL_RGBA8;
+            }
+            return GL_RGB8;
+        }
+
+        unsigned int mipChainLength(const vec2u& size) {
+            const auto side = std::max(1U, std::max(size.x, size.y));
+            return 1 + static_cast<unsigned int>(std::floor(std::log2(static_cast<double>(side))));
+        }
+
+        vec2u mipSize(const vec2u& size, unsigned int mip) {
+            return { std::max(1U, size.x >> mip), std::max(1U, size.y >> mip) };
+        }
+
+        /// glad is generated without EXT_texture_compression_s3tc, values are taken from it.
+        constexpr GLenum compressedRGBAS3TCDXT1 = 0x83F1;
+        constexpr GLenum compressedRGBAS3TCDXT5 = 0x83F3;
+
+        GLenum convertCompressedFormat(CompressedFormat format) {
+            switch(format) {
+                case CompressedFormat::BC1:
+                    return compressedRGBAS3TCDXT1;
+                case CompressedFormat::BC3:
+                    return compressedRGBAS3TCDXT5;
+                case CompressedFormat::BC7:
+                    return GL_COMPRESSED_RGBA_BPTC_UNORM;
+                case CompressedFormat::ETC2_RGB:
+                    return GL_COMPRESSED_RGB8_ETC2;
+                case CompressedFormat::ETC2_RGBA:
+                    return GL_COMPRESSED_RGBA8_ETC2_EAC;
+            }
+            return compressedRGBAS3TCDXT5;
+        }
+
+        /// Formats list is asked from driver once, context is current on first compressed upload.
+        bool isCompressedFormatSupported(GLenum format) {
+            static const std::vector<GLint> supportedFormats = []() {
+                GLint count = 0;
+                glGetIntegerv(GL_NUM_COMPRESSED_TEXTURE_FORMATS, &count);
+                std::vector<GLint> formats(static_cast<std::size_t>(std::max(count, 0)));
+                if(!formats.empty())
+                    glGetIntegerv(GL_COMPRESSED_TEXTURE_FORMATS, formats.data());
+                return formats;
+            }();
+            return std::find(supportedFormats.begin(), supportedFormats.end(),
+                             static_cast<GLint>(format)) != supportedFormats.end();
+        }
+
+        bool hasExtension(const std::string& path, const char* extension) {
+            const std::size_t length = std::strlen(extension);
+            return path.size() >= length && path.compare(path.size() - length, length, extension) == 0;
+        }
+    }
+
     Texture::Texture() = default;
 
+    Texture::Texture(Texture&& other) noexcept {
+        *this = std::move(other);
+    }
+
+    Texture& Texture::operator=(Texture&& other) noexcept {
+        if(this == &other)
+            return *this;
+        if(m_streamIndex >= 0)
+            TextureResidency::getInstance().remove(*this);
+        if(m_texture != noTexture)
+            glCall(glDeleteTextures, 1, &m_texture);
+
+        m_texture = std::exchange(other.m_texture, noTexture);
+        m_mips = std::move(other.m_mips);
+        m_size = other.m_size;
+        m_colorFormat = other.m_colorFormat;
+        m_texParam = other.m_texParam;
+        m_options = other.m_options;
+        m_path = std::move(other.m_path);
+        m_compressed = other.m_compressed;
+        m_compressedFormat = other.m_compressedFormat;
+        m_mipLevels = std::exchange(other.m_mipLevels, 0);
+        m_residentMip = std::exchange(other.m_residentMip, 0);
+        if(other.m_streamIndex >= 0)
+            TextureResidency::getInstance().relocate(other, *this);
+        return *this;
+    }
+
     Texture::~Texture() {
-        glCall(glDeleteTextures, 1, &m_texture);
+        if(m_streamIndex >= 0)
+            TextureResidency::getInstance().remove(*this);
+        if(m_texture != noTexture)
+            glCall(glDeleteTextures, 1, &m_texture);
     }
 
     bool Texture::loadFromFile(const std::string& path) {
-        if(!m_image.loadFromFile(path))
+        if(hasExtension(path, CompressedImage::extension)) {
+            CompressedImage compressedImage;
+            if(!compressedImage.loadFromFile(path))
+                return false;
+            return create(compressedImage);
+        }
+
+        Image image;
+        if(!image.loadFromFile(path))
             return false;
-        setupGL();
-        bindBufferData(m_image.getBuffer());
+        m_mips.clear();
+        m_mips.emplace_back(std::move(image));
+        m_path = path;
+        createFromMips();
         return true;
     }
 
     vec2u& Texture::getSize() {
-        return m_image.getSize();
+        return m_size;
     }
 
     const vec2u& Texture::getSize() const {
-        return m_image.getSize();
+        return m_size;
     }
 
-    void Texture::setupGL() {
-        if(m_texture != 20000)
+    void Texture::setupGL(const vec2u& size, unsigned int levels) {
+        if(m_texture != noTexture)
             glDeleteTextures(1, &m_texture);
         if(RenderAPI::getOpenGLVersion() == RenderApi::OpenGL4_5)
             glCreateTextures(GL_TEXTURE_2D, 1, &m_texture);
@@ -67,52 +177,246 @@ namespace robot2D {
             glGenTextures(1, &m_texture);
             glBindTexture(GL_TEXTURE_2D, m_texture);
         }
+        m_mipLevels = levels;
 
-        auto size = m_image.getSize();
-        GLint internalFormat = GL_RGB8;
-        auto glFormat = convertColorType(m_image.getColorFormat());
-        if(glFormat == GL_RGBA)
-            internalFormat = GL_RGBA8;
-
+        const GLint minFilter = levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR;
+        const GLint wrap = m_texParam == 1 ? GL_CLAMP_TO_EDGE : GL_REPEAT;
         if(RenderAPI::getOpenGLVersion() == RenderApi::OpenGL4_3) {
-            if(m_texParam == 0) {
-                glTexParameteri(m_texture, GL_TEXTURE_WRAP_S, GL_REPEAT);
-                glTexParameteri(m_texture, GL_TEXTURE_WRAP_T, GL_REPEAT);
-            } else if(m_texParam == 1) {
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-            }
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrap);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrap);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(levels - 1));
         }
         else {
-            glTextureStorage2D(m_texture, 1, internalFormat, size.x, size.y);
+            const GLenum internalFormat = m_compressed ? convertCompressedFormat(m_compressedFormat)
+                                                       : convertInternalFormat(m_colorFormat);
+            glTextureStorage2D(m_texture, static_cast<GLsizei>(levels), internalFormat, size.x, size.y);
 
-            glTextureParameteri(m_texture, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTextureParameteri(m_texture, GL_TEXTURE_MIN_FILTER, minFilter);
             glTextureParameteri(m_texture, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTextureParameteri(m_texture, GL_TEXTURE_WRAP_S, wrap);
+            glTextureParameteri(m_texture, GL_TEXTURE_WRAP_T, wrap);
+        }
+    }
 
-            if(m_texParam == 0) {
-                glTextureParameteri(m_texture, GL_TEXTURE_WRAP_S, GL_REPEAT);
-                glTextureParameteri(m_texture, GL_TEXTURE_WRAP_T, GL_REPEAT);
-            } else if(m_texParam == 1) {
-                glTextureParameteri(m_texture, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-                glTextureParameteri(m_texture, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-            }
+    void Texture::uploadLevel(unsigned int level, const vec2u& size, const void* pixels) {
+        auto glFormat = convertColorType(m_colorFormat);
+        /// odd mip widths leave rows unaligned
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        if(RenderAPI::getOpenGLVersion() == RenderApi::OpenGL4_3) {
+            glBindTexture(GL_TEXTURE_2D, m_texture);
+            glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), convertInternalFormat(m_colorFormat),
+                         size.x, size.y, 0, glFormat, GL_UNSIGNED_BYTE, pixels);
         }
+        else
+            glTextureSubImage2D(m_texture, static_cast<GLint>(level), 0, 0,
+                                size.x, size.y, glFormat, GL_UNSIGNED_BYTE, pixels);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
     }
 
     void Texture::create(const vec2u& size, const void* data, int texParam, const ImageColorFormat& colorFormat) {
-        m_image.create(size, data, colorFormat);
+        Image image;
+        image.create(size, data, colorFormat);
+        m_mips.clear();
+        m_mips.emplace_back(std::move(image));
         m_texParam = texParam;
-        setupGL();
-        bindBufferData(m_image.getBuffer());
+        m_path.clear();
+        createFromMips();
     }
 
     void Texture::create(const Image& image) {
-        m_image = image;
-        m_texParam = static_cast<int>(m_image.getImageParameter());
-        setupGL();
-        bindBufferData(m_image.getBuffer());
+        m_mips.assign(1, image);
+        m_texParam = static_cast<int>(image.getImageParameter());
+        m_path.clear();
+        createFromMips();
+    }
+
+    void Texture::create(Image&& image) {
+        m_texParam = static_cast<int>(image.getImageParameter());
+        m_mips.clear();
+        m_mips.emplace_back(std::move(image));
+        m_path.clear();
+        createFromMips();
+    }
+
+    bool Texture::create(const CompressedImage& image) {
+        if(image.empty())
+            return false;
+
+        const auto& levels = image.getLevels();
+        const GLenum internalFormat = convertCompressedFormat(image.getFormat());
+        if(!isCompressedFormatSupported(internalFormat)) {
+            RB_CORE_WARN("Texture: compressed format {0} isn't supported, it's decoded to RGBA",
+                         static_cast<std::uint32_t>(image.getFormat()));
+            Image decoded;
+            if(!image.decompress(decoded))
+                return false;
+            m_mips.clear();
+            m_mips.emplace_back(std::move(decoded));
+            m_path.clear();
+            createFromMips();
+            return true;
+        }
+
+        if(m_streamIndex >= 0)
+            TextureResidency::getInstance().remove(*this);
+        m_mips.clear();
+        m_path.clear();
+        m_size = levels.front().size;
+        m_colorFormat = image.getFormat() == CompressedFormat::ETC2_RGB ? ImageColorFormat::RGB
+                                                                        : ImageColorFormat::RGBA;
+        m_compressed = true;
+        m_compressedFormat = image.getFormat();
+        m_residentMip = 0;
+
+        setupGL(m_size, static_cast<unsigned int>(levels.size()));
+        for(std::size_t index = 0; index < levels.size(); ++index) {
+            const auto& level = levels[index];
+            if(RenderAPI::getOpenGLVersion() == RenderApi::OpenGL4_3)
+                glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(index), internalFormat,
+                                       level.size.x, level.size.y, 0,
+                                       static_cast<GLsizei>(level.blocks.size()), level.blocks.data());
+            else
+                glCompressedTextureSubImage2D(m_texture, static_cast<GLint>(index), 0, 0,
+                                              level.size.x, level.size.y, internalFormat,
+                                              static_cast<GLsizei>(level.blocks.size()), level.blocks.data());
+        }
+        return true;
+    }
+
+    void Texture::createFromMips() {
+        const auto& image = m_mips.front();
+        m_compressed = false;
+        m_size = image.getSize();
+        m_colorFormat = image.getColorFormat();
+        m_residentMip = 0;
+
+        auto& residency = TextureResidency::getInstance();
+        if(m_options.streamed) {
+            buildMipChain();
+            if(m_streamIndex < 0)
+                residency.add(*this);
+            /// residency lowers it when texture is small on screen or budget is over
+            makeResident(0);
+            return;
+        }
+        if(m_streamIndex >= 0)
+            residency.remove(*this);
+
+        const unsigned int levels = m_options.mipmaps ? mipChainLength(m_size) : 1;
+        setupGL(m_size, levels);
+        uploadLevel(0, m_size, image.getBuffer().data());
+        if(levels > 1) {
+            if(RenderAPI::getOpenGLVersion() == RenderApi::OpenGL4_3)
+                glGenerateMipmap(GL_TEXTURE_2D);
+            else
+                glGenerateTextureMipmap(m_texture);
+        }
+
+        if(!m_options.keepPixels)
+            m_mips.clear();
+    }
+
+    void Texture::buildMipChain() {
+        m_mips.resize(1);
+        Image mip;
+        while(m_mips.back().downsample(mip))
+            m_mips.emplace_back(std::move(mip));
+    }
+
+    bool Texture::hasMips(unsigned int firstMip) const {
+        if(firstMip >= m_mips.size())
+            return false;
+        return std::all_of(m_mips.begin() + firstMip, m_mips.end(), [](const Image& image) {
+            return !image.getBuffer().empty();
+        });
+    }
+
+    bool Texture::makeResident(unsigned int firstMip) {
+        if(!hasMips(firstMip))
+            return false;
+
+        setupGL(m_mips[firstMip].getSize(), static_cast<unsigned int>(m_mips.size()) - firstMip);
+        for(auto level = firstMip; level < m_mips.size(); ++level)
+            uploadLevel(level - firstMip, m_mips[level].getSize(), m_mips[level].getBuffer());
+        m_residentMip = firstMip;
+        return true;
+    }
+
+    void Texture::releaseMips(unsigned int firstMip) {
+        for(unsigned int level = 0; level < firstMip && level < m_mips.size(); ++level)
+            m_mips[level] = Image{};
+    }
+
+    unsigned int Texture::getMipChainLength() const {
+        return mipChainLength(m_size);
+    }
+
+    std::size_t Texture::getVideoBytes() const {
+        if(m_texture == noTexture)
+            return 0;
+        std::size_t bytes = 0;
+        for(unsigned int level = 0; level < m_mipLevels; ++level) {
+            const auto size = mipSize(m_size, m_residentMip + level);
+            if(m_compressed)
+                bytes += getCompressedSize(m_compressedFormat, size);
+            else
+                bytes += static_cast<std::size_t>(size.x) * size.y * static_cast<std::size_t>(m_colorFormat);
+        }
+        return bytes;
+    }
+
+    std::size_t Texture::getSystemBytes() const {
+        std::size_t bytes = 0;
+        for(const auto& mip: m_mips)
+            bytes += mip.getBuffer().size();
+        return bytes;
+    }
+
+    const Image& Texture::getImage() const {
+        static const Image empty;
+        return m_mips.empty() ? empty : m_mips.front();
+    }
+
+    Image& Texture::getImage() {
+        if(m_mips.empty())
+            m_mips.emplace_back();
+        return m_mips.front();
+    }
+
+    void Texture::update(const IntRect& area, const void* pixels) {
+        const auto& size = m_size;
+        if(m_texture == noTexture || m_compressed || area.lx < 0 || area.ly < 0 || area.width <= 0 || area.height <= 0
+            || static_cast<unsigned int>(area.lx + area.width) > size.x
+            || static_cast<unsigned int>(area.ly + area.height) > size.y)
+            return;
+
+        const auto channels = static_cast<std::size_t>(m_colorFormat);
+        const auto rowSize = static_cast<std::size_t>(area.width) * channels;
+        const auto* source = static_cast<const unsigned char*>(pixels);
+        if(auto* buffer = getPixels()) {
+            for(int row = 0; row < area.height; ++row) {
+                auto* destination = buffer + ((area.ly + row) * size.x + area.lx) * channels;
+                if(destination != source + row * rowSize)
+                    std::memmove(destination, source + row * rowSize, rowSize);
+            }
+        }
+
+        if(m_residentMip != 0)
+            return;
+
+        auto glFormat = convertColorType(m_colorFormat);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        if(RenderAPI::getOpenGLVersion() == RenderApi::OpenGL4_3) {
+            glBindTexture(GL_TEXTURE_2D, m_texture);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, area.lx, area.ly, area.width, area.height,
+                            glFormat, GL_UNSIGNED_BYTE, pixels);
+        }
+        else
+            glTextureSubImage2D(m_texture, 0, area.lx, area.ly, area.width, area.height,
+                                glFormat, GL_UNSIGNED_BYTE, pixels);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
     }
 
     const unsigned int& Texture::getID() const {
@@ -120,22 +424,15 @@ namespace robot2D {
     }
 
     const unsigned char* Texture::getPixels() const {
-        return m_image.getBuffer().data();
+        if(m_mips.empty() || m_mips.front().getBuffer().empty())
+            return nullptr;
+        return m_mips.front().getBuffer().data();
     }
 
     unsigned char* Texture::getPixels() {
-        return m_image.getBuffer();
-    }
-
-    void Texture::bindBufferData(void* bufferData) {
-        auto glFormat = convertColorType(m_image.getColorFormat());
-        auto size = m_image.getSize();
-        if(RenderAPI::getOpenGLVersion() == RenderApi::OpenGL4_3)
-            glTexImage2D(GL_TEXTURE_2D, 0, glFormat, size.x,
-                         size.y, 0, glFormat, GL_UNSIGNED_BYTE, bufferData);
-        else
-            glTextureSubImage2D(m_texture, 0, 0, 0,
-                                size.x, size.y, glFormat, GL_UNSIGNED_BYTE, bufferData);
+        if(m_mips.empty())
+            return nullptr;
+        return m_mips.front().getBuffer();
     }
 
     void Texture::bind(uint32_t slot) {
@@ -152,7 +449,9 @@ namespace robot2D {
     }
 
     bool Texture::saveToFile(const std::string& path) {
-        return m_image.save(path);
+        if(m_mips.empty())
+            return false;
+        return m_mips.front().save(path);
     }
 
 
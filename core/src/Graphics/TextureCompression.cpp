@@ -0,0 +1,1094 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <fstream>
+#include <cstring>
+#include <iterator>
+#include <algorithm>
+
+#include <robot2D/Core/JobSystem.hpp>
+#include <robot2D/Graphics/TextureCompression.hpp>
+#include <robot2D/Util/Logger.hpp>
+#include <robot2D/Util/Profiler.hpp>
+
+namespace robot2D {
+    namespace {
+        constexpr std::size_t minBlockRowsPerJob = 8;
+
+        /// "R2TX" in little endian.
+        constexpr std::uint32_t containerMagic = 0x58543252;
+        constexpr std::uint32_t containerVersion = 1;
+        constexpr std::uint32_t maxLevels = 32;
+        constexpr std::size_t headerBytes = 6 * sizeof(std::uint32_t);
+        constexpr std::size_t levelEntryBytes = 2 * sizeof(std::uint64_t);
+
+        /// RGBA of pixel, ints keep arithmetic of encoders simple.
+        using Pixel = std::array<int, 4>;
+        /// Pixels of 4x4 block by rows, index is y * 4 + x.
+        using Block = std::array<Pixel, 16>;
+
+        int clampByte(int value) {
+            return std::clamp(value, 0, 255);
+        }
+
+        int squaredDistance(const Pixel& left, const Pixel& right, int channels) {
+            int sum = 0;
+            for(int channel = 0; channel < channels; ++channel) {
+                const int delta = left[channel] - right[channel];
+                sum += delta * delta;
+            }
+            return sum;
+        }
+
+        bool isValidFormat(CompressedFormat format) {
+            return format >= CompressedFormat::BC1 && format <= CompressedFormat::ETC2_RGBA;
+        }
+
+        vec2u levelSize(const vec2u& size, unsigned int level) {
+            return { std::max(1U, size.x >> level), std::max(1U, size.y >> level) };
+        }
+
+        /// Reads 4x4 block as RGBA, pixels out of image repeat its last row / column.
+        void fetchBlock(const Image& image, unsigned int blockX, unsigned int blockY, Block& block) {
+            const auto& size = image.getSize();
+            const auto channels = static_cast<unsigned int>(image.getColorFormat());
+            const auto* pixels = image.getBuffer().data();
+            for(unsigned int y = 0; y < 4; ++y) {
+                const auto row = std::min(blockY * 4 + y, size.y - 1);
+                for(unsigned int x = 0; x < 4; ++x) {
+                    const auto column = std::min(blockX * 4 + x, size.x - 1);
+                    const auto* pixel = pixels + (static_cast<std::size_t>(row) * size.x + column) * channels;
+                    auto& out = block[y * 4 + x];
+                    if(channels >= 3)
+                        out = { pixel[0], pixel[1], pixel[2], channels == 4 ? pixel[3] : 255 };
+                    else
+                        out = { pixel[0], pixel[0], pixel[0], 255 };
+                }
+            }
+        }
+
+        /// Ends of used pixels projected onto their principal axis, slightly moved inside.
+        void principalEnds(const Block& block, int channels, std::uint16_t usedMask, Pixel& low, Pixel& high) {
+            std::array<float, 4> mean{};
+            int count = 0;
+            for(int i = 0; i < 16; ++i) {
+                if(!(usedMask & (1 << i)))
+                    continue;
+                for(int channel = 0; channel < channels; ++channel)
+                    mean[channel] += static_cast<float>(block[i][channel]);
+                ++count;
+            }
+            for(int channel = 0; channel < channels; ++channel)
+                mean[channel] /= static_cast<float>(std::max(count, 1));
+
+            std::array<std::array<float, 4>, 4> covariance{};
+            for(int i = 0; i < 16; ++i) {
+                if(!(usedMask & (1 << i)))
+                    continue;
+                for(int row = 0; row < channels; ++row)
+                    for(int column = 0; column < channels; ++column)
+                        covariance[row][column] += (static_cast<float>(block[i][row]) - mean[row])
+                                * (static_cast<float>(block[i][column]) - mean[column]);
+            }
+
+            /// power iteration converges fast enough for 16 pixels
+            std::array<float, 4> axis{1.F, 1.F, 1.F, 1.F};
+            for(int iteration = 0; iteration < 8; ++iteration) {
+                std::array<float, 4> next{};
+                float length = 0.F;
+                for(int row = 0; row < channels; ++row) {
+                    for(int column = 0; column < channels; ++column)
+                        next[row] += covariance[row][column] * axis[column];
+                    length = std::max(length, std::abs(next[row]));
+                }
+                if(length < 1e-6F) {
+                    axis.fill(0.F);
+                    break;
+                }
+                for(int channel = 0; channel < channels; ++channel)
+                    axis[channel] = next[channel] / length;
+            }
+
+            float axisLength = 0.F;
+            for(int channel = 0; channel < channels; ++channel)
+                axisLength += axis[channel] * axis[channel];
+
+            float minT = 0.F;
+            float maxT = 0.F;
+            if(axisLength > 0.F) {
+                minT = std::numeric_limits<float>::max();
+                maxT = std::numeric_limits<float>::lowest();
+                for(int i = 0; i < 16; ++i) {
+                    if(!(usedMask & (1 << i)))
+                        continue;
+                    float t = 0.F;
+                    for(int channel = 0; channel < channels; ++channel)
+                        t += (static_cast<float>(block[i][channel]) - mean[channel]) * axis[channel];
+                    t /= axisLength;
+                    minT = std::min(minT, t);
+                    maxT = std::max(maxT, t);
+                }
+                /// interpolated values land closer to pixels when ends aren't outliers
+                const float inset = (maxT - minT) / 16.F;
+                minT += inset;
+                maxT -= inset;
+            }
+
+            low = high = { 0, 0, 0, 255 };
+            for(int channel = 0; channel < channels; ++channel) {
+                low[channel] = clampByte(static_cast<int>(std::lround(mean[channel] + axis[channel] * minT)));
+                high[channel] = clampByte(static_cast<int>(std::lround(mean[channel] + axis[channel] * maxT)));
+            }
+        }
+
+        void writeLittleEndian(std::uint64_t value, std::size_t bytes, std::uint8_t* out) {
+            for(std::size_t i = 0; i < bytes; ++i)
+                out[i] = static_cast<std::uint8_t>(value >> (8 * i));
+        }
+
+        std::uint64_t readLittleEndian(const std::uint8_t* data, std::size_t bytes) {
+            std::uint64_t value = 0;
+            for(std::size_t i = 0; i < bytes; ++i)
+                value |= static_cast<std::uint64_t>(data[i]) << (8 * i);
+            return value;
+        }
+
+        /// ETC and EAC blocks are 64 bit big endian words.
+        void writeBigEndian(std::uint64_t value, std::uint8_t* out) {
+            for(std::size_t i = 0; i < 8; ++i)
+                out[i] = static_cast<std::uint8_t>(value >> (56 - 8 * i));
+        }
+
+        std::uint64_t readBigEndian(const std::uint8_t* data) {
+            std::uint64_t value = 0;
+            for(std::size_t i = 0; i < 8; ++i)
+                value = (value << 8) | data[i];
+            return value;
+        }
+
+        ////////////////////////////////////// BC1 / BC3 //////////////////////////////////////
+
+        std::uint16_t pack565(const Pixel& color) {
+            return static_cast<std::uint16_t>(((color[0] * 31 + 127) / 255) << 11
+                    | ((color[1] * 63 + 127) / 255) << 5 | ((color[2] * 31 + 127) / 255));
+        }
+
+        Pixel unpack565(std::uint16_t value) {
+            const int red = (value >> 11) & 31;
+            const int green = (value >> 5) & 63;
+            const int blue = value & 31;
+            return { (red << 3) | (red >> 2), (green << 2) | (green >> 4), (blue << 3) | (blue >> 2), 255 };
+        }
+
+        /// Without fourColors third color is average and fourth one is transparent black.
+        void colorPalette(std::uint16_t color0, std::uint16_t color1, bool fourColors, std::array<Pixel, 4>& palette) {
+            palette[0] = unpack565(color0);
+            palette[1] = unpack565(color1);
+            for(int channel = 0; channel < 3; ++channel) {
+                const int first = palette[0][channel];
+                const int second = palette[1][channel];
+                if(fourColors) {
+                    palette[2][channel] = (2 * first + second) / 3;
+                    palette[3][channel] = (first + 2 * second) / 3;
+                }
+                else {
+                    palette[2][channel] = (first + second) / 2;
+                    palette[3][channel] = 0;
+                }
+            }
+            palette[2][3] = 255;
+            palette[3][3] = fourColors ? 255 : 0;
+        }
+
+        /// Color half of BC1 / BC3 block. BC1 keeps pixels with alpha below half as punch through ones.
+        void encodeColorBlock(const Block& block, bool punchThrough, std::uint8_t* out) {
+            std::uint16_t usedMask = 0;
+            for(int i = 0; i < 16; ++i)
+                if(!punchThrough || block[i][3] >= 128)
+                    usedMask |= static_cast<std::uint16_t>(1 << i);
+
+            if(usedMask == 0) {
+                writeLittleEndian(0, 4, out);
+                writeLittleEndian(0xFFFFFFFF, 4, out + 4);
+                return;
+            }
+
+            Pixel low, high;
+            principalEnds(block, 3, usedMask, low, high);
+            auto color0 = pack565(high);
+            auto color1 = pack565(low);
+
+            /// order of ends selects palette mode
+            const bool fourColors = usedMask == 0xFFFF;
+            if(fourColors ? color0 < color1 : color0 > color1)
+                std::swap(color0, color1);
+
+            std::array<Pixel, 4> palette;
+            colorPalette(color0, color1, color0 > color1 || !punchThrough, palette);
+            const int colorsCount = fourColors && color0 != color1 ? 4 : 3;
+
+            std::uint32_t indices = 0;
+            for(int i = 0; i < 16; ++i) {
+                int bestIndex = 3;
+                if(usedMask & (1 << i)) {
+                    int bestError = std::numeric_limits<int>::max();
+                    for(int index = 0; index < colorsCount; ++index) {
+                        const int error = squaredDistance(block[i], palette[index], 3);
+                        if(error < bestError) {
+                            bestError = error;
+                            bestIndex = index;
+                        }
+                    }
+                }
+                indices |= static_cast<std::uint32_t>(bestIndex) << (2 * i);
+            }
+
+            writeLittleEndian(color0, 2, out);
+            writeLittleEndian(color1, 2, out + 2);
+            writeLittleEndian(indices, 4, out + 4);
+        }
+
+        /// BC3 color half always uses four colors.
+        void decodeColorBlock(const std::uint8_t* data, bool punchThrough, Block& block) {
+            const auto color0 = static_cast<std::uint16_t>(readLittleEndian(data, 2));
+            const auto color1 = static_cast<std::uint16_t>(readLittleEndian(data + 2, 2));
+            const auto indices = static_cast<std::uint32_t>(readLittleEndian(data + 4, 4));
+
+            std::array<Pixel, 4> palette;
+            colorPalette(color0, color1, color0 > color1 || !punchThrough, palette);
+            for(int i = 0; i < 16; ++i)
+                block[i] = palette[(indices >> (2 * i)) & 3];
+        }
+
+        void alphaPalette(int alpha0, int alpha1, std::array<int, 8>& palette) {
+            palette[0] = alpha0;
+            palette[1] = alpha1;
+            if(alpha0 > alpha1) {
+                for(int i = 1; i < 7; ++i)
+                    palette[1 + i] = ((7 - i) * alpha0 + i * alpha1) / 7;
+            }
+            else {
+                for(int i = 1; i < 5; ++i)
+                    palette[1 + i] = ((5 - i) * alpha0 + i * alpha1) / 5;
+                palette[6] = 0;
+                palette[7] = 255;
+            }
+        }
+
+        /// Picks closest palette entries, returns squared error.
+        int fitAlphaBlock(const Block& block, int alpha0, int alpha1, std::uint64_t& indices) {
+            std::array<int, 8> palette;
+            alphaPalette(alpha0, alpha1, palette);
+            int totalError = 0;
+            indices = 0;
+            for(int i = 0; i < 16; ++i) {
+                int bestIndex = 0;
+                int bestError = std::numeric_limits<int>::max();
+                for(int index = 0; index < 8; ++index) {
+                    const int delta = block[i][3] - palette[index];
+                    if(delta * delta < bestError) {
+                        bestError = delta * delta;
+                        bestIndex = index;
+                    }
+                }
+                totalError += bestError;
+                indices |= static_cast<std::uint64_t>(bestIndex) << (3 * i);
+            }
+            return totalError;
+        }
+
+        /// Tries eight interpolated values between ends and six ones with exact 0 and 255.
+        void encodeAlphaBlock(const Block& block, std::uint8_t* out) {
+            int minAlpha = 255, maxAlpha = 0;
+            int minInner = 255, maxInner = 0;
+            for(const auto& pixel: block) {
+                minAlpha = std::min(minAlpha, pixel[3]);
+                maxAlpha = std::max(maxAlpha, pixel[3]);
+                if(pixel[3] != 0 && pixel[3] != 255) {
+                    minInner = std::min(minInner, pixel[3]);
+                    maxInner = std::max(maxInner, pixel[3]);
+                }
+            }
+
+            int alpha0 = maxAlpha, alpha1 = minAlpha;
+            std::uint64_t indices;
+            int error = fitAlphaBlock(block, alpha0, alpha1, indices);
+            if(error > 0) {
+                if(minInner > maxInner)
+                    minInner = maxInner = 0;
+                std::uint64_t innerIndices;
+                const int innerError = fitAlphaBlock(block, minInner, maxInner, innerIndices);
+                if(innerError < error) {
+                    alpha0 = minInner;
+                    alpha1 = maxInner;
+                    indices = innerIndices;
+                }
+            }
+
+            out[0] = static_cast<std::uint8_t>(alpha0);
+            out[1] = static_cast<std::uint8_t>(alpha1);
+            writeLittleEndian(indices, 6, out + 2);
+        }
+
+        void decodeAlphaBlock(const std::uint8_t* data, Block& block) {
+            std::array<int, 8> palette;
+            alphaPalette(data[0], data[1], palette);
+            const auto indices = readLittleEndian(data + 2, 6);
+            for(int i = 0; i < 16; ++i)
+                block[i][3] = palette[(indices >> (3 * i)) & 7];
+        }
+
+        ////////////////////////////////////// BC7 //////////////////////////////////////
+
+        constexpr std::array<int, 16> bc7Weights{0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+        constexpr unsigned int bc7Mode = 6;
+
+        /// Bits of 128 bit block, lowest bit first.
+        class BlockBits {
+        public:
+            explicit BlockBits(const std::uint8_t* data): m_data{const_cast<std::uint8_t*>(data)} {}
+
+            void write(unsigned int value, unsigned int bits) {
+                for(unsigned int i = 0; i < bits; ++i, ++m_position)
+                    if(value & (1U << i))
+                        m_data[m_position >> 3] |= static_cast<std::uint8_t>(1U << (m_position & 7));
+            }
+
+            unsigned int read(unsigned int bits) {
+                unsigned int value = 0;
+                for(unsigned int i = 0; i < bits; ++i, ++m_position)
+                    value |= static_cast<unsigned int>((m_data[m_position >> 3] >> (m_position & 7)) & 1) << i;
+                return value;
+            }
+        private:
+            std::uint8_t* m_data;
+            unsigned int m_position{0};
+        };
+
+        /// Mode 6 ends are 7 bits per channel with shared lowest bit, picks bit with smaller error.
+        /// Opaque end keeps alpha exactly 255, otherwise opaque sprites would be blended.
+        void quantizeBc7End(const Pixel& end, Pixel& quantized, unsigned int& pBit) {
+            int bestError = std::numeric_limits<int>::max();
+            for(unsigned int bit = end[3] == 255 ? 1 : 0; bit < 2; ++bit) {
+                Pixel candidate;
+                int error = 0;
+                for(int channel = 0; channel < 4; ++channel) {
+                    const int value = std::clamp((end[channel] - static_cast<int>(bit) + 1) / 2, 0, 127);
+                    candidate[channel] = value;
+                    const int delta = ((value << 1) | static_cast<int>(bit)) - end[channel];
+                    error += delta * delta;
+                }
+                if(error < bestError) {
+                    bestError = error;
+                    quantized = candidate;
+                    pBit = bit;
+                }
+            }
+        }
+
+        Pixel bc7Interpolate(const Pixel& end0, const Pixel& end1, int weight) {
+            Pixel result;
+            for(int channel = 0; channel < 4; ++channel)
+                result[channel] = ((64 - weight) * end0[channel] + weight * end1[channel] + 32) >> 6;
+            return result;
+        }
+
+        void encodeBc7Block(const Block& block, std::uint8_t* out) {
+            Pixel low, high;
+            principalEnds(block, 4, 0xFFFF, low, high);
+
+            std::array<Pixel, 2> quantized;
+            std::array<unsigned int, 2> pBits;
+            quantizeBc7End(low, quantized[0], pBits[0]);
+            quantizeBc7End(high, quantized[1], pBits[1]);
+
+            std::array<Pixel, 2> ends;
+            for(int end = 0; end < 2; ++end)
+                for(int channel = 0; channel < 4; ++channel)
+                    ends[end][channel] = (quantized[end][channel] << 1) | static_cast<int>(pBits[end]);
+
+            std::array<Pixel, 16> palette;
+            for(int index = 0; index < 16; ++index)
+                palette[index] = bc7Interpolate(ends[0], ends[1], bc7Weights[index]);
+
+            std::array<unsigned int, 16> indices;
+            for(int i = 0; i < 16; ++i) {
+                int bestError = std::numeric_limits<int>::max();
+                for(unsigned int index = 0; index < 16; ++index) {
+                    const int error = squaredDistance(block[i], palette[index], 4);
+                    if(error < bestError) {
+                        bestError = error;
+                        indices[i] = index;
+                    }
+                }
+            }
+
+            /// first index has implicit zero top bit
+            if(indices[0] >= 8) {
+                std::swap(quantized[0], quantized[1]);
+                std::swap(pBits[0], pBits[1]);
+                for(auto& index: indices)
+                    index = 15 - index;
+            }
+
+            std::memset(out, 0, 16);
+            BlockBits bits{out};
+            bits.write(1U << bc7Mode, bc7Mode + 1);
+            for(int channel = 0; channel < 4; ++channel) {
+                bits.write(static_cast<unsigned int>(quantized[0][channel]), 7);
+                bits.write(static_cast<unsigned int>(quantized[1][channel]), 7);
+            }
+            bits.write(pBits[0], 1);
+            bits.write(pBits[1], 1);
+            bits.write(indices[0], 3);
+            for(int i = 1; i < 16; ++i)
+                bits.write(indices[i], 4);
+        }
+
+        bool decodeBc7Block(const std::uint8_t* data, Block& block) {
+            BlockBits bits{data};
+            unsigned int mode = 0;
+            while(mode < 8 && bits.read(1) == 0)
+                ++mode;
+            if(mode != bc7Mode)
+                return false;
+
+            std::array<Pixel, 2> ends;
+            for(int channel = 0; channel < 4; ++channel) {
+                ends[0][channel] = static_cast<int>(bits.read(7)) << 1;
+                ends[1][channel] = static_cast<int>(bits.read(7)) << 1;
+            }
+            for(auto& end: ends) {
+                const int pBit = static_cast<int>(bits.read(1));
+                for(auto& channel: end)
+                    channel |= pBit;
+            }
+
+            for(int i = 0; i < 16; ++i) {
+                const auto index = bits.read(i == 0 ? 3 : 4);
+                block[i] = bc7Interpolate(ends[0], ends[1], bc7Weights[index]);
+            }
+            return true;
+        }
+
+        ////////////////////////////////////// ETC2 / EAC //////////////////////////////////////
+
+        constexpr int etcModifiers[8][2] = {
+            {2, 8}, {5, 17}, {9, 29}, {13, 42}, {18, 60}, {24, 80}, {33, 106}, {47, 183}
+        };
+        constexpr int etcDistances[8] = {3, 6, 11, 16, 23, 32, 41, 64};
+        constexpr int eacModifiers[16][8] = {
+            {-3, -6, -9, -15, 2, 5, 8, 14}, {-3, -7, -10, -13, 2, 6, 9, 12},
+            {-2, -5, -8, -13, 1, 4, 7, 12}, {-2, -4, -6, -13, 1, 3, 5, 12},
+            {-3, -6, -8, -12, 2, 5, 7, 11}, {-3, -7, -9, -11, 2, 6, 8, 10},
+            {-4, -7, -8, -11, 3, 6, 7, 10}, {-3, -5, -8, -11, 2, 4, 7, 10},
+            {-2, -6, -8, -10, 1, 5, 7, 9}, {-2, -5, -8, -10, 1, 4, 7, 9},
+            {-2, -4, -8, -10, 1, 3, 7, 9}, {-2, -5, -7, -10, 1, 4, 6, 9},
+            {-3, -4, -7, -10, 2, 3, 6, 9}, {-1, -2, -3, -10, 0, 1, 2, 9},
+            {-4, -6, -8, -9, 3, 5, 7, 8}, {-3, -5, -7, -9, 2, 4, 6, 8}
+        };
+        /// Table with zero modifier, flat alpha blocks are exact with it.
+        constexpr int eacFlatTable = 13;
+        constexpr int eacFlatIndex = 4;
+
+        /// Index bits are 2 - sign, 1 - large modifier.
+        int etcModifier(int table, int index) {
+            const int modifier = etcModifiers[table][index & 1];
+            return (index & 2) ? -modifier : modifier;
+        }
+
+        bool inSecondSubblock(int x, int y, bool flip) {
+            return flip ? y >= 2 : x >= 2;
+        }
+
+        int expand4(int value) { return (value << 4) | value; }
+        int expand5(int value) { return (value << 3) | (value >> 2); }
+        int expand6(int value) { return (value << 2) | (value >> 4); }
+        int expand7(int value) { return (value << 1) | (value >> 6); }
+
+        /// Pixels are stored by columns, index of pixel is x * 4 + y.
+        int etcPixelIndex(std::uint64_t bits, int x, int y) {
+            const int position = x * 4 + y;
+            return static_cast<int>(((bits >> (16 + position)) & 1) << 1 | ((bits >> position) & 1));
+        }
+
+        /// Best modifiers table for subblock of base color, returns squared error and writes pixel indices.
+        int fitEtcSubblock(const Block& block, bool flip, bool second, const Pixel& base,
+                           int& table, std::array<int, 16>& indices) {
+            int bestError = std::numeric_limits<int>::max();
+            std::array<int, 16> candidate{};
+            for(int tableIndex = 0; tableIndex < 8; ++tableIndex) {
+                int error = 0;
+                for(int y = 0; y < 4 && error < bestError; ++y) {
+                    for(int x = 0; x < 4; ++x) {
+                        if(inSecondSubblock(x, y, flip) != second)
+                            continue;
+                        const auto& pixel = block[y * 4 + x];
+                        int pixelError = std::numeric_limits<int>::max();
+                        for(int index = 0; index < 4; ++index) {
+                            const int modifier = etcModifier(tableIndex, index);
+                            const Pixel color{ clampByte(base[0] + modifier), clampByte(base[1] + modifier),
+                                               clampByte(base[2] + modifier), 255 };
+                            const int distance = squaredDistance(pixel, color, 3);
+                            if(distance < pixelError) {
+                                pixelError = distance;
+                                candidate[y * 4 + x] = index;
+                            }
+                        }
+                        error += pixelError;
+                    }
+                }
+                if(error < bestError) {
+                    bestError = error;
+                    table = tableIndex;
+                    for(int y = 0; y < 4; ++y)
+                        for(int x = 0; x < 4; ++x)
+                            if(inSecondSubblock(x, y, flip) == second)
+                                indices[y * 4 + x] = candidate[y * 4 + x];
+                }
+            }
+            return bestError;
+        }
+
+        /// ETC1 individual and differential modes, both are valid ETC2 blocks.
+        /// Differential ends never overflow, overflow selects T, H and planar modes in ETC2.
+        std::uint64_t encodeEtcColor(const Block& block) {
+            std::uint64_t bestBits = 0;
+            int bestError = std::numeric_limits<int>::max();
+
+            for(int flipValue = 0; flipValue < 2; ++flipValue) {
+                const bool flip = flipValue == 1;
+                std::array<std::array<int, 3>, 2> sums{};
+                for(int y = 0; y < 4; ++y)
+                    for(int x = 0; x < 4; ++x)
+                        for(int channel = 0; channel < 3; ++channel)
+                            sums[inSecondSubblock(x, y, flip)][channel] += block[y * 4 + x][channel];
+
+                for(int differential = 0; differential < 2; ++differential) {
+                    const int levels = differential ? 31 : 15;
+                    std::array<std::array<int, 3>, 2> quantized;
+                    for(int sub = 0; sub < 2; ++sub)
+                        for(int channel = 0; channel < 3; ++channel)
+                            quantized[sub][channel] = (sums[sub][channel] * levels + 8 * 255 / 2) / (8 * 255);
+
+                    std::array<int, 3> deltas{};
+                    if(differential) {
+                        for(int channel = 0; channel < 3; ++channel) {
+                            deltas[channel] = std::clamp(quantized[1][channel] - quantized[0][channel], -4, 3);
+                            quantized[1][channel] = quantized[0][channel] + deltas[channel];
+                        }
+                    }
+
+                    std::array<Pixel, 2> bases;
+                    for(int sub = 0; sub < 2; ++sub)
+                        for(int channel = 0; channel < 3; ++channel)
+                            bases[sub][channel] = differential ? expand5(quantized[sub][channel])
+                                                               : expand4(quantized[sub][channel]);
+
+                    std::array<int, 2> tables{};
+                    std::array<int, 16> indices{};
+                    const int error = fitEtcSubblock(block, flip, false, bases[0], tables[0], indices)
+                            + fitEtcSubblock(block, flip, true, bases[1], tables[1], indices);
+                    if(error >= bestError)
+                        continue;
+
+                    std::uint64_t bits = 0;
+                    for(int channel = 0; channel < 3; ++channel) {
+                        const int shift = 59 - channel * 8;
+                        if(differential) {
+                            bits |= static_cast<std::uint64_t>(quantized[0][channel]) << shift;
+                            bits |= static_cast<std::uint64_t>(deltas[channel] & 7) << (shift - 3);
+                        }
+                        else {
+                            bits |= static_cast<std::uint64_t>(quantized[0][channel]) << (shift + 1);
+                            bits |= static_cast<std::uint64_t>(quantized[1][channel]) << (shift - 3);
+                        }
+                    }
+                    bits |= static_cast<std::uint64_t>(tables[0]) << 37;
+                    bits |= static_cast<std::uint64_t>(tables[1]) << 34;
+                    bits |= static_cast<std::uint64_t>(differential) << 33;
+                    bits |= static_cast<std::uint64_t>(flipValue) << 32;
+                    for(int y = 0; y < 4; ++y) {
+                        for(int x = 0; x < 4; ++x) {
+                            const int index = indices[y * 4 + x];
+                            const int position = x * 4 + y;
+                            bits |= static_cast<std::uint64_t>(index >> 1) << (16 + position);
+                            bits |= static_cast<std::uint64_t>(index & 1) << position;
+                        }
+                    }
+
+                    bestError = error;
+                    bestBits = bits;
+                }
+            }
+            return bestBits;
+        }
+
+        void decodeEtcPaint(std::uint64_t bits, const std::array<Pixel, 4>& paint, Block& block) {
+            for(int y = 0; y < 4; ++y)
+                for(int x = 0; x < 4; ++x)
+                    block[y * 4 + x] = paint[etcPixelIndex(bits, x, y)];
+        }
+
+        Pixel etcOffsetColor(const Pixel& color, int offset) {
+            return { clampByte(color[0] + offset), clampByte(color[1] + offset), clampByte(color[2] + offset), 255 };
+        }
+
+        void decodeEtcColor(std::uint64_t bits, Block& block) {
+            /// value of count bits ending at high bit
+            auto field = [bits](int high, int count) {
+                return static_cast<int>((bits >> (high - count + 1)) & ((1ULL << count) - 1));
+            };
+            auto signExtend3 = [](int value) { return value >= 4 ? value - 8 : value; };
+
+            const bool differential = field(33, 1) != 0;
+            const bool flip = field(32, 1) != 0;
+            std::array<Pixel, 2> bases;
+
+            if(!differential) {
+                for(int channel = 0; channel < 3; ++channel) {
+                    bases[0][channel] = expand4(field(63 - channel * 8, 4));
+                    bases[1][channel] = expand4(field(59 - channel * 8, 4));
+                }
+            }
+            else {
+                std::array<int, 3> first, second;
+                for(int channel = 0; channel < 3; ++channel) {
+                    first[channel] = field(63 - channel * 8, 5);
+                    second[channel] = first[channel] + signExtend3(field(58 - channel * 8, 3));
+                }
+
+                if(second[0] < 0 || second[0] > 31) {
+                    /// T mode
+                    const Pixel color0{ expand4(field(60, 2) << 2 | field(57, 2)), expand4(field(55, 4)),
+                                        expand4(field(51, 4)), 255 };
+                    const Pixel color1{ expand4(field(47, 4)), expand4(field(43, 4)), expand4(field(39, 4)), 255 };
+                    const int distance = etcDistances[field(35, 2) << 1 | field(32, 1)];
+                    decodeEtcPaint(bits, { color0, etcOffsetColor(color1, distance), color1,
+                                           etcOffsetColor(color1, -distance) }, block);
+                    return;
+                }
+                if(second[1] < 0 || second[1] > 31) {
+                    /// H mode
+                    const std::array<int, 3> packed0{ field(62, 4), field(58, 3) << 1 | field(52, 1),
+                                                      field(51, 1) << 3 | field(49, 3) };
+                    const std::array<int, 3> packed1{ field(46, 4), field(42, 4), field(38, 4) };
+                    const int value0 = packed0[0] << 8 | packed0[1] << 4 | packed0[2];
+                    const int value1 = packed1[0] << 8 | packed1[1] << 4 | packed1[2];
+                    const int distance = etcDistances[field(34, 1) << 2 | field(32, 1) << 1
+                                                      | (value0 >= value1 ? 1 : 0)];
+                    const Pixel color0{ expand4(packed0[0]), expand4(packed0[1]), expand4(packed0[2]), 255 };
+                    const Pixel color1{ expand4(packed1[0]), expand4(packed1[1]), expand4(packed1[2]), 255 };
+                    decodeEtcPaint(bits, { etcOffsetColor(color0, distance), etcOffsetColor(color0, -distance),
+                                           etcOffsetColor(color1, distance), etcOffsetColor(color1, -distance) },
+                                   block);
+                    return;
+                }
+                if(second[2] < 0 || second[2] > 31) {
+                    /// planar mode, colors are interpolated from origin, horizontal and vertical ends
+                    const Pixel origin{ expand6(field(62, 6)), expand7(field(56, 1) << 6 | field(54, 6)),
+                                        expand6(field(48, 1) << 5 | field(44, 2) << 3 | field(41, 3)), 255 };
+                    const Pixel horizontal{ expand6(field(38, 5) << 1 | field(32, 1)), expand7(field(31, 7)),
+                                            expand6(field(24, 6)), 255 };
+                    const Pixel vertical{ expand6(field(18, 6)), expand7(field(12, 7)), expand6(field(5, 6)), 255 };
+                    for(int y = 0; y < 4; ++y) {
+                        for(int x = 0; x < 4; ++x) {
+                            auto& pixel = block[y * 4 + x];
+                            for(int channel = 0; channel < 3; ++channel)
+                                pixel[channel] = clampByte((x * (horizontal[channel] - origin[channel])
+                                        + y * (vertical[channel] - origin[channel]) + 4 * origin[channel] + 2) / 4);
+                            pixel[3] = 255;
+                        }
+                    }
+                    return;
+                }
+
+                for(int channel = 0; channel < 3; ++channel) {
+                    bases[0][channel] = expand5(first[channel]);
+                    bases[1][channel] = expand5(second[channel]);
+                }
+            }
+
+            const std::array<int, 2> tables{ field(39, 3), field(36, 3) };
+            for(int y = 0; y < 4; ++y) {
+                for(int x = 0; x < 4; ++x) {
+                    const int sub = inSecondSubblock(x, y, flip) ? 1 : 0;
+                    block[y * 4 + x] = etcOffsetColor(bases[sub], etcModifier(tables[sub], etcPixelIndex(bits, x, y)));
+                }
+            }
+        }
+
+        /// Squared error of alpha block, stops once it exceeds limit.
+        int fitEacBlock(const Block& block, int base, int multiplier, int table, int limit, std::uint64_t& indices) {
+            int totalError = 0;
+            indices = 0;
+            for(int y = 0; y < 4 && totalError < limit; ++y) {
+                for(int x = 0; x < 4; ++x) {
+                    int bestIndex = 0;
+                    int bestError = std::numeric_limits<int>::max();
+                    for(int index = 0; index < 8; ++index) {
+                        const int delta = block[y * 4 + x][3]
+                                - clampByte(base + eacModifiers[table][index] * multiplier);
+                        if(delta * delta < bestError) {
+                            bestError = delta * delta;
+                            bestIndex = index;
+                        }
+                    }
+                    totalError += bestError;
+                    indices |= static_cast<std::uint64_t>(bestIndex) << (45 - 3 * (x * 4 + y));
+                }
+            }
+            return totalError;
+        }
+
+        /// Searches tables with multipliers and bases close to ones covering alpha range.
+        std::uint64_t encodeEacAlpha(const Block& block) {
+            int minAlpha = 255, maxAlpha = 0;
+            for(const auto& pixel: block) {
+                minAlpha = std::min(minAlpha, pixel[3]);
+                maxAlpha = std::max(maxAlpha, pixel[3]);
+            }
+
+            std::uint64_t bestBits = 0;
+            if(minAlpha == maxAlpha) {
+                bestBits = static_cast<std::uint64_t>(minAlpha) << 56 | 1ULL << 52
+                        | static_cast<std::uint64_t>(eacFlatTable) << 48;
+                for(int position = 0; position < 16; ++position)
+                    bestBits |= static_cast<std::uint64_t>(eacFlatIndex) << (45 - 3 * position);
+                return bestBits;
+            }
+
+            int bestError = std::numeric_limits<int>::max();
+            for(int table = 0; table < 16 && bestError > 0; ++table) {
+                const int tableMin = eacModifiers[table][3];
+                const int tableMax = eacModifiers[table][7];
+                const float center = static_cast<float>(minAlpha + maxAlpha) / 2.F;
+                const int idealMultiplier = static_cast<int>(std::lround(
+                        static_cast<float>(maxAlpha - minAlpha) / static_cast<float>(tableMax - tableMin)));
+                for(int multiplier = idealMultiplier - 1; multiplier <= idealMultiplier + 1; ++multiplier) {
+                    if(multiplier < 1 || multiplier > 15)
+                        continue;
+                    const int idealBase = static_cast<int>(std::lround(
+                            center - static_cast<float>(multiplier * (tableMin + tableMax)) / 2.F));
+                    for(int base = idealBase - 1; base <= idealBase + 1; ++base) {
+                        if(base < 0 || base > 255)
+                            continue;
+                        std::uint64_t indices;
+                        const int error = fitEacBlock(block, base, multiplier, table, bestError, indices);
+                        if(error < bestError) {
+                            bestError = error;
+                            bestBits = static_cast<std::uint64_t>(base) << 56
+                                    | static_cast<std::uint64_t>(multiplier) << 52
+                                    | static_cast<std::uint64_t>(table) << 48 | indices;
+                        }
+                    }
+                }
+            }
+            return bestBits;
+        }
+
+        void decodeEacAlpha(std::uint64_t bits, Block& block) {
+            const int base = static_cast<int>(bits >> 56);
+            const int multiplier = static_cast<int>((bits >> 52) & 15);
+            const int table = static_cast<int>((bits >> 48) & 15);
+            for(int y = 0; y < 4; ++y) {
+                for(int x = 0; x < 4; ++x) {
+                    const auto index = static_cast<int>((bits >> (45 - 3 * (x * 4 + y))) & 7);
+                    block[y * 4 + x][3] = clampByte(base + eacModifiers[table][index] * multiplier);
+                }
+            }
+        }
+
+        ////////////////////////////////////// blocks //////////////////////////////////////
+
+        void encodeBlock(CompressedFormat format, const Block& block, std::uint8_t* out) {
+            switch(format) {
+                case CompressedFormat::BC1:
+                    encodeColorBlock(block, true, out);
+                    break;
+                case CompressedFormat::BC3:
+                    encodeAlphaBlock(block, out);
+                    encodeColorBlock(block, false, out + 8);
+                    break;
+                case CompressedFormat::BC7:
+                    encodeBc7Block(block, out);
+                    break;
+                case CompressedFormat::ETC2_RGB:
+                    writeBigEndian(encodeEtcColor(block), out);
+                    break;
+                case CompressedFormat::ETC2_RGBA:
+                    writeBigEndian(encodeEacAlpha(block), out);
+                    writeBigEndian(encodeEtcColor(block), out + 8);
+                    break;
+            }
+        }
+
+        bool decodeBlock(CompressedFormat format, const std::uint8_t* data, Block& block) {
+            switch(format) {
+                case CompressedFormat::BC1:
+                    decodeColorBlock(data, true, block);
+                    return true;
+                case CompressedFormat::BC3:
+                    decodeColorBlock(data + 8, false, block);
+                    decodeAlphaBlock(data, block);
+                    return true;
+                case CompressedFormat::BC7:
+                    return decodeBc7Block(data, block);
+                case CompressedFormat::ETC2_RGB:
+                    decodeEtcColor(readBigEndian(data), block);
+                    return true;
+                case CompressedFormat::ETC2_RGBA:
+                    decodeEtcColor(readBigEndian(data + 8), block);
+                    decodeEacAlpha(readBigEndian(data), block);
+                    return true;
+            }
+            return false;
+        }
+    }
+
+    std::size_t getBlockBytes(CompressedFormat format) {
+        switch(format) {
+            case CompressedFormat::BC1:
+            case CompressedFormat::ETC2_RGB:
+                return 8;
+            case CompressedFormat::BC3:
+            case CompressedFormat::BC7:
+            case CompressedFormat::ETC2_RGBA:
+                return 16;
+        }
+        return 0;
+    }
+
+    std::size_t getCompressedSize(CompressedFormat format, const vec2u& size) {
+        const std::size_t blocksX = (size.x + 3) / 4;
+        const std::size_t blocksY = (size.y + 3) / 4;
+        return blocksX * blocksY * getBlockBytes(format);
+    }
+
+    bool compressImage(const Image& image, CompressedFormat format, std::vector<std::uint8_t>& blocks) {
+        RB_PROFILE_FUNCTION();
+        const auto& size = image.getSize();
+        if(size.x == 0 || size.y == 0 || image.getBuffer().empty()) {
+            RB_CORE_ERROR("compressImage: image is empty");
+            return false;
+        }
+        if(!isValidFormat(format)) {
+            RB_CORE_ERROR("compressImage: unknown format {0}", static_cast<std::uint32_t>(format));
+            return false;
+        }
+
+        const auto blockBytes = getBlockBytes(format);
+        const unsigned int blocksX = (size.x + 3) / 4;
+        const unsigned int blocksY = (size.y + 3) / 4;
+        blocks.assign(getCompressedSize(format, size), 0);
+
+        JobSystem::getInstance().parallelFor(blocksY, minBlockRowsPerJob, [&](std::size_t firstRow, std::size_t lastRow) {
+            Block block;
+            for(auto blockY = firstRow; blockY < lastRow; ++blockY) {
+                for(unsigned int blockX = 0; blockX < blocksX; ++blockX) {
+                    fetchBlock(image, blockX, static_cast<unsigned int>(blockY), block);
+                    encodeBlock(format, block, blocks.data() + (blockY * blocksX + blockX) * blockBytes);
+                }
+            }
+        });
+
+        return true;
+    }
+
+    bool decompressImage(CompressedFormat format, const vec2u& size,
+                         const std::uint8_t* blocks, std::size_t bytes, Image& image) {
+        RB_PROFILE_FUNCTION();
+        if(!isValidFormat(format) || size.x == 0 || size.y == 0 || !blocks
+            || bytes < getCompressedSize(format, size)) {
+            RB_CORE_ERROR("decompressImage: blocks don't match size {0}x{1}", size.x, size.y);
+            return false;
+        }
+
+        const auto blockBytes = getBlockBytes(format);
+        const unsigned int blocksX = (size.x + 3) / 4;
+        const unsigned int blocksY = (size.y + 3) / 4;
+        PixelBuffer pixels(static_cast<std::size_t>(size.x) * size.y * 4);
+
+        Block block;
+        for(unsigned int blockY = 0; blockY < blocksY; ++blockY) {
+            for(unsigned int blockX = 0; blockX < blocksX; ++blockX) {
+                const auto* data = blocks + (static_cast<std::size_t>(blockY) * blocksX + blockX) * blockBytes;
+                if(!decodeBlock(format, data, block)) {
+                    RB_CORE_ERROR("decompressImage: unsupported block at {0}x{1}", blockX, blockY);
+                    return false;
+                }
+
+                for(unsigned int y = 0; y < 4 && blockY * 4 + y < size.y; ++y) {
+                    for(unsigned int x = 0; x < 4 && blockX * 4 + x < size.x; ++x) {
+                        auto* pixel = pixels.data() + ((static_cast<std::size_t>(blockY) * 4 + y) * size.x
+                                + blockX * 4 + x) * 4;
+                        for(int channel = 0; channel < 4; ++channel)
+                            pixel[channel] = static_cast<std::uint8_t>(block[y * 4 + x][channel]);
+                    }
+                }
+            }
+        }
+
+        return image.create(size, std::move(pixels), ImageColorFormat::RGBA);
+    }
+
+    bool CompressedImage::create(const Image& image, CompressedFormat format, bool mipmaps) {
+        m_levels.clear();
+        m_format = format;
+
+        const Image* source = &image;
+        Image mip, nextMip;
+        while(true) {
+            Level level;
+            level.size = source -> getSize();
+            if(!compressImage(*source, format, level.blocks)) {
+                m_levels.clear();
+                return false;
+            }
+            m_levels.emplace_back(std::move(level));
+
+            if(!mipmaps || !source -> downsample(nextMip))
+                break;
+            std::swap(mip, nextMip);
+            source = &mip;
+        }
+
+        return true;
+    }
+
+    bool CompressedImage::saveToMemory(std::vector<std::uint8_t>& data) const {
+        if(m_levels.empty())
+            return false;
+
+        std::size_t offset = headerBytes + m_levels.size() * levelEntryBytes;
+        data.assign(offset + getBytes(), 0);
+        auto* out = data.data();
+        const std::uint32_t header[] = {
+            containerMagic, containerVersion, static_cast<std::uint32_t>(m_format),
+            m_levels.front().size.x, m_levels.front().size.y, static_cast<std::uint32_t>(m_levels.size())
+        };
+        for(const auto value: header) {
+            writeLittleEndian(value, sizeof(value), out);
+            out += sizeof(value);
+        }
+
+        for(const auto& level: m_levels) {
+            writeLittleEndian(offset, sizeof(std::uint64_t), out);
+            writeLittleEndian(level.blocks.size(), sizeof(std::uint64_t), out + sizeof(std::uint64_t));
+            out += levelEntryBytes;
+            std::memcpy(data.data() + offset, level.blocks.data(), level.blocks.size());
+            offset += level.blocks.size();
+        }
+        return true;
+    }
+
+    bool CompressedImage::loadFromMemory(const void* data, std::size_t size) {
+        m_levels.clear();
+        const auto* bytes = static_cast<const std::uint8_t*>(data);
+        if(!bytes || size < headerBytes) {
+            RB_CORE_ERROR("CompressedImage: data is too small");
+            return false;
+        }
+
+        std::uint32_t header[headerBytes / sizeof(std::uint32_t)];
+        for(std::size_t i = 0; i < std::size(header); ++i)
+            header[i] = static_cast<std::uint32_t>(readLittleEndian(bytes + i * sizeof(std::uint32_t),
+                                                                    sizeof(std::uint32_t)));
+        const auto format = static_cast<CompressedFormat>(header[2]);
+        const vec2u fullSize{header[3], header[4]};
+        const auto levelsCount = header[5];
+        if(header[0] != containerMagic || header[1] != containerVersion) {
+            RB_CORE_ERROR("CompressedImage: unknown container");
+            return false;
+        }
+        if(!isValidFormat(format) || fullSize.x == 0 || fullSize.y == 0
+            || levelsCount == 0 || levelsCount > maxLevels
+            || size < headerBytes + levelsCount * levelEntryBytes) {
+            RB_CORE_ERROR("CompressedImage: broken header");
+            return false;
+        }
+
+        m_format = format;
+        for(std::uint32_t index = 0; index < levelsCount; ++index) {
+            const auto* entry = bytes + headerBytes + index * levelEntryBytes;
+            const auto offset = readLittleEndian(entry, sizeof(std::uint64_t));
+            const auto levelBytes = readLittleEndian(entry + sizeof(std::uint64_t), sizeof(std::uint64_t));
+            Level level;
+            level.size = levelSize(fullSize, index);
+            if(levelBytes != getCompressedSize(format, level.size) || offset > size || levelBytes > size - offset) {
+                RB_CORE_ERROR("CompressedImage: broken level {0}", index);
+                m_levels.clear();
+                return false;
+            }
+            level.blocks.assign(bytes + offset, bytes + offset + levelBytes);
+            m_levels.emplace_back(std::move(level));
+        }
+        return true;
+    }
+
+    bool CompressedImage::saveToFile(const std::string& path) const {
+        std::vector<std::uint8_t> data;
+        if(!saveToMemory(data))
+            return false;
+
+        std::ofstream file{path, std::ios::binary};
+        if(!file.is_open()) {
+            RB_CORE_ERROR("CompressedImage: can't open {0}", path);
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        return file.good();
+    }
+
+    bool CompressedImage::loadFromFile(const std::string& path) {
+        std::ifstream file{path, std::ios::binary};
+        if(!file.is_open()) {
+            RB_CORE_ERROR("CompressedImage: can't open {0}", path);
+            return false;
+        }
+        std::vector<std::uint8_t> data{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+        return loadFromMemory(data.data(), data.size());
+    }
+
+    bool CompressedImage::decompress(Image& image, unsigned int level) const {
+        if(level >= m_levels.size())
+            return false;
+        const auto& source = m_levels[level];
+        return decompressImage(m_format, source.size, source.blocks.data(), source.blocks.size(), image);
+    }
+
+    const vec2u& CompressedImage::getSize() const {
+        static const vec2u empty{};
+        return m_levels.empty() ? empty : m_levels.front().size;
+    }
+
+    std::size_t CompressedImage::getBytes() const {
+        std::size_t bytes = 0;
+        for(const auto& level: m_levels)
+            bytes += level.blocks.size();
+        return bytes;
+    }
+
+}
@@ -0,0 +1,285 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#include <cmath>
+#include <string>
+#include <utility>
+#include <algorithm>
+
+#include <robot2D/Graphics/TextureResidency.hpp>
+#include <robot2D/Graphics/Texture.hpp>
+#include <robot2D/Util/Logger.hpp>
+#include <robot2D/Util/Profiler.hpp>
+
+namespace robot2D {
+
+    namespace {
+        std::vector<Image> loadMipChain(const std::string& path) {
+            std::vector<Image> chain(1);
+            if(!chain.front().loadFromFile(path))
+                return {};
+            Image mip;
+            while(chain.back().downsample(mip))
+                chain.emplace_back(std::move(mip));
+            return chain;
+        }
+    }
+
+    TextureResidency& TextureResidency::getInstance() {
+        static TextureResidency instance;
+        return instance;
+    }
+
+    void TextureResidency::setVideoBudget(std::size_t bytes) {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_videoBudget = bytes;
+    }
+
+    void TextureResidency::setSystemBudget(std::size_t bytes) {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_systemBudget = bytes;
+    }
+
+    std::size_t TextureResidency::MipChain::getBytes(unsigned int fromMip) const {
+        std::size_t bytes = 0;
+        for(auto level = fromMip; level < length; ++level)
+            bytes += static_cast<std::size_t>(std::max(1U, size.x >> level))
+                    * std::max(1U, size.y >> level) * bytesPerPixel;
+        return bytes;
+    }
+
+    unsigned int TextureResidency::mipForExtent(float texels, float pixels) {
+        if(pixels <= 0.F)
+            return noRequest;
+        if(texels <= pixels)
+            return 0;
+        return static_cast<unsigned int>(std::log2(texels / pixels));
+    }
+
+    void TextureResidency::requestMip(const Texture& texture, unsigned int mip) {
+        if(texture.m_streamIndex < 0)
+            return;
+        auto& requested = m_streams[static_cast<std::size_t>(texture.m_streamIndex)].requestedMip;
+        auto current = requested.load(std::memory_order_relaxed);
+        while(mip < current && !requested.compare_exchange_weak(current, mip, std::memory_order_relaxed)) {}
+    }
+
+    void TextureResidency::add(Texture& texture) {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        int index;
+        if(!m_freeStreams.empty()) {
+            index = m_freeStreams.back();
+            m_freeStreams.pop_back();
+        }
+        else {
+            index = static_cast<int>(m_streams.size());
+            m_streams.emplace_back();
+        }
+
+        auto& stream = m_streams[static_cast<std::size_t>(index)];
+        stream.texture = &texture;
+        stream.requestedMip.store(noRequest, std::memory_order_relaxed);
+        stream.lastUse = m_frame;
+        stream.targetMip = 0;
+        texture.m_streamIndex = index;
+    }
+
+    void TextureResidency::remove(Texture& texture) {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        if(texture.m_streamIndex < 0)
+            return;
+        auto& stream = m_streams[static_cast<std::size_t>(texture.m_streamIndex)];
+        /// file being read keeps its own chain, result isn't needed anymore
+        stream.loading = {};
+        stream.loadedChain.reset();
+        stream.texture = nullptr;
+        m_freeStreams.emplace_back(texture.m_streamIndex);
+        texture.m_streamIndex = -1;
+    }
+
+    void TextureResidency::relocate(Texture& from, Texture& to) {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        if(from.m_streamIndex < 0)
+            return;
+        m_streams[static_cast<std::size_t>(from.m_streamIndex)].texture = &to;
+        to.m_streamIndex = std::exchange(from.m_streamIndex, -1);
+    }
+
+    unsigned int TextureResidency::getEvictedMip(const Texture& texture) {
+        const auto& size = texture.getSize();
+        unsigned int mip = 0;
+        while(mip + 1 < texture.getMipChainLength() && std::max(size.x >> mip, size.y >> mip) > minResidentSize)
+            ++mip;
+        return mip;
+    }
+
+    void TextureResidency::update() {
+        RB_PROFILE_FUNCTION();
+        std::lock_guard<std::mutex> lock{m_mutex};
+        if(m_streams.size() == m_freeStreams.size()) {
+            m_videoBytes = 0;
+            m_systemBytes = 0;
+            return;
+        }
+        ++m_frame;
+
+        std::vector<Stream*> streams;
+        for(auto& stream: m_streams) {
+            if(!stream.texture)
+                continue;
+            streams.emplace_back(&stream);
+            auto& texture = *stream.texture;
+
+            if(stream.loading && stream.loading.isDone()) {
+                auto chain = std::move(*stream.loadedChain);
+                stream.loading = {};
+                stream.loadedChain.reset();
+                if(chain.size() == texture.m_mips.size() && chain.front().getSize() == texture.getSize())
+                    texture.m_mips = std::move(chain);
+                else
+                    RB_CORE_WARN("TextureResidency: file {0} changed, its mips aren't streamed", texture.m_path);
+            }
+
+            const auto lastMip = texture.getMipChainLength() - 1;
+            const auto requested = stream.requestedMip.exchange(noRequest, std::memory_order_relaxed);
+            if(requested != noRequest) {
+                stream.lastUse = m_frame;
+                stream.targetMip = std::min(requested, lastMip);
+            }
+            else if(m_frame - stream.lastUse > framesBeforeEviction)
+                stream.targetMip = std::max(stream.targetMip, getEvictedMip(texture));
+        }
+
+        fitVideoBudget(streams);
+
+        unsigned int uploads = 0;
+        m_videoBytes = 0;
+        for(auto* stream: streams) {
+            auto& texture = *stream -> texture;
+            if(stream -> targetMip > texture.m_residentMip)
+                texture.makeResident(stream -> targetMip);
+            else if(stream -> targetMip < texture.m_residentMip) {
+                if(texture.hasMips(stream -> targetMip)) {
+                    if(uploads < maxUploadsPerFrame && texture.makeResident(stream -> targetMip))
+                        ++uploads;
+                }
+                else if(!texture.m_path.empty() && !stream -> loading) {
+                    auto chain = std::make_shared<std::vector<Image>>();
+                    stream -> loadedChain = chain;
+                    stream -> loading = JobSystem::getInstance().schedule([chain, path = texture.m_path]() {
+                        *chain = loadMipChain(path);
+                    }, {}, JobPriority::Background);
+                }
+            }
+            m_videoBytes += texture.getVideoBytes();
+        }
+
+        fitSystemBudget(streams);
+    }
+
+    void TextureResidency::fitBudget(std::vector<MipChain>& chains, std::size_t budget) {
+        std::size_t bytes = 0;
+        for(const auto& chain: chains)
+            bytes += chain.getBytes(chain.firstMip);
+        if(bytes <= budget)
+            return;
+
+        /// least recently used first, bigger first among equally used
+        std::vector<MipChain*> order;
+        for(auto& chain: chains)
+            order.emplace_back(&chain);
+        std::sort(order.begin(), order.end(), [](const MipChain* left, const MipChain* right) {
+            if(left -> lastUse != right -> lastUse)
+                return left -> lastUse < right -> lastUse;
+            return left -> getBytes(left -> firstMip) > right -> getBytes(right -> firstMip);
+        });
+
+        bool reduced = true;
+        while(bytes > budget && reduced) {
+            reduced = false;
+            for(auto* chain: order) {
+                if(chain -> firstMip + 1 >= chain -> length)
+                    continue;
+                bytes -= chain -> getBytes(chain -> firstMip) - chain -> getBytes(chain -> firstMip + 1);
+                ++chain -> firstMip;
+                reduced = true;
+                if(bytes <= budget)
+                    break;
+            }
+        }
+    }
+
+    void TextureResidency::fitVideoBudget(const std::vector<Stream*>& streams) {
+        std::vector<MipChain> chains;
+        chains.reserve(streams.size());
+        for(const auto* stream: streams) {
+            const auto& texture = *stream -> texture;
+            chains.push_back({texture.getSize(), static_cast<std::size_t>(texture.getColorFormat()),
+                              texture.getMipChainLength(), stream -> targetMip, stream -> lastUse});
+        }
+
+        fitBudget(chains, m_videoBudget);
+        for(std::size_t i = 0; i < streams.size(); ++i)
+            streams[i] -> targetMip = chains[i].firstMip;
+    }
+
+    void TextureResidency::fitSystemBudget(const std::vector<Stream*>& streams) {
+        m_systemBytes = 0;
+        for(const auto* stream: streams)
+            m_systemBytes += stream -> texture -> getSystemBytes();
+        if(m_systemBytes <= m_systemBudget)
+            return;
+
+        auto order = streams;
+        std::sort(order.begin(), order.end(), [](const Stream* left, const Stream* right) {
+            return left -> lastUse < right -> lastUse;
+        });
+
+        for(auto* stream: order) {
+            auto& texture = *stream -> texture;
+            if(texture.m_path.empty() || stream -> loading.valid())
+                continue;
+            /// finer mips than resident ones can be read from file again
+            m_systemBytes -= texture.getSystemBytes();
+            texture.releaseMips(texture.m_residentMip);
+            m_systemBytes += texture.getSystemBytes();
+            if(m_systemBytes <= m_systemBudget)
+                break;
+        }
+    }
+
+    std::size_t TextureResidency::getVideoBytes() const {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return m_videoBytes;
+    }
+
+    std::size_t TextureResidency::getSystemBytes() const {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return m_systemBytes;
+    }
+
+    std::size_t TextureResidency::getTexturesCount() const {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return m_streams.size() - m_freeStreams.size();
+    }
+
+}
@@ -0,0 +1,122 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#include <robot2D/Graphics/GL.hpp>
+#include <robot2D/Util/Profiler.hpp>
+#include "RenderThread.hpp"
+
+namespace robot2D::priv {
+
+    RenderThread::RenderThread(RenderWindow& window):
+        m_window{window} {}
+
+    RenderThread::~RenderThread() {
+        stop();
+    }
+
+    void RenderThread::start() {
+        if(m_running)
+            return;
+
+        m_window.setActive(false);
+        m_running = true;
+        m_thread = std::thread(&RenderThread::threadWork, this);
+    }
+
+    void RenderThread::stop() {
+        if(!m_thread.joinable())
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            m_running = false;
+        }
+        m_condition.notify_all();
+        m_thread.join();
+
+        m_window.setActive(true);
+    }
+
+    FramePacket& RenderThread::beginFrame() {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_condition.wait(lock, [this]() {
+            return m_renderingIndex != m_writeIndex && m_pendingIndex != m_writeIndex;
+        });
+
+        auto& packet = m_packets[m_writeIndex];
+        packet.reset();
+        return packet;
+    }
+
+    void RenderThread::endFrame() {
+        {
+            std::unique_lock<std::mutex> lock{m_mutex};
+            m_condition.wait(lock, [this]() { return m_pendingIndex == noPacket; });
+            m_pendingIndex = m_writeIndex;
+            m_writeIndex = 1 - m_writeIndex;
+        }
+        m_condition.notify_all();
+    }
+
+    void RenderThread::threadWork() {
+        RB_PROFILE_THREAD("Render");
+        m_window.setActive(true);
+
+        while(true) {
+            {
+                std::unique_lock<std::mutex> lock{m_mutex};
+                m_condition.wait(lock, [this]() { return m_pendingIndex != noPacket || !m_running; });
+                if(m_pendingIndex == noPacket)
+                    break;
+                m_renderingIndex = m_pendingIndex;
+                m_pendingIndex = noPacket;
+            }
+            m_condition.notify_all();
+
+            renderPacket(m_packets[m_renderingIndex]);
+
+            {
+                std::lock_guard<std::mutex> lock{m_mutex};
+                m_renderingIndex = noPacket;
+            }
+            m_condition.notify_all();
+        }
+
+        m_window.setActive(false);
+    }
+
+    void RenderThread::renderPacket(const FramePacket& packet) {
+        RB_PROFILE_SCOPE("RenderThread::renderPacket");
+        /// resize callback runs on main thread without context, so viewport follows packet here
+        if(packet.framebufferSize != m_viewportSize && packet.framebufferSize.x > 0 && packet.framebufferSize.y > 0) {
+            m_viewportSize = packet.framebufferSize;
+            glCall(glViewport, 0, 0, static_cast<GLsizei>(m_viewportSize.x), static_cast<GLsizei>(m_viewportSize.y));
+        }
+        m_window.clear(packet.clearColor);
+        m_window.beforeRender();
+        for(const auto& [layerID, view]: packet.views)
+            m_window.setView(view, layerID);
+        m_window.submit({&packet.commands});
+        m_window.afterRender();
+        m_window.swapBuffers();
+    }
+
+}
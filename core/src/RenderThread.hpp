@@ -0,0 +1,79 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#pragma once
+
+#include <array>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include <robot2D/Graphics/RenderWindow.hpp>
+#include <robot2D/Graphics/FramePacket.hpp>
+
+namespace robot2D::priv {
+
+    /**
+     * \brief Owns render context in pipelined mode and draws FramePackets one frame behind simulation.
+     * \details Two packets are used: one is rendered while simulation fills other one.
+     * Simulation waits only when it's going to overtake render thread by more than one frame.
+     */
+    class RenderThread {
+    public:
+        explicit RenderThread(RenderWindow& window);
+        RenderThread(const RenderThread& other) = delete;
+        RenderThread& operator=(const RenderThread& other) = delete;
+        RenderThread(RenderThread&& other) = delete;
+        RenderThread& operator=(RenderThread&& other) = delete;
+        ~RenderThread();
+
+        /// Releases render context on calling thread and starts rendering.
+        void start();
+
+        /// Renders packet in flight, then gives render context back to calling thread.
+        void stop();
+
+        /// Returns free packet to fill, blocks while render thread still reads it.
+        FramePacket& beginFrame();
+
+        /// Hands filled packet over to render thread.
+        void endFrame();
+    private:
+        void threadWork();
+        void renderPacket(const FramePacket& packet);
+    private:
+        static constexpr int noPacket = -1;
+
+        RenderWindow& m_window;
+        std::array<FramePacket, 2> m_packets;
+        std::thread m_thread;
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+
+        /// Viewport applied on render thread, zero until first packet.
+        vec2u m_viewportSize{};
+        int m_writeIndex{0};
+        int m_pendingIndex{noPacket};
+        int m_renderingIndex{noPacket};
+        bool m_running{false};
+    };
+
+}
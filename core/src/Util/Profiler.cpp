@@ -0,0 +1,226 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <robot2D/Util/Profiler.hpp>
+#include <robot2D/Util/Logger.hpp>
+
+namespace robot2D {
+
+    namespace {
+        struct ProfileEvent {
+            const char* name;
+            std::uint64_t start;
+            std::uint64_t end;
+        };
+
+        struct ThreadBuffer {
+            explicit ThreadBuffer(std::uint32_t threadID):
+                events(Profiler::threadBufferSize),
+                id{threadID} {}
+
+            std::vector<ProfileEvent> events;
+            std::atomic<std::uint64_t> written{0};
+            /// Set while owner thread is inside record, export waits until it drops.
+            std::atomic<bool> inFlight{false};
+            std::uint32_t id;
+            std::string name;
+        };
+
+        struct ProfilerRegistry {
+            std::mutex mutex;
+            std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+            std::atomic<bool> capturing{false};
+            std::atomic<std::uint64_t> captureStart{0};
+            std::atomic<std::uint64_t> captureEnd{0};
+            std::atomic<unsigned int> framesLeft{0};
+            std::string capturePath;
+        };
+
+        ProfilerRegistry& getRegistry() {
+            static ProfilerRegistry registry;
+            return registry;
+        }
+
+        std::shared_ptr<ThreadBuffer> registerThread() {
+            auto& registry = getRegistry();
+            std::lock_guard<std::mutex> lock{registry.mutex};
+            auto buffer = std::make_shared<ThreadBuffer>(static_cast<std::uint32_t>(registry.buffers.size()));
+            registry.buffers.emplace_back(buffer);
+            return buffer;
+        }
+
+        /// Registry shares ownership, so events of finished threads still can be exported.
+        ThreadBuffer& getThreadBuffer() {
+            thread_local std::shared_ptr<ThreadBuffer> buffer = registerThread();
+            return *buffer;
+        }
+
+        void writeEscaped(std::ofstream& file, const std::string& value) {
+            for(const char symbol: value) {
+                if(symbol == '"' || symbol == '\\')
+                    file << '\\';
+                file << symbol;
+            }
+        }
+    }
+
+    void Profiler::beginCapture() {
+        auto& registry = getRegistry();
+        registry.captureStart.store(now(), std::memory_order_relaxed);
+        registry.captureEnd.store(0, std::memory_order_relaxed);
+        registry.capturing.store(true, std::memory_order_release);
+    }
+
+    void Profiler::endCapture() {
+        auto& registry = getRegistry();
+        if(registry.capturing.exchange(false))
+            registry.captureEnd.store(now(), std::memory_order_relaxed);
+        /// writer which saw capture on finishes its event before buffers are read
+        std::lock_guard<std::mutex> lock{registry.mutex};
+        for(const auto& buffer: registry.buffers) {
+            while(buffer -> inFlight.load())
+                std::this_thread::yield();
+        }
+    }
+
+    bool Profiler::isCapturing() {
+        return getRegistry().capturing.load(std::memory_order_relaxed);
+    }
+
+    void Profiler::captureFrames(unsigned int frames, const std::string& path) {
+        if(frames == 0)
+            return;
+        auto& registry = getRegistry();
+        {
+            std::lock_guard<std::mutex> lock{registry.mutex};
+            registry.capturePath = path;
+        }
+        registry.framesLeft.store(frames, std::memory_order_relaxed);
+        beginCapture();
+    }
+
+    void Profiler::frameEnd() {
+        auto& registry = getRegistry();
+        if(registry.framesLeft.load(std::memory_order_relaxed) == 0)
+            return;
+        if(registry.framesLeft.fetch_sub(1, std::memory_order_relaxed) != 1)
+            return;
+
+        endCapture();
+        std::string path;
+        {
+            std::lock_guard<std::mutex> lock{registry.mutex};
+            path = registry.capturePath;
+        }
+        if(writeChromeTrace(path))
+            RB_CORE_INFO("Profiler: trace written to {0}", path);
+    }
+
+    void Profiler::setThreadName(const std::string& name) {
+        auto& buffer = getThreadBuffer();
+        std::lock_guard<std::mutex> lock{getRegistry().mutex};
+        buffer.name = name;
+    }
+
+    std::uint64_t Profiler::now() {
+        using namespace std::chrono;
+        return static_cast<std::uint64_t>(
+                duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+    }
+
+    void Profiler::record(const char* name, std::uint64_t start, std::uint64_t end) {
+        if(!isCapturing())
+            return;
+        auto& buffer = getThreadBuffer();
+        /// flag is raised before capture is checked again, so endCapture either sees it or we see capture off
+        buffer.inFlight.store(true);
+        if(getRegistry().capturing.load()) {
+            const auto index = buffer.written.load(std::memory_order_relaxed);
+            buffer.events[index % threadBufferSize] = {name, start, end};
+            buffer.written.store(index + 1, std::memory_order_release);
+        }
+        buffer.inFlight.store(false, std::memory_order_release);
+    }
+
+    bool Profiler::writeChromeTrace(const std::string& path) {
+        endCapture();
+        std::ofstream file{path};
+        if(!file.is_open()) {
+            RB_CORE_ERROR("Profiler: can't open {0} to write trace", path);
+            return false;
+        }
+
+        auto& registry = getRegistry();
+        const auto captureStart = registry.captureStart.load(std::memory_order_relaxed);
+        auto captureEnd = registry.captureEnd.load(std::memory_order_relaxed);
+        if(captureEnd == 0)
+            captureEnd = now();
+
+        std::lock_guard<std::mutex> lock{registry.mutex};
+        file << "{\"traceEvents\":[";
+        bool first = true;
+        auto separate = [&file, &first]() {
+            if(!first)
+                file << ",\n";
+            first = false;
+        };
+
+        file.setf(std::ios::fixed);
+        file.precision(3);
+        for(const auto& buffer: registry.buffers) {
+            if(!buffer -> name.empty()) {
+                separate();
+                file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer -> id
+                     << ",\"args\":{\"name\":\"";
+                writeEscaped(file, buffer -> name);
+                file << "\"}}";
+            }
+
+            const auto written = buffer -> written.load(std::memory_order_acquire);
+            const auto count = std::min<std::uint64_t>(written, threadBufferSize);
+            for(auto index = written - count; index < written; ++index) {
+                const auto& event = buffer -> events[index % threadBufferSize];
+                if(event.start < captureStart || event.end > captureEnd)
+                    continue;
+                separate();
+                file << "{\"name\":\"";
+                writeEscaped(file, event.name);
+                file << "\",\"cat\":\"robot2D\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer -> id
+                     << ",\"ts\":" << static_cast<double>(event.start - captureStart) / 1000.0
+                     << ",\"dur\":" << static_cast<double>(event.end - event.start) / 1000.0 << "}";
+            }
+        }
+        file << "],\"displayTimeUnit\":\"ms\"}\n";
+
+        return file.good();
+    }
+
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <robot2D/Core/AssetPack.hpp>
+
+namespace {
+    std::string tempPath(const char* name) {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+
+    std::vector<std::uint8_t> makeText(std::size_t size) {
+        const char* words = "robot2D scene entity transform sprite ";
+        const auto length = std::strlen(words);
+        std::vector<std::uint8_t> text(size);
+        for(std::size_t i = 0; i < size; ++i)
+            text[i] = static_cast<std::uint8_t>(words[(i * 7 + i / length) % length]);
+        return text;
+    }
+}
+
+TEST(Core, AssetPackRoundTrip) {
+    const auto path = tempPath("robot2D-test.pack");
+    const auto text = makeText(100000);
+    std::vector<std::uint8_t> binary(4097);
+    for(std::size_t i = 0; i < binary.size(); ++i)
+        binary[i] = static_cast<std::uint8_t>((i * 2654435761U) >> 13);
+
+    {
+        robot2D::AssetPackWriter writer;
+        writer.addData("scenes/Main.scene", std::vector<std::uint8_t>{text}, robot2D::AssetCompression::LZ4);
+        writer.addData("textures/noise.png", std::vector<std::uint8_t>{binary});
+        writer.addData("empty.txt", {}, robot2D::AssetCompression::LZ4);
+        ASSERT_TRUE(writer.saveToFile(path));
+    }
+    EXPECT_LT(std::filesystem::file_size(path), text.size());
+
+    robot2D::AssetPack pack;
+    ASSERT_TRUE(pack.openFromFile(path));
+    EXPECT_TRUE(pack.hasAsset("textures/noise.png"));
+    EXPECT_FALSE(pack.hasAsset("textures/missing.png"));
+    EXPECT_EQ(pack.getAssetNames().size(), 3);
+
+    auto scene = pack.getAsset("scenes/Main.scene");
+    ASSERT_TRUE(scene);
+    ASSERT_EQ(scene.size, text.size());
+    EXPECT_EQ(std::memcmp(scene.data, text.data(), text.size()), 0);
+    EXPECT_EQ(pack.getAsset("scenes/Main.scene").data, scene.data);
+
+    auto texture = pack.getAsset("textures/noise.png");
+    ASSERT_TRUE(texture);
+    ASSERT_EQ(texture.size, binary.size());
+    EXPECT_EQ(std::memcmp(texture.data, binary.data(), binary.size()), 0);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(texture.data) % robot2D::AssetPack::blobAlignment, 0);
+
+    auto empty = pack.getAsset("empty.txt");
+    EXPECT_TRUE(empty);
+    EXPECT_EQ(empty.size, 0);
+
+    robot2D::MemoryInputStream stream;
+    ASSERT_TRUE(pack.openStream("textures/noise.png", stream));
+    EXPECT_EQ(stream.getSize(), binary.size());
+    std::uint8_t bytes[4];
+    EXPECT_EQ(stream.seek(4095), 4095);
+    EXPECT_EQ(stream.read(bytes, sizeof(bytes)), 2);
+    EXPECT_EQ(bytes[1], binary[4096]);
+
+    pack.close();
+    std::remove(path.c_str());
+}
+
+TEST(Core, AssetPackRejectsCorruptedFile) {
+    const auto path = tempPath("robot2D-corrupted.pack");
+    {
+        robot2D::AssetPackWriter writer;
+        writer.addData("a.txt", makeText(1000), robot2D::AssetCompression::LZ4);
+        ASSERT_TRUE(writer.saveToFile(path));
+    }
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 3);
+
+    robot2D::AssetPack pack;
+    EXPECT_FALSE(pack.openFromFile(path));
+    EXPECT_FALSE(pack.isOpen());
+    std::remove(path.c_str());
+}
@@ -0,0 +1,36 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
+
+#include <robot2D/Core/Hash.hpp>
+
+namespace {
+    std::uint64_t hashText(const char* text, std::uint64_t seed = 0) {
+        return robot2D::xxHash64(text, std::strlen(text), seed);
+    }
+}
+
+TEST(Core, XXHash64ReferenceValues) {
+    EXPECT_EQ(robot2D::xxHash64(nullptr, 0), 0xEF46DB3751D8E999ULL);
+    EXPECT_EQ(hashText(""), 0xEF46DB3751D8E999ULL);
+    EXPECT_EQ(hashText("abc"), 0x44BC2CF5AD770999ULL);
+    EXPECT_EQ(hashText("xxhash"), 0x32DD38952C4BC720ULL);
+    EXPECT_EQ(hashText("xxhash", 20141025), 0xB559B98D844E0635ULL);
+    /// longer than one 32 bytes stripe
+    EXPECT_EQ(hashText("Nobody inspects the spammish repetition"), 0xFBCEA83C8A378BF1ULL);
+}
+
+TEST(Core, XXHash64TailAndSeedChangeHash) {
+    std::vector<std::uint8_t> data(1000);
+    for(std::size_t i = 0; i < data.size(); ++i)
+        data[i] = static_cast<std::uint8_t>((i * 2654435761U) >> 11);
+
+    const auto hash = robot2D::xxHash64(data.data(), data.size());
+    EXPECT_EQ(hash, robot2D::xxHash64(data.data(), data.size()));
+    EXPECT_NE(hash, robot2D::xxHash64(data.data(), data.size(), 1));
+    for(std::size_t size = 990; size < data.size(); ++size)
+        EXPECT_NE(hash, robot2D::xxHash64(data.data(), size));
+
+    data[500] ^= 1;
+    EXPECT_NE(hash, robot2D::xxHash64(data.data(), data.size()));
+}
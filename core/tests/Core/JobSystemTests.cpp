@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <robot2D/Core/JobSystem.hpp>
+
+TEST(Core, JobSystemRunsAllJobs) {
+    robot2D::JobSystem jobSystem{4};
+    std::atomic<int> counter{0};
+    std::vector<robot2D::JobHandle> handles;
+    for(int i = 0; i < 10000; ++i)
+        handles.emplace_back(jobSystem.schedule([&counter]() { counter.fetch_add(1); }));
+
+    for(const auto& handle: handles)
+        jobSystem.wait(handle);
+    EXPECT_EQ(counter.load(), 10000);
+}
+
+TEST(Core, JobSystemRespectsDependencies) {
+    robot2D::JobSystem jobSystem{3};
+    std::atomic<int> finishedParents{0};
+    int seenByChild = -1;
+
+    std::vector<robot2D::JobHandle> parents;
+    for(int i = 0; i < 8; ++i) {
+        parents.emplace_back(jobSystem.schedule([&finishedParents]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            finishedParents.fetch_add(1);
+        }));
+    }
+    auto child = jobSystem.schedule([&]() { seenByChild = finishedParents.load(); }, parents);
+    auto continuation = jobSystem.then(child, [&seenByChild]() { seenByChild *= 2; });
+
+    jobSystem.wait(continuation);
+    EXPECT_EQ(seenByChild, 16);
+}
+
+TEST(Core, JobSystemCompletionsRunOnDrainingThread) {
+    robot2D::JobSystem jobSystem{2};
+    const auto mainThread = std::this_thread::get_id();
+    std::atomic<int> completed{0};
+    bool onMainThread = true;
+
+    for(int i = 0; i < 16; ++i) {
+        jobSystem.schedule([]() {}, [&]() {
+            onMainThread = onMainThread && std::this_thread::get_id() == mainThread;
+            ++completed;
+        });
+    }
+
+    while(jobSystem.hasPendingJobs())
+        jobSystem.drainCompleted(robot2D::Time{1000});
+    EXPECT_EQ(completed.load(), 16);
+    EXPECT_TRUE(onMainThread);
+}
+
+TEST(Core, JobSystemWaitInsideJob) {
+    robot2D::JobSystem jobSystem{1};
+    std::atomic<int> counter{0};
+    auto outer = jobSystem.schedule([&]() {
+        auto inner = jobSystem.schedule([&counter]() { counter.fetch_add(1); });
+        jobSystem.wait(inner);
+        counter.fetch_add(1);
+    });
+    jobSystem.wait(outer);
+    EXPECT_EQ(counter.load(), 2);
+}
+
+TEST(Core, JobSystemDrainsInteractiveCompletionsFirst) {
+    robot2D::JobSystem jobSystem{2};
+    std::vector<robot2D::JobPriority> drained;
+    std::vector<robot2D::JobHandle> handles;
+
+    for(int i = 0; i < 8; ++i) {
+        handles.emplace_back(jobSystem.schedule([]() {}, [&drained]() {
+            drained.emplace_back(robot2D::JobPriority::Background);
+        }, robot2D::JobPriority::Background));
+    }
+    handles.emplace_back(jobSystem.schedule([]() {}, [&drained]() {
+        drained.emplace_back(robot2D::JobPriority::Interactive);
+    }, robot2D::JobPriority::Interactive));
+
+    for(const auto& handle: handles)
+        jobSystem.wait(handle);
+    jobSystem.drainCompleted(robot2D::Time{1000000});
+
+    ASSERT_EQ(drained.size(), 9U);
+    EXPECT_EQ(drained.front(), robot2D::JobPriority::Interactive);
+    EXPECT_FALSE(jobSystem.hasPendingJobs());
+}
+
+TEST(Core, JobSystemRunsJobsScheduledWhileStopping) {
+    robot2D::JobSystem jobSystem{2};
+    std::atomic<int> counter{0};
+    std::atomic<bool> started{false};
+    constexpr int jobsCount = 2000;
+
+    std::thread producer([&]() {
+        started.store(true);
+        for(int i = 0; i < jobsCount; ++i)
+            jobSystem.schedule([&counter]() { counter.fetch_add(1); });
+    });
+    while(!started.load())
+        std::this_thread::yield();
+    jobSystem.stop();
+    producer.join();
+
+    EXPECT_EQ(counter.load(), jobsCount);
+    EXPECT_FALSE(jobSystem.hasPendingJobs());
+}
+
+TEST(Core, JobSystemParallelForCoversRangeOnce) {
+    robot2D::JobSystem jobSystem{3};
+    std::vector<std::atomic<int>> visits(10007);
+    std::atomic<int> chunks{0};
+
+    jobSystem.parallelFor(visits.size(), 100, [&](std::size_t begin, std::size_t end) {
+        for(auto i = begin; i < end; ++i)
+            visits[i].fetch_add(1);
+        chunks.fetch_add(1);
+    });
+
+    for(const auto& visit: visits)
+        EXPECT_EQ(visit.load(), 1);
+    /// three workers and calling thread
+    EXPECT_LE(chunks.load(), 4);
+
+    int calls = 0;
+    jobSystem.parallelFor(0, 1, [&calls](std::size_t, std::size_t) { ++calls; });
+    EXPECT_EQ(calls, 0);
+    jobSystem.parallelFor(50, 100, [&calls](std::size_t, std::size_t) { ++calls; });
+    EXPECT_EQ(calls, 1);
+}
+
+TEST(Core, JobSystemMainThreadParallelForSkipsBackgroundJobs) {
+    robot2D::JobSystem jobSystem{1};
+    const auto mainThread = std::this_thread::get_id();
+    std::atomic<bool> backgroundOnMain{false};
+    std::atomic<bool> backgroundRan{false};
+    robot2D::JobHandle background;
+
+    jobSystem.parallelFor(2, 1, [&](std::size_t begin, std::size_t) {
+        if(begin == 0) {
+            /// lets worker take second chunk, so main thread waits with background job queued
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            return;
+        }
+        background = jobSystem.schedule([&]() {
+            backgroundOnMain = std::this_thread::get_id() == mainThread;
+            backgroundRan = true;
+        }, {}, robot2D::JobPriority::Background);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    });
+
+    /// wait would run still queued job on main thread, worker has to take it
+    while(!background.isDone())
+        std::this_thread::yield();
+    EXPECT_TRUE(backgroundRan.load());
+    EXPECT_FALSE(backgroundOnMain.load());
+}
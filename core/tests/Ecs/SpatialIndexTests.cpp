@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <algorithm>
+
+#include <robot2D/Ecs/Scene.hpp>
+#include <robot2D/Ecs/SpatialIndex.hpp>
+
+namespace {
+    class SpatialIndexTest : public ::testing::Test {
+    protected:
+        void SetUp() override {
+            scene = std::make_unique<robot2D::ecs::Scene>(messageBus);
+        }
+
+        robot2D::MessageBus messageBus{};
+        std::unique_ptr<robot2D::ecs::Scene> scene;
+        robot2D::ecs::SpatialIndex spatialIndex{};
+    };
+
+    std::vector<robot2D::ecs::EntityID> toIndices(const std::vector<robot2D::ecs::Entity>& entities) {
+        std::vector<robot2D::ecs::EntityID> indices;
+        for(const auto& entity: entities)
+            indices.push_back(entity.getIndex());
+        std::sort(indices.begin(), indices.end());
+        return indices;
+    }
+}
+
+TEST_F(SpatialIndexTest, QueryMatchesBruteForce) {
+    std::mt19937 generator{42};
+    std::uniform_real_distribution<float> position{0.F, 1000.F};
+    std::uniform_real_distribution<float> size{1.F, 50.F};
+    std::uniform_real_distribution<float> offset{-20.F, 20.F};
+
+    std::vector<robot2D::ecs::Entity> entities;
+    std::vector<robot2D::FloatRect> rects;
+    std::vector<robot2D::ecs::SpatialIndex::ProxyID> proxies;
+    for(int i = 0; i < 1000; ++i) {
+        entities.emplace_back(scene -> createEntity());
+        rects.emplace_back(position(generator), position(generator), size(generator), size(generator));
+        proxies.emplace_back(spatialIndex.createProxy(rects.back(), entities.back()));
+    }
+
+    for(std::size_t i = 0; i < rects.size(); i += 2) {
+        rects[i].lx += offset(generator);
+        rects[i].ly += offset(generator);
+        spatialIndex.moveProxy(proxies[i], rects[i]);
+    }
+
+    spatialIndex.destroyProxy(proxies[1]);
+    EXPECT_EQ(spatialIndex.getProxyCount(), 999);
+
+    for(int q = 0; q < 50; ++q) {
+        robot2D::FloatRect area{position(generator), position(generator), 100.F, 100.F};
+
+        std::vector<robot2D::ecs::Entity> expected;
+        for(std::size_t i = 0; i < rects.size(); ++i) {
+            if(i == 1)
+                continue;
+            const auto& rect = rects[i];
+            if(rect.lx <= area.lx + area.width && area.lx <= rect.lx + rect.width
+               && rect.ly <= area.ly + area.height && area.ly <= rect.ly + rect.height)
+                expected.push_back(entities[i]);
+        }
+
+        std::vector<robot2D::ecs::Entity> found;
+        spatialIndex.query(area, found);
+        EXPECT_EQ(toIndices(found), toIndices(expected));
+    }
+}
+
+TEST_F(SpatialIndexTest, PointQuery) {
+    auto first = scene -> createEntity();
+    auto second = scene -> createEntity();
+    spatialIndex.createProxy({0.F, 0.F, 10.F, 10.F}, first);
+    spatialIndex.createProxy({5.F, 5.F, 10.F, 10.F}, second);
+
+    std::vector<robot2D::ecs::Entity> found;
+    spatialIndex.query(robot2D::vec2f{2.F, 2.F}, found);
+    ASSERT_EQ(found.size(), 1);
+    EXPECT_EQ(found[0], first);
+
+    found.clear();
+    spatialIndex.query(robot2D::vec2f{7.F, 7.F}, found);
+    EXPECT_EQ(found.size(), 2);
+}
+
+TEST_F(SpatialIndexTest, RayCastSortedByDistance) {
+    auto nearEntity = scene -> createEntity();
+    auto farEntity = scene -> createEntity();
+    auto missEntity = scene -> createEntity();
+    spatialIndex.createProxy({50.F, -5.F, 10.F, 10.F}, farEntity);
+    spatialIndex.createProxy({10.F, -5.F, 10.F, 10.F}, nearEntity);
+    spatialIndex.createProxy({10.F, 50.F, 10.F, 10.F}, missEntity);
+
+    std::vector<robot2D::ecs::SpatialIndex::RayHit> hits;
+    spatialIndex.rayCast({0.F, 0.F}, {100.F, 0.F}, hits);
+    ASSERT_EQ(hits.size(), 2);
+    EXPECT_EQ(hits[0].entity, nearEntity);
+    EXPECT_FLOAT_EQ(hits[0].fraction, 0.1F);
+    EXPECT_EQ(hits[1].entity, farEntity);
+}
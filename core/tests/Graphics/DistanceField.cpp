@@ -0,0 +1,34 @@
+#include <vector>
+#include <gtest/gtest.h>
+#include <robot2D/Graphics/DistanceField.hpp>
+
+TEST(Graphics, DistanceFieldIsPadded) {
+    std::vector<std::uint8_t> coverage(4 * 3, 255);
+    std::vector<std::uint8_t> field;
+    robot2D::generateDistanceField(coverage.data(), {4, 3}, 2, field);
+    EXPECT_EQ(field.size(), 8u * 7u);
+}
+
+TEST(Graphics, DistanceFieldSignAroundEdge) {
+    constexpr int size = 16;
+    std::vector<std::uint8_t> coverage(size * size, 0);
+    for(int y = 4; y < 12; ++y)
+        for(int x = 4; x < 12; ++x)
+            coverage[y * size + x] = 255;
+
+    constexpr int spread = 4;
+    constexpr int width = size + 2 * spread;
+    std::vector<std::uint8_t> field;
+    robot2D::generateDistanceField(coverage.data(), {size, size}, spread, field);
+
+    auto at = [&field](int x, int y) { return field[(y + spread) * width + x + spread]; };
+    EXPECT_GT(at(8, 8), 128);
+    EXPECT_LT(at(0, 0), 128);
+    /// first pixel inside and last pixel outside lie around edge
+    EXPECT_NEAR(at(4, 8), 128 + 127 / (2 * spread), 2);
+    EXPECT_NEAR(at(3, 8), 128 - 127 / (2 * spread), 2);
+    /// distance grows away from edge
+    EXPECT_GT(at(5, 8), at(4, 8));
+    EXPECT_LT(at(2, 8), at(3, 8));
+    EXPECT_EQ(field[0], 0);
+}
@@ -0,0 +1,94 @@
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <robot2D/Graphics/Image.hpp>
+
+TEST(Graphics, ImageDownsampleAveragesQuads) {
+    const std::vector<std::uint8_t> pixels = {
+        0, 100,  10, 10,
+        200, 100, 30, 30,
+    };
+    robot2D::Image image;
+    ASSERT_TRUE(image.create({4, 2}, pixels.data(), robot2D::ImageColorFormat::RED));
+
+    robot2D::Image mip;
+    ASSERT_TRUE(image.downsample(mip));
+    EXPECT_EQ(mip.getSize(), robot2D::vec2u(2, 1));
+    EXPECT_EQ(mip.getColorFormat(), robot2D::ImageColorFormat::RED);
+    EXPECT_EQ(mip.getBuffer()[0], 100);
+    EXPECT_EQ(mip.getBuffer()[1], 20);
+}
+
+TEST(Graphics, ImageDownsampleBuildsChain) {
+    std::vector<std::uint8_t> pixels(5 * 3 * 4, 255);
+    robot2D::Image image;
+    ASSERT_TRUE(image.create({5, 3}, pixels.data(), robot2D::ImageColorFormat::RGBA));
+
+    std::vector<robot2D::Image> chain(1, image);
+    robot2D::Image mip;
+    while(chain.back().downsample(mip))
+        chain.emplace_back(std::move(mip));
+
+    ASSERT_EQ(chain.size(), 3);
+    EXPECT_EQ(chain[1].getSize(), robot2D::vec2u(2, 1));
+    EXPECT_EQ(chain[2].getSize(), robot2D::vec2u(1, 1));
+    EXPECT_EQ(chain[2].getBuffer()[3], 255);
+}
+
+TEST(Graphics, ImageTakesBufferWithoutCopy) {
+    robot2D::PixelBuffer pixels(4 * 2 * 3, 7);
+    const auto* data = pixels.data();
+
+    robot2D::Image image;
+    ASSERT_TRUE(image.create({4, 2}, std::move(pixels), robot2D::ImageColorFormat::RGB));
+    EXPECT_EQ(image.getBuffer(), data);
+
+    robot2D::Image moved{std::move(image)};
+    EXPECT_EQ(moved.getBuffer(), data);
+    EXPECT_EQ(moved.getSize(), robot2D::vec2u(4, 2));
+    EXPECT_EQ(image.getBuffer(), nullptr);
+    EXPECT_EQ(image.getSize(), robot2D::vec2u(0, 0));
+
+    robot2D::PixelBuffer wrongSize(5, 0);
+    EXPECT_FALSE(image.create({4, 2}, std::move(wrongSize), robot2D::ImageColorFormat::RGB));
+}
+
+TEST(Graphics, ImageBoxDownsampleAveragesBlocks) {
+    const robot2D::vec2u size{301, 157};
+    const unsigned int factor = 7;
+    std::vector<std::uint8_t> pixels(size.x * size.y * 4);
+    for(std::size_t i = 0; i < pixels.size(); ++i)
+        pixels[i] = static_cast<std::uint8_t>((i * 2654435761U) >> 13);
+    robot2D::Image image;
+    ASSERT_TRUE(image.create(size, pixels.data(), robot2D::ImageColorFormat::RGBA));
+
+    robot2D::Image thumbnail;
+    ASSERT_TRUE(image.downsample(factor, thumbnail));
+    ASSERT_EQ(thumbnail.getSize(), robot2D::vec2u(43, 23));
+
+    const auto& result = static_cast<const robot2D::Image&>(thumbnail).getBuffer();
+    for(unsigned int y = 0; y < 23; ++y) {
+        for(unsigned int x = 0; x < 43; ++x) {
+            for(unsigned int channel = 0; channel < 4; ++channel) {
+                unsigned int sum = 0, count = 0;
+                for(unsigned int sy = y * factor; sy < std::min(size.y, (y + 1) * factor); ++sy)
+                    for(unsigned int sx = x * factor; sx < std::min(size.x, (x + 1) * factor); ++sx, ++count)
+                        sum += pixels[(sy * size.x + sx) * 4 + channel];
+                ASSERT_EQ(result[(y * 43 + x) * 4 + channel], (sum + count / 2) / count) << x << " " << y;
+            }
+        }
+    }
+
+    robot2D::Image half, boxHalf;
+    ASSERT_TRUE(image.downsample(half));
+    ASSERT_TRUE(image.downsample(2, boxHalf));
+    EXPECT_FALSE(image.downsample(1, boxHalf));
+    EXPECT_FALSE(image.downsample(robot2D::Image::maxDownsampleFactor + 1, boxHalf));
+    /// odd sizes differ only at last row and column, which 2x2 filter repeats
+    const auto& halfBuffer = static_cast<const robot2D::Image&>(half).getBuffer();
+    const auto& boxBuffer = static_cast<const robot2D::Image&>(boxHalf).getBuffer();
+    for(unsigned int y = 0; y < half.getSize().y; ++y)
+        for(unsigned int i = 0; i < half.getSize().x * 4; ++i)
+            EXPECT_EQ(halfBuffer[y * half.getSize().x * 4 + i], boxBuffer[y * boxHalf.getSize().x * 4 + i]);
+}
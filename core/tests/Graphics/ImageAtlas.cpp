@@ -0,0 +1,70 @@
+#include <vector>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <robot2D/Graphics/ImageAtlas.hpp>
+
+namespace {
+    /// RGBA image filled by value, transparent border of given width around.
+    robot2D::Image makeImage(unsigned width, unsigned height, std::uint8_t value, unsigned border = 0) {
+        std::vector<std::uint8_t> pixels(width * height * 4, 0);
+        for(unsigned y = border; y < height - border; ++y) {
+            for(unsigned x = border; x < width - border; ++x) {
+                auto* pixel = &pixels[(y * width + x) * 4];
+                pixel[0] = pixel[1] = pixel[2] = value;
+                pixel[3] = 255;
+            }
+        }
+        robot2D::Image image;
+        image.create({width, height}, pixels.data(), robot2D::ImageColorFormat::RGBA);
+        return image;
+    }
+}
+
+TEST(Graphics, ImageAtlasPacksDifferentSizes) {
+    std::vector<robot2D::Image> images;
+    for(unsigned i = 0; i < 40; ++i)
+        images.emplace_back(makeImage(4 + i % 9, 3 + (i * 5) % 11, static_cast<std::uint8_t>(i + 1)));
+
+    robot2D::ImageAtlas atlas;
+    ASSERT_TRUE(atlas.packAtlas(images));
+    const auto& entries = atlas.getEntries();
+    ASSERT_EQ(entries.size(), images.size());
+
+    const auto& atlasImage = atlas.getImage();
+    const auto width = atlasImage.getSize().x;
+    for(std::size_t i = 0; i < entries.size(); ++i) {
+        EXPECT_EQ(entries[i].rect.width, static_cast<int>(images[i].getSize().x));
+        EXPECT_EQ(entries[i].rect.height, static_cast<int>(images[i].getSize().y));
+        for(std::size_t j = i + 1; j < entries.size(); ++j)
+            EXPECT_FALSE(entries[i].rect.intersects(entries[j].rect));
+
+        const auto& rect = entries[i].rect;
+        const auto* pixel = &atlasImage.getBuffer()[((rect.ly + rect.height - 1) * width + rect.lx + rect.width - 1) * 4];
+        EXPECT_EQ(pixel[0], i + 1);
+    }
+}
+
+TEST(Graphics, ImageAtlasTrimsTransparentBorder) {
+    std::vector<robot2D::Image> images;
+    images.emplace_back(makeImage(16, 12, 200, 3));
+
+    robot2D::ImageAtlas atlas;
+    ASSERT_TRUE(atlas.packAtlas(images, {"sprite"}));
+    const auto* entry = atlas.getEntry("sprite");
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry -> rect.width, 10);
+    EXPECT_EQ(entry -> rect.height, 6);
+    EXPECT_EQ(entry -> offset, robot2D::vec2i(3, 3));
+    EXPECT_EQ(entry -> sourceSize, robot2D::vec2u(16, 12));
+    EXPECT_EQ(atlas.getEntry("missing"), nullptr);
+}
+
+TEST(Graphics, ImageAtlasFailsWhenTooBig) {
+    std::vector<robot2D::Image> images;
+    images.emplace_back(makeImage(40, 40, 1));
+
+    robot2D::ImageAtlas atlas;
+    robot2D::ImageAtlasOptions options;
+    options.maxSize = 32;
+    EXPECT_FALSE(atlas.packAtlas(images, {}, options));
+}
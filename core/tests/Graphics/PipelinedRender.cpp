@@ -0,0 +1,51 @@
+#include <stdexcept>
+#include <gtest/gtest.h>
+#include <robot2D/Engine.hpp>
+
+namespace {
+    class PipelinedApplication: public robot2D::Application {
+    public:
+        void setup() override {}
+
+        void update(float) override {
+            if(++updates == 3)
+                m_window -> setSize({240, 180});
+        }
+
+        void render() override {
+            ++renders;
+        }
+
+        void record(robot2D::FramePacket& packet) override {
+            packet.clearColor = robot2D::Color::Red;
+            framebufferSize = packet.framebufferSize;
+            if(++records == 8)
+                m_running = false;
+        }
+
+        int updates{0};
+        int renders{0};
+        int records{0};
+        robot2D::vec2u framebufferSize{};
+    };
+}
+
+TEST(Graphics, PipelinedRenderRecordsPacketsWithFramebufferSize) {
+    robot2D::EngineConfiguration configuration{{320, 240}, "PipelinedRenderTest", 120};
+    configuration.pipelinedRender = true;
+
+    auto application = std::make_unique<PipelinedApplication>();
+    auto* app = application.get();
+    robot2D::Engine engine;
+    try {
+        engine.run(std::move(application), std::move(configuration));
+    }
+    catch(const std::runtime_error& exception) {
+        GTEST_SKIP() << "no display available: " << exception.what();
+    }
+
+    EXPECT_EQ(app -> records, 8);
+    EXPECT_EQ(app -> renders, 0);
+    EXPECT_GT(app -> framebufferSize.x, 0u);
+    EXPECT_GT(app -> framebufferSize.y, 0u);
+}
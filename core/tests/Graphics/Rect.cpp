@@ -44,8 +44,8 @@ TEST(Graphics, Graphics_RectContainsOtherRect_Test) {
 
 TEST(Graphics, Graphics_RectNotContainsOtherRect_Test) {
     robot2D::IntRect rect{100, 100, 200, 200};
-    robot2D::IntRect insideRect{150, 150, 110, 30};
-    EXPECT_FALSE(rect.contains(insideRect));
+    robot2D::IntRect outsideRect{150, 150, 210, 30};
+    EXPECT_FALSE(rect.contains(outsideRect));
 }
 
 TEST(Graphics, Graphics_RectCreateFrom4Anchors_Test) {
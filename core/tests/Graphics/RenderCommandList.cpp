@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include <robot2D/Graphics/RenderCommandList.hpp>
+
+TEST(Graphics, RenderCommandListRecordsLayers) {
+    robot2D::RenderCommandList commandList;
+    robot2D::RenderStates states;
+    states.layerID = 2;
+    states.transform.translate(10.F, 20.F);
+    commandList.draw(states);
+
+    EXPECT_EQ(commandList.getLayerCount(), 3);
+    EXPECT_EQ(commandList.getQuadCount(), 1);
+
+    const auto& command = commandList.getCommands(2)[0];
+    EXPECT_FLOAT_EQ(command.positions[0].x, 10.F);
+    EXPECT_FLOAT_EQ(command.positions[0].y, 20.F);
+    EXPECT_FLOAT_EQ(command.positions[2].x, 11.F);
+    EXPECT_FLOAT_EQ(command.positions[2].y, 21.F);
+}
+
+TEST(Graphics, RenderCommandListStableSort) {
+    robot2D::RenderCommandList commandList;
+    robot2D::RenderStates states;
+    states.layerID = 0;
+
+    states.entityID = 0;
+    commandList.draw(states, 5);
+    states.entityID = 1;
+    commandList.draw(states, 1);
+    states.entityID = 2;
+    commandList.draw(states, 5);
+    commandList.sort();
+
+    const auto& commands = commandList.getCommands(0);
+    EXPECT_EQ(commands[0].entityID, 1);
+    EXPECT_EQ(commands[1].entityID, 0);
+    EXPECT_EQ(commands[2].entityID, 2);
+
+    commandList.clear();
+    EXPECT_EQ(commandList.getQuadCount(), 0);
+}
+
+TEST(Graphics, RenderCommandListQuadArrayKeepsSampling) {
+    robot2D::RenderCommandList commandList;
+    robot2D::RenderStates states;
+    states.layerID = 1;
+    states.textureSampling = robot2D::TextureSampling::DistanceField;
+    states.transform.translate(5.F, 0.F);
+
+    std::array<robot2D::Vertex, 4> quad;
+    quad[0].position = {0.F, 0.F};
+    quad[1].position = {2.F, 0.F};
+    quad[2].position = {2.F, 3.F};
+    quad[3].position = {0.F, 3.F};
+    quad[2].texCoords = {0.5F, 0.25F};
+    commandList.draw(quad, states);
+
+    const auto& command = commandList.getCommands(1)[0];
+    EXPECT_EQ(command.sampling, robot2D::TextureSampling::DistanceField);
+    EXPECT_FLOAT_EQ(command.positions[2].x, 7.F);
+    EXPECT_FLOAT_EQ(command.positions[2].y, 3.F);
+    EXPECT_FLOAT_EQ(command.texCoords[2].x, 0.5F);
+}
@@ -0,0 +1,51 @@
+#include <vector>
+#include <gtest/gtest.h>
+#include <robot2D/Graphics/SkylinePacker.hpp>
+
+TEST(Graphics, SkylinePackerPacksInRow) {
+    robot2D::SkylinePacker packer{{64, 64}};
+    robot2D::IntRect first;
+    robot2D::IntRect second;
+    EXPECT_TRUE(packer.pack({16, 16}, first));
+    EXPECT_TRUE(packer.pack({16, 8}, second));
+    EXPECT_EQ(first, robot2D::IntRect(0, 0, 16, 16));
+    EXPECT_EQ(second, robot2D::IntRect(16, 0, 16, 8));
+}
+
+TEST(Graphics, SkylinePackerPrefersLowestPlace) {
+    robot2D::SkylinePacker packer{{32, 64}};
+    robot2D::IntRect placed;
+    EXPECT_TRUE(packer.pack({16, 32}, placed));
+    EXPECT_TRUE(packer.pack({16, 8}, placed));
+    EXPECT_TRUE(packer.pack({16, 8}, placed));
+    EXPECT_EQ(placed, robot2D::IntRect(16, 8, 16, 8));
+}
+
+TEST(Graphics, SkylinePackerRectsNotOverlap) {
+    robot2D::SkylinePacker packer{{128, 128}, 1};
+    std::vector<robot2D::IntRect> rects;
+    robot2D::IntRect placed;
+    for(unsigned i = 0; i < 200; ++i) {
+        if(!packer.pack({3 + i % 13, 2 + (i * 7) % 17}, placed))
+            break;
+        EXPECT_LE(placed.lx + placed.width, 128);
+        EXPECT_LE(placed.ly + placed.height, 128);
+        for(const auto& rect: rects) {
+            bool hit = rect.lx < placed.lx + placed.width && placed.lx < rect.lx + rect.width
+                && rect.ly < placed.ly + placed.height && placed.ly < rect.ly + rect.height;
+            EXPECT_FALSE(hit);
+        }
+        rects.push_back(placed);
+    }
+    EXPECT_GT(rects.size(), 50u);
+    EXPECT_GT(packer.getOccupancy(), 0.5F);
+}
+
+TEST(Graphics, SkylinePackerFull) {
+    robot2D::SkylinePacker packer{{16, 16}};
+    robot2D::IntRect placed;
+    EXPECT_TRUE(packer.pack({16, 16}, placed));
+    EXPECT_FALSE(packer.pack({1, 1}, placed));
+    packer.reset({16, 16});
+    EXPECT_TRUE(packer.pack({1, 1}, placed));
+}
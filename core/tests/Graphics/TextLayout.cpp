@@ -0,0 +1,174 @@
+#include <cmath>
+#include <string>
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <robot2D/Graphics/Font.hpp>
+#include <robot2D/Graphics/GlyphCache.hpp>
+#include <robot2D/Graphics/TextLayout.hpp>
+
+namespace {
+    constexpr unsigned int characterSize = 20;
+
+    class TextLayoutTest: public ::testing::Test {
+    protected:
+        void SetUp() override {
+            if(!m_font.loadFromFile(ROBOT2D_TESTS_FONT, characterSize))
+                GTEST_SKIP() << "test font isn't available: " << ROBOT2D_TESTS_FONT;
+        }
+
+        robot2D::TextLayout layout(const std::string& text, float maxWidth = 0.F,
+                                   robot2D::TextAlignment alignment = robot2D::TextAlignment::Left) {
+            robot2D::TextLayoutOptions options;
+            options.maxWidth = maxWidth;
+            options.alignment = alignment;
+            robot2D::TextLayout result;
+            robot2D::layoutText(m_font, text, options, result);
+            return result;
+        }
+
+        float lineHeight() const {
+            return m_font.getLineSpacing(characterSize);
+        }
+
+        static float left(const robot2D::LayoutGlyph& glyph) {
+            return glyph.quad.vertices[0].position.x;
+        }
+
+        static float top(const robot2D::LayoutGlyph& glyph) {
+            return glyph.quad.vertices[0].position.y;
+        }
+
+        robot2D::Font m_font;
+    };
+}
+
+TEST_F(TextLayoutTest, NewLineStartsLineAtLeftEdge) {
+    const auto single = layout("ab");
+    const auto lines = layout("ab\nab");
+
+    ASSERT_EQ(single.glyphs.size(), 2u);
+    ASSERT_EQ(lines.glyphs.size(), 4u);
+    EXPECT_EQ(lines.linesCount, 2u);
+    EXPECT_FLOAT_EQ(lines.size.x, single.size.x);
+    EXPECT_FLOAT_EQ(lines.size.y, 2.F * lineHeight());
+    for(std::size_t it = 0; it < 2; ++it) {
+        EXPECT_FLOAT_EQ(left(lines.glyphs[it + 2]), left(single.glyphs[it]));
+        EXPECT_FLOAT_EQ(top(lines.glyphs[it + 2]), top(single.glyphs[it]) + lineHeight());
+    }
+}
+
+TEST_F(TextLayoutTest, WordWrapMovesWholeWord) {
+    const auto first = layout("hello");
+    const auto second = layout("world");
+    const auto unwrapped = layout("hello world");
+    ASSERT_GT(unwrapped.size.x, first.size.x);
+
+    /// "hello " fits, "world" doesn't
+    const float maxWidth = (first.size.x + unwrapped.size.x) / 2.F;
+    const auto wrapped = layout("hello world", maxWidth);
+
+    ASSERT_EQ(wrapped.glyphs.size(), 10u);
+    EXPECT_EQ(wrapped.linesCount, 2u);
+    EXPECT_FLOAT_EQ(wrapped.size.x, std::max(first.size.x, second.size.x));
+    EXPECT_FLOAT_EQ(wrapped.size.y, 2.F * lineHeight());
+    for(std::size_t it = 0; it < 5; ++it) {
+        EXPECT_FLOAT_EQ(left(wrapped.glyphs[it]), left(first.glyphs[it]));
+        EXPECT_NEAR(left(wrapped.glyphs[it + 5]), left(second.glyphs[it]), 0.5F);
+        EXPECT_FLOAT_EQ(top(wrapped.glyphs[it + 5]), top(second.glyphs[it]) + lineHeight());
+    }
+}
+
+TEST_F(TextLayoutTest, LongWordIsBrokenBetweenCharacters) {
+    const std::string word = "abcdefghijklmnop";
+    const auto unwrapped = layout(word);
+    const float maxWidth = unwrapped.size.x / 3.F;
+    const auto wrapped = layout(word, maxWidth);
+
+    EXPECT_EQ(wrapped.glyphs.size(), word.size());
+    EXPECT_GE(wrapped.linesCount, 3u);
+    EXPECT_LE(wrapped.size.x, maxWidth);
+    EXPECT_FLOAT_EQ(wrapped.size.y, static_cast<float>(wrapped.linesCount) * lineHeight());
+
+    /// each line is unwrapped text shifted left and down, next line takes glyphs where previous stopped
+    std::size_t line = 0;
+    float shift = 0.F;
+    for(std::size_t it = 0; it < wrapped.glyphs.size(); ++it) {
+        const float down = top(wrapped.glyphs[it]) - top(unwrapped.glyphs[it]);
+        const auto glyphLine = static_cast<std::size_t>(std::lround(down / lineHeight()));
+        EXPECT_NEAR(down, static_cast<float>(glyphLine) * lineHeight(), 0.01F);
+        if(glyphLine != line) {
+            EXPECT_EQ(glyphLine, line + 1);
+            EXPECT_GT(left(unwrapped.glyphs[it]) - left(wrapped.glyphs[it]), shift);
+            line = glyphLine;
+            shift = left(unwrapped.glyphs[it]) - left(wrapped.glyphs[it]);
+        }
+        else
+            EXPECT_FLOAT_EQ(left(unwrapped.glyphs[it]) - left(wrapped.glyphs[it]), shift);
+    }
+    EXPECT_EQ(line + 1, wrapped.linesCount);
+}
+
+TEST_F(TextLayoutTest, AlignmentOffsetsLines) {
+    const std::string text = "ab\nabcdef";
+    const auto shortLine = layout("ab");
+    const auto leftAligned = layout(text);
+    const auto centered = layout(text, 0.F, robot2D::TextAlignment::Center);
+    const auto rightAligned = layout(text, 0.F, robot2D::TextAlignment::Right);
+    ASSERT_EQ(leftAligned.glyphs.size(), 8u);
+
+    /// bitmap fonts keep glyphs on whole pixels
+    const float centerOffset = std::floor((leftAligned.size.x - shortLine.size.x) * 0.5F);
+    const float rightOffset = std::floor(leftAligned.size.x - shortLine.size.x);
+    EXPECT_FLOAT_EQ(left(centered.glyphs[0]), left(leftAligned.glyphs[0]) + centerOffset);
+    EXPECT_FLOAT_EQ(left(rightAligned.glyphs[0]), left(leftAligned.glyphs[0]) + rightOffset);
+    /// widest line defines box, so it stays in place
+    EXPECT_FLOAT_EQ(left(centered.glyphs[2]), left(leftAligned.glyphs[2]));
+    EXPECT_FLOAT_EQ(left(rightAligned.glyphs[2]), left(leftAligned.glyphs[2]));
+
+    /// with wrapping box is maxWidth wide
+    const float maxWidth = leftAligned.size.x + 40.F;
+    const auto boxed = layout(text, maxWidth, robot2D::TextAlignment::Right);
+    EXPECT_FLOAT_EQ(left(boxed.glyphs[2]), left(leftAligned.glyphs[2]) + std::floor(maxWidth - leftAligned.size.x));
+}
+
+TEST_F(TextLayoutTest, CacheSharesLayoutUntilGlyphGenerationChanges) {
+    auto& cache = robot2D::TextLayoutCache::getInstance();
+    auto& glyphCache = robot2D::GlyphCache::getInstance();
+    robot2D::TextLayoutOptions options;
+
+    const auto layout = cache.getLayout(m_font, "cached", options);
+    EXPECT_EQ(cache.getLayout(m_font, "cached", options), layout);
+    options.maxWidth = 10.F;
+    EXPECT_NE(cache.getLayout(m_font, "cached", options), layout);
+    options.maxWidth = 0.F;
+
+    /// single page overflows with large glyphs, least recently used page is cleared
+    const auto generation = glyphCache.getGeneration();
+    glyphCache.setMaxPages(1);
+    robot2D::Glyph glyph;
+    for(std::uint32_t codepoint = 'A'; codepoint <= 'z' && glyphCache.getGeneration() == generation; ++codepoint)
+        glyphCache.getGlyph(m_font, 300, codepoint, glyph);
+    glyphCache.setMaxPages(robot2D::GlyphCache::defaultMaxPages);
+    ASSERT_NE(glyphCache.getGeneration(), generation);
+
+    const auto rebuilt = cache.getLayout(m_font, "cached", options);
+    EXPECT_NE(rebuilt, layout);
+    EXPECT_EQ(rebuilt -> generation, glyphCache.getGeneration());
+    EXPECT_EQ(rebuilt -> glyphs.size(), layout -> glyphs.size());
+    /// old layout stays valid for its holder
+    EXPECT_EQ(layout -> glyphs.size(), 6u);
+    EXPECT_EQ(cache.getLayout(m_font, "cached", options), rebuilt);
+}
+
+TEST_F(TextLayoutTest, CacheDropsLayoutsOfDestroyedFont) {
+    auto& cache = robot2D::TextLayoutCache::getInstance();
+    const auto count = cache.getEntriesCount();
+    {
+        robot2D::Font font;
+        ASSERT_TRUE(font.loadFromFile(ROBOT2D_TESTS_FONT, characterSize));
+        cache.getLayout(font, "first", {});
+        cache.getLayout(font, "second", {});
+        EXPECT_EQ(cache.getEntriesCount(), count + 2);
+    }
+    EXPECT_EQ(cache.getEntriesCount(), count);
+}
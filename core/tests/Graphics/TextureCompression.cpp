@@ -0,0 +1,191 @@
+#include <array>
+#include <cmath>
+#include <vector>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <robot2D/Graphics/TextureCompression.hpp>
+
+namespace {
+    /// Horizontal gradients with soft alpha, odd size leaves partial blocks.
+    robot2D::Image makeGradient(const robot2D::vec2u& size, bool opaque) {
+        std::vector<std::uint8_t> pixels(size.x * size.y * 4);
+        for(unsigned int y = 0; y < size.y; ++y) {
+            for(unsigned int x = 0; x < size.x; ++x) {
+                auto* pixel = pixels.data() + (y * size.x + x) * 4;
+                pixel[0] = static_cast<std::uint8_t>(x * 255 / size.x);
+                pixel[1] = static_cast<std::uint8_t>(255 - x * 200 / size.x);
+                pixel[2] = static_cast<std::uint8_t>(128 + 100 * std::sin(static_cast<float>(x) / 8.F));
+                pixel[3] = opaque ? 255 : static_cast<std::uint8_t>(x * 255 / size.x);
+            }
+        }
+        robot2D::Image image;
+        image.create(size, pixels.data(), robot2D::ImageColorFormat::RGBA);
+        return image;
+    }
+
+    double psnr(const robot2D::Image& left, const robot2D::Image& right, int firstChannel, int lastChannel) {
+        const auto& a = left.getBuffer();
+        const auto& b = right.getBuffer();
+        double error = 0;
+        std::size_t count = 0;
+        for(std::size_t i = 0; i < a.size(); i += 4) {
+            for(int channel = firstChannel; channel <= lastChannel; ++channel, ++count) {
+                const double delta = static_cast<double>(a[i + channel]) - static_cast<double>(b[i + channel]);
+                error += delta * delta;
+            }
+        }
+        error /= static_cast<double>(count);
+        return error == 0 ? 100.0 : 10.0 * std::log10(255.0 * 255.0 / error);
+    }
+
+    double roundTripPsnr(robot2D::CompressedFormat format, bool opaque, int firstChannel, int lastChannel) {
+        const robot2D::vec2u size{37, 21};
+        const auto image = makeGradient(size, opaque);
+        std::vector<std::uint8_t> blocks;
+        EXPECT_TRUE(robot2D::compressImage(image, format, blocks));
+        EXPECT_EQ(blocks.size(), robot2D::getCompressedSize(format, size));
+
+        robot2D::Image decoded;
+        EXPECT_TRUE(robot2D::decompressImage(format, size, blocks.data(), blocks.size(), decoded));
+        EXPECT_EQ(decoded.getSize(), size);
+        return psnr(image, decoded, firstChannel, lastChannel);
+    }
+
+    using Pixel = std::array<std::uint8_t, 4>;
+
+    /// Decodes single 4x4 block and compares it with pixels computed by format's specification.
+    void expectReferenceBlock(robot2D::CompressedFormat format, const std::vector<std::uint8_t>& block,
+                              const std::array<Pixel, 16>& expected) {
+        robot2D::Image decoded;
+        ASSERT_TRUE(robot2D::decompressImage(format, {4, 4}, block.data(), block.size(), decoded));
+        const auto& pixels = static_cast<const robot2D::Image&>(decoded).getBuffer();
+        for(std::size_t i = 0; i < expected.size(); ++i) {
+            const Pixel pixel{pixels[i * 4], pixels[i * 4 + 1], pixels[i * 4 + 2], pixels[i * 4 + 3]};
+            EXPECT_EQ(pixel, expected[i]) << "pixel " << i;
+        }
+    }
+}
+
+TEST(Graphics, TextureCompressionBlockSizes) {
+    EXPECT_EQ(robot2D::getCompressedSize(robot2D::CompressedFormat::BC1, {5, 3}), 16);
+    EXPECT_EQ(robot2D::getCompressedSize(robot2D::CompressedFormat::ETC2_RGB, {4, 4}), 8);
+    EXPECT_EQ(robot2D::getCompressedSize(robot2D::CompressedFormat::BC3, {1, 1}), 16);
+    EXPECT_EQ(robot2D::getCompressedSize(robot2D::CompressedFormat::BC7, {8, 5}), 64);
+    EXPECT_EQ(robot2D::getCompressedSize(robot2D::CompressedFormat::ETC2_RGBA, {16, 16}), 256);
+}
+
+TEST(Graphics, TextureCompressionRoundTripQuality) {
+    using robot2D::CompressedFormat;
+    EXPECT_GT(roundTripPsnr(CompressedFormat::BC1, true, 0, 2), 38.0);
+    EXPECT_GT(roundTripPsnr(CompressedFormat::ETC2_RGB, true, 0, 2), 33.0);
+    EXPECT_GT(roundTripPsnr(CompressedFormat::BC3, false, 0, 2), 38.0);
+    EXPECT_GT(roundTripPsnr(CompressedFormat::BC3, false, 3, 3), 45.0);
+    EXPECT_GT(roundTripPsnr(CompressedFormat::BC7, false, 0, 3), 44.0);
+    EXPECT_GT(roundTripPsnr(CompressedFormat::ETC2_RGBA, false, 0, 2), 33.0);
+    EXPECT_GT(roundTripPsnr(CompressedFormat::ETC2_RGBA, false, 3, 3), 45.0);
+    /// opaque stays exactly opaque
+    EXPECT_EQ(roundTripPsnr(CompressedFormat::BC7, true, 3, 3), 100.0);
+}
+
+TEST(Graphics, TextureCompressionKeepsPunchThroughAlpha) {
+    std::vector<std::uint8_t> pixels(4 * 4 * 4, 200);
+    for(std::size_t i = 0; i < 16; i += 2)
+        pixels[i * 4 + 3] = 0;
+    robot2D::Image image;
+    ASSERT_TRUE(image.create({4, 4}, pixels.data(), robot2D::ImageColorFormat::RGBA));
+
+    std::vector<std::uint8_t> blocks;
+    ASSERT_TRUE(robot2D::compressImage(image, robot2D::CompressedFormat::BC1, blocks));
+    robot2D::Image decoded;
+    ASSERT_TRUE(robot2D::decompressImage(robot2D::CompressedFormat::BC1, {4, 4}, blocks.data(), blocks.size(), decoded));
+    for(std::size_t i = 0; i < 16; ++i)
+        EXPECT_EQ(decoded.getBuffer()[i * 4 + 3], i % 2 == 0 ? 0 : 255);
+}
+
+TEST(Graphics, TextureCompressionFlatAlphaIsExact) {
+    std::vector<std::uint8_t> pixels(8 * 4 * 4, 77);
+    robot2D::Image image;
+    ASSERT_TRUE(image.create({8, 4}, pixels.data(), robot2D::ImageColorFormat::RGBA));
+
+    for(auto format: {robot2D::CompressedFormat::BC3, robot2D::CompressedFormat::BC7,
+                      robot2D::CompressedFormat::ETC2_RGBA}) {
+        std::vector<std::uint8_t> blocks;
+        ASSERT_TRUE(robot2D::compressImage(image, format, blocks));
+        robot2D::Image decoded;
+        ASSERT_TRUE(robot2D::decompressImage(format, {8, 4}, blocks.data(), blocks.size(), decoded));
+        const auto& decodedPixels = static_cast<const robot2D::Image&>(decoded).getBuffer();
+        for(std::size_t i = 3; i < decodedPixels.size(); i += 4)
+            EXPECT_EQ(decodedPixels[i], 77);
+    }
+}
+
+TEST(Graphics, CompressedImageContainerRoundTrip) {
+    robot2D::CompressedImage image;
+    ASSERT_TRUE(image.create(makeGradient({37, 21}, false), robot2D::CompressedFormat::BC3));
+    ASSERT_EQ(image.getLevels().size(), 6);
+    EXPECT_EQ(image.getLevels().back().size, robot2D::vec2u(1, 1));
+
+    std::vector<std::uint8_t> data;
+    ASSERT_TRUE(image.saveToMemory(data));
+
+    robot2D::CompressedImage loaded;
+    ASSERT_TRUE(loaded.loadFromMemory(data.data(), data.size()));
+    EXPECT_EQ(loaded.getFormat(), robot2D::CompressedFormat::BC3);
+    EXPECT_EQ(loaded.getSize(), robot2D::vec2u(37, 21));
+    ASSERT_EQ(loaded.getLevels().size(), image.getLevels().size());
+    for(std::size_t level = 0; level < image.getLevels().size(); ++level)
+        EXPECT_EQ(loaded.getLevels()[level].blocks, image.getLevels()[level].blocks);
+
+    EXPECT_FALSE(loaded.loadFromMemory(data.data(), data.size() - 1));
+    data[0] = 0;
+    EXPECT_FALSE(loaded.loadFromMemory(data.data(), data.size()));
+    EXPECT_TRUE(loaded.empty());
+}
+
+TEST(Graphics, TextureCompressionReferenceBC1) {
+    /// red and blue endpoints, every row walks indices 0..3, thirds are exact
+    expectReferenceBlock(robot2D::CompressedFormat::BC1,
+                         {0x00, 0xF8, 0x1F, 0x00, 0xE4, 0xE4, 0xE4, 0xE4},
+                         {{
+                             {255, 0, 0, 255}, {0, 0, 255, 255}, {170, 0, 85, 255}, {85, 0, 170, 255},
+                             {255, 0, 0, 255}, {0, 0, 255, 255}, {170, 0, 85, 255}, {85, 0, 170, 255},
+                             {255, 0, 0, 255}, {0, 0, 255, 255}, {170, 0, 85, 255}, {85, 0, 170, 255},
+                             {255, 0, 0, 255}, {0, 0, 255, 255}, {170, 0, 85, 255}, {85, 0, 170, 255}
+                         }});
+
+    /// color0 <= color1 switches to three colors and transparent black
+    expectReferenceBlock(robot2D::CompressedFormat::BC1,
+                         {0x00, 0x00, 0x00, 0x80, 0xE4, 0xE4, 0xE4, 0xE4},
+                         {{
+                             {0, 0, 0, 255}, {132, 0, 0, 255}, {66, 0, 0, 255}, {0, 0, 0, 0},
+                             {0, 0, 0, 255}, {132, 0, 0, 255}, {66, 0, 0, 255}, {0, 0, 0, 0},
+                             {0, 0, 0, 255}, {132, 0, 0, 255}, {66, 0, 0, 255}, {0, 0, 0, 0},
+                             {0, 0, 0, 255}, {132, 0, 0, 255}, {66, 0, 0, 255}, {0, 0, 0, 0}
+                         }});
+}
+
+TEST(Graphics, TextureCompressionReferenceBC7Mode6) {
+    /// endpoints (0, 254, 128, 254) and (255, 1, 129, 255) after p-bits, pixel i uses index i
+    expectReferenceBlock(robot2D::CompressedFormat::BC7,
+                         {0x40, 0xC0, 0xFF, 0x0F, 0x00, 0x02, 0xFF, 0x7F,
+                          0x11, 0x32, 0x54, 0x76, 0x98, 0xBA, 0xDC, 0xFE},
+                         {{
+                             {0, 254, 128, 254}, {16, 238, 128, 254}, {36, 218, 128, 254}, {52, 203, 128, 254},
+                             {68, 187, 128, 254}, {84, 171, 128, 254}, {104, 151, 128, 254}, {120, 135, 128, 254},
+                             {135, 120, 129, 255}, {151, 104, 129, 255}, {171, 84, 129, 255}, {187, 68, 129, 255},
+                             {203, 52, 129, 255}, {219, 37, 129, 255}, {239, 17, 129, 255}, {255, 1, 129, 255}
+                         }});
+}
+
+TEST(Graphics, TextureCompressionReferenceETC2) {
+    /// individual mode: left half (136, 68, 34) with table 1, right half 204 gray with table 0,
+    /// row y uses modifier index y
+    expectReferenceBlock(robot2D::CompressedFormat::ETC2_RGB,
+                         {0x8C, 0x4C, 0x2C, 0x20, 0xCC, 0xCC, 0xAA, 0xAA},
+                         {{
+                             {141, 73, 39, 255}, {141, 73, 39, 255}, {206, 206, 206, 255}, {206, 206, 206, 255},
+                             {153, 85, 51, 255}, {153, 85, 51, 255}, {212, 212, 212, 255}, {212, 212, 212, 255},
+                             {131, 63, 29, 255}, {131, 63, 29, 255}, {202, 202, 202, 255}, {202, 202, 202, 255},
+                             {119, 51, 17, 255}, {119, 51, 17, 255}, {196, 196, 196, 255}, {196, 196, 196, 255}
+                         }});
+}
@@ -0,0 +1,87 @@
+#include <vector>
+#include <gtest/gtest.h>
+#include <robot2D/Graphics/TextureResidency.hpp>
+
+namespace {
+    using MipChain = robot2D::TextureResidency::MipChain;
+
+    /// Square RGBA chain down to 1x1.
+    MipChain makeChain(unsigned int size, std::uint64_t lastUse) {
+        unsigned int length = 1;
+        while((size >> (length - 1)) > 1)
+            ++length;
+        return {{size, size}, 4, length, 0, lastUse};
+    }
+
+    std::size_t totalBytes(const std::vector<MipChain>& chains) {
+        std::size_t bytes = 0;
+        for(const auto& chain: chains)
+            bytes += chain.getBytes(chain.firstMip);
+        return bytes;
+    }
+}
+
+TEST(Graphics, TextureResidencyMipForExtent) {
+    using robot2D::TextureResidency;
+    EXPECT_EQ(TextureResidency::mipForExtent(256.F, 0.F), TextureResidency::noRequest);
+    EXPECT_EQ(TextureResidency::mipForExtent(256.F, -4.F), TextureResidency::noRequest);
+    /// magnified and exact fit need full resolution
+    EXPECT_EQ(TextureResidency::mipForExtent(256.F, 512.F), 0);
+    EXPECT_EQ(TextureResidency::mipForExtent(256.F, 256.F), 0);
+    EXPECT_EQ(TextureResidency::mipForExtent(256.F, 128.F), 1);
+    EXPECT_EQ(TextureResidency::mipForExtent(1024.F, 256.F), 2);
+    /// between two mips finer one is kept
+    EXPECT_EQ(TextureResidency::mipForExtent(1000.F, 256.F), 1);
+    EXPECT_EQ(TextureResidency::mipForExtent(1024.F, 1.F), 10);
+}
+
+TEST(Graphics, TextureResidencyChainBytes) {
+    const auto chain = makeChain(4, 0);
+    EXPECT_EQ(chain.length, 3);
+    EXPECT_EQ(chain.getBytes(0), (16 + 4 + 1) * 4);
+    EXPECT_EQ(chain.getBytes(2), 4);
+    EXPECT_EQ(chain.getBytes(3), 0);
+}
+
+TEST(Graphics, TextureResidencyFitBudgetKeepsChainsUnderBudget) {
+    std::vector<MipChain> chains{ makeChain(256, 5), makeChain(256, 5) };
+    const auto bytes = totalBytes(chains);
+    robot2D::TextureResidency::fitBudget(chains, bytes);
+    EXPECT_EQ(chains[0].firstMip, 0);
+    EXPECT_EQ(chains[1].firstMip, 0);
+}
+
+TEST(Graphics, TextureResidencyFitBudgetLowersLeastRecentlyUsed) {
+    std::vector<MipChain> chains{ makeChain(256, 10), makeChain(256, 3) };
+    /// dropping single finest mip is enough
+    const auto budget = totalBytes(chains) - 256 * 256 * 4;
+    robot2D::TextureResidency::fitBudget(chains, budget);
+    EXPECT_EQ(chains[0].firstMip, 0);
+    EXPECT_EQ(chains[1].firstMip, 1);
+    EXPECT_LE(totalBytes(chains), budget);
+}
+
+TEST(Graphics, TextureResidencyFitBudgetLowersBiggerFirst) {
+    std::vector<MipChain> chains{ makeChain(64, 7), makeChain(512, 7) };
+    const auto budget = totalBytes(chains) - 64 * 64 * 4;
+    robot2D::TextureResidency::fitBudget(chains, budget);
+    EXPECT_EQ(chains[0].firstMip, 0);
+    EXPECT_EQ(chains[1].firstMip, 1);
+}
+
+TEST(Graphics, TextureResidencyFitBudgetSpreadsOverAllChains) {
+    std::vector<MipChain> chains{ makeChain(256, 1), makeChain(256, 2), makeChain(256, 3) };
+    /// each chain has to lose its finest mip, recently used one loses nothing more
+    const auto budget = totalBytes(chains) - 3 * 256 * 256 * 4;
+    robot2D::TextureResidency::fitBudget(chains, budget);
+    EXPECT_EQ(chains[0].firstMip, 1);
+    EXPECT_EQ(chains[1].firstMip, 1);
+    EXPECT_EQ(chains[2].firstMip, 1);
+    EXPECT_LE(totalBytes(chains), budget);
+}
+
+TEST(Graphics, TextureResidencyFitBudgetStopsAtSmallestMip) {
+    std::vector<MipChain> chains{ makeChain(16, 0) };
+    robot2D::TextureResidency::fitBudget(chains, 0);
+    EXPECT_EQ(chains[0].firstMip, chains[0].length - 1);
+}
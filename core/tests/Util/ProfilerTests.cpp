@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <filesystem>
+#include <robot2D/Util/Profiler.hpp>
+
+namespace {
+    std::string readFile(const std::string& path) {
+        std::ifstream file{path};
+        std::stringstream stream;
+        stream << file.rdbuf();
+        return stream.str();
+    }
+}
+
+TEST(Util, ProfilerRecordsOnlyWhileCapturing) {
+    const auto path = (std::filesystem::temp_directory_path() / "robot2D_profiler_test.json").string();
+
+    robot2D::Profiler::record("BeforeCapture", 1, 2);
+    robot2D::Profiler::beginCapture();
+    {
+        robot2D::ProfileScope scope{"MainScope"};
+    }
+    std::thread worker{[]() {
+        robot2D::Profiler::setThreadName("Worker");
+        robot2D::ProfileScope scope{"WorkerScope"};
+    }};
+    worker.join();
+    robot2D::Profiler::endCapture();
+    robot2D::Profiler::record("AfterCapture", robot2D::Profiler::now(), robot2D::Profiler::now());
+
+    ASSERT_TRUE(robot2D::Profiler::writeChromeTrace(path));
+    const auto trace = readFile(path);
+    EXPECT_NE(trace.find("\"MainScope\""), std::string::npos);
+    EXPECT_NE(trace.find("\"WorkerScope\""), std::string::npos);
+    EXPECT_NE(trace.find("\"Worker\""), std::string::npos);
+    EXPECT_EQ(trace.find("BeforeCapture"), std::string::npos);
+    EXPECT_EQ(trace.find("AfterCapture"), std::string::npos);
+
+    std::filesystem::remove(path);
+}
+
+TEST(Util, ProfilerWriteStopsRunningCapture) {
+    const auto path = (std::filesystem::temp_directory_path() / "robot2D_profiler_running_test.json").string();
+
+    robot2D::Profiler::beginCapture();
+    std::atomic<bool> running{true};
+    std::thread worker{[&running]() {
+        while(running.load())
+            robot2D::ProfileScope scope{"BusyScope"};
+    }};
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    ASSERT_TRUE(robot2D::Profiler::writeChromeTrace(path));
+    EXPECT_FALSE(robot2D::Profiler::isCapturing());
+    running = false;
+    worker.join();
+
+    const auto trace = readFile(path);
+    EXPECT_NE(trace.find("\"BusyScope\""), std::string::npos);
+    EXPECT_EQ(trace.substr(trace.size() - 2), "}\n");
+
+    std::filesystem::remove(path);
+}
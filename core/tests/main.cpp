@@ -1,6 +1,8 @@
 #include "gtest/gtest.h"
+#include <robot2D/Util/Logger.hpp>
 
 int main(int argc, char** argv) {
+    logger::Log::Init();
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
-}
\ No newline at end of file
+}
@@ -0,0 +1,128 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <editor/QuadTree.hpp>
+
+namespace {
+    constexpr int entitiesCount = 100000;
+    constexpr int framesCount = 10;
+    constexpr int picksCount = 1000;
+    constexpr float worldSize = 20000.F;
+
+    using Clock = std::chrono::steady_clock;
+
+    double elapsedMs(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    struct Sprite {
+        robot2D::FloatRect rect;
+        editor::QuadTree<int>::ItemID itemID;
+    };
+}
+
+/// Editor-like load: every sprite moves each frame, marquee selection over a screen and mouse picks.
+int main() {
+    std::mt19937 generator{1};
+    std::uniform_real_distribution<float> position{0.F, worldSize};
+    std::uniform_real_distribution<float> size{4.F, 64.F};
+    std::uniform_real_distribution<float> step{-4.F, 4.F};
+
+    std::vector<Sprite> sprites(entitiesCount);
+    for(auto& sprite: sprites)
+        sprite.rect = { position(generator), position(generator), size(generator), size(generator) };
+
+    editor::QuadTree<int> tree;
+    tree.resize({0, 0, worldSize, worldSize});
+
+    auto start = Clock::now();
+    for(int i = 0; i < entitiesCount; ++i)
+        sprites[i].itemID = tree.insert(i, sprites[i].rect);
+    std::printf("insert %d entities: %.2f ms\n", entitiesCount, elapsedMs(start));
+
+    start = Clock::now();
+    for(int frame = 0; frame < framesCount; ++frame) {
+        for(auto& sprite: sprites) {
+            sprite.rect.lx += step(generator);
+            sprite.rect.ly += step(generator);
+            tree.relocate(sprite.itemID, sprite.rect);
+        }
+    }
+    std::printf("relocate all entities: %.2f ms per frame\n", elapsedMs(start) / framesCount);
+
+    /// marquee over one screen, same query as rubber band selection
+    const robot2D::FloatRect marquee{ worldSize / 2.F, worldSize / 2.F, 1920.F, 1080.F };
+    std::vector<int> found;
+    found.reserve(entitiesCount);
+
+    start = Clock::now();
+    for(int frame = 0; frame < framesCount; ++frame) {
+        found.clear();
+        tree.search(marquee, found);
+    }
+    const double treeMarquee = elapsedMs(start) / framesCount;
+    const auto treeFound = found.size();
+
+    start = Clock::now();
+    for(int frame = 0; frame < framesCount; ++frame) {
+        found.clear();
+        for(int i = 0; i < entitiesCount; ++i) {
+            if(marquee.intersects(sprites[i].rect))
+                found.push_back(i);
+        }
+    }
+    const double scanMarquee = elapsedMs(start) / framesCount;
+    const auto scanFound = found.size();
+    std::printf("marquee: tree %.3f ms, scan %.3f ms (x%.1f faster), found %zu / %zu\n",
+                treeMarquee, scanMarquee, scanMarquee / treeMarquee, treeFound, scanFound);
+
+    std::vector<robot2D::vec2f> picks(picksCount);
+    for(auto& pick: picks)
+        pick = { position(generator), position(generator) };
+
+    std::size_t treeHits = 0;
+    start = Clock::now();
+    for(const auto& pick: picks) {
+        found.clear();
+        tree.search(pick, found);
+        treeHits += found.size();
+    }
+    const double treePick = elapsedMs(start) / picksCount;
+
+    std::size_t scanHits = 0;
+    start = Clock::now();
+    for(const auto& pick: picks) {
+        const robot2D::FloatRect pointRect{pick.x, pick.y, 1, 1};
+        for(const auto& sprite: sprites)
+            scanHits += pointRect.intersects(sprite.rect) ? 1 : 0;
+    }
+    const double scanPick = elapsedMs(start) / picksCount;
+    std::printf("pick: tree %.4f ms, scan %.4f ms (x%.1f faster), hits %zu / %zu\n",
+                treePick, scanPick, scanPick / treePick, treeHits, scanHits);
+
+    return treeFound == scanFound && treeHits == scanHits ? 0 : 1;
+}
@@ -0,0 +1,157 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+
+#include <editor/serializers/SceneData.hpp>
+#include <editor/serializers/SceneBinaryFormat.hpp>
+#include <editor/serializers/SceneYAMLFormat.hpp>
+
+namespace {
+    constexpr int entitiesCount = 50000;
+    constexpr int childrenPerParent = 4;
+    constexpr int runsCount = 3;
+
+    using Clock = std::chrono::steady_clock;
+
+    double elapsedMs(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    /// Sprites with transforms, every 10th has text, every 25th has script and physics,
+    /// every 5th entity is parent of next childrenPerParent ones.
+    void generateScene(editor::SceneData& sceneData) {
+        std::mt19937_64 generator{1};
+        std::uniform_real_distribution<float> position{0.F, 20000.F};
+        std::uniform_real_distribution<float> size{4.F, 64.F};
+
+        const char* textures[] = { "assets/textures/hero.png", "assets/textures/tile.png",
+                                   "assets/textures/tree.png", "assets/textures/rock.png" };
+        sceneData.name = sceneData.addString("BenchmarkScene");
+
+        std::uint64_t parentUUID = 0;
+        int childrenLeft = 0;
+        for(int i = 0; i < entitiesCount; ++i) {
+            const auto index = static_cast<std::uint32_t>(i);
+            editor::SceneData::Entity entity{};
+            entity.uuid = generator();
+            entity.tag = sceneData.addString("Entity " + std::to_string(i));
+            entity.firstChild = static_cast<std::uint32_t>(sceneData.childIDs.size());
+
+            if(childrenLeft > 0) {
+                entity.flags |= editor::SceneData::IsChild;
+                entity.parentUUID = parentUUID;
+                --childrenLeft;
+            }
+            sceneData.entities.emplace_back(entity);
+
+            sceneData.transforms.push_back({ index, { position(generator), position(generator) },
+                                             { size(generator), size(generator) }, {}, 0.F });
+            sceneData.drawables.push_back({ index, robot2D::Color::White,
+                                            sceneData.addString(textures[i % 4]), 1 });
+            if(i % 10 == 0)
+                sceneData.texts.push_back({ index, sceneData.addString("Label " + std::to_string(i)),
+                                            sceneData.addString("assets/fonts/arial.ttf") });
+            if(i % 25 == 0) {
+                const auto firstField = static_cast<std::uint32_t>(sceneData.scriptFields.size());
+                sceneData.scriptFields.push_back({ sceneData.addString("speed"), sceneData.addString("Float"), 0 });
+                sceneData.scripts.push_back({ index, sceneData.addString("Game.Player"), firstField, 1 });
+                sceneData.physics.push_back({ index, 1, 0 });
+            }
+        }
+
+        /// children ids are known after uuids are generated
+        for(int i = 0; i < entitiesCount; ++i) {
+            auto& entity = sceneData.entities[i];
+            if(i % 5 != 0 || (entity.flags & editor::SceneData::IsChild))
+                continue;
+            entity.firstChild = static_cast<std::uint32_t>(sceneData.childIDs.size());
+            for(int child = 1; child <= childrenPerParent && i + child < entitiesCount; ++child) {
+                auto& childEntity = sceneData.entities[i + child];
+                childEntity.flags |= editor::SceneData::IsChild;
+                childEntity.parentUUID = entity.uuid;
+                sceneData.childIDs.emplace_back(childEntity.uuid);
+                ++entity.childrenCount;
+            }
+        }
+    }
+}
+
+int main() {
+    namespace fs = std::filesystem;
+    const auto directory = fs::temp_directory_path();
+    const auto yamlPath = (directory / "robot2D-benchmark.scene").string();
+    const auto binaryPath = (directory / "robot2D-benchmark.bscene").string();
+
+    editor::SceneData sceneData;
+    generateScene(sceneData);
+
+    auto start = Clock::now();
+    if(!editor::SceneYAMLFormat{}.saveToFile(yamlPath, sceneData))
+        return 1;
+    std::printf("yaml save: %.2f ms\n", elapsedMs(start));
+
+    start = Clock::now();
+    if(!editor::SceneBinaryFormat{}.saveToFile(binaryPath, sceneData))
+        return 1;
+    std::printf("binary save: %.2f ms\n", elapsedMs(start));
+
+    const auto yamlSize = fs::file_size(yamlPath);
+    const auto binarySize = fs::file_size(binaryPath);
+    std::printf("size: yaml %.2f MB, binary %.2f MB (x%.1f smaller)\n",
+                static_cast<double>(yamlSize) / (1024.0 * 1024.0),
+                static_cast<double>(binarySize) / (1024.0 * 1024.0),
+                static_cast<double>(yamlSize) / static_cast<double>(binarySize));
+
+    double yamlTime = 0.0;
+    double binaryTime = 0.0;
+    editor::SceneData yamlData;
+    editor::SceneData binaryData;
+    for(int run = 0; run < runsCount; ++run) {
+        start = Clock::now();
+        if(!editor::SceneYAMLFormat{}.loadFromFile(yamlPath, yamlData))
+            return 1;
+        yamlTime += elapsedMs(start);
+
+        start = Clock::now();
+        if(!editor::SceneBinaryFormat{}.loadFromFile(binaryPath, binaryData))
+            return 1;
+        binaryTime += elapsedMs(start);
+    }
+
+    const bool sameScene = yamlData.entities.size() == binaryData.entities.size()
+        && yamlData.transforms.size() == binaryData.transforms.size()
+        && yamlData.childIDs == binaryData.childIDs
+        && binaryData.getString(binaryData.entities.back().tag) == yamlData.getString(yamlData.entities.back().tag);
+
+    std::printf("load %d entities: yaml %.2f ms, binary %.2f ms (x%.1f faster), same scene: %s\n",
+                entitiesCount, yamlTime / runsCount, binaryTime / runsCount,
+                yamlTime / binaryTime, sameScene ? "yes" : "no");
+
+    fs::remove(yamlPath);
+    fs::remove(binaryPath);
+    return sameScene ? 0 : 1;
+}
@@ -41,6 +41,10 @@ namespace robot2D {
 
     bool ImageButton(const robot2D::Texture& texture, const robot2D::vec2f& size);
 
+    /// Button of texture's part between uv0 and uv1, atlas cell for example.
+    bool ImageButton(const robot2D::Texture& texture, const robot2D::vec2f& size,
+                     const robot2D::vec2f& uv0, const robot2D::vec2f& uv1);
+
     void RenderFrameBuffer(const robot2D::FrameBuffer::Ptr& frameBuffer, const robot2D::vec2f& size);
 
     bool InputText(
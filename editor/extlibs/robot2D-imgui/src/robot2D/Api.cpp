@@ -49,6 +49,13 @@ namespace robot2D {
                                   {1,1}, 0);
     }
 
+    bool ImageButton(const robot2D::Texture& texture, const robot2D::vec2f& size,
+                     const robot2D::vec2f& uv0, const robot2D::vec2f& uv1) {
+        auto imID = ImGui::convertTextureHandle(texture.getID());
+        return ImGui::ImageButton(imID, ImVec2(size.x, size.y), ImVec2(uv0.x, uv0.y),
+                                  ImVec2(uv1.x, uv1.y), 0);
+    }
+
     struct InputTextCallback_UserData
     {
         std::string*            Str;
@@ -25,6 +25,8 @@ source distribution.
 #include <unordered_map>
 #include "Animation.hpp"
 
+class TiXmlDocument;
+
 namespace editor {
 
     class AnimationParser {
@@ -37,7 +39,10 @@ namespace editor {
         ~AnimationParser() = default;
 
         bool loadFromFile(const std::string& path, Animation* animation);
+        bool loadFromMemory(const char* data, std::size_t size, Animation* animation);
         bool saveToFile(const std::string& path, const Animation* animation);
+    private:
+        bool parseDocument(TiXmlDocument& document, Animation* animation);
     private:
         enum class XmlKey {
             image,
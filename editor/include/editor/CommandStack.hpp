@@ -24,6 +24,7 @@ source distribution.
 #include <stack>
 #include <queue>
 #include <cassert>
+#include <functional>
 
 #include <robot2D/Util/Logger.hpp>
 #include "commands/ICommand.hpp"
@@ -31,6 +32,9 @@ source distribution.
 namespace editor {
     class CommandStack {
     public:
+        /// Called after command is added, undone or redone.
+        using ChangeCallback = std::function<void()>;
+
         CommandStack() = default;
         ~CommandStack() = default;
 
@@ -53,6 +57,7 @@ namespace editor {
         std::size_t redoSize() const;
 
         void clear();
+        void setChangeCallback(ChangeCallback&& callback) { m_changeCallback = std::move(callback); }
 
         [[nodiscard]]
         bool empty() const noexcept;
@@ -60,6 +65,7 @@ namespace editor {
         std::stack<ICommand::Ptr> m_stack {};
         std::vector<class_id> m_commandIDs {};
         std::queue<ICommand::Ptr> m_redoQueue {};
+        ChangeCallback m_changeCallback {};
     };
 
     template<typename T, typename ...Args>
@@ -70,6 +76,8 @@ namespace editor {
         auto who = ptr -> who();
         m_commandIDs.push_back(who);
         m_stack.push(ptr);
+        if(m_changeCallback)
+            m_changeCallback();
         return static_cast<T*>(ptr.get());
     }
 
@@ -24,6 +24,7 @@ source distribution.
 #include <unordered_map>
 #include <vector>
 #include <list>
+#include <cstdint>
 
 #include <robot2D/Graphics/Transformable.hpp>
 #include <robot2D/Graphics/Texture.hpp>
@@ -33,6 +34,8 @@ source distribution.
 #include <robot2D/Graphics/Math3D.hpp>
 #include <robot2D/Graphics/Vertex.hpp>
 #include <robot2D/Graphics/Font.hpp>
+#include <robot2D/Graphics/RenderStates.hpp>
+#include <robot2D/Graphics/TextLayout.hpp>
 #include <robot2D/Ecs/Entity.hpp>
 
 #include "editor/panels/ITreeItem.hpp"
@@ -67,7 +70,11 @@ namespace editor {
         void setPosition(const robot2D::vec2f& pos) override;
         void setScale(const robot2D::vec2f& factor) override;
         void setSize(const robot2D::vec2f& factor) override;
+        void setOrigin(const robot2D::vec2f& origin) override;
+        void setRotate(const float& angle) override;
 
+        /// Grows on every change of bounds, systems compare it with last seen value instead of resetting flags.
+        std::uint32_t getVersion() const { return m_version; }
 
         void addChild(SceneEntity parent, SceneEntity child);
         void removeChild(SceneEntity entity, bool removeFromScene = true);
@@ -99,6 +106,7 @@ namespace editor {
         void removeChild(int childID, bool removeFromScene);
     private:
         int m_childID = -1;
+        std::uint32_t m_version{0};
         std::list<SceneEntity> m_children;
         SceneEntity m_parent;
     };
@@ -314,6 +322,9 @@ namespace editor {
     public:
         DECLARE_COMPONENT_ID()
 
+        /// Size glyphs of text fonts are rasterized with, font is shared by every text which uses it.
+        static constexpr unsigned int defaultCharacterSize = 20;
+
         TextComponent();
         ~TextComponent() override = default;
 
@@ -332,8 +343,16 @@ namespace editor {
         void setFontPath(const std::string& path) { m_fontPath = path;}
         const std::string& getFontPath() const { return m_fontPath; }
 
-        const robot2D::Texture& getTexture() const;
-        std::unordered_map<int, robot2D::GlyphQuad>& getGlyphCache();
+        /// Lines are wrapped on spaces to fit width, 0 disables wrapping.
+        void setMaxWidth(float maxWidth);
+        float getMaxWidth() const { return m_maxWidth; }
+
+        void setAlignment(robot2D::TextAlignment alignment);
+        robot2D::TextAlignment getAlignment() const { return m_alignment; }
+
+        /// Glyphs in entity's local space, taken by TextSystem from TextLayoutCache when text changes.
+        const robot2D::TextLayout* getLayout() const { return m_layout.get(); }
+        robot2D::TextureSampling getTextureSampling() const;
     private:
         friend class TextSystem;
         friend class SceneRender;
@@ -341,14 +360,53 @@ namespace editor {
         std::string m_text{"Hello"};
         unsigned int m_characterSize;
         const robot2D::Font* m_font;
-        robot2D::Texture* m_texture;
+        float m_maxWidth{0.F};
+        robot2D::TextAlignment m_alignment{robot2D::TextAlignment::Left};
 
         bool m_needUpdate;
-        std::unordered_map<int, robot2D::GlyphQuad> m_bufferCache;
-        friend class TextSystem;
-
-        bool m_scaled = false;
         std::string m_fontPath;
+
+        std::shared_ptr<const robot2D::TextLayout> m_layout;
+    };
+
+    class ParticleEmitterComponent final {
+    public:
+        DECLARE_COMPONENT_ID()
+
+        ParticleEmitterComponent() = default;
+        ~ParticleEmitterComponent() = default;
+
+        void setTexture(const robot2D::Texture& texture) { m_texture = &texture; }
+        const robot2D::Texture* getTexture() const { return m_texture; }
+
+        void setTexturePath(const std::string& path) { m_texturePath = path; }
+        const std::string& getTexturePath() const { return m_texturePath; }
+
+        /// Particles per second.
+        float emissionRate{50.F};
+        /// Particle life in seconds.
+        float lifeTime{1.5F};
+        float speed{120.F};
+        /// Emission direction and cone width around it, in degrees.
+        float direction{-90.F};
+        float spread{30.F};
+        robot2D::vec2f gravity{0.F, 98.F};
+
+        float startSize{8.F};
+        float endSize{2.F};
+        robot2D::Color startColor{robot2D::Color::White};
+        robot2D::Color endColor{255.F, 255.F, 255.F, 0.F};
+
+        /// Pool capacity of emitter, alive particles never exceed it.
+        unsigned int maxParticles{1000};
+        unsigned int layerIndex{1};
+        bool emitting{true};
+    private:
+        friend class ParticleSystem;
+
+        float m_emitAccumulator{0.F};
+        const robot2D::Texture* m_texture{nullptr};
+        std::string m_texturePath;
     };
 
     struct ScriptComponent {
@@ -410,8 +468,8 @@ namespace editor {
 
 
     struct QuadTreeComponent {
-        using Iterator = typename QuadTreeContainer<SceneEntity>::ContainerIterator;
-        Iterator iterator;
+        using ItemID = typename QuadTree<SceneEntity>::ItemID;
+        ItemID itemID{QuadTree<SceneEntity>::invalidItem};
     };
 
 }
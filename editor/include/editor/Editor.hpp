@@ -63,6 +63,8 @@ namespace editor {
         bool m_leftCtrlPressed = false;
         bool opt_padding = true;
         bool dockspace_open = false;
+        /// Marquee selects entities by pixels of entity ID attachment instead of quadtree bounds.
+        bool gpuMarqueeSelection = false;
         std::unordered_map<TextureID, std::string> texturePaths = {
                 {TextureID::Logo, "logo.png"},
                 {TextureID::EditButton, "StopButton.png"},
@@ -169,6 +171,8 @@ namespace editor {
         ObjectManipulator m_objectManipulator;
 
         bool m_leftMousePressed{false};
+        /// Marquee corner in viewport framebuffer's pixels.
+        robot2D::vec2i m_selectionStartPixel{};
         bool m_needPrepareView{true};
 
         editor::PopupConfiguration* m_popupConfiguration{nullptr};
@@ -9,6 +9,7 @@
 #include "EditorCamera.hpp"
 
 namespace editor {
+    class SpatialSystem;
 
     class EditorInteractor: public UIInteractor {
     public:
@@ -33,6 +34,8 @@ namespace editor {
         virtual robot2D::vec2f getMainCameraPosition() const = 0;
         virtual void setMainCamera(SceneEntity cameraEntity) = 0;
         virtual void setEditorCamera(IEditorCamera::Ptr editorCamera) = 0;
+        /// Spatial index of scene which is simulated now, nullptr without active scene.
+        virtual const SpatialSystem* getSpatialSystem() const = 0;
     };
 
 } // namespace editor
\ No newline at end of file
@@ -21,6 +21,7 @@ source distribution.
 
 #pragma once
 #include <vector>
+#include <deque>
 #include <editor/scripting/ScriptingEngineService.hpp>
 
 #include "Project.hpp"
@@ -33,6 +34,7 @@ source distribution.
 #include "PopupConfiguration.hpp"
 #include "PopupManager.hpp"
 #include "CommandStack.hpp"
+#include "SceneJournal.hpp"
 
 #include "ScriptInteractor.hpp"
 #include "EditorInteractor.hpp"
@@ -86,11 +88,13 @@ namespace editor {
         robot2D::vec2f getMainCameraPosition() const override;
         void setMainCamera(SceneEntity cameraEntity) override;
         void setEditorCamera(IEditorCamera::Ptr editorCamera) override;
+        const SpatialSystem* getSpatialSystem() const override;
         //////////////////////////////////////// EditorInteractor ////////////////////////////////////////
 
 
         //////////////////////////////////////// UIInteractor ////////////////////////////////////////
         SceneEntity findEntity(const robot2D::vec2i& mousePos)  override;
+        void findSelectEntities(const std::vector<int>& entityIndices) override;
         std::vector<SceneEntity>& getSelectedEntities()  override;
         std::string getAssociatedProjectPath() const override;
         const std::list<SceneEntity>& getEntities() const override;
@@ -105,6 +109,7 @@ namespace editor {
         void removeEntityChild(SceneEntity entity) override;
         bool isRunning() const override;
         SceneEntity getEntity(UUID uuid) override;
+        void markEntityDirty(SceneEntity entity) override;
 
         void restoreDeletedEntities(DeletedEntitiesRestoreInformation& restoreInformation,
                                     DeletedEntitiesRestoreUIInformation& restoreUiInformation) override;
@@ -118,7 +123,11 @@ namespace editor {
         //////////////////////////////////////// UIInteractor ////////////////////////////////////////
     private:
         void loadSceneCallback(Scene::Ptr loadedScene);
+        /// Shows m_selectedEntities in scene panel and inspector.
+        void showSelectedEntitiesOnUI();
         void processEntity(SceneEntity entity);
+        /// Creates textures of loaded scene's entities until frame budget runs out.
+        void processPendingEntities();
 
         friend class EditorModule;
         void switchRuntimeState(const ToolbarMessage::Type& messageType);
@@ -141,6 +150,7 @@ namespace editor {
         EditorPresenter& m_presenter;
         EditorRouter& m_router;
         CommandStack m_commandStack;
+        SceneJournal m_journal;
         IScriptInteractorFrom::WeakPtr m_scriptInteractor;
 
         Project::Ptr m_currentProject;
@@ -155,6 +165,10 @@ namespace editor {
         SceneEntity m_mainCameraEntity;
         std::function<void()> m_closeResultProjectCallback{nullptr};
 
-        QuadTreeContainer<SceneEntity> m_quadTree;
+        QuadTree<SceneEntity> m_quadTree;
+        /// Reused by picking to keep search allocation free.
+        std::vector<SceneEntity> m_foundEntities;
+        /// Entities of loaded scene which GPU resources aren't created yet.
+        std::deque<SceneEntity> m_pendingEntities;
     };
 }
\ No newline at end of file
@@ -22,6 +22,7 @@ source distribution.
 #pragma once
 
 #include <string>
+#include <robot2D/Graphics/TextureCompression.hpp>
 
 namespace editor {
     struct ExportOptions {
@@ -31,5 +32,11 @@ namespace editor {
         bool isFullscreen{false};
         std::string outputFolder;
         std::string startScene;
+        /// Project which assets folder is packed.
+        std::string projectPath;
+        /// Images also get GPU compressed mip chain entry (<name>.rtex) next to source PNG / JPG,
+        /// scene loading uploads it instead of decoding source image.
+        bool compressTextures{true};
+        robot2D::CompressedFormat textureFormat{robot2D::CompressedFormat::BC7};
     };
 }
\ No newline at end of file
@@ -37,9 +37,15 @@ namespace editor {
 
     std::string getFileExtension(const std::string& path);
 
+    /// Extension is compared case-insensitively, file doesn't have to exist.
+    bool isImageFile(const std::string& path);
+
     std::string combinePath(const std::string& basePath, const std::string& appendPath);
 
     std::string addFilename(const std::string& path, const std::string& filename);
 
     std::string cutPath(const std::string& fullPath, const std::string& anchor);
+
+    /// Path relative to project's root with '/' separators, asset packs store assets under such names.
+    std::string toAssetName(const std::string& projectPath, const std::string& path);
 }
\ No newline at end of file
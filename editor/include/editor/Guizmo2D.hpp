@@ -167,8 +167,9 @@ namespace editor {
         robot2D::Sprite m_rotateSprite;
 
         robot2D::vec2f m_manipulatorLastPos;
-        robot2D::Texture m_manipulatorTexture;
-        robot2D::Texture m_manipulatorRotateTexture;
+        /// Owned by EditorResourceManager, set in setup.
+        robot2D::Texture* m_manipulatorTexture{nullptr};
+        robot2D::Texture* m_manipulatorRotateTexture{nullptr};
 
         enum class TextureType {
             FreeMove, Move, Scale
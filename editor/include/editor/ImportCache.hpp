@@ -0,0 +1,116 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include <robot2D/Core/AssetPack.hpp>
+#include <robot2D/Core/JobSystem.hpp>
+#include <robot2D/Graphics/Image.hpp>
+#include <robot2D/Graphics/Font.hpp>
+
+namespace editor {
+
+    /**
+     * \brief Project's on-disk cache of imported assets keyed by content.
+     * \details Key is XXH64 of source bytes seeded by import settings, so copied or renamed file hits same blob,
+     * while edited file or changed settings miss it. Image blob keeps decoded pixels ready to upload,
+     * font blob keeps SDF glyphs of printable ASCII, so distance transform isn't repeated on next open.
+     * Blob is written into temporary file and renamed, jobs importing same asset never read half written blob.
+     * Without opened directory assets are just decoded. Thread safe.
+     */
+    class ImportCache {
+    public:
+        static ImportCache* getCache() {
+            static ImportCache importCache;
+            return &importCache;
+        }
+
+        ImportCache(const ImportCache& other) = delete;
+        ImportCache& operator=(const ImportCache& other) = delete;
+        ImportCache(ImportCache&& other) = delete;
+        ImportCache& operator=(ImportCache&& other) = delete;
+        ~ImportCache() = default;
+
+        /// Blobs live in project's directory, it's created when missing.
+        bool open(const std::string& directory);
+        void close();
+        bool isOpen() const;
+
+        /// Takes pixels from cache or decodes source and stores them. Packed bytes are preferred over path.
+        bool importImage(const std::string& path, const robot2D::AssetView& packed, robot2D::Image& image);
+
+        /// Loads font in SDF mode, face still reads source, only glyph distance fields come from cache.
+        bool importFont(const std::string& path, const robot2D::AssetView& packed,
+                        int charSize, robot2D::Font& font);
+
+        /// Image scaled down by box filter to fit maxSide, it's cached separately from full image.
+        bool importThumbnail(const std::string& path, unsigned int maxSide, robot2D::Image& thumbnail);
+
+        /// Schedules background job which fills cache for image or font file, other files are skipped.
+        void importFile(const std::string& path, robot2D::JobSystem& jobSystem);
+
+        /// importFile for every file under directory, directory itself is walked by background job too.
+        void importDirectory(const std::string& directory, robot2D::JobSystem& jobSystem);
+
+        std::size_t getHits() const { return m_hits.load(std::memory_order_relaxed); }
+        std::size_t getMisses() const { return m_misses.load(std::memory_order_relaxed); }
+    private:
+        ImportCache() = default;
+
+        enum class AssetKind: std::uint32_t {
+            Image = 1,
+            Font,
+            Thumbnail
+        };
+
+        /// parameter is import setting of kind, thumbnail's size for example.
+        static std::uint64_t makeKey(AssetKind kind, const void* data, std::size_t size, std::uint32_t parameter);
+        /// Empty when cache isn't opened, source isn't hashed then.
+        std::string getBlobPath(AssetKind kind, const void* data, std::size_t size,
+                                std::uint32_t parameter = 0) const;
+
+        /// Image and thumbnail blobs have same layout.
+        bool readImage(const std::string& blobPath, AssetKind kind, robot2D::Image& image) const;
+        bool writeImage(const std::string& blobPath, AssetKind kind, const robot2D::Image& image);
+        bool readGlyphs(const std::string& blobPath, robot2D::Font::SdfGlyphs& glyphs) const;
+        bool writeGlyphs(const std::string& blobPath, const robot2D::Font::SdfGlyphs& glyphs);
+        /// Blob is written under unique temporary name and renamed into place.
+        std::string makeTempPath(const std::string& blobPath);
+        bool commitBlob(const std::string& tempPath, const std::string& blobPath);
+
+        /// Decodes file into cache unless it's already there.
+        void prepareFile(const std::string& path);
+    private:
+        mutable std::mutex m_mutex;
+        std::string m_directory;
+
+        std::atomic<std::uint32_t> m_tempCounter{0};
+        std::atomic<std::size_t> m_hits{0};
+        std::atomic<std::size_t> m_misses{0};
+    };
+
+}
@@ -51,8 +51,18 @@ namespace editor {
             return m_fonts.has(id);
         }
 
+        /// Scene textures are created from images ResourceManager keeps, so they don't keep own CPU copy.
+        /// Their mips are streamed by on-screen size, so zoomed out scenes keep only small mips on GPU.
         robot2D::Texture* addTexture(const std::string& id) {
-            return m_textures.add(id);
+            auto* texture = m_textures.add(id);
+            if(texture) {
+                robot2D::TextureOptions options;
+                options.mipmaps = true;
+                options.keepPixels = false;
+                options.streamed = true;
+                texture -> setOptions(options);
+            }
+            return texture;
         }
 
         robot2D::Texture& getTexture(const std::string& id) {
@@ -0,0 +1,127 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <random>
+#include <unordered_map>
+
+#include <robot2D/Ecs/System.hpp>
+#include <robot2D/Graphics/Drawable.hpp>
+#include <robot2D/Graphics/Shader.hpp>
+#include <robot2D/Graphics/VertexArray.hpp>
+
+#include "Components.hpp"
+
+namespace editor {
+
+    /// \brief Per frame cost of particles simulation.
+    struct ParticleStats {
+        unsigned int emitters{0};
+        unsigned int aliveParticles{0};
+        unsigned int emittedParticles{0};
+        /// Simulation time in milliseconds.
+        float simulationTime{0.F};
+    };
+
+    /// \brief Structure of Arrays storage of one emitter, each attribute is own contiguous array.
+    struct ParticlePool {
+        /// Storage for capacity particles, alive ones above it are dropped.
+        void resize(std::size_t capacity);
+        /// Swap particle with last alive one.
+        void kill(std::size_t index);
+
+        std::vector<float> positionX;
+        std::vector<float> positionY;
+        std::vector<float> velocityX;
+        std::vector<float> velocityY;
+        std::vector<float> life;
+        std::vector<float> lifeTime;
+        std::size_t count{0};
+    };
+
+    class ParticleSystem: public robot2D::ecs::System, public robot2D::Drawable {
+    public:
+        ParticleSystem(robot2D::MessageBus& messageBus);
+        ParticleSystem(const ParticleSystem& other) = delete;
+        ParticleSystem& operator=(const ParticleSystem& other) = delete;
+        ParticleSystem(ParticleSystem&& other) = delete;
+        ParticleSystem& operator=(ParticleSystem&& other) = delete;
+        ~ParticleSystem() override = default;
+
+        void update(float dt) override;
+        void draw(robot2D::RenderTarget& target, robot2D::RenderStates states) const override;
+
+        /// Max particles spawned per frame by all emitters together, 0 - unlimited.
+        void setEmissionBudget(unsigned int budget) { m_emissionBudget = budget; }
+        unsigned int getEmissionBudget() const { return m_emissionBudget; }
+
+        const ParticleStats& getStats() const { return m_stats; }
+    protected:
+        void onEntityRemoved(robot2D::ecs::Entity entity) override;
+    private:
+        struct ParticleInstance {
+            robot2D::vec2f position;
+            float size;
+            robot2D::Color color;
+        };
+
+        struct EmitterData {
+            ParticlePool pool;
+        };
+
+        /// Emitters sharing texture and layer are drawn from one instance buffer.
+        struct ParticleBatch {
+            const robot2D::Texture* texture{nullptr};
+            unsigned int layerID{0};
+            std::vector<ParticleInstance> instances;
+            robot2D::VertexArray::Ptr vertexArray{nullptr};
+            robot2D::VertexBuffer::Ptr instanceBuffer{nullptr};
+            std::size_t instanceCapacity{0};
+        };
+
+        void setupGL();
+        void setupBatchGL(ParticleBatch& batch, std::size_t capacity);
+        void simulate(float dt);
+        unsigned int emit(EmitterData& data, ParticleEmitterComponent& emitter,
+                          const robot2D::vec2f& origin, float dt, unsigned int budget);
+        ParticleBatch& getBatch(const ParticleEmitterComponent& emitter);
+        void pack(ParticleBatch& batch, const EmitterData& data, const ParticleEmitterComponent& emitter);
+        void upload();
+
+        Ptr cloneSelf(robot2D::ecs::Scene*, const std::vector<robot2D::ecs::Entity>& newEntities) override;
+    private:
+        robot2D::ShaderHandler m_particleShader;
+        robot2D::VertexBuffer::Ptr m_quadBuffer{nullptr};
+        robot2D::IndexBuffer::Ptr m_indexBuffer{nullptr};
+        /// Bound for emitters without texture, keeps single shader path.
+        robot2D::Texture m_whiteTexture;
+
+        std::unordered_map<robot2D::ecs::EntityID, EmitterData> m_emitters;
+        std::vector<ParticleBatch> m_batches;
+        std::minstd_rand m_random;
+        ParticleStats m_stats;
+        unsigned int m_emissionBudget{5000};
+        bool m_initialized{false};
+    };
+
+}
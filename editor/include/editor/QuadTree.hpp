@@ -1,308 +1,310 @@
 #pragma once
 
-#include <deque>
 #include <array>
-#include <memory>
-#include <list>
+#include <vector>
+#include <cstdint>
+#include <limits>
 #include <cmath>
+#include <algorithm>
 
 #include <robot2D/Graphics/Rect.hpp>
 
 
 namespace editor {
 
-    template<typename T>
-    struct QuadTreeItemLocation {
-        using ValuePair = std::pair<robot2D::FloatRect, T>;
-        typename std::list<ValuePair>* container;
-        typename std::list<ValuePair>::iterator iterator;
-    };
-
-    template<typename T>
-    struct QuadTreeItem {
-        using Container = std::list<QuadTreeItem<T>>;
-        using ContainerIterator = typename Container::iterator;
-
-        T value;
-        QuadTreeItemLocation<ContainerIterator> iterator;
-    };
-
-
     robot2D::vec2f rotatePoint(float angle, robot2D::vec2f point, robot2D::vec2f center_of_rotation);
 
+    /**
+     * \brief Loose QuadTree with nodes and items kept in flat arrays.
+     * \details Node's loose bounds are twice bigger than its tight area, so item is placed only by own size and center
+     * and never straddles children. Item rects of node are stored contiguously, search writes into caller's vector.
+     * Relocate touches at most maxDepth nodes and doesn't allocate when item stays in same node.
+     */
     template<typename T>
     class QuadTree {
-    private:
-        using Ptr = std::shared_ptr<QuadTree<T>>;
-        using ValuePair = std::pair<robot2D::FloatRect, T>;
     public:
-        QuadTree() = default;
-        QuadTree(const robot2D::FloatRect& region, std::size_t depth);
+        using ItemID = std::uint32_t;
+        static constexpr ItemID invalidItem = std::numeric_limits<ItemID>::max();
+
+        QuadTree();
         QuadTree(const QuadTree& other) = delete;
         QuadTree& operator=(const QuadTree& other) = delete;
         QuadTree(QuadTree&& other) = delete;
         QuadTree& operator=(QuadTree&& other) = delete;
         ~QuadTree() = default;
 
+        /// Clears tree and sets new root area.
         void resize(const robot2D::FloatRect& newArea);
+        void clear();
 
-        QuadTreeItemLocation<T> insert(const T& object, const robot2D::FloatRect& objectRect);
-        std::list<T> search(const robot2D::FloatRect& rect) const;
-        void search(const robot2D::FloatRect& rect, std::list<T>& items) const;
-        void search(const robot2D::vec2f& point, std::list<T>& items) const;
-
+        ItemID insert(const T& value, const robot2D::FloatRect& rect);
+        bool remove(ItemID itemID);
+        void relocate(ItemID itemID, const robot2D::FloatRect& newRect);
 
-        void items(std::list<T>& listItems) const
-        {
-            // No questions asked, just return child items
-            for (const auto& p : m_objects)
-                listItems.push_back(p.second);
+        /// Appends values which rects intersect rect.
+        void search(const robot2D::FloatRect& rect, std::vector<T>& result) const;
+        /// Appends values which rects contain point, rotated rects are respected.
+        void search(const robot2D::vec2f& point, std::vector<T>& result) const;
 
-            // Now add children of this layer's items
-            for (int i = 0; i < 4; i++)
-                if (m_childrenTrees[i])
-                    m_childrenTrees[i] -> items(listItems);
-        }
-
-
-        std::list<T> items() const
-        {
-            // No questions asked, just return child items
-            std::list<T> listItems;
-            items(listItems);
-            return listItems;
-        }
-
-        void clearAll();
+        const T& getValue(ItemID itemID) const { return m_items[itemID].value; }
+        std::size_t size() const { return m_items.size() - m_freeItems.size(); }
+        bool empty() const { return size() == 0; }
     private:
-        inline static constexpr std::size_t maxDepth = 8;
-
-        std::size_t m_depth = 0;
-
-        robot2D::FloatRect m_rect;
+        static constexpr std::size_t maxDepth = 8;
+        static constexpr std::uint32_t noNode = std::numeric_limits<std::uint32_t>::max();
+
+        struct Node {
+            robot2D::vec2f center;
+            robot2D::vec2f halfSize;
+            std::array<std::uint32_t, 4> children{noNode, noNode, noNode, noNode};
+            std::vector<robot2D::FloatRect> rects;
+            std::vector<ItemID> items;
+        };
 
-        std::array<robot2D::FloatRect, 4> m_childrenRects {};
-        std::array<Ptr, 4> m_childrenTrees {};
+        struct Item {
+            T value;
+            std::uint32_t node{noNode};
+            std::uint32_t slot{0};
+        };
 
-        std::list<ValuePair> m_objects;
+        std::uint32_t findNode(const robot2D::FloatRect& rect);
+        void link(ItemID itemID, std::uint32_t nodeIndex, const robot2D::FloatRect& rect);
+        void unlink(ItemID itemID);
+        void addSubtree(std::uint32_t nodeIndex, std::vector<T>& result) const;
+        bool looseIntersects(const Node& node, const robot2D::FloatRect& rect) const;
+        bool looseInside(const Node& node, const robot2D::FloatRect& rect) const;
+    private:
+        std::vector<Node> m_nodes;
+        std::vector<Item> m_items;
+        std::vector<ItemID> m_freeItems;
     };
 
+    namespace quadtree_detail {
+        /// Half extents of rect's bounding box, rotated rect is covered by its half diagonal.
+        inline robot2D::vec2f halfExtents(const robot2D::FloatRect& rect) {
+            robot2D::vec2f half{std::abs(rect.width) / 2.F, std::abs(rect.height) / 2.F};
+            if(rect.isRotated()) {
+                const float radius = std::sqrt(half.x * half.x + half.y * half.y);
+                return {radius, radius};
+            }
+            return half;
+        }
+    }
+
     template<typename T>
-    QuadTree<T>::QuadTree(const robot2D::FloatRect& region, std::size_t depth): m_rect{region}, m_depth(depth) {}
+    QuadTree<T>::QuadTree() {
+        m_nodes.emplace_back();
+    }
 
     template<typename T>
     void QuadTree<T>::resize(const robot2D::FloatRect& newArea) {
-        clearAll();
-        m_rect = newArea;
-
-        robot2D::vec2f childSize = { m_rect.width / 2.f, m_rect.height / 2.f };
-
-        m_childrenRects = {
-            robot2D::FloatRect { m_rect.topPoint(), childSize },
-            robot2D::FloatRect {{ m_rect.lx + childSize.x, m_rect.ly  }, childSize },
-            robot2D::FloatRect {{ m_rect.lx , m_rect.ly + childSize.y }, childSize },
-            robot2D::FloatRect { { m_rect.lx + childSize.x, m_rect.ly + childSize.y }, childSize }
-        };
+        clear();
+        auto& root = m_nodes.front();
+        root.halfSize = { std::abs(newArea.width) / 2.F, std::abs(newArea.height) / 2.F };
+        root.center = newArea.centerPoint();
+    }
 
+    template<typename T>
+    void QuadTree<T>::clear() {
+        const auto center = m_nodes.front().center;
+        const auto halfSize = m_nodes.front().halfSize;
+        m_nodes.clear();
+        m_items.clear();
+        m_freeItems.clear();
+
+        auto& root = m_nodes.emplace_back();
+        root.center = center;
+        root.halfSize = halfSize;
     }
 
     template<typename T>
-    QuadTreeItemLocation<T> QuadTree<T>::insert(const T& object, const robot2D::FloatRect& objectRect) {
-        for(int i = 0 ; i < 4; ++i) {
-            if(m_childrenRects[i].contains(objectRect)) {
-                if(m_depth + 1 < maxDepth) {
-                    if(!m_childrenTrees[i])
-                        m_childrenTrees[i] = std::make_shared<QuadTree<T>>(m_childrenRects[i], m_depth + 1);
-
-                    return m_childrenTrees[i] -> insert(object, objectRect);
-                }
-            }
+    typename QuadTree<T>::ItemID QuadTree<T>::insert(const T& value, const robot2D::FloatRect& rect) {
+        ItemID itemID;
+        if(!m_freeItems.empty()) {
+            itemID = m_freeItems.back();
+            m_freeItems.pop_back();
+            m_items[itemID].value = value;
+        }
+        else {
+            itemID = static_cast<ItemID>(m_items.size());
+            m_items.push_back({value});
         }
 
-        m_objects.push_back( std::make_pair( objectRect, object ) );
-        return { &m_objects, std::prev(m_objects.end()) };
+        link(itemID, findNode(rect), rect);
+        return itemID;
     }
 
-
     template<typename T>
-    std::list<T> QuadTree<T>::search(const robot2D::FloatRect& rect) const{
-        std::list<T> listItems;
-        search(rect, listItems);
-        return listItems;
+    bool QuadTree<T>::remove(ItemID itemID) {
+        if(itemID >= m_items.size() || m_items[itemID].node == noNode)
+            return false;
+        unlink(itemID);
+        m_items[itemID].value = T{};
+        m_freeItems.push_back(itemID);
+        return true;
     }
 
     template<typename T>
-    void QuadTree<T>::search(const robot2D::FloatRect& rect, std::list<T>& items) const {
-        // First, check for items belonging to this area, add them to the list
-        // if there is overlap
-        for (const auto& p : m_objects)
-        {
-            if (rect.intersects(p.first))
-                items.push_back(p.second);
+    void QuadTree<T>::relocate(ItemID itemID, const robot2D::FloatRect& newRect) {
+        if(itemID >= m_items.size() || m_items[itemID].node == noNode)
+            return;
+
+        auto& item = m_items[itemID];
+        const auto nodeIndex = findNode(newRect);
+        if(nodeIndex == item.node) {
+            m_nodes[nodeIndex].rects[item.slot] = newRect;
+            return;
         }
 
-        // Second, recurse through children and see if they can
-        // add to the list
-        for (int i = 0; i < 4; i++)
-        {
-            if (m_childrenTrees[i])
-            {
-                // If child is entirely contained within area, recursively
-                // add all of its children, no need to check boundaries
-                if (rect.contains(m_childrenRects[i]))
-                    m_childrenTrees[i] -> items(items);
-
-                    // If child overlaps with search area then checks need
-                    // to be made
-                else if (m_childrenRects[i].intersects(rect))
-                    m_childrenTrees[i] -> search(rect, items);
-            }
-        }
+        unlink(itemID);
+        link(itemID, nodeIndex, newRect);
     }
 
     template<typename T>
-    void QuadTree<T>::search(const robot2D::vec2f& point, std::list<T>& items) const {
-        constexpr auto getRect = [](const robot2D::vec2f& point) {
-            return robot2D::FloatRect{point.x, point.y, 1, 1};
-        };
-
-        for (const auto& p : m_objects)
-        {
-            const auto& rect = p.first;
-            if(!rect.isRotated()) {
-                auto&& pointRect = getRect(point);
-                if (pointRect.intersects(rect))
-                    items.push_back(p.second);
-            }
-            else {
-                auto pointRect = getRect(rotatePoint(rect.getRotateAngle(), point,
-                                                       rect.centerPoint()));
-                if (pointRect.intersects(rect))
-                    items.push_back(p.second);
+    std::uint32_t QuadTree<T>::findNode(const robot2D::FloatRect& rect) {
+        const auto center = rect.centerPoint();
+        const auto half = quadtree_detail::halfExtents(rect);
+
+        std::uint32_t nodeIndex = 0;
+        for(std::size_t depth = 1; depth < maxDepth; ++depth) {
+            const auto& node = m_nodes[nodeIndex];
+            const robot2D::vec2f childHalf = { node.halfSize.x / 2.F, node.halfSize.y / 2.F };
+            if(half.x > childHalf.x || half.y > childHalf.y)
+                break;
+            if(std::abs(center.x - node.center.x) > node.halfSize.x
+                || std::abs(center.y - node.center.y) > node.halfSize.y)
+                break;
+
+            const int quadrant = (center.x >= node.center.x ? 1 : 0) | (center.y >= node.center.y ? 2 : 0);
+            auto childIndex = node.children[quadrant];
+            if(childIndex == noNode) {
+                Node child;
+                child.halfSize = childHalf;
+                child.center = { node.center.x + ((quadrant & 1) ? childHalf.x : -childHalf.x),
+                                 node.center.y + ((quadrant & 2) ? childHalf.y : -childHalf.y) };
+                childIndex = static_cast<std::uint32_t>(m_nodes.size());
+                m_nodes[nodeIndex].children[quadrant] = childIndex;
+                m_nodes.emplace_back(std::move(child));
             }
+            nodeIndex = childIndex;
         }
 
-        // Second, recurse through children and see if they can
-        // add to the list
-        for (int i = 0; i < 4; i++)
-        {
-            if (m_childrenTrees[i])
-            {
-                // If child is entirely contained within area, recursively
-                // add all of its children, no need to check boundaries
-                const auto& rect = m_childrenRects[i];
-                if(!rect.isRotated()) {
-                    auto&& pointRect = getRect(point);
-                    if (pointRect.contains(rect))
-                        m_childrenTrees[i] -> items(items);
-                    else if(rect.intersects(pointRect))
-                        m_childrenTrees[i] -> search(point, items);
-                }
-                else {
-                    auto pointRect = getRect(rotatePoint(rect.getRotateAngle(), point,
-                                                           rect.centerPoint()));
-                    if (pointRect.contains(rect))
-                        m_childrenTrees[i] -> items(items);
-                    else if(rect.intersects(pointRect))
-                        m_childrenTrees[i] -> search(point, items);
-                }
-            }
-        }
+        return nodeIndex;
     }
 
-
     template<typename T>
-    void QuadTree<T>::clearAll() {
-        m_objects.clear();
-        for(auto& child: m_childrenTrees) {
-            if(!child)
-                continue;
-            child -> clearAll();
-            child.reset();
-        }
+    void QuadTree<T>::link(ItemID itemID, std::uint32_t nodeIndex, const robot2D::FloatRect& rect) {
+        auto& node = m_nodes[nodeIndex];
+        auto& item = m_items[itemID];
+        item.node = nodeIndex;
+        item.slot = static_cast<std::uint32_t>(node.items.size());
+        node.items.push_back(itemID);
+        node.rects.push_back(rect);
     }
 
-
-
     template<typename T>
-    class QuadTreeContainer {
-    private:
-        using Item = QuadTreeItem<T>;
-        using Container = std::list<Item>;
-    public:
-        using ContainerIterator = typename std::list<Item>::iterator;
-
-        QuadTreeContainer() = default;
-        QuadTreeContainer(const QuadTreeContainer& other) = delete;
-        QuadTreeContainer& operator=(const QuadTreeContainer& other) = delete;
-        QuadTreeContainer(QuadTreeContainer&& other) = delete;
-        QuadTreeContainer& operator=(QuadTreeContainer&& other) = delete;
-        ~QuadTreeContainer() = default;
-
+    void QuadTree<T>::unlink(ItemID itemID) {
+        auto& item = m_items[itemID];
+        auto& node = m_nodes[item.node];
+
+        const auto lastItem = node.items.back();
+        node.items[item.slot] = lastItem;
+        node.rects[item.slot] = node.rects.back();
+        m_items[lastItem].slot = item.slot;
+        node.items.pop_back();
+        node.rects.pop_back();
+
+        item.node = noNode;
+    }
 
-        bool empty() const { return m_container.empty(); }
-        std::size_t size() const { m_container.size(); }
+    template<typename T>
+    bool QuadTree<T>::looseIntersects(const Node& node, const robot2D::FloatRect& rect) const {
+        const float minX = std::min(rect.lx, rect.lx + rect.width);
+        const float minY = std::min(rect.ly, rect.ly + rect.height);
+        const float maxX = std::max(rect.lx, rect.lx + rect.width);
+        const float maxY = std::max(rect.ly, rect.ly + rect.height);
+        return maxX >= node.center.x - 2.F * node.halfSize.x && minX <= node.center.x + 2.F * node.halfSize.x
+            && maxY >= node.center.y - 2.F * node.halfSize.y && minY <= node.center.y + 2.F * node.halfSize.y;
+    }
 
-        void resizeRectangle(const robot2D::FloatRect& newArea) {
-            m_tree.resize(newArea);
-        }
+    template<typename T>
+    bool QuadTree<T>::looseInside(const Node& node, const robot2D::FloatRect& rect) const {
+        const float minX = std::min(rect.lx, rect.lx + rect.width);
+        const float minY = std::min(rect.ly, rect.ly + rect.height);
+        const float maxX = std::max(rect.lx, rect.lx + rect.width);
+        const float maxY = std::max(rect.ly, rect.ly + rect.height);
+        return minX <= node.center.x - 2.F * node.halfSize.x && maxX >= node.center.x + 2.F * node.halfSize.x
+            && minY <= node.center.y - 2.F * node.halfSize.y && maxY >= node.center.y + 2.F * node.halfSize.y;
+    }
 
-        void clear() {
-            m_tree.clearAll();
-            m_container.clear();
-        }
+    template<typename T>
+    void QuadTree<T>::addSubtree(std::uint32_t nodeIndex, std::vector<T>& result) const {
+        const auto& node = m_nodes[nodeIndex];
+        for(const auto itemID: node.items)
+            result.push_back(m_items[itemID].value);
+        for(const auto child: node.children)
+            if(child != noNode)
+                addSubtree(child, result);
+    }
 
-        ContainerIterator begin() const { return m_container.begin(); }
-        ContainerIterator end() const { { return m_container.begin(); }}
-        typename Container::const_iterator cbegin() const { return m_container.cbegin(); }
-        typename Container::const_iterator cend() const { return m_container.cend(); }
+    template<typename T>
+    void QuadTree<T>::search(const robot2D::FloatRect& rect, std::vector<T>& result) const {
+        std::array<std::uint32_t, 4 * maxDepth> stack;
+        std::size_t stackSize = 0;
+        stack[stackSize++] = 0;
+
+        while(stackSize > 0) {
+            const auto nodeIndex = stack[--stackSize];
+            const auto& node = m_nodes[nodeIndex];
+
+            /// root also keeps items out of its area, so it's checked anyway
+            if(nodeIndex != 0 && looseInside(node, rect)) {
+                addSubtree(nodeIndex, result);
+                continue;
+            }
 
+            for(std::size_t i = 0; i < node.rects.size(); ++i) {
+                if(rect.intersects(node.rects[i]))
+                    result.push_back(m_items[node.items[i]].value);
+            }
 
-        ContainerIterator insert(const T& value, const robot2D::FloatRect& rect) {
-            Item item;
-            item.value = value;
-            m_container.push_back(item);
-            auto& backItem = m_container.back();
-            auto lastIterator = std::prev(m_container.end());
-            backItem.iterator = m_tree.insert(lastIterator, rect);
-            return lastIterator;
+            for(const auto child: node.children) {
+                if(child != noNode && looseIntersects(m_nodes[child], rect))
+                    stack[stackSize++] = child;
+            }
         }
+    }
 
-        std::list<ContainerIterator> search(const robot2D::FloatRect& rect) const
-        {
-            std::list<ContainerIterator> searchItems;
-            m_tree.search(rect, searchItems);
-            return searchItems;
-        }
+    template<typename T>
+    void QuadTree<T>::search(const robot2D::vec2f& point, std::vector<T>& result) const {
+        const robot2D::FloatRect pointRect{point.x, point.y, 1, 1};
 
-        std::list<ContainerIterator> search(const robot2D::vec2f& point) const
-        {
-            std::list<ContainerIterator> searchItems;
-            m_tree.search(point, searchItems);
-            return searchItems;
-        }
+        std::array<std::uint32_t, 4 * maxDepth> stack;
+        std::size_t stackSize = 0;
+        stack[stackSize++] = 0;
 
-        bool remove(ContainerIterator& item) {
-            auto* container = item -> iterator.container;
-            if(!container)
-                return false;
-            container -> erase(item -> iterator.iterator);
-            m_container.erase(item);
-            return true;
-        }
+        while(stackSize > 0) {
+            const auto& node = m_nodes[stack[--stackSize]];
 
-        void relocate(ContainerIterator& item, const robot2D::FloatRect& newRect) {
-            auto* container = item -> iterator.container;
-            if(!container)
-                return;
-            container -> erase(item -> iterator.iterator);
+            for(std::size_t i = 0; i < node.rects.size(); ++i) {
+                const auto& rect = node.rects[i];
+                if(!rect.isRotated()) {
+                    if(pointRect.intersects(rect))
+                        result.push_back(m_items[node.items[i]].value);
+                }
+                else {
+                    robot2D::FloatRect rotatedPointRect{
+                        rotatePoint(rect.getRotateAngle(), point, rect.centerPoint()), {1, 1}};
+                    if(rotatedPointRect.intersects(rect))
+                        result.push_back(m_items[node.items[i]].value);
+                }
+            }
 
-            item -> iterator = m_tree.insert(item, newRect);
+            for(const auto child: node.children) {
+                if(child != noNode && looseIntersects(m_nodes[child], pointRect))
+                    stack[stackSize++] = child;
+            }
         }
-    private:
-        Container m_container;
-        QuadTree<ContainerIterator> m_tree;
-    };
-
+    }
 
-}
\ No newline at end of file
+}
@@ -26,6 +26,7 @@ source distribution.
 #include <robot2D/Graphics/FrameBuffer.hpp>
 
 #include <robot2D/Graphics/Drawable.hpp>
+#include <robot2D/Graphics/RenderCommandList.hpp>
 
 namespace editor {
 
@@ -47,7 +48,21 @@ namespace editor {
         void draw(robot2D::RenderTarget& target, robot2D::RenderStates states) const override;
     private:
         Ptr cloneSelf(robot2D::ecs::Scene*, const std::vector<robot2D::ecs::Entity>& newEntities) override;
+
+        /// Builds quads of entities into command lists, big scenes are split between worker threads.
+        void recordQuads() const;
+
+        /// Clears batched flag of entities out of their layer's view, needs SpatialSystem in scene.
+        void cullEntities(const robot2D::RenderTarget& target) const;
+
+        /// Creates or updates glyph atlas page textures on render thread before recording.
+        void resolveGlyphPages() const;
+
+        /// Records text's glyphs as regular quads, so texts share layer batch with sprites.
+        void recordText(robot2D::RenderCommandList& commandList, const robot2D::ecs::Entity& ent, int sortKey) const;
     private:
+        static constexpr std::size_t minQuadsPerRecordJob = 2048;
+
         bool m_needUpdateZBuffer;
         bool m_runtimeFlag{false};
 
@@ -63,6 +78,16 @@ namespace editor {
 
         std::vector<InsertItem> m_insertItems;
         robot2D::View m_cameraView;
+        mutable std::vector<robot2D::RenderCommandList> m_commandLists;
+        /// Filled on render thread, workers only read it.
+        mutable std::vector<bool> m_batchedEntities;
+        /// Indexed by entity index, true when entity's bounds intersect view of its layer.
+        mutable std::vector<bool> m_visibleEntities;
+        mutable std::vector<robot2D::ecs::Entity> m_foundEntities;
+        mutable bool m_cullingEnabled{false};
+        /// Glyph atlas page textures by page index, resolved once per frame.
+        mutable std::vector<const robot2D::Texture*> m_glyphPages;
+        mutable bool m_textsEnabled{false};
     };
 
 }
\ No newline at end of file
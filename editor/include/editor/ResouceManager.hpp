@@ -21,9 +21,12 @@ source distribution.
 
 #pragma once
 
+#include <algorithm>
 #include <string>
 #include <mutex>
+#include <memory>
 
+#include <robot2D/Core/AssetPack.hpp>
 #include <robot2D/Graphics/Texture.hpp>
 #include <robot2D/Graphics/Font.hpp>
 #include <robot2D/Util/ResourceHandler.hpp>
@@ -55,6 +58,24 @@ namespace editor {
             return m_images.has(id);
         }
 
+        /// Block compressed mip chain exported next to image, scene textures prefer it over image's pixels.
+        robot2D::CompressedImage* addCompressedImage(const std::string& id) {
+            std::lock_guard<std::mutex> lockGuard{m_mutex};
+            return m_compressedImages.add(id);
+        }
+
+        /// Creates texture from image's compressed container when it was loaded, otherwise from image.
+        bool createTexture(const std::string& id, robot2D::Texture& texture) {
+            std::lock_guard<std::mutex> lockGuard{m_mutex};
+            if(m_compressedImages.has(id) && !m_compressedImages.get(id).empty()
+               && texture.create(m_compressedImages.get(id)))
+                return true;
+            if(!m_images.has(id))
+                return false;
+            texture.create(m_images.get(id));
+            return true;
+        }
+
         robot2D::Font* addFont(const std::string& id) {
             std::lock_guard<std::mutex> lockGuard{m_mutex};
             return m_fonts.add(id);
@@ -95,11 +116,43 @@ namespace editor {
             std::lock_guard<std::mutex> lockGuard{m_mutex};
             return m_animations.at(uuid);
         }
+
+        /// Exported project keeps assets in one pack, loaders look there before loose files.
+        bool openAssetPack(const std::string& path) {
+            auto assetPack = std::make_shared<robot2D::AssetPack>();
+            if(!assetPack -> openFromFile(path))
+                return false;
+            std::lock_guard<std::mutex> lockGuard{m_mutex};
+            m_assetPack = std::move(assetPack);
+            return true;
+        }
+
+        /// Project without pack reads loose files only.
+        void closeAssetPack() {
+            std::lock_guard<std::mutex> lockGuard{m_mutex};
+            m_assetPack.reset();
+        }
+
+        std::shared_ptr<robot2D::AssetPack> getAssetPack() const {
+            std::lock_guard<std::mutex> lockGuard{m_mutex};
+            return m_assetPack;
+        }
+
+        /// Fonts read pack's memory directly, so pack they were loaded from lives as long as fonts.
+        void holdAssetPack(std::shared_ptr<robot2D::AssetPack> assetPack) {
+            std::lock_guard<std::mutex> lockGuard{m_mutex};
+            if(!assetPack || std::find(m_fontPacks.begin(), m_fontPacks.end(), assetPack) != m_fontPacks.end())
+                return;
+            m_fontPacks.emplace_back(std::move(assetPack));
+        }
     private:
         mutable std::mutex m_mutex;
         robot2D::ResourceHandler<robot2D::Image, std::string> m_images;
+        robot2D::ResourceHandler<robot2D::CompressedImage, std::string> m_compressedImages;
         robot2D::ResourceHandler<robot2D::Font, std::string> m_fonts;
         std::unordered_map<UUID, std::vector<std::string>> m_animationPaths;
         std::unordered_map<UUID, std::vector<Animation>> m_animations;
+        std::shared_ptr<robot2D::AssetPack> m_assetPack;
+        std::vector<std::shared_ptr<robot2D::AssetPack>> m_fontPacks;
     };
 }
\ No newline at end of file
@@ -25,6 +25,8 @@ source distribution.
 #include <cassert>
 #include <functional>
 #include <list>
+#include <unordered_set>
+#include <utility>
 
 #include <robot2D/Ecs/Scene.hpp>
 #include <robot2D/Ecs/Entity.hpp>
@@ -39,8 +41,11 @@ source distribution.
 #include "EditorCamera.hpp"
 #include "SceneEntity.hpp"
 #include "SceneGraph.hpp"
+#include "ParticleSystem.hpp"
+#include "serializers/SceneFragmentCache.hpp"
 
 namespace editor {
+    class SpatialSystem;
 
     class Scene : public robot2D::Drawable {
     public:
@@ -88,6 +93,8 @@ namespace editor {
         void restoreEntities(DeletedEntitiesRestoreInformation& restoreInformation);
 
         SceneEntity getEntity(UUID uuid) const;
+        /// Runtime scene's index while running, scripts query it for rect / point / ray.
+        const SpatialSystem* getSpatialSystem() const;
 
         bool isRunning() const { return m_running; }
 
@@ -112,6 +119,16 @@ namespace editor {
         void setEditorCamera(EditorCamera::Ptr editorCamera);
 
         bool hasChanges() const { return m_hasChanges; }
+        void setHasChanges(bool flag) { m_hasChanges = flag; }
+
+        /// Entity's non transform components were edited, its YAML is emitted again on next save.
+        void markDirty(const SceneEntity& entity);
+        SceneFragmentCache& getFragmentCache() { return m_fragmentCache; }
+        /// Entities marked dirty since previous call, consumed by SceneJournal.
+        std::unordered_set<UUID> takeEditedEntities() { return std::exchange(m_editedEntities, {}); }
+
+        /// Particles cost of current frame, runtime scene's one while running.
+        ParticleStats getParticleStats() const;
 
         /// \brief use for simple traverse inside Scene and don't think how SceneGraph works by outside caller.
         void traverseGraph(TraverseFunction&& traverseFunction);
@@ -156,6 +173,8 @@ namespace editor {
         std::string m_associatedProjectPath;
         bool m_running = false;
         bool m_hasChanges{false};
+        SceneFragmentCache m_fragmentCache;
+        std::unordered_set<UUID> m_editedEntities;
 
         using Iterator = std::list<SceneEntity>::iterator;   
         using SetItem = std::tuple<Iterator, SceneEntity, bool, SceneEntity>;
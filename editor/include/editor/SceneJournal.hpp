@@ -0,0 +1,123 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include <editor/Uuid.hpp>
+
+namespace YAML {
+    class Node;
+}
+
+namespace editor {
+    class Scene;
+    class IScriptInteractorFrom;
+
+    /**
+     * \brief Write-ahead log of scene edits made since last save, kept next to scene file.
+     * \details Editor periodically captures entities changed since previous capture, removed entities and new order
+     * and appends them to log, file is written by background thread. Scene load replays log onto saved scene,
+     * so crash loses only edits of last capture interval. Log is emptied when scene is saved
+     * and removed when changes are discarded.
+     */
+    class SceneJournal {
+    public:
+        SceneJournal() = default;
+        SceneJournal(const SceneJournal& other) = delete;
+        SceneJournal& operator=(const SceneJournal& other) = delete;
+        SceneJournal(SceneJournal&& other) = delete;
+        SceneJournal& operator=(SceneJournal&& other) = delete;
+        ~SceneJournal();
+
+        static std::string getJournalPath(const std::string& scenePath);
+        /// Applies log of scene onto its saved YAML. False if there is no log or it was written for other save.
+        static bool replay(const std::string& scenePath, YAML::Node& sceneNode);
+
+        /// Starts journaling of loaded scene, log of this save is continued, stale one is started anew.
+        void start(Scene& scene);
+        /// Writes queued records and stops background thread.
+        void stop();
+
+        /// Captures changes when interval passed or capture was requested.
+        void update(float dt, Scene& scene, std::shared_ptr<IScriptInteractorFrom> scriptInteractor);
+        void requestCapture() { m_captureRequested = true; }
+        void capture(Scene& scene, std::shared_ptr<IScriptInteractorFrom> scriptInteractor);
+
+        /// Scene file has all changes now, log is emptied.
+        void markSaved(Scene& scene);
+        /// Unsaved changes are dropped, log file is removed.
+        void discard();
+    private:
+        struct EntityState {
+            std::uint32_t transformVersion{0};
+            std::uint64_t hierarchyHash{0};
+            std::uint32_t generation{0};
+        };
+
+        struct Operation {
+            enum class Type {
+                /// Keeps log if its header matches, otherwise starts it anew.
+                Open,
+                Append,
+                Reset,
+                Remove
+            } type;
+            std::string path;
+            std::string bytes;
+        };
+
+        /// Updates known entities states, calls onChanged for new and changed ones, returns order hash.
+        template<typename Callback>
+        std::uint64_t scan(Scene& scene, Callback&& onChanged);
+        std::string makeHeader() const;
+        void push(Operation&& operation);
+        void writerWork();
+        static void execute(const Operation& operation);
+    private:
+        static constexpr float captureInterval = 2.F;
+
+        std::string m_scenePath;
+        std::string m_path;
+        std::unordered_map<UUID, EntityState> m_entities;
+        std::uint64_t m_orderHash{0};
+        std::uint32_t m_generation{0};
+        float m_timer{0.F};
+        bool m_captureRequested{false};
+        bool m_active{false};
+
+        std::thread m_thread;
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::deque<Operation> m_operations;
+        bool m_running{false};
+    };
+
+} // namespace editor
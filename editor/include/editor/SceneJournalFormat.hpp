@@ -0,0 +1,53 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace editor::journal {
+    /// File starts with magic, version, reserved field and stamp of scene save which journal belongs to.
+    constexpr std::uint32_t magic = 0x4C4A3252; // "R2JL"
+    constexpr std::uint16_t version = 1;
+
+    /// Record is payload size, checksum of type and payload, type and payload itself.
+    enum class RecordType: std::uint8_t {
+        /// Entity's UUID and its YAML as one element sequence.
+        Upsert = 1,
+        /// Entity's UUID.
+        Remove,
+        /// UUIDs of all entities in scene file order.
+        Order
+    };
+
+    template<typename T>
+    void write(std::string& bytes, T value) {
+        bytes.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    /// Journal belongs to one save of scene, size and write time of file identify it.
+    std::uint64_t sceneStamp(const std::string& scenePath);
+    std::string makeHeader(std::uint64_t stamp);
+    void appendRecord(std::string& bytes, RecordType type, const std::string& payload);
+
+} // namespace editor::journal
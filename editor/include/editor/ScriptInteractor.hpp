@@ -114,6 +114,13 @@ namespace editor {
         virtual void exitEngineRuntime() = 0;
         virtual SceneEntity duplicateRuntime(SceneEntity entity,
                                                       robot2D::vec2f position = robot2D::vec2f{}) = 0;
+
+        /// Spatial queries of simulated scene, result gets UUIDs of found entities.
+        virtual void queryEntities(const robot2D::FloatRect& rect, std::vector<std::uint64_t>& result) = 0;
+        virtual void queryEntities(const robot2D::vec2f& point, std::vector<std::uint64_t>& result) = 0;
+        /// Result is sorted from start of segment to its end.
+        virtual void rayCastEntities(const robot2D::vec2f& from, const robot2D::vec2f& to,
+                                     std::vector<std::uint64_t>& result) = 0;
     };
 
     class ScriptingEngineService;
@@ -132,6 +139,10 @@ namespace editor {
         bool loadSceneRuntime(std::string &&name) override;
         void exitEngineRuntime() override;
         SceneEntity duplicateRuntime(editor::SceneEntity entity, robot2D::vec2f position = robot2D::vec2f{}) override;
+        void queryEntities(const robot2D::FloatRect& rect, std::vector<std::uint64_t>& result) override;
+        void queryEntities(const robot2D::vec2f& point, std::vector<std::uint64_t>& result) override;
+        void rayCastEntities(const robot2D::vec2f& from, const robot2D::vec2f& to,
+                             std::vector<std::uint64_t>& result) override;
         //////////////////////////////////////////////// IScriptInteractor ////////////////////////////////////////////////
 
         //////////////////////////////////////////////// IScriptInteractorFrom ////////////////////////////////////////////////
@@ -144,6 +155,9 @@ namespace editor {
         void setEditorCamera(EditorCamera::Ptr editorCamera) override;
         ScriptingEngineService* getScriptingEngine() const override;
         //////////////////////////////////////////////// IScriptInteractorFrom ////////////////////////////////////////////////
+    private:
+        /// Appends UUIDs of entities which have IDComponent.
+        static void appendIDs(const std::vector<robot2D::ecs::Entity>& entities, std::vector<std::uint64_t>& result);
     private:
         EditorInteractor::WeakPtr m_editorInteractor;
         ScriptingEngineService* m_scriptingEngine;
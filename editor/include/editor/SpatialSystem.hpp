@@ -0,0 +1,70 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include <robot2D/Ecs/System.hpp>
+#include <robot2D/Ecs/SpatialIndex.hpp>
+
+namespace editor {
+
+    /**
+     * \brief Keeps global bounds of every transformed entity in SpatialIndex.
+     * \details Proxies are moved only when TransformComponent's version changed since last update,
+     * so static entities cost nothing. Runtime systems and scripts ask it for rect / point / ray queries.
+     */
+    class SpatialSystem: public robot2D::ecs::System {
+    public:
+        SpatialSystem(robot2D::MessageBus& messageBus);
+        SpatialSystem(const SpatialSystem& other) = delete;
+        SpatialSystem& operator=(const SpatialSystem& other) = delete;
+        SpatialSystem(SpatialSystem&& other) = delete;
+        SpatialSystem& operator=(SpatialSystem&& other) = delete;
+        ~SpatialSystem() override = default;
+
+        void update(float dt) override;
+
+        void query(const robot2D::FloatRect& rect, std::vector<robot2D::ecs::Entity>& result) const;
+        void query(const robot2D::vec2f& point, std::vector<robot2D::ecs::Entity>& result) const;
+        void rayCast(const robot2D::vec2f& from, const robot2D::vec2f& to,
+                     std::vector<robot2D::ecs::SpatialIndex::RayHit>& result) const;
+
+        const robot2D::ecs::SpatialIndex& getIndex() const { return m_index; }
+    private:
+        void onEntityAdded(robot2D::ecs::Entity entity) override;
+        void onEntityRemoved(robot2D::ecs::Entity entity) override;
+        Ptr cloneSelf(robot2D::ecs::Scene* scene, const std::vector<robot2D::ecs::Entity>& newEntities) override;
+    private:
+        struct Proxy {
+            robot2D::ecs::SpatialIndex::ProxyID id{robot2D::ecs::SpatialIndex::nullProxy};
+            std::uint32_t version{0};
+        };
+
+        robot2D::ecs::SpatialIndex m_index;
+        /// indexed by entity index
+        std::vector<Proxy> m_proxies;
+    };
+
+}
@@ -21,10 +21,46 @@ source distribution.
 
 #pragma once
 #include <cstdint>
+#include <atomic>
+#include <memory>
+
+#include <robot2D/Core/JobSystem.hpp>
 #include "TaskFunction.hpp"
 
 namespace editor {
     using TaskID = std::uint32_t;
+    using TaskPriority = robot2D::JobPriority;
+
+    /// \brief State shared by task running on worker and its handles on main thread.
+    struct TaskState {
+        TaskID id{0};
+        const char* name{""};
+        bool cancellable{true};
+        std::atomic<bool> cancelled{false};
+        std::atomic<bool> finished{false};
+        std::atomic<float> progress{0.F};
+    };
+
+    /// \brief Lets caller follow and cancel scheduled task, empty handle means task wasn't scheduled.
+    class TaskHandle {
+    public:
+        TaskHandle() = default;
+        explicit TaskHandle(std::shared_ptr<TaskState> state): m_state{std::move(state)} {}
+
+        bool valid() const { return m_state != nullptr; }
+        TaskID getTaskID() const { return m_state ? m_state -> id : 0; }
+        const char* getName() const { return m_state ? m_state -> name : ""; }
+
+        /// Task stops at its next check, its callback isn't called.
+        void cancel() { if(m_state && m_state -> cancellable) m_state -> cancelled = true; }
+        bool isCancellable() const { return m_state && m_state -> cancellable; }
+        bool isCancelled() const { return m_state && m_state -> cancelled; }
+        bool isFinished() const { return !m_state || m_state -> finished; }
+        /// Fraction in [0, 1] reported by task itself.
+        float getProgress() const { return m_state ? m_state -> progress.load() : 1.F; }
+    private:
+        std::shared_ptr<TaskState> m_state{nullptr};
+    };
 
     class ITask {
     public:
@@ -41,10 +77,24 @@ namespace editor {
 
         virtual void call();
         TaskID getTaskID() const;
+        TaskHandle getHandle() const { return TaskHandle{m_state}; }
+
+        /// Exclusive tasks never overlap each other, others run in parallel with anything.
+        virtual bool isExclusive() const { return false; }
+        virtual TaskPriority getPriority() const { return TaskPriority::Normal; }
+        /// Shown in editor's task list.
+        virtual const char* getName() const { return "Task"; }
+        /// Tasks which callback must always run (like scene load) return false.
+        virtual bool isCancellable() const { return true; }
+
+        /// Long tasks check it between steps and return early.
+        bool isCancelled() const { return m_state -> cancelled.load(std::memory_order_relaxed); }
+    protected:
+        void setProgress(float progress);
     protected:
         friend class TaskQueue;
 
         ITaskFunction::Ptr m_function;
-        TaskID m_taskID{ 0 };
+        std::shared_ptr<TaskState> m_state;
     };
 }
\ No newline at end of file
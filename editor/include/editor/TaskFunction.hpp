@@ -46,7 +46,8 @@ namespace editor {
                 // TODO log
                 return;
             }
-            const T* funcData = static_cast<T*>(buffer);
+            /// callback may take results out of finished task, nothing reads it afterwards
+            T* funcData = static_cast<T*>(buffer);
             if(funcData)
                 m_func(*funcData);
         }
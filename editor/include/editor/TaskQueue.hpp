@@ -20,16 +20,17 @@ source distribution.
 *********************************************************************/
 
 #pragma once
-#include <thread>
 #include <mutex>
-#include <shared_mutex>
-#include <condition_variable>
-#include <queue>
-#include <atomic>
+#include <vector>
 
+#include <robot2D/Core/JobSystem.hpp>
 #include "Task.hpp"
 
 namespace editor {
+    /**
+     * \brief Runs editor tasks on core JobSystem workers, results are delivered on main thread in process.
+     * \details Independent tasks run in parallel, exclusive ones (see ITask::isExclusive) wait for previous exclusive task.
+     */
     class TaskQueue {
     public:
         TaskQueue(const TaskQueue&) = delete;
@@ -43,50 +44,57 @@ namespace editor {
             return &taskQueue;
         }
 
+        /// \brief Callback is called on main thread in process, unless task was cancelled.
         template<typename T, typename ... Args, typename Callback>
-        TaskID addAsyncTask(Callback&& callback, Args&& ...args) {
+        TaskHandle addAsyncTask(Callback&& callback, Args&& ...args) {
 
             auto function = std::make_shared<TaskFunction<T, Callback>>(std::forward<Callback>(callback));
             if(!function) {
                 //TODO: add logging
-                return -1;
+                return {};
             }
             auto task = std::make_shared<T>(function, std::forward<Args>(args)...);
-
-
-            task -> m_taskID = m_currentId;
-            ++m_currentId;
             if(!task) {
                 //TODO: add logging
-                return -1;
-            }
-            {
-                std::lock_guard<std::mutex> lock(m_inputMutex);
-                m_inputTasksQueue.push(task);
-                data_cond.notify_one();
+                return {};
             }
-            return 0;
+
+            return schedule(task);
         }
 
+        /// Delivers finished tasks' callbacks within frame budget, interactive ones first.
         void process();
         void stop();
 
-        /// TODO(a.raag): create correct method
-        bool hasPendingTasks() const { return false; }
+        /// Tasks which callback wasn't delivered yet, plain background jobs (imports, thumbnails) aren't counted.
+        bool hasPendingTasks() const {
+            std::lock_guard<std::mutex> lock{m_activeMutex};
+            return !m_activeTasks.empty();
+        }
+
+        /// Tasks may split own work into jobs of same pool.
+        robot2D::JobSystem& getJobSystem() { return m_jobSystem; }
+
+        /// Handles of tasks which callback wasn't delivered yet, in scheduling order.
+        void getActiveTasks(std::vector<TaskHandle>& result) const;
 
         /// remove all ?
         void clear();
     private:
         TaskQueue();
-        void threadWork();
+        TaskHandle schedule(ITask::Ptr task);
+        void removeActiveTask(TaskID taskID);
     private:
-        std::thread m_thread;
-        std::mutex m_inputMutex;
-        std::mutex m_outputMutex;
-        std::queue<ITask::Ptr> m_inputTasksQueue;
-        std::queue<ITask::Ptr> m_outputTasksQueue;
-        std::condition_variable data_cond;
-        std::uint32_t m_currentId;
-        std::atomic_bool m_running;
+        /// Main thread time given to task callbacks per frame.
+        static constexpr std::int64_t processBudgetMicroSeconds = 4000;
+
+        /// engine's parallel parts use same pool
+        robot2D::JobSystem& m_jobSystem;
+        std::mutex m_exclusiveMutex;
+        robot2D::JobHandle m_lastExclusiveJob;
+
+        mutable std::mutex m_activeMutex;
+        std::vector<TaskHandle> m_activeTasks;
+        std::atomic<TaskID> m_currentId;
     };
 }
\ No newline at end of file
@@ -0,0 +1,105 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+#include <robot2D/Core/JobSystem.hpp>
+#include <robot2D/Graphics/Texture.hpp>
+
+namespace editor {
+
+    /**
+     * \brief Makes thumbnails of project's images on workers and keeps them on one atlas texture.
+     * \details Worker takes thumbnail from ImportCache (or decodes and box filters image into it), centers it
+     * in transparent RGBA cell and main thread copies cell into atlas in job's completion.
+     * When atlas is full cell of thumbnail which wasn't requested longest time is reused.
+     * Everything except jobs runs on main thread.
+     */
+    class ThumbnailService {
+    public:
+        static constexpr unsigned int atlasSize = 2048;
+        static constexpr unsigned int cellSize = 128;
+
+        struct Thumbnail {
+            robot2D::vec2f uv0;
+            robot2D::vec2f uv1;
+        };
+
+        ThumbnailService();
+        ThumbnailService(const ThumbnailService& other) = delete;
+        ThumbnailService& operator=(const ThumbnailService& other) = delete;
+        ThumbnailService(ThumbnailService&& other) = delete;
+        ThumbnailService& operator=(ThumbnailService&& other) = delete;
+        ~ThumbnailService() = default;
+
+        /// Thumbnails requested before next frame are kept on atlas.
+        void beginFrame() { ++m_frame; }
+
+        /// Thumbnail placed on atlas, otherwise its job is scheduled and nullptr is returned.
+        const Thumbnail* getThumbnail(const std::string& path, robot2D::JobSystem& jobSystem);
+
+        /// File was changed or removed, thumbnail is made again on next request.
+        void invalidate(const std::string& path);
+
+        const robot2D::Texture& getAtlas() const { return m_atlas; }
+    private:
+        static constexpr unsigned int cellsPerRow = atlasSize / cellSize;
+        static constexpr int noCell = -1;
+
+        enum class State {
+            Pending,
+            Ready,
+            /// Image can't be decoded, generic icon stays.
+            Failed
+        };
+
+        struct Entry {
+            State state{State::Pending};
+            int cell{noCell};
+            std::uint64_t lastUse{0};
+            /// Completion of older request is ignored.
+            std::uint64_t request{0};
+            Thumbnail thumbnail;
+        };
+
+        void schedule(const std::string& path, std::uint64_t request, robot2D::JobSystem& jobSystem);
+        void place(const std::string& path, std::uint64_t request, const std::vector<std::uint8_t>& pixels);
+        int takeCell();
+    private:
+        robot2D::Texture m_atlas;
+        std::unordered_map<std::string, Entry> m_entries;
+        /// Path of thumbnail by cell, empty for free cell.
+        std::vector<std::string> m_cells;
+        std::uint64_t m_frame{0};
+        std::uint64_t m_requests{0};
+        bool m_atlasCreated{false};
+        /// Completions check it, so service can go away before its jobs.
+        std::shared_ptr<bool> m_alive;
+    };
+
+}
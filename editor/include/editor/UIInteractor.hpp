@@ -47,6 +47,8 @@ namespace editor {
 
         virtual std::vector<SceneEntity>& getSelectedEntities()  = 0;
         virtual SceneEntity findEntity(const robot2D::vec2i& mousePos) = 0;
+        /// Marquee selection by indices read from viewport's entity ID attachment, -1 is empty pixel.
+        virtual void findSelectEntities(const std::vector<int>& entityIndices) = 0;
 
         virtual void restoreDeletedEntities(DeletedEntitiesRestoreInformation& restoreInformation,
                                             DeletedEntitiesRestoreUIInformation& restoreUiInformation) = 0;
@@ -62,6 +64,8 @@ namespace editor {
         virtual void removeEntityChild(SceneEntity entity) = 0;
         virtual bool isRunning() const = 0;
         virtual SceneEntity getEntity(UUID uuid) = 0;
+        /// Entity was edited outside of scene's api, e.g. by inspector.
+        virtual void markEntityDirty(SceneEntity entity) = 0;
 
         virtual void uiSelectedEntities(std::set<ITreeItem::Ptr>& uiItems, bool isAll) = 0;
 
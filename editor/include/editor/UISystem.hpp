@@ -2,6 +2,7 @@
 
 #include <functional>
 #include <robot2D/Ecs/System.hpp>
+#include <robot2D/Ecs/SpatialIndex.hpp>
 #include <robot2D/Core/Event.hpp>
 #include "EditorCamera.hpp"
 
@@ -36,7 +37,25 @@ namespace editor {
         std::uint32_t addMouseHoverCallback(MouseHoverCallback&& callback);
         std::uint32_t addMouseUnHoverCallback(MouseHoverCallback&& callback);
 
+        /// Entities which hitboxes contain point, hitboxes are kept in SpatialIndex.
+        void query(const robot2D::vec2f& point, std::vector<robot2D::ecs::Entity>& result) const;
     private:
+        void onEntityAdded(robot2D::ecs::Entity entity) override;
+        void onEntityRemoved(robot2D::ecs::Entity entity) override;
+        /// Moves proxies of hitboxes which area was changed since last update.
+        void updateProxies();
+    private:
+        struct Proxy {
+            robot2D::ecs::SpatialIndex::ProxyID id{robot2D::ecs::SpatialIndex::nullProxy};
+            robot2D::FloatRect area;
+        };
+
+        robot2D::ecs::SpatialIndex m_index;
+        /// indexed by entity index
+        std::vector<Proxy> m_proxies;
+        std::vector<robot2D::ecs::Entity> m_hoveredEntities;
+        std::vector<robot2D::ecs::Entity> m_foundEntities;
+
         std::vector<MousePressedCallback> m_mousePressedCallbacks;
         std::vector<MouseHoverCallback> m_mouseHoverCallbacks;
         std::vector<MouseHoverCallback> m_mouseUnHoverCallbacks;
@@ -38,6 +38,8 @@ namespace editor {
         ~AnimationTextureSliceTask() override = default;
 
         void execute() override;
+        TaskPriority getPriority() const override { return TaskPriority::Interactive; }
+        const char* getName() const override { return "Texture Slice"; }
         [[nodiscard]] const std::string& getFileName() const { return m_fileName; }
         [[nodiscard]] const std::string& getFilePath() const { return m_filePath; }
         [[nodiscard]] const std::vector<robot2D::IntRect>& getRects() const { return m_frameRects; }
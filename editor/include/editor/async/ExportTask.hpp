@@ -31,7 +31,10 @@ namespace editor {
 
 
         void execute() override;
+        TaskPriority getPriority() const override { return TaskPriority::Background; }
+        const char* getName() const override { return "Export"; }
     private:
-        const ExportOptions& m_exportOptions;
+        /// copy, task outlives caller's options when it runs on worker
+        ExportOptions m_exportOptions;
     };
 } // namespace editor
\ No newline at end of file
@@ -39,6 +39,8 @@ namespace editor {
         ~FontLoadTask() override = default;
 
         void execute() override;
+        TaskPriority getPriority() const override { return TaskPriority::Interactive; }
+        const char* getName() const override { return "Font Load"; }
         const robot2D::Font& getFont() const { return m_font; }
         SceneEntity getEntity() const { return std::move(m_entity); }
     private:
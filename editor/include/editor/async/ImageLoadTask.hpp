@@ -39,8 +39,12 @@ namespace editor {
         ~ImageLoadTask() override = default;
 
         void execute() override;
+        TaskPriority getPriority() const override { return TaskPriority::Interactive; }
+        const char* getName() const override { return "Image Load"; }
         const robot2D::Image& getImage() const { return m_image; }
-        SceneEntity getEntity() const { return std::move(m_entity); }
+        /// Callback takes decoded pixels to texture without copy.
+        robot2D::Image takeImage() { return std::move(m_image); }
+        SceneEntity getEntity() const { return m_entity; }
     private:
         std::string m_imagePath;
         robot2D::Image m_image;
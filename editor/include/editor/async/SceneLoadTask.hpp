@@ -22,7 +22,10 @@ source distribution.
 #pragma once
 #include <string>
 #include <functional>
+#include <vector>
+#include <memory>
 
+#include <robot2D/Core/AssetPack.hpp>
 #include <editor/Scene.hpp>
 #include <editor/Task.hpp>
 #include <editor/ScriptInteractor.hpp>
@@ -42,15 +45,37 @@ namespace editor {
         ~SceneLoadTask() override = default;
 
         void execute() override;
+        /// Deserializer and script interactor aren't safe to share between two scene loads.
+        bool isExclusive() const override { return true; }
+        /// Editor stays in Load state until callback switches it back.
+        bool isCancellable() const override { return false; }
+        const char* getName() const override { return "Scene Load"; }
         Scene::Ptr getScene() const { return m_scene; }
         SceneLoadChainCallback getChainCallback() const { return m_chainCallback; }
     private:
+        /// Image or font which file is decoded on worker, packed bytes are preferred over path.
+        struct AssetLoad {
+            robot2D::Image* image{nullptr};
+            robot2D::Font* font{nullptr};
+            std::string path;
+            robot2D::AssetView packed{};
+            /// Set when image has exported compressed container, image itself isn't decoded then.
+            robot2D::CompressedImage* compressedImage{nullptr};
+            std::string compressedPath;
+            robot2D::AssetView compressedPacked{};
+        };
+
+        /// Decodes all scene's images and fonts in parallel jobs.
         void loadAssets();
-        void loadAssets(SceneEntity& entity);
+        void collectAssets(SceneEntity& entity, std::vector<AssetLoad>& assetLoads);
+        void collectImage(const std::string& localPath, std::vector<AssetLoad>& assetLoads);
+        static void decodeAsset(AssetLoad& assetLoad);
+        robot2D::AssetView findPacked(const std::string& absolutePath);
     private:
         Scene::Ptr m_scene;
         SceneLoadChainCallback m_chainCallback;
         IScriptInteractorFrom::WeakPtr m_scriptInteractorFrom;
+        std::shared_ptr<robot2D::AssetPack> m_assetPack;
     };
 
 } // namespace editor
\ No newline at end of file
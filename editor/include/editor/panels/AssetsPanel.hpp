@@ -19,7 +19,12 @@ and must not be misrepresented as being the original software.
 source distribution.
 *********************************************************************/
 
+#include <atomic>
 #include <filesystem>
+#include <memory>
+#include <mutex>
+
+#include <filewatch/FileWatch.hpp>
 
 #include <robot2D/Graphics/Texture.hpp>
 #include <robot2D/Util/ResourceHandler.hpp>
@@ -28,6 +33,7 @@ source distribution.
 #include <editor/UIManager.hpp>
 #include <editor/PrefabManager.hpp>
 #include <editor/UIInteractor.hpp>
+#include <editor/ThumbnailService.hpp>
 
 #include "IPanel.hpp"
 
@@ -83,6 +89,10 @@ namespace editor {
         void render() override;
     private:
         void dropFiles(const std::vector<std::string>& paths);
+        /// Starts watching directory, its listing is enumerated on next frame.
+        void changeDirectory(const std::filesystem::path& path);
+        /// Enumerates current directory only when watcher or panel changed it.
+        void refreshListing();
         void uiAssetsCreation();
         void processAssets();
         /// \brief in panel drag and out of panel
@@ -93,6 +103,13 @@ namespace editor {
             Scene,
             Folder
         };
+        struct ListingItem {
+            std::filesystem::directory_entry entry;
+            std::filesystem::path relativePath;
+            std::string filename;
+            AssetsPanelConfiguration::ResourceIconType iconType;
+        };
+
         struct AssetItem {
             AssetType assetType;
             std::string name;
@@ -118,5 +135,14 @@ namespace editor {
         State m_state = State::Loading;
         bool m_itemClicked{false};
         bool m_visible{false};
+
+        std::vector<ListingItem> m_listing;
+        std::atomic<bool> m_listingDirty{true};
+        /// Files reported by watcher, their thumbnails are made again.
+        std::mutex m_changesMutex;
+        std::vector<std::string> m_changedFiles;
+        ThumbnailService m_thumbnails;
+        /// Declared last, its callback thread stops before members it touches are destroyed.
+        std::unique_ptr<filewatch::FileWatch<std::string>> m_watcher;
     };
 }
\ No newline at end of file
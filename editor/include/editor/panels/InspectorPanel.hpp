@@ -56,6 +56,8 @@ namespace editor {
         void clearSelection();
     private:
         void drawAssetBase();
+        /// Marks inspected entity dirty for incremental scene save.
+        void markEditedEntity();
         void drawComponentsBase(SceneEntity entity);
         void drawComponents(SceneEntity entity);
         void drawUIComponents(SceneEntity entity);
@@ -67,6 +69,7 @@ namespace editor {
         void drawCollider2DComponent(SceneEntity, Collider2DComponent& component);
         void drawTextComponent(SceneEntity, TextComponent& component);
         void drawAnimationComponent(SceneEntity, AnimationComponent& component);
+        void drawParticleEmitterComponent(SceneEntity, ParticleEmitterComponent& component);
         void drawScriptComponent(SceneEntity, ScriptComponent& component);
         void processScriptComponent(SceneEntity, ScriptComponent& component);
 
@@ -76,8 +79,8 @@ namespace editor {
         void onPanelEntityNeedSelect(const PanelEntitySelectedMessage& message);
         void onPanelEntitySelected(const PanelEntitySelectedMessage& message);
 
-        static void onLoadImage(const robot2D::Image& image, SceneEntity entity);
-        static void onLoadFont(const robot2D::Font& font, SceneEntity entity);
+        static void onLoadImage(robot2D::Image&& image, SceneEntity entity);
+        static void onLoadFont(const robot2D::Font& font, SceneEntity entity, UIInteractor::Ptr interactor);
     private:
         MessageDispatcher& m_messageDispatcher;
         PrefabManager& m_prefabManager;
@@ -95,5 +98,7 @@ namespace editor {
         } m_inspectType = InspectType::EditorEntity;
 
         bool m_prefabHasModification{false};
+        bool m_wasEditing{false};
+        bool m_componentsChanged{false};
     };
 }
\ No newline at end of file
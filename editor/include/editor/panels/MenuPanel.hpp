@@ -24,6 +24,7 @@ source distribution.
 #include <editor/PopupManager.hpp>
 #include <editor/UIInteractor.hpp>
 #include <editor/ExportOptions.hpp>
+#include <editor/Task.hpp>
 
 #include "IPanel.hpp"
 
@@ -46,6 +47,8 @@ namespace editor {
         void pluginsMenu();
         void developerMenu();
         void helpMenu();
+        /// Oldest unfinished task with progress at the end of menu bar.
+        void tasksStatus();
 
         void showExportProjectModal();
 
@@ -61,5 +64,6 @@ namespace editor {
         } m_popupType = PopupType::None;
 
         ExportOptions m_exportOptions;
+        std::vector<TaskHandle> m_activeTasks;
     };
 }
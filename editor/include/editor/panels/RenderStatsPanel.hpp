@@ -0,0 +1,50 @@
+/*********************************************************************
+(c) Alex Raag 2023
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#pragma once
+
+#include <array>
+#include <robot2D/Graphics/RenderStats.hpp>
+
+#include "IPanel.hpp"
+
+namespace editor {
+    /// \brief Render profiler: draw calls by layer, batch breaks, uploads and CPU / GPU frame timings.
+    class RenderStatsPanel final: public IPanel {
+    public:
+        RenderStatsPanel();
+        RenderStatsPanel(const RenderStatsPanel& other) = delete;
+        RenderStatsPanel& operator=(const RenderStatsPanel& other) = delete;
+        RenderStatsPanel(RenderStatsPanel&& other) = delete;
+        RenderStatsPanel& operator=(RenderStatsPanel&& other) = delete;
+        ~RenderStatsPanel() override = default;
+
+        void setRenderStats(const robot2D::RenderStats& renderStats);
+        void render() override;
+    private:
+        static constexpr std::size_t historySize = 120;
+
+        robot2D::RenderStats m_renderStats{};
+        std::array<float, historySize> m_cpuHistory{};
+        std::array<float, historySize> m_gpuHistory{};
+        std::size_t m_historyOffset{0};
+    };
+}
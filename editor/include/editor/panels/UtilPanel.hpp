@@ -5,6 +5,7 @@
 
 #include "IPanel.hpp"
 #include "editor/EditorCamera.hpp"
+#include "editor/ParticleSystem.hpp"
 
 namespace editor {
     struct UtilPanelConfiguration {
@@ -24,11 +25,13 @@ namespace editor {
         const robot2D::Color& getColor() const;
 
         void setRenderStats(robot2D::RenderStats&& renderStats);
+        void setParticleStats(const ParticleStats& particleStats);
         void render() override;
     private:
         IEditorCamera::Ptr m_camera;
         robot2D::Color m_clearColor;
         robot2D::RenderStats m_renderStats;
+        ParticleStats m_particleStats;
         UtilPanelConfiguration m_configuration;
     };
 }
\ No newline at end of file
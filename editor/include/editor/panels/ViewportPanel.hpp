@@ -53,6 +53,9 @@ namespace editor {
 
     class ViewportPanel final: public IPanel {
     public:
+        /// Integer attachment of editor's framebuffer where entity indices are drawn for picking.
+        static constexpr robot2D::RenderID entityIDAttachment = 1;
+
         ViewportPanel(UIInteractor* uiInteractor,
                       IEditorCamera::Ptr editorCamera,
                       robot2D::MessageBus& messageBus,
@@ -73,12 +76,21 @@ namespace editor {
         void handleEvents(const robot2D::Event& event);
         void setFramebuffer(robot2D::FrameBuffer::Ptr frameBuffer);
 
+        /// Mouse position in framebuffer's pixels, y goes up from bottom.
+        robot2D::vec2i getFrameBufferMousePos() const;
+        /// Reads entity ID attachment between corners, selection is applied when GPU copy is ready.
+        void requestAreaSelection(const robot2D::vec2i& from, const robot2D::vec2i& to);
+
 
         void update(float deltaTime) override;
         void render() override;
     private:
         void instrumentBar(robot2D::vec2f windowOffset, robot2D::vec2f windowAvailSize);
         void toolbarOverlay(robot2D::vec2f windowOffset, robot2D::vec2f windowAvailSize);
+        /// Asks GPU for entity ID under mouse, answer comes few frames later and never blocks.
+        void updateHoveredEntity(const robot2D::vec2i& mousePos);
+        /// Passes finished marquee readback to UIInteractor.
+        void updateAreaSelection();
     private:
         UIInteractor* m_uiInteractor;
 
@@ -93,6 +105,10 @@ namespace editor {
 
         std::vector<robot2D::ecs::Entity> m_selectedEntities;
         robot2D::FrameBuffer::Ptr m_frameBuffer{ nullptr };
+        robot2D::ReadbackID m_hoverReadback{ robot2D::invalidReadback };
+        robot2D::ReadbackID m_selectionReadback{ robot2D::invalidReadback };
+        std::vector<int> m_readbackPixels;
+        int m_hoveredEntityIndex{ -1 };
         robot2D::vec2u  m_ViewportSize{};
         robot2D::WindowOptions m_windowOptions;
 
@@ -7,6 +7,7 @@
 #include <editor/SceneEntity.hpp>
 #include <editor/Uuid.hpp>
 #include <editor/scripting/ScriptingEngineService.hpp>
+#include <editor/serializers/SceneData.hpp>
 
 namespace editor {
     using ChildPair = std::pair<UUID, std::vector<UUID>>;
@@ -21,6 +22,17 @@ namespace editor {
         bool hasChildren() const { return !childPair.second.empty(); }
     };
 
+    /// Appends records of entity to sceneData, children go right after their parent when withChildren is set.
+    void collectEntity(SceneEntity entity, SceneData& sceneData,
+                       IScriptInteractorFrom::Ptr scriptInteractor, bool withChildren = true);
+
+    /// Adds components of sceneData's records to created entities, entities[i] gets sceneData.entities[i].
+    void applySceneData(const SceneData& sceneData, std::vector<SceneEntity>& entities,
+                        IScriptInteractorFrom::Ptr scriptInteractor);
+
+    /// Hierarchy of sceneData.entities[index], it's resolved after all entities are created.
+    ChildInfo getChildInfo(const SceneData& sceneData, std::size_t index, const SceneEntity& entity);
+
     class IEntitySerializer {
     public:
         virtual ~IEntitySerializer() noexcept = 0;
@@ -39,6 +51,8 @@ namespace editor {
 
 
         bool serialize(YAML::Emitter& out, const SceneEntity& entity, IScriptInteractorFrom::Ptr scriptInteractor);
+        /// Same as serialize, but children aren't emitted after entity.
+        bool serializeSelf(YAML::Emitter& out, const SceneEntity& entity, IScriptInteractorFrom::Ptr scriptInteractor);
         bool deserialize(const YAML::detail::iterator_value& iterator,
                          SceneEntity& entity,
                          bool& addToScene,
@@ -0,0 +1,61 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "SceneData.hpp"
+
+namespace editor {
+
+    /**
+     * \brief Versioned binary scene file.
+     * \details File starts with fixed header and chunk directory, every SceneData table is stored as chunk of
+     * little-endian POD records aligned by 16 bytes, so loading is mapping of file and one copy per table.
+     * Reader skips chunk types it doesn't know and rejects chunks which record size differs from own.
+     */
+    class SceneBinaryFormat {
+    public:
+        static constexpr std::uint32_t magic = 0x53443252; // "R2DS"
+        static constexpr std::uint16_t version = 1;
+
+        SceneBinaryFormat() = default;
+        SceneBinaryFormat(const SceneBinaryFormat& other) = delete;
+        SceneBinaryFormat& operator=(const SceneBinaryFormat& other) = delete;
+        SceneBinaryFormat(SceneBinaryFormat&& other) = delete;
+        SceneBinaryFormat& operator=(SceneBinaryFormat&& other) = delete;
+        ~SceneBinaryFormat() = default;
+
+        /// Checks magic of file, so binary and YAML scenes can share extension.
+        static bool isBinaryScene(const std::string& path);
+
+        bool loadFromFile(const std::string& path, SceneData& sceneData);
+        bool loadFromMemory(const std::uint8_t* data, std::size_t size, SceneData& sceneData);
+
+        bool saveToFile(const std::string& path, const SceneData& sceneData);
+        void saveToMemory(std::vector<std::uint8_t>& buffer, const SceneData& sceneData);
+    };
+
+} // namespace editor
@@ -0,0 +1,215 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <robot2D/Graphics/Color.hpp>
+#include <robot2D/Core/Vector2.hpp>
+
+/**
+ * Fields shared by SceneData::ParticleEmitter and ParticleEmitterComponent, in order of YAML file.
+ * FIELD(name, member, ValueType) is expanded by YAML codec and by entity mapping, ValueType is how YAML stores value,
+ * so new emitter field is added here and into both structures.
+ */
+#define PARTICLE_EMITTER_FIELDS(FIELD)                      \
+    FIELD("EmissionRate", emissionRate, float)              \
+    FIELD("LifeTime", lifeTime, float)                      \
+    FIELD("Speed", speed, float)                            \
+    FIELD("Direction", direction, float)                    \
+    FIELD("Spread", spread, float)                          \
+    FIELD("Gravity", gravity, robot2D::vec2f)               \
+    FIELD("StartSize", startSize, float)                    \
+    FIELD("EndSize", endSize, float)                        \
+    FIELD("StartColor", startColor, robot2D::Color)         \
+    FIELD("EndColor", endColor, robot2D::Color)             \
+    FIELD("MaxParticles", maxParticles, std::uint32_t)      \
+    FIELD("LayerIndex", layerIndex, std::uint32_t)          \
+    FIELD("Emitting", emitting, bool)
+
+namespace editor {
+
+    enum class SceneFormat {
+        Yaml = 0,
+        Binary
+    };
+
+    /**
+     * \brief Plain scene description, common ground of YAML and binary scene formats.
+     * \details Every component kind lives in own table of POD records which point to entity by its index,
+     * strings are deduplicated into one string table and referenced by StringID.
+     * Entities go in depth-first order, the same as YAML writes them: parent is followed by its children.
+     * SceneData doesn't know ECS, so scene files can be converted without creating Scene. Components are mapped
+     * to records in EntitySerializer only, SceneYAMLFormat and SceneBinaryFormat store records.
+     */
+    struct SceneData {
+        using StringID = std::uint32_t;
+        static constexpr StringID noString = std::numeric_limits<StringID>::max();
+
+        enum EntityFlags: std::uint32_t {
+            IsChild = 1 << 0
+        };
+
+        struct Entity {
+            std::uint64_t uuid;
+            std::uint64_t parentUUID;
+            StringID tag;
+            std::uint32_t flags;
+            /// Range in childIDs.
+            std::uint32_t firstChild;
+            std::uint32_t childrenCount;
+        };
+
+        struct Transform {
+            std::uint32_t entity;
+            robot2D::vec2f position;
+            robot2D::vec2f size;
+            robot2D::vec2f origin;
+            float rotation;
+        };
+
+        struct Camera {
+            std::uint32_t entity;
+            std::uint32_t isPrimary;
+            float orthoSize;
+            robot2D::vec2f size;
+            robot2D::vec2f position;
+        };
+
+        struct Drawable {
+            std::uint32_t entity;
+            robot2D::Color color;
+            StringID texturePath;
+            std::int32_t depth;
+        };
+
+        struct Text {
+            std::uint32_t entity;
+            StringID text;
+            StringID fontPath;
+        };
+
+        struct Script {
+            std::uint32_t entity;
+            StringID className;
+            /// Range in scriptFields.
+            std::uint32_t firstField;
+            std::uint32_t fieldsCount;
+        };
+
+        struct ScriptField {
+            StringID name;
+            /// Name of ScriptFieldType as YAML stores it.
+            StringID type;
+            /// Raw bytes of value, every serializable field type fits into 8 bytes.
+            std::uint64_t data;
+        };
+
+        struct Physics {
+            std::uint32_t entity;
+            std::uint32_t bodyType;
+            std::uint32_t fixedRotation;
+        };
+
+        struct Collider {
+            std::uint32_t entity;
+            robot2D::vec2f offset;
+            robot2D::vec2f size;
+            float density;
+            float friction;
+            float restitution;
+            float restitutionThreshold;
+        };
+
+        struct Prefab {
+            std::uint32_t entity;
+            std::uint32_t padding;
+            std::uint64_t prefabUUID;
+        };
+
+        struct Animation {
+            std::uint32_t entity;
+            /// Range in animationPaths.
+            std::uint32_t firstPath;
+            std::uint32_t pathsCount;
+        };
+
+        struct Button {
+            std::uint32_t entity;
+            StringID methodName;
+            std::uint64_t scriptUUID;
+        };
+
+        struct ParticleEmitter {
+            std::uint32_t entity;
+            float emissionRate;
+            float lifeTime;
+            float speed;
+            float direction;
+            float spread;
+            robot2D::vec2f gravity;
+            float startSize;
+            float endSize;
+            robot2D::Color startColor;
+            robot2D::Color endColor;
+            std::uint32_t maxParticles;
+            std::uint32_t layerIndex;
+            std::uint32_t emitting;
+        };
+
+        StringID addString(std::string_view value);
+        std::string_view getString(StringID id) const;
+        std::size_t getStringsCount() const { return stringOffsets.empty() ? 0 : stringOffsets.size() - 1; }
+        void clear();
+
+        StringID name{noString};
+
+        /// String i occupies [stringOffsets[i], stringOffsets[i + 1]) of strings.
+        std::string strings;
+        std::vector<std::uint32_t> stringOffsets;
+
+        std::vector<Entity> entities;
+        std::vector<std::uint64_t> childIDs;
+        std::vector<Transform> transforms;
+        std::vector<Camera> cameras;
+        std::vector<Drawable> drawables;
+        std::vector<Text> texts;
+        std::vector<Script> scripts;
+        std::vector<ScriptField> scriptFields;
+        std::vector<Physics> physics;
+        std::vector<Collider> colliders;
+        std::vector<Prefab> prefabs;
+        std::vector<Animation> animations;
+        std::vector<StringID> animationPaths;
+        std::vector<Button> buttons;
+        std::vector<ParticleEmitter> particleEmitters;
+    private:
+        std::unordered_map<std::string, StringID> m_stringIndex;
+    };
+
+} // namespace editor
@@ -0,0 +1,97 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <editor/Uuid.hpp>
+#include <editor/SceneEntity.hpp>
+
+namespace editor {
+
+    /**
+     * \brief YAML text of every entity from last save, so save emits only entities touched since then.
+     * \details Fragment stays valid while entity's transform version and hierarchy hash are same and entity
+     * wasn't marked dirty. Transform version catches moves from any place, hierarchy hash catches reparenting,
+     * other components are marked dirty by their editors. Fragments are stored indented as entries of scene's
+     * Entities sequence and are spliced into file as is.
+     */
+    class SceneFragmentCache {
+    public:
+        struct Fragment {
+            std::string text;
+            std::uint32_t transformVersion{0};
+            std::uint64_t hierarchyHash{0};
+        };
+        /// Emitter output of one entity as single entry sequence.
+        using EmitFunction = std::function<std::string(SceneEntity&)>;
+
+        SceneFragmentCache() = default;
+        SceneFragmentCache(const SceneFragmentCache& other) = delete;
+        SceneFragmentCache& operator=(const SceneFragmentCache& other) = delete;
+        SceneFragmentCache(SceneFragmentCache&& other) = delete;
+        SceneFragmentCache& operator=(SceneFragmentCache&& other) = delete;
+        ~SceneFragmentCache() = default;
+
+        void markDirty(UUID uuid) { m_dirtyEntities.insert(uuid); }
+        /// Next save emits every entity again.
+        void invalidate();
+
+        /**
+         * \brief Appends entries of scene's Entities sequence to text, entity goes before its children.
+         * \details Untouched entities are spliced from cache, others are emitted by emitEntity and wait for commit.
+         * \return false if there was no entity to append.
+         */
+        bool appendEntities(std::string& text, std::list<SceneEntity>& entities, const EmitFunction& emitEntity);
+
+        /// Cached fragment if entity wasn't touched since last save, nullptr otherwise.
+        const Fragment* find(UUID uuid, std::uint32_t transformVersion, std::uint64_t hierarchyHash) const;
+
+        /// Fragment found by find goes to save in progress, it's moved on commit without copying.
+        void keep(UUID uuid);
+        void store(UUID uuid, Fragment&& fragment);
+        /// File is written, fragments of this save replace old ones and removed entities are dropped.
+        void commit();
+        /// Writing failed, cache and dirty marks stay as before save.
+        void rollback();
+
+        std::size_t getFragmentsCount() const { return m_fragments.size(); }
+
+        /// Parent and children ids are part of entity's YAML, any reparenting changes hash.
+        static std::uint64_t computeHierarchyHash(SceneEntity& entity);
+    private:
+        void appendEntity(std::string& text, SceneEntity& entity, const EmitFunction& emitEntity);
+    private:
+        std::unordered_map<UUID, Fragment> m_fragments;
+        std::unordered_map<UUID, Fragment> m_nextFragments;
+        std::vector<UUID> m_keptEntities;
+        std::unordered_set<UUID> m_dirtyEntities;
+    };
+
+}
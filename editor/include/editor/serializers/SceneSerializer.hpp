@@ -22,12 +22,19 @@ source distribution.
 #pragma once
 
 #include <memory>
+#include <vector>
 #include "editor/Errors.hpp"
 #include <editor/ScriptInteractor.hpp>
+#include "SceneData.hpp"
+
+namespace YAML {
+    class Node;
+}
 
 namespace editor {
 
     class Scene;
+    struct ChildInfo;
     class SceneSerializer {
     public:
         SceneSerializer(std::shared_ptr<Scene> scene);
@@ -38,10 +45,26 @@ namespace editor {
         ~SceneSerializer() = default;
 
         bool serialize(const std::string& path, const std::string& sceneName,
-                       IScriptInteractorFrom::Ptr scriptingEngine);
+                       IScriptInteractorFrom::Ptr scriptingEngine, SceneFormat format = SceneFormat::Yaml);
+        /// Format of file is detected by its content.
         bool deserialize(const std::string& path, IScriptInteractorFrom::Ptr scriptingEngine);
         SceneSerializerError getError() const;
 
+    private:
+        /// Splices cached fragments of untouched entities, emits only dirty ones.
+        bool serializeYaml(const std::string& path, const std::string& sceneName,
+                           IScriptInteractorFrom::Ptr scriptingEngine);
+        bool serializeBinary(const std::string& path, const std::string& sceneName,
+                             IScriptInteractorFrom::Ptr scriptingEngine);
+        /// Scene file from asset pack, either format.
+        bool deserializeFromMemory(const std::uint8_t* bytes, std::size_t size,
+                                   IScriptInteractorFrom::Ptr scriptingEngine);
+        bool deserializeYaml(const YAML::Node& data, IScriptInteractorFrom::Ptr scriptingEngine);
+        /// Both formats end here, YAML is read into SceneData first.
+        bool deserializeData(const SceneData& sceneData, IScriptInteractorFrom::Ptr scriptingEngine);
+        /// Scene with journal records applied, it differs from its file.
+        bool deserializeReplayed(const YAML::Node& data, IScriptInteractorFrom::Ptr scriptingEngine);
+        void resolveChildren(std::vector<ChildInfo>& children);
     private:
         std::shared_ptr<Scene> m_scene;
         SceneSerializerError m_error;
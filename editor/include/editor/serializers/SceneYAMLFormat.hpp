@@ -0,0 +1,64 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#pragma once
+
+#include <string>
+#include "SceneData.hpp"
+
+namespace YAML {
+    class Node;
+    class Emitter;
+}
+
+namespace editor {
+
+    /**
+     * \brief Reads and writes SceneData in YAML layout of scene files.
+     * \details The only YAML codec of scene entities, EntityYAMLSerializer maps components to SceneData and
+     * goes through loadEntity and saveEntities.
+     */
+    class SceneYAMLFormat {
+    public:
+        SceneYAMLFormat() = default;
+        SceneYAMLFormat(const SceneYAMLFormat& other) = delete;
+        SceneYAMLFormat& operator=(const SceneYAMLFormat& other) = delete;
+        SceneYAMLFormat(SceneYAMLFormat&& other) = delete;
+        SceneYAMLFormat& operator=(SceneYAMLFormat&& other) = delete;
+        ~SceneYAMLFormat() = default;
+
+        bool loadFromFile(const std::string& path, SceneData& sceneData);
+        bool loadFromNode(const YAML::Node& root, SceneData& sceneData);
+        /// Appends entity of one entry of Entities sequence, throws YAML::Exception on bad layout.
+        /// \return false if entry has no id or tag.
+        bool loadEntity(const YAML::Node& node, SceneData& sceneData);
+
+        bool saveToFile(const std::string& path, const SceneData& sceneData);
+        void saveToEmitter(YAML::Emitter& out, const SceneData& sceneData);
+        /// Entries of Entities sequence, caller begins and ends sequence.
+        void saveEntities(YAML::Emitter& out, const SceneData& sceneData);
+    };
+
+    /// Converts scene file into targetFormat, format of source file is detected by its content.
+    bool convertScene(const std::string& sourcePath, const std::string& targetPath, SceneFormat targetFormat);
+
+} // namespace editor
@@ -113,6 +113,35 @@ namespace robot2D
 
         #endregion
 
+        #region ParticleEmitter
+
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        internal extern static bool ParticleEmitterComponent_GetEmitting(ulong entityID);
+
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        internal extern static void ParticleEmitterComponent_SetEmitting(ulong entityID, bool emitting);
+
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        internal extern static float ParticleEmitterComponent_GetEmissionRate(ulong entityID);
+
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        internal extern static void ParticleEmitterComponent_SetEmissionRate(ulong entityID, float emissionRate);
+
+        #endregion
+
+        #region Spatial
+
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        internal extern static ulong[] Spatial_QueryRect(ref Vector2 position, ref Vector2 size);
+
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        internal extern static ulong[] Spatial_QueryPoint(ref Vector2 point);
+
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        internal extern static ulong[] Spatial_RayCast(ref Vector2 from, ref Vector2 to);
+
+        #endregion
+
         [MethodImplAttribute(MethodImplOptions.InternalCall)]
         internal extern static bool SceneManager_LoadScene(string name);
         
@@ -102,6 +102,21 @@ namespace robot2D
         }
     }
     
+    public class ParticleEmitter : Component
+    {
+        public bool Emitting
+        {
+            get => InternalCalls.ParticleEmitterComponent_GetEmitting(Entity.ID);
+            set => InternalCalls.ParticleEmitterComponent_SetEmitting(Entity.ID, value);
+        }
+
+        public float EmissionRate
+        {
+            get => InternalCalls.ParticleEmitterComponent_GetEmissionRate(Entity.ID);
+            set => InternalCalls.ParticleEmitterComponent_SetEmissionRate(Entity.ID, value);
+        }
+    }
+
     public class CameraComponent : Component
     {
         public Vector2 Position
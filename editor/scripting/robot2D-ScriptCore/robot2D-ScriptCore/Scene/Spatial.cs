@@ -0,0 +1,29 @@
+﻿namespace robot2D
+{
+    public static class Spatial
+    {
+        public static Entity[] QueryRect(Vector2 position, Vector2 size)
+        {
+            return ToEntities(InternalCalls.Spatial_QueryRect(ref position, ref size));
+        }
+
+        public static Entity[] QueryPoint(Vector2 point)
+        {
+            return ToEntities(InternalCalls.Spatial_QueryPoint(ref point));
+        }
+
+        /// Entities crossed by segment, sorted from start to end.
+        public static Entity[] RayCast(Vector2 from, Vector2 to)
+        {
+            return ToEntities(InternalCalls.Spatial_RayCast(ref from, ref to));
+        }
+
+        private static Entity[] ToEntities(ulong[] entityIDs)
+        {
+            Entity[] entities = new Entity[entityIDs.Length];
+            for (int i = 0; i < entityIDs.Length; ++i)
+                entities[i] = new Entity(entityIDs[i]);
+            return entities;
+        }
+    }
+}
@@ -63,7 +63,20 @@ namespace editor {
         TiXmlDocument document(p);
         if (!document.LoadFile())
             return false;
+        return parseDocument(document, anim);
+    }
+
+    bool AnimationParser::loadFromMemory(const char* data, std::size_t size, Animation* anim) {
+        /// TinyXML parses only null terminated text
+        std::string text{data, size};
+        TiXmlDocument document;
+        document.Parse(text.c_str());
+        if(document.Error())
+            return false;
+        return parseDocument(document, anim);
+    }
 
+    bool AnimationParser::parseDocument(TiXmlDocument& document, Animation* anim) {
         TiXmlElement* head = document.FirstChildElement(m_keys[XmlKey::head].c_str());
         if(!head)
             return false;
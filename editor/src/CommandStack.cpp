@@ -33,6 +33,8 @@ namespace editor {
 
         ptr -> undo();
         m_redoQueue.push(ptr);
+        if(m_changeCallback)
+            m_changeCallback();
     }
 
     void CommandStack::redo() {
@@ -43,6 +45,8 @@ namespace editor {
         m_redoQueue.pop();
 
         ptr -> redo();
+        if(m_changeCallback)
+            m_changeCallback();
     }
 
     bool CommandStack::empty() const noexcept {
@@ -52,6 +56,8 @@ namespace editor {
     void CommandStack::addCommand(ICommand::Ptr&& ptr) {
         assert(ptr != nullptr && "Don't add nullptr command");
         m_stack.push(std::move(ptr));
+        if(m_changeCallback)
+            m_changeCallback();
     }
 
     std::size_t CommandStack::undoSize() const {
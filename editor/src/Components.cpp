@@ -61,6 +61,11 @@ namespace editor {
         return id;
     }
 
+    const class_id& ParticleEmitterComponent::id() noexcept {
+        static const class_id id{"ParticleEmitter"};
+        return id;
+    }
+
 
 
     DrawableComponent::DrawableComponent():
@@ -165,6 +170,7 @@ namespace editor {
 
     void TransformComponent::setPosition(const robot2D::vec2f& pos, bool needUpdateChild) {
         m_hasModification = true;
+        ++m_version;
         if(needUpdateChild)
             setPosition(pos);
         else {
@@ -183,6 +189,7 @@ namespace editor {
         }
         Transformable::setPosition(pos);
         m_hasModification = true;
+        ++m_version;
     }
 
     bool TransformComponent::hasChildren() const {
@@ -237,11 +244,25 @@ namespace editor {
     void TransformComponent::setScale(const robot2D::vec2f& factor) {
         Transformable::setScale(factor);
         m_hasModification = true;
+        ++m_version;
     }
 
     void TransformComponent::setSize(const robot2D::vec2f& factor) {
         Transformable::setSize(factor);
         m_hasModification = true;
+        ++m_version;
+    }
+
+    void TransformComponent::setOrigin(const robot2D::vec2f& origin) {
+        Transformable::setOrigin(origin);
+        m_hasModification = true;
+        ++m_version;
+    }
+
+    void TransformComponent::setRotate(const float& angle) {
+        Transformable::setRotate(angle);
+        m_hasModification = true;
+        ++m_version;
     }
 
     robot2D::FloatRect TransformComponent::getLocalBounds() const {
@@ -259,7 +280,7 @@ namespace editor {
 
     TextComponent::TextComponent():
             m_text{""},
-            m_characterSize{20},
+            m_characterSize{defaultCharacterSize},
             m_font{nullptr},
             m_needUpdate{false}{}
 
@@ -292,24 +313,27 @@ namespace editor {
 
     void TextComponent::setFont(const robot2D::Font& font) {
         m_font = &font;
-        m_texture = new robot2D::Texture();
-        m_texture -> create(*(m_font -> getImages()[0]));
+        m_needUpdate = true;
     }
 
     const robot2D::Font* TextComponent::getFont() const {
         return m_font;
     }
 
-    const robot2D::Texture& TextComponent::getTexture() const {
-        return *m_texture;
+    void TextComponent::setMaxWidth(float maxWidth) {
+        m_maxWidth = maxWidth;
+        m_needUpdate = true;
     }
 
-    std::unordered_map<int, robot2D::GlyphQuad>& TextComponent::getGlyphCache() {
-        if (m_bufferCache.empty() || m_scaled) {
-            m_bufferCache = m_font -> getBufferCache(1.F);
-            m_scaled = false;
-        }
-        return m_bufferCache;
+    void TextComponent::setAlignment(robot2D::TextAlignment alignment) {
+        m_alignment = alignment;
+        m_needUpdate = true;
+    }
+
+    robot2D::TextureSampling TextComponent::getTextureSampling() const {
+        if(m_font && m_font -> getRenderMode() == robot2D::FontRenderMode::SDF)
+            return robot2D::TextureSampling::DistanceField;
+        return robot2D::TextureSampling::Coverage;
     }
 
 
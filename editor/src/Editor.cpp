@@ -36,6 +36,7 @@ source distribution.
 #include <editor/panels/MenuPanel.hpp>
 #include <editor/panels/InspectorPanel.hpp>
 #include <editor/panels/UtilPanel.hpp>
+#include <editor/panels/RenderStatsPanel.hpp>
 #include <editor/panels/ViewportPanel.hpp>
 #include <editor/panels/GameViewport.hpp>
 ///////////////////////////// PANELS /////////////////////////////
@@ -179,6 +180,7 @@ namespace editor {
         m_panelManager.addPanel<AssetsPanel>(m_messageBus, m_interactor, m_panelManager, m_prefabManager);
         m_panelManager.addPanel<InspectorPanel>(m_messageDispather, m_messageBus, m_prefabManager, m_panelManager);
         m_panelManager.addPanel<UtilPanel>(m_editorCamera);
+        m_panelManager.addPanel<RenderStatsPanel>();
         m_panelManager.addPanel<MenuPanel>(m_messageBus, m_interactor);
         m_panelManager.addPanel<ViewportPanel>(m_interactor,
                                                m_editorCamera,
@@ -259,6 +261,9 @@ namespace editor {
             const auto& clearColor = m_panelManager.getPanel<UtilPanel>().getColor();
             // TODO: @a.raag reset stats
             m_window -> clear(clearColor);
+            /// empty pixels of entity ID attachment mean no entity for picking
+            if(m_frameBuffer)
+                m_frameBuffer -> clearAttachment(ViewportPanel::entityIDAttachment, -1);
         }
 
         m_sceneGrid.render(m_frameBuffer -> getSpecification().size);
@@ -303,7 +308,10 @@ namespace editor {
 
     void Editor::guiRender() {
         auto stats = m_window -> getStats();
+        m_panelManager.getPanel<RenderStatsPanel>().setRenderStats(stats);
         m_panelManager.getPanel<UtilPanel>().setRenderStats(std::move(stats));
+        if(m_activeScene)
+            m_panelManager.getPanel<UtilPanel>().setParticleStats(m_activeScene -> getParticleStats());
         m_panelManager.render();
 
         if(m_interactor -> getState() == EditorState::Load) {
@@ -422,6 +430,7 @@ namespace editor {
             });
             m_selectionCollider.setPosition(mousePos);
             m_selectionCollider.setIsShown(true);
+            m_selectionStartPixel = viewportPanel.getFrameBufferMousePos();
         }
     }
 
@@ -432,7 +441,10 @@ namespace editor {
                                                                                 && !m_guizmo2D.isActive()) {
             m_leftMousePressed = false;
             m_selectionCollider.setIsShown(false);
-            m_interactor -> findSelectEntities(m_selectionCollider.getRect());
+            if(m_configuration.gpuMarqueeSelection)
+                viewportPanel.requestAreaSelection(m_selectionStartPixel, viewportPanel.getFrameBufferMousePos());
+            else
+                m_interactor -> findSelectEntities(m_selectionCollider.getRect());
             m_selectionCollider.reset();
         }
     }
@@ -19,11 +19,15 @@ and must not be misrepresented as being the original software.
 source distribution.
 *********************************************************************/
 
+#include <unordered_set>
+
+#include <robot2D/Core/Clock.hpp>
 #include <editor/EditorLogic.hpp>
 #include <editor/Editor.hpp>
 #include <editor/FileApi.hpp>
 #include <editor/Messages.hpp>
 #include <editor/ResouceManager.hpp>
+#include <editor/ImportCache.hpp>
 #include <editor/LocalResourceManager.hpp>
 #include <editor/Components.hpp>
 
@@ -49,6 +53,8 @@ source distribution.
 
 namespace {
     const std::string scenePath = "assets/scenes";
+    /// decoded assets of project, kept out of assets so they aren't exported or shown
+    const std::string importCachePath = ".cache/import";
     const robot2D::FloatRect initRectangle = {{-10000, -10000}, {20000, 20000}};
 
     std::filesystem::path get_exec_path() {
@@ -131,7 +137,7 @@ namespace editor {
         m_messageDispatcher.onMessage<GenerateProjectMessage>(MessageID::GenerateProject,
                                                               BIND_CLASS_FN(generateProject));
 
-        m_quadTree.resizeRectangle(initRectangle);
+        m_quadTree.resize(initRectangle);
     }
 
 
@@ -141,6 +147,8 @@ namespace editor {
 
     void EditorLogic::update(float dt) {
         auto state = m_presenter.getState();
+        if(state != EditorState::Load && !m_pendingEntities.empty())
+            processPendingEntities();
         switch(state) {
             case EditorState::Load:
                 break;
@@ -151,13 +159,14 @@ namespace editor {
                     auto& tx = entity.getComponent<TransformComponent>();
                     if(tx.m_hasModification) {
                         if(entity.hasComponent<QuadTreeComponent>()) {
-                            auto iterator = entity.getComponent<QuadTreeComponent>().iterator;
-                            m_quadTree.relocate(iterator, entity.calculateRect());
+                            auto itemID = entity.getComponent<QuadTreeComponent>().itemID;
+                            m_quadTree.relocate(itemID, entity.calculateRect());
                         }
                         tx.m_hasModification = false;
                     }
                 }
                 m_activeScene -> update(dt);
+                m_journal.update(dt, *m_activeScene, m_scriptInteractor.lock());
                 break;
             }
 
@@ -174,14 +183,20 @@ namespace editor {
     void EditorLogic::setup(IScriptInteractorFrom::WeakPtr scriptInteractor) {
         m_scriptInteractor = scriptInteractor;
         PopupManager::getManager() -> addObserver(this);
+        m_commandStack.setChangeCallback([this]() { m_journal.requestCapture(); });
     }
 
     void EditorLogic::destroy() {
         TaskQueue::GetQueue() -> stop();
+        m_journal.stop();
     }
 
     void EditorLogic::createProject(Project::Ptr project) {
         m_currentProject = project;
+        ResourceManager::getManager() -> closeAssetPack();
+        ImportCache::getCache() -> open(combinePath(project -> getPath(), importCachePath));
+        ImportCache::getCache() -> importDirectory(combinePath(project -> getPath(), "assets"),
+                                                   TaskQueue::GetQueue() -> getJobSystem());
         if(!m_sceneManager.add(std::move(project), m_scriptInteractor)) {
             RB_EDITOR_ERROR("Can't Create Scene. Reason: {0}",
                             errorToString(m_sceneManager.getError()));
@@ -208,6 +223,14 @@ namespace editor {
         auto appendPath = combinePath(scenePath, project -> getStartScene());
         auto scenePath = combinePath(path, appendPath);
 
+        /// exported projects ship assets packed, loaders prefer pack over loose files
+        auto packPath = combinePath(path, "assets.pack");
+        if(!std::filesystem::exists(packPath) || !ResourceManager::getManager() -> openAssetPack(packPath))
+            ResourceManager::getManager() -> closeAssetPack();
+        ImportCache::getCache() -> open(combinePath(path, importCachePath));
+        /// once per project open, so scene loads find project's assets decoded
+        ImportCache::getCache() -> importDirectory(combinePath(path, "assets"), TaskQueue::GetQueue() -> getJobSystem());
+
         m_presenter.prepareView();
         m_sceneManager.loadSceneAsync(project, scenePath,
                                       BIND_CLASS_FN(loadSceneCallback), m_scriptInteractor);
@@ -235,6 +258,7 @@ namespace editor {
             };
 
             m_popupConfiguration.onNo = [this, taskQueue, scenePath]() {
+                m_journal.discard();
                 m_presenter.switchState(EditorState::Load);
                 m_sceneManager.loadSceneAsync(m_currentProject, scenePath,
                                               BIND_CLASS_FN(loadSceneCallback), m_scriptInteractor);
@@ -257,11 +281,14 @@ namespace editor {
     }
 
     void EditorLogic::saveScene(const MenuProjectMessage& message) {
-        m_sceneManager.save(std::move(m_activeScene), m_scriptInteractor);
+        saveScene();
     }
 
     bool EditorLogic::saveScene() {
-        return m_sceneManager.save(std::move(m_activeScene), m_scriptInteractor);
+        if(!m_sceneManager.save(std::move(m_activeScene), m_scriptInteractor))
+            return false;
+        m_journal.markSaved(*m_activeScene);
+        return true;
     }
 
     void EditorLogic::loadSceneCallback(Scene::Ptr loadedScene) {
@@ -269,8 +296,11 @@ namespace editor {
         m_presenter.switchState(EditorState::Edit);
         m_presenter.setMainCameraEntity({});
 
+        m_journal.start(*m_activeScene);
+
+        m_pendingEntities.clear();
         for(auto& entity: m_activeScene -> getEntities()) {
-            processEntity(entity);
+            m_pendingEntities.emplace_back(entity);
 
             if(entity.hasComponent<CameraComponent>()) {
                 auto& cameraComponent = entity.getComponent<CameraComponent>();
@@ -291,6 +321,20 @@ namespace editor {
     }
 
 
+    void EditorLogic::processPendingEntities() {
+        /// texture uploads of big scene are spread over frames, so editor stays responsive
+        constexpr float frameBudgetMs = 8.F;
+        robot2D::Clock clock;
+        while(!m_pendingEntities.empty()) {
+            auto entity = m_pendingEntities.front();
+            m_pendingEntities.pop_front();
+            if(entity)
+                processEntity(entity);
+            if(clock.duration().asMilliSeconds() >= frameBudgetMs)
+                break;
+        }
+    }
+
     void EditorLogic::copyToBuffer() {
         m_copyEntities.clear();
         m_copyEntities = m_selectedEntities;
@@ -339,8 +383,8 @@ namespace editor {
     }
 
     void EditorLogic::processEntity(SceneEntity entity) {
-        auto iterator = m_quadTree.insert(entity, entity.calculateRect());
-        entity.addComponent<QuadTreeComponent>().iterator = iterator;
+        auto itemID = m_quadTree.insert(entity, entity.calculateRect());
+        entity.addComponent<QuadTreeComponent>().itemID = itemID;
 
         auto* manager = ResourceManager::getManager();
         auto* localManager = LocalResourceManager::getManager();
@@ -367,12 +411,9 @@ namespace editor {
             }
             else {
                 if(manager -> hasImage(id)) {
-                    auto& image = manager -> getImage(id);
                     auto* texture = localManager -> addTexture(texturePath.filename().string());
-                    if(texture) {
-                        texture -> create(image);
+                    if(texture && manager -> createTexture(id, *texture))
                         drawable.setTexture(*texture);
-                    }
                 }
             }
 
@@ -408,12 +449,9 @@ namespace editor {
                 if(localManager -> hasTexture(imageId))
                     animation -> texture = &localManager -> getTexture(imageId);
                 else {
-                    auto& image = manager -> getImage(imageId);
                     auto* localTexture = localManager -> addTexture(imageId);
-                    if(localTexture) {
-                        localTexture -> create(image);
+                    if(localTexture && manager -> createTexture(imageId, *localTexture))
                         animation -> texture = localTexture;
-                    }
                 }
             }
             auto& animationComponent = entity.getComponent<AnimationComponent>();
@@ -464,25 +502,42 @@ namespace editor {
     void EditorLogic::findSelectEntities(const robot2D::FloatRect& rect) {
         m_selectedEntities.clear();
 
-        auto&& foundItems = m_quadTree.search(rect);
-        m_selectedEntities.resize(foundItems.size());
-        std::transform(foundItems.begin(), foundItems.end(), m_selectedEntities.begin(), [](
-                const QuadTreeContainer<SceneEntity>::ContainerIterator iterator) {
-           return iterator -> value;
-        });
+        m_quadTree.search(rect, m_selectedEntities);
+        showSelectedEntitiesOnUI();
 
-        if(!m_selectedEntities.empty()) {
-            std::vector<ITreeItem::Ptr> selected_items{};
-            selected_items.reserve(m_selectedEntities.size());
+        /// TODO(a.raag): add Selection Command
+    }
 
-            for(auto& entity: m_selectedEntities) {
-                auto& component = entity.getComponent<UIComponent>();
-                selected_items.push_back(component.treeItem);
-            }
-            m_presenter.findSelectedEntitiesOnUI(std::move(selected_items));
+    void EditorLogic::findSelectEntities(const std::vector<int>& entityIndices) {
+        m_selectedEntities.clear();
+        if(!m_activeScene)
+            return;
+
+        std::unordered_set<int> indices{entityIndices.begin(), entityIndices.end()};
+        indices.erase(-1);
+        if(indices.empty())
+            return;
+
+        /// only entities which have visible pixels in area are selected, unlike quadtree's bounds overlap
+        for(auto& entity: m_activeScene -> getEntities()) {
+            if(indices.count(static_cast<int>(entity.getWrappedEntity().getIndex())) > 0)
+                m_selectedEntities.emplace_back(entity);
         }
+        showSelectedEntitiesOnUI();
+    }
 
-        /// TODO(a.raag): add Selection Command
+    void EditorLogic::showSelectedEntitiesOnUI() {
+        if(m_selectedEntities.empty())
+            return;
+
+        std::vector<ITreeItem::Ptr> selected_items{};
+        selected_items.reserve(m_selectedEntities.size());
+
+        for(auto& entity: m_selectedEntities) {
+            auto& component = entity.getComponent<UIComponent>();
+            selected_items.push_back(component.treeItem);
+        }
+        m_presenter.findSelectedEntitiesOnUI(std::move(selected_items));
     }
 
 
@@ -535,15 +590,15 @@ namespace editor {
     void EditorLogic::addEmptyEntity() {
         auto entity = m_activeScene -> addEmptyEntity();
         auto rect = entity.calculateRect();
-        auto treeIterator = m_quadTree.insert(entity, rect);
-        entity.addComponent<QuadTreeComponent>().iterator = treeIterator;
+        auto itemID = m_quadTree.insert(entity, rect);
+        entity.addComponent<QuadTreeComponent>().itemID = itemID;
     }
 
     SceneEntity EditorLogic::addButton() {
         auto entity = m_activeScene -> addEmptyButton();
         auto rect = entity.calculateRect();
-        auto treeIterator = m_quadTree.insert(entity, rect);
-        entity.addComponent<QuadTreeComponent>().iterator = treeIterator;
+        auto itemID = m_quadTree.insert(entity, rect);
+        entity.addComponent<QuadTreeComponent>().itemID = itemID;
         return entity;
     }
 
@@ -573,38 +628,22 @@ namespace editor {
         m_selectedEntities.clear();
         robot2D::FloatRect rect = {{ static_cast<float>(mousePos.x),
                                      static_cast<float>(mousePos.y) }, { 1.f, 1.f }};
-        auto&& foundItems = m_quadTree.search(rect);
-        if(foundItems.empty()) {
+        m_foundEntities.clear();
+        m_quadTree.search(rect, m_foundEntities);
+        if(m_foundEntities.empty()) {
             m_presenter.clearSelectionOnUI();
             return {};
         }
-        else if(foundItems.size() > 1) {
-            std::vector<SceneEntity> tmp;
-            tmp.reserve(foundItems.size());
-            std::transform(foundItems.begin(), foundItems.end(), tmp.begin(), [](
-                    const QuadTreeContainer<SceneEntity>::ContainerIterator iterator) {
-                return iterator -> value;
-            });
-
-            std::sort(tmp.begin(), tmp.end(), [](SceneEntity entity1, SceneEntity entity2) {
-                auto depth1 = entity1.getComponent<DrawableComponent>().getDepth();
-                auto depth2 = entity2.getComponent<DrawableComponent>().getDepth();
-                return depth1 > depth2;
-            });
-
-            m_selectedEntities.push_back(tmp[0]);
-            return tmp[0];
-        }
-        else {
-            std::transform(foundItems.begin(), foundItems.end(), m_selectedEntities.begin(), [](
-                    const QuadTreeContainer<SceneEntity>::ContainerIterator iterator) {
-                return iterator -> value;
-            });
 
-            return m_selectedEntities[0];
-        }
+        auto found = std::max_element(m_foundEntities.begin(), m_foundEntities.end(),
+                                      [](SceneEntity entity1, SceneEntity entity2) {
+            auto depth1 = entity1.getComponent<DrawableComponent>().getDepth();
+            auto depth2 = entity2.getComponent<DrawableComponent>().getDepth();
+            return depth1 < depth2;
+        });
 
-        return SceneEntity{};
+        m_selectedEntities.push_back(*found);
+        return *found;
     }
 
 
@@ -627,7 +666,13 @@ namespace editor {
         m_quadTree.clear();
 
         auto taskQueue = TaskQueue::GetQueue();
-        m_closeResultProjectCallback = std::move(resultCallback);
+        /// next project can be opened without pack, so closed one's pack mustn't be left for loaders
+        m_closeResultProjectCallback = [this, callback = std::move(resultCallback)]() {
+            /// entities of closed scene mustn't be processed after next project is opened
+            m_pendingEntities.clear();
+            ResourceManager::getManager() -> closeAssetPack();
+            callback();
+        };
         if(m_activeScene -> hasChanges() || taskQueue -> hasPendingTasks()) {
             m_popupConfiguration.title = "Close Project";
             m_popupConfiguration.onYes = [this]() {
@@ -638,6 +683,7 @@ namespace editor {
                 m_closeResultProjectCallback();
             };
             m_popupConfiguration.onNo = [this]() {
+                m_journal.discard();
                 m_closeResultProjectCallback();
             };
             m_presenter.showPopup(&m_popupConfiguration);
@@ -658,11 +704,13 @@ namespace editor {
             }
         };
 
-        m_activeScene -> traverseGraph(std::move([&processModification, message](SceneEntity& sceneEntity) {
+        auto scene = m_activeScene;
+        m_activeScene -> traverseGraph(std::move([&processModification, &scene, message](SceneEntity& sceneEntity) {
             if(sceneEntity.hasComponent<PrefabComponent>()) {
                 auto& prefabComponent = sceneEntity.getComponent<PrefabComponent>();
                 if(prefabComponent.prefabUUID == message.prefabUUID) {
                     processModification(message.prefabEntity, sceneEntity);
+                    scene -> markDirty(sceneEntity);
                 }
             }
         }));
@@ -679,10 +727,13 @@ namespace editor {
     }
 
     void EditorLogic::exportProject(const ExportOptions& exportOptions) {
+        auto options = exportOptions;
+        options.projectPath = m_currentProject -> getPath();
+
         auto queue = TaskQueue::GetQueue();
         queue -> addAsyncTask<ExportTask>([](const ExportTask& exportTask) {
 
-        }, exportOptions);
+        }, options);
     }
 
     void EditorLogic::uiSelectedEntities(std::set<ITreeItem::Ptr>& uiItems, bool isAll) {
@@ -699,10 +750,21 @@ namespace editor {
         return m_activeScene -> getEntity(uuid);
     }
 
+    void EditorLogic::markEntityDirty(SceneEntity entity) {
+        if(m_activeScene && !m_activeScene -> isRunning())
+            m_activeScene -> markDirty(entity);
+    }
+
     void EditorLogic::setEditorCamera(IEditorCamera::Ptr editorCamera) {
         m_activeScene -> setEditorCamera(editorCamera);
     }
 
+    const SpatialSystem* EditorLogic::getSpatialSystem() const {
+        if(!m_activeScene)
+            return nullptr;
+        return m_activeScene -> getSpatialSystem();
+    }
+
     void EditorLogic::generateProject(const GenerateProjectMessage& message) {
         std::string genCmd;
 #ifdef ROBOT2D_WINDOWS
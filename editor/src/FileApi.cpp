@@ -19,6 +19,8 @@ and must not be misrepresented as being the original software.
 source distribution.
 *********************************************************************/
 
+#include <algorithm>
+#include <cctype>
 #include <editor/FileApi.hpp>
 
 namespace editor {
@@ -82,6 +84,13 @@ namespace editor {
         return filePath.extension().string();
     }
 
+    bool isImageFile(const std::string& path) {
+        auto extension = fs::path{path}.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return extension == ".png" || extension == ".jpg" || extension == ".jpeg";
+    }
+
 
     std::string cutPath(const std::string& fullPath, const std::string& anchor) {
         std::string path;
@@ -91,5 +100,11 @@ namespace editor {
         path = relative.substr(pos, relative.size() - pos);
         return path;
     }
-}
 
+    std::string toAssetName(const std::string& projectPath, const std::string& path) {
+        fs::path assetPath{path};
+        if(assetPath.is_absolute())
+            assetPath = assetPath.lexically_relative(fs::path{projectPath});
+        return assetPath.lexically_normal().generic_string();
+    }
+}
@@ -361,11 +361,13 @@ namespace editor {
 
     void Guizmo2D::setOperationType(Guizmo2D::Operation type) {
         m_operation = type;
+        if(!m_manipulatorTexture || !m_manipulatorRotateTexture)
+            return;
         switch(m_operation) {
             case Operation::Rotate: {
                 m_rotateSprite.setSize(rotateSize);
-                auto size = m_manipulatorRotateTexture.getSize();
-                m_rotateSprite.setTexture(m_manipulatorRotateTexture,
+                auto size = m_manipulatorRotateTexture -> getSize();
+                m_rotateSprite.setTexture(*m_manipulatorRotateTexture,
                                           robot2D::IntRect{0, 0, (int)size.x, (int)size.y});
                 return;
             }
@@ -373,12 +375,12 @@ namespace editor {
                 auto& xSprite = m_xAxisManipulator.m_sprite;
                 xSprite.setRotate(270);
                 xSprite.setColor(robot2D::Color::Red);
-                xSprite.setTexture(m_manipulatorTexture, m_textureRects[TextureType::Move]);
+                xSprite.setTexture(*m_manipulatorTexture, m_textureRects[TextureType::Move]);
 
                 auto& ySprite = m_yAxisManipulator.m_sprite;
                 ySprite.setRotate(180);
                 ySprite.setColor(robot2D::Color::Green);
-                ySprite.setTexture(m_manipulatorTexture, m_textureRects[TextureType::Move]);
+                ySprite.setTexture(*m_manipulatorTexture, m_textureRects[TextureType::Move]);
                 m_XYAxisManipulator.setColor(robot2D::Color{0.f, 0.f, 255.f, 100.f});
                 break;
             }
@@ -386,12 +388,12 @@ namespace editor {
                 auto& xSprite = m_xAxisManipulator.m_sprite;
                 xSprite.setRotate(270);
                 xSprite.setColor(robot2D::Color::Red);
-                xSprite.setTexture(m_manipulatorTexture, m_textureRects[TextureType::Scale]);
+                xSprite.setTexture(*m_manipulatorTexture, m_textureRects[TextureType::Scale]);
 
                 auto& ySprite = m_yAxisManipulator.m_sprite;
                 ySprite.setRotate(180);
                 ySprite.setColor(robot2D::Color::Green);
-                ySprite.setTexture(m_manipulatorTexture, m_textureRects[TextureType::Scale]);
+                ySprite.setTexture(*m_manipulatorTexture, m_textureRects[TextureType::Scale]);
                 break;
             }
         }
@@ -415,8 +417,8 @@ namespace editor {
 
 
 
-        m_manipulatorTexture = resourceManager -> getTexture(EditorResourceID::Manipulator);
-        m_manipulatorRotateTexture = resourceManager -> getTexture(EditorResourceID::ManipulatorRotate);
+        m_manipulatorTexture = &resourceManager -> getTexture(EditorResourceID::Manipulator);
+        m_manipulatorRotateTexture = &resourceManager -> getTexture(EditorResourceID::ManipulatorRotate);
         m_camera = camera;
         setOperationType(m_operation);
     }
@@ -0,0 +1,400 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+#include <robot2D/Core/Hash.hpp>
+#include <robot2D/Core/MappedFileInputStream.hpp>
+#include <robot2D/Util/Logger.hpp>
+
+#include <editor/ImportCache.hpp>
+#include <editor/FileApi.hpp>
+
+namespace editor {
+    namespace fs = std::filesystem;
+
+    namespace {
+        /// "RIMP"
+        constexpr std::uint32_t blobMagic = 0x504D4952;
+        /// Grows when blob layout or import itself changes, old blobs are never hit again.
+        constexpr std::uint32_t importVersion = 1;
+        constexpr std::size_t imageHeaderSize = 6 * sizeof(std::uint32_t);
+
+        template<typename T>
+        void writeValue(std::ostream& stream, const T& value) {
+            stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        template<typename T>
+        bool readValue(std::istream& stream, T& value) {
+            return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(T)));
+        }
+
+        bool isFontFile(const fs::path& path) {
+            return path.extension() == ".ttf";
+        }
+
+        /// Source bytes of asset: packed entry or mapped file, file isn't copied to be hashed.
+        struct SourceBytes {
+            robot2D::MappedFileInputStream file;
+            const std::uint8_t* data{nullptr};
+            std::size_t size{0};
+
+            bool open(const std::string& path, const robot2D::AssetView& packed) {
+                if(packed) {
+                    data = packed.data;
+                    size = packed.size;
+                    return true;
+                }
+                if(!file.openFromFile(path))
+                    return false;
+                data = file.getData();
+                size = file.getDataSize();
+                return true;
+            }
+        };
+    }
+
+    bool ImportCache::open(const std::string& directory) {
+        std::error_code error;
+        fs::create_directories(directory, error);
+        if(error) {
+            RB_EDITOR_ERROR("ImportCache: can't create directory {0}. Reason: {1}", directory, error.message());
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_directory = directory;
+        return true;
+    }
+
+    void ImportCache::close() {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_directory.clear();
+    }
+
+    bool ImportCache::isOpen() const {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return !m_directory.empty();
+    }
+
+    std::uint64_t ImportCache::makeKey(AssetKind kind, const void* data, std::size_t size, std::uint32_t parameter) {
+        std::array<std::uint32_t, 6> settings{static_cast<std::uint32_t>(kind), importVersion, parameter};
+        if(kind == AssetKind::Font) {
+            /// glyphs don't depend on character size font is loaded with
+            settings[2] = robot2D::Font::sdfGlyphSize;
+            settings[3] = static_cast<std::uint32_t>(robot2D::Font::sdfSpread);
+            settings[4] = robot2D::Font::sdfPreparedFirst;
+            settings[5] = robot2D::Font::sdfPreparedLast;
+        }
+        const auto seed = robot2D::xxHash64(settings.data(), settings.size() * sizeof(std::uint32_t));
+        return robot2D::xxHash64(data, size, seed);
+    }
+
+    std::string ImportCache::getBlobPath(AssetKind kind, const void* data, std::size_t size,
+                                         std::uint32_t parameter) const {
+        std::string directory;
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            directory = m_directory;
+        }
+        if(directory.empty())
+            return {};
+
+        const char* extension = kind == AssetKind::Image ? ".image"
+                                : kind == AssetKind::Font ? ".glyphs" : ".thumbnail";
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx%s",
+                      static_cast<unsigned long long>(makeKey(kind, data, size, parameter)), extension);
+        return (fs::path{directory} / name).string();
+    }
+
+    bool ImportCache::importImage(const std::string& path, const robot2D::AssetView& packed, robot2D::Image& image) {
+        SourceBytes source;
+        if(!source.open(path, packed))
+            return false;
+
+        const auto blobPath = getBlobPath(AssetKind::Image, source.data, source.size);
+        if(!blobPath.empty() && readImage(blobPath, AssetKind::Image, image)) {
+            m_hits.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        if(!image.loadFromMemory(source.data, source.size))
+            return false;
+        if(!blobPath.empty()) {
+            m_misses.fetch_add(1, std::memory_order_relaxed);
+            writeImage(blobPath, AssetKind::Image, image);
+        }
+        return true;
+    }
+
+    bool ImportCache::importFont(const std::string& path, const robot2D::AssetView& packed,
+                                 int charSize, robot2D::Font& font) {
+        SourceBytes source;
+        if(!source.open(path, packed))
+            return false;
+
+        const auto blobPath = getBlobPath(AssetKind::Font, source.data, source.size);
+        robot2D::Font::SdfGlyphs glyphs;
+        const bool cached = !blobPath.empty() && readGlyphs(blobPath, glyphs);
+
+        /// font reads its bytes by itself, mapping is used only for hashing
+        const bool loaded = packed ? font.loadFromMemory(packed.data, packed.size, charSize, glyphs)
+                                   : font.loadFromFile(path, charSize, glyphs);
+        if(!loaded)
+            return false;
+
+        if(cached)
+            m_hits.fetch_add(1, std::memory_order_relaxed);
+        else if(!blobPath.empty()) {
+            m_misses.fetch_add(1, std::memory_order_relaxed);
+            writeGlyphs(blobPath, glyphs);
+        }
+        return true;
+    }
+
+    bool ImportCache::importThumbnail(const std::string& path, unsigned int maxSide, robot2D::Image& thumbnail) {
+        if(maxSide == 0)
+            return false;
+
+        std::string blobPath;
+        {
+            SourceBytes source;
+            if(!source.open(path, {}))
+                return false;
+            blobPath = getBlobPath(AssetKind::Thumbnail, source.data, source.size, maxSide);
+        }
+        if(!blobPath.empty() && readImage(blobPath, AssetKind::Thumbnail, thumbnail)) {
+            m_hits.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        if(!importImage(path, {}, thumbnail))
+            return false;
+        while(true) {
+            const auto& size = thumbnail.getSize();
+            const auto factor = (std::max(size.x, size.y) + maxSide - 1) / maxSide;
+            if(factor < 2)
+                break;
+            if(!thumbnail.downsample(std::min(factor, robot2D::Image::maxDownsampleFactor), thumbnail))
+                return false;
+        }
+
+        if(!blobPath.empty()) {
+            m_misses.fetch_add(1, std::memory_order_relaxed);
+            writeImage(blobPath, AssetKind::Thumbnail, thumbnail);
+        }
+        return true;
+    }
+
+    void ImportCache::importFile(const std::string& path, robot2D::JobSystem& jobSystem) {
+        if(!isOpen() || (!isImageFile(path) && !isFontFile(path)))
+            return;
+        jobSystem.schedule([this, path]() { prepareFile(path); }, {}, robot2D::JobPriority::Background);
+    }
+
+    void ImportCache::importDirectory(const std::string& directory, robot2D::JobSystem& jobSystem) {
+        if(!isOpen())
+            return;
+        jobSystem.schedule([this, directory, &jobSystem]() {
+            std::error_code error;
+            for(fs::recursive_directory_iterator it{directory, error}, end; !error && it != end; it.increment(error)) {
+                if(it -> is_regular_file(error))
+                    importFile(it -> path().string(), jobSystem);
+            }
+            if(error)
+                RB_EDITOR_WARN("ImportCache: can't scan {0}. Reason: {1}", directory, error.message());
+        }, {}, robot2D::JobPriority::Background);
+    }
+
+    void ImportCache::prepareFile(const std::string& path) {
+        SourceBytes source;
+        if(!source.open(path, {}))
+            return;
+
+        const auto kind = isImageFile(path) ? AssetKind::Image : AssetKind::Font;
+        const auto blobPath = getBlobPath(kind, source.data, source.size);
+        std::error_code error;
+        if(blobPath.empty() || fs::exists(blobPath, error))
+            return;
+
+        if(kind == AssetKind::Image) {
+            robot2D::Image image;
+            if(!image.loadFromMemory(source.data, source.size))
+                return;
+            m_misses.fetch_add(1, std::memory_order_relaxed);
+            writeImage(blobPath, AssetKind::Image, image);
+            return;
+        }
+
+        /// bitmap mode font doesn't put anything into GlyphCache, distance fields are made right here
+        robot2D::Font font;
+        if(!font.loadFromFile(path))
+            return;
+        robot2D::Font::SdfGlyphs glyphs;
+        glyphs.reserve(robot2D::Font::sdfPreparedLast - robot2D::Font::sdfPreparedFirst + 1);
+        for(auto codepoint = robot2D::Font::sdfPreparedFirst; codepoint <= robot2D::Font::sdfPreparedLast; ++codepoint) {
+            robot2D::GlyphBitmap bitmap;
+            if(font.rasterizeSdfGlyph(codepoint, bitmap))
+                glyphs.emplace_back(codepoint, std::move(bitmap));
+        }
+        m_misses.fetch_add(1, std::memory_order_relaxed);
+        writeGlyphs(blobPath, glyphs);
+    }
+
+    bool ImportCache::readImage(const std::string& blobPath, AssetKind assetKind, robot2D::Image& image) const {
+        std::ifstream file{blobPath, std::ios::binary};
+        if(!file.is_open())
+            return false;
+
+        std::uint32_t magic = 0, version = 0, kind = 0, width = 0, height = 0, channels = 0;
+        if(!readValue(file, magic) || !readValue(file, version) || !readValue(file, kind)
+            || !readValue(file, width) || !readValue(file, height) || !readValue(file, channels))
+            return false;
+
+        const auto bytes = static_cast<std::size_t>(width) * height * channels;
+        std::error_code error;
+        const auto fileSize = fs::file_size(blobPath, error);
+        if(magic != blobMagic || version != importVersion || kind != static_cast<std::uint32_t>(assetKind)
+            || channels == 0 || channels > 4 || error || fileSize != imageHeaderSize + bytes) {
+            RB_EDITOR_WARN("ImportCache: broken blob {0}, asset is imported again", blobPath);
+            return false;
+        }
+
+        /// pixels are read straight into image's buffer
+        robot2D::PixelBuffer pixels(bytes);
+        if(!file.read(reinterpret_cast<char*>(pixels.data()), static_cast<std::streamsize>(bytes)))
+            return false;
+        return image.create({width, height}, std::move(pixels), static_cast<robot2D::ImageColorFormat>(channels));
+    }
+
+    bool ImportCache::writeImage(const std::string& blobPath, AssetKind kind, const robot2D::Image& image) {
+        const auto tempPath = makeTempPath(blobPath);
+        {
+            std::ofstream file{tempPath, std::ios::binary};
+            if(!file.is_open())
+                return false;
+
+            const auto& size = image.getSize();
+            const auto& pixels = image.getBuffer();
+            writeValue(file, blobMagic);
+            writeValue(file, importVersion);
+            writeValue(file, static_cast<std::uint32_t>(kind));
+            writeValue(file, size.x);
+            writeValue(file, size.y);
+            writeValue(file, static_cast<std::uint32_t>(image.getColorFormat()));
+            file.write(reinterpret_cast<const char*>(pixels.data()), static_cast<std::streamsize>(pixels.size()));
+            if(!file) {
+                file.close();
+                std::error_code error;
+                fs::remove(tempPath, error);
+                return false;
+            }
+        }
+        return commitBlob(tempPath, blobPath);
+    }
+
+    bool ImportCache::readGlyphs(const std::string& blobPath, robot2D::Font::SdfGlyphs& glyphs) const {
+        std::ifstream file{blobPath, std::ios::binary};
+        if(!file.is_open())
+            return false;
+
+        std::uint32_t magic = 0, version = 0, kind = 0, count = 0;
+        if(!readValue(file, magic) || !readValue(file, version) || !readValue(file, kind) || !readValue(file, count)
+            || magic != blobMagic || version != importVersion || kind != static_cast<std::uint32_t>(AssetKind::Font)
+            || count > robot2D::Font::sdfPreparedLast - robot2D::Font::sdfPreparedFirst + 1) {
+            RB_EDITOR_WARN("ImportCache: broken blob {0}, asset is imported again", blobPath);
+            return false;
+        }
+
+        glyphs.resize(count);
+        for(auto& [codepoint, bitmap]: glyphs) {
+            if(!readValue(file, codepoint) || !readValue(file, bitmap.size.x) || !readValue(file, bitmap.size.y)
+                || !readValue(file, bitmap.bearing.x) || !readValue(file, bitmap.bearing.y)
+                || !readValue(file, bitmap.advance) || bitmap.size.x < 0 || bitmap.size.y < 0
+                || bitmap.size.x > 4 * static_cast<int>(robot2D::Font::sdfGlyphSize)
+                || bitmap.size.y > 4 * static_cast<int>(robot2D::Font::sdfGlyphSize)) {
+                glyphs.clear();
+                return false;
+            }
+            bitmap.pixels.resize(static_cast<std::size_t>(bitmap.size.x) * static_cast<std::size_t>(bitmap.size.y));
+            if(!file.read(reinterpret_cast<char*>(bitmap.pixels.data()),
+                          static_cast<std::streamsize>(bitmap.pixels.size()))) {
+                glyphs.clear();
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool ImportCache::writeGlyphs(const std::string& blobPath, const robot2D::Font::SdfGlyphs& glyphs) {
+        const auto tempPath = makeTempPath(blobPath);
+        {
+            std::ofstream file{tempPath, std::ios::binary};
+            if(!file.is_open())
+                return false;
+
+            writeValue(file, blobMagic);
+            writeValue(file, importVersion);
+            writeValue(file, static_cast<std::uint32_t>(AssetKind::Font));
+            writeValue(file, static_cast<std::uint32_t>(glyphs.size()));
+            for(const auto& [codepoint, bitmap]: glyphs) {
+                writeValue(file, codepoint);
+                writeValue(file, bitmap.size.x);
+                writeValue(file, bitmap.size.y);
+                writeValue(file, bitmap.bearing.x);
+                writeValue(file, bitmap.bearing.y);
+                writeValue(file, bitmap.advance);
+                file.write(reinterpret_cast<const char*>(bitmap.pixels.data()),
+                           static_cast<std::streamsize>(bitmap.pixels.size()));
+            }
+            if(!file) {
+                file.close();
+                std::error_code error;
+                fs::remove(tempPath, error);
+                return false;
+            }
+        }
+        return commitBlob(tempPath, blobPath);
+    }
+
+    std::string ImportCache::makeTempPath(const std::string& blobPath) {
+        return blobPath + "." + std::to_string(m_tempCounter.fetch_add(1, std::memory_order_relaxed)) + ".tmp";
+    }
+
+    bool ImportCache::commitBlob(const std::string& tempPath, const std::string& blobPath) {
+        std::error_code error;
+        fs::rename(tempPath, blobPath, error);
+        if(error) {
+            RB_EDITOR_WARN("ImportCache: can't store blob {0}. Reason: {1}", blobPath, error.message());
+            fs::remove(tempPath, error);
+            return false;
+        }
+        return true;
+    }
+
+}
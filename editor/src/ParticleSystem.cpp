@@ -0,0 +1,383 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+#include <cmath>
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define EDITOR_PARTICLES_SSE
+    #include <emmintrin.h>
+#endif
+
+#include <robot2D/Core/Clock.hpp>
+#include <robot2D/Core/JobSystem.hpp>
+#include <robot2D/Graphics/RenderTarget.hpp>
+#include <robot2D/Ecs/EntityManager.hpp>
+
+#include <editor/ParticleSystem.hpp>
+
+constexpr const char* particleVertShader = R"(
+    #version 330 core
+    layout(location = 0) in vec2 corner;
+    layout(location = 1) in vec2 uv;
+    layout(location = 2) in vec2 instancePosition;
+    layout(location = 3) in float instanceSize;
+    layout(location = 4) in vec4 instanceColor;
+
+    out vec2 textureCoords;
+    out vec4 outputColor;
+    uniform mat4 projection;
+
+    void main() {
+        outputColor = instanceColor;
+        textureCoords = uv;
+        gl_Position = projection * vec4(instancePosition + corner * instanceSize, 0.0, 1.0);
+    }
+)";
+
+constexpr const char* particleFragShader = R"(
+    #version 330 core
+
+    out vec4 fragColor;
+    in vec2 textureCoords;
+    in vec4 outputColor;
+
+    uniform sampler2D particleSampler;
+
+    void main() {
+        vec4 texel = texture(particleSampler, textureCoords) * outputColor;
+        if(texel.a == 0.0) {
+            discard;
+        }
+        fragColor = texel;
+    }
+)";
+
+namespace editor {
+
+    namespace {
+        /// Particles count simulated by one worker.
+        constexpr std::size_t simulationChunkSize = 4096;
+        constexpr float pi = 3.14159265F;
+
+        struct SimulationJob {
+            ParticlePool* pool;
+            std::size_t begin;
+            std::size_t end;
+            robot2D::vec2f gravity;
+        };
+
+        void integrate(const SimulationJob& job, float dt) {
+            auto& pool = *job.pool;
+            float* positionX = pool.positionX.data();
+            float* positionY = pool.positionY.data();
+            float* velocityX = pool.velocityX.data();
+            float* velocityY = pool.velocityY.data();
+            float* life = pool.life.data();
+
+            const float gravityX = job.gravity.x * dt;
+            const float gravityY = job.gravity.y * dt;
+
+            std::size_t i = job.begin;
+#ifdef EDITOR_PARTICLES_SSE
+            const __m128 deltaTime = _mm_set1_ps(dt);
+            const __m128 deltaGravityX = _mm_set1_ps(gravityX);
+            const __m128 deltaGravityY = _mm_set1_ps(gravityY);
+
+            for(; i + 4 <= job.end; i += 4) {
+                __m128 vx = _mm_add_ps(_mm_loadu_ps(velocityX + i), deltaGravityX);
+                __m128 vy = _mm_add_ps(_mm_loadu_ps(velocityY + i), deltaGravityY);
+                __m128 px = _mm_add_ps(_mm_loadu_ps(positionX + i), _mm_mul_ps(vx, deltaTime));
+                __m128 py = _mm_add_ps(_mm_loadu_ps(positionY + i), _mm_mul_ps(vy, deltaTime));
+                __m128 lf = _mm_sub_ps(_mm_loadu_ps(life + i), deltaTime);
+
+                _mm_storeu_ps(velocityX + i, vx);
+                _mm_storeu_ps(velocityY + i, vy);
+                _mm_storeu_ps(positionX + i, px);
+                _mm_storeu_ps(positionY + i, py);
+                _mm_storeu_ps(life + i, lf);
+            }
+#endif
+            for(; i < job.end; ++i) {
+                velocityX[i] += gravityX;
+                velocityY[i] += gravityY;
+                positionX[i] += velocityX[i] * dt;
+                positionY[i] += velocityY[i] * dt;
+                life[i] -= dt;
+            }
+        }
+
+        robot2D::Color lerp(const robot2D::Color& start, const robot2D::Color& end, float t) {
+            return {
+                start.red + (end.red - start.red) * t,
+                start.green + (end.green - start.green) * t,
+                start.blue + (end.blue - start.blue) * t,
+                start.alpha + (end.alpha - start.alpha) * t
+            };
+        }
+    }
+
+    void ParticlePool::resize(std::size_t capacity) {
+        positionX.resize(capacity);
+        positionY.resize(capacity);
+        velocityX.resize(capacity);
+        velocityY.resize(capacity);
+        life.resize(capacity);
+        lifeTime.resize(capacity);
+        if(count > capacity)
+            count = capacity;
+    }
+
+    void ParticlePool::kill(std::size_t index) {
+        const std::size_t last = count - 1;
+        positionX[index] = positionX[last];
+        positionY[index] = positionY[last];
+        velocityX[index] = velocityX[last];
+        velocityY[index] = velocityY[last];
+        life[index] = life[last];
+        lifeTime[index] = lifeTime[last];
+        --count;
+    }
+
+    ParticleSystem::ParticleSystem(robot2D::MessageBus& messageBus):
+        robot2D::ecs::System(messageBus, typeid(ParticleSystem)),
+        m_random{std::random_device{}()} {
+        addRequirement<ParticleEmitterComponent>();
+        addRequirement<TransformComponent>();
+    }
+
+    void ParticleSystem::setupGL() {
+        float quadVertices[] = {
+            -0.5F, -0.5F, 0.F, 0.F,
+             0.5F, -0.5F, 1.F, 0.F,
+             0.5F,  0.5F, 1.F, 1.F,
+            -0.5F,  0.5F, 0.F, 1.F
+        };
+        uint32_t quadIndices[] = { 0, 1, 2, 2, 3, 0 };
+
+        m_quadBuffer = robot2D::VertexBuffer::Create(quadVertices, sizeof(quadVertices));
+        m_quadBuffer -> setAttributeLayout({
+                                               {robot2D::ElementType::Float2, "Corner"},
+                                               {robot2D::ElementType::Float2, "UVS"},
+                                           });
+        m_indexBuffer = robot2D::IndexBuffer::Create(quadIndices, sizeof(quadIndices));
+
+        const unsigned char whitePixel[4] = { 255, 255, 255, 255 };
+        m_whiteTexture.create({1, 1}, whitePixel);
+
+        m_particleShader.createShader(robot2D::ShaderType::Vertex, particleVertShader, false);
+        m_particleShader.createShader(robot2D::ShaderType::Fragment, particleFragShader, false);
+        m_particleShader.use();
+        m_particleShader.set("particleSampler", 0);
+        m_particleShader.unUse();
+
+        m_initialized = true;
+    }
+
+    void ParticleSystem::setupBatchGL(ParticleBatch& batch, std::size_t capacity) {
+        batch.vertexArray = robot2D::VertexArray::Create();
+        batch.vertexArray -> setVertexBuffer(m_quadBuffer);
+        batch.vertexArray -> setIndexBuffer(m_indexBuffer);
+
+        batch.instanceBuffer = robot2D::VertexBuffer::Create(sizeof(ParticleInstance) * capacity);
+        batch.instanceBuffer -> setAttributeLayout({
+                                                      {robot2D::ElementType::Float2, "Position"},
+                                                      {robot2D::ElementType::Float1, "Size"},
+                                                      {robot2D::ElementType::Float4, "Color"},
+                                                  });
+        batch.vertexArray -> setInstanceBuffer(batch.instanceBuffer);
+        batch.instanceCapacity = capacity;
+    }
+
+    void ParticleSystem::update(float dt) {
+        if(!m_initialized)
+            setupGL();
+
+        robot2D::Clock clock;
+        m_stats = {};
+
+        simulate(dt);
+
+        for(auto& batch: m_batches)
+            batch.instances.clear();
+
+        unsigned int budget = m_emissionBudget;
+        for(auto& entity: m_entities) {
+            auto& emitter = entity.getComponent<ParticleEmitterComponent>();
+            auto& transform = entity.getComponent<TransformComponent>();
+            auto& data = m_emitters[entity.getIndex()];
+
+            if(data.pool.positionX.size() != emitter.maxParticles)
+                data.pool.resize(emitter.maxParticles);
+
+            const auto bounds = transform.getGlobalBounds();
+            robot2D::vec2f origin = { bounds.lx + bounds.width / 2.F, bounds.ly + bounds.height / 2.F };
+
+            unsigned int emitted = emit(data, emitter, origin, dt, m_emissionBudget ? budget : emitter.maxParticles);
+            if(m_emissionBudget)
+                budget -= emitted;
+
+            if(data.pool.count > 0)
+                pack(getBatch(emitter), data, emitter);
+
+            m_stats.emittedParticles += emitted;
+            m_stats.aliveParticles += static_cast<unsigned int>(data.pool.count);
+            ++m_stats.emitters;
+        }
+        upload();
+
+        m_stats.simulationTime = clock.duration().asMilliSeconds();
+    }
+
+    void ParticleSystem::simulate(float dt) {
+        std::vector<SimulationJob> jobs;
+        for(auto& entity: m_entities) {
+            auto found = m_emitters.find(entity.getIndex());
+            if(found == m_emitters.end())
+                continue;
+            auto& pool = found -> second.pool;
+            const auto& gravity = entity.getComponent<ParticleEmitterComponent>().gravity;
+            for(std::size_t begin = 0; begin < pool.count; begin += simulationChunkSize)
+                jobs.push_back({&pool, begin, std::min(begin + simulationChunkSize, pool.count), gravity});
+        }
+
+        if(jobs.empty())
+            return;
+
+        /// chunks are spread over shared pool, calling thread simulates its part too
+        robot2D::JobSystem::getInstance().parallelFor(jobs.size(), 1, [&jobs, dt](std::size_t begin, std::size_t end) {
+            for(std::size_t i = begin; i < end; ++i)
+                integrate(jobs[i], dt);
+        });
+
+        for(auto& [id, data]: m_emitters) {
+            auto& pool = data.pool;
+            for(std::size_t i = 0; i < pool.count;) {
+                if(pool.life[i] <= 0.F)
+                    pool.kill(i);
+                else
+                    ++i;
+            }
+        }
+    }
+
+    unsigned int ParticleSystem::emit(EmitterData& data, ParticleEmitterComponent& emitter,
+                                      const robot2D::vec2f& origin, float dt, unsigned int budget) {
+        if(!emitter.emitting || emitter.lifeTime <= 0.F)
+            return 0;
+
+        emitter.m_emitAccumulator += emitter.emissionRate * dt;
+        auto requested = static_cast<std::size_t>(emitter.m_emitAccumulator);
+        /// throttled particles are dropped instead of bursting on next frames
+        emitter.m_emitAccumulator -= static_cast<float>(requested);
+
+        auto& pool = data.pool;
+        std::size_t free = pool.positionX.size() - pool.count;
+        std::size_t spawnCount = std::min({requested, free, static_cast<std::size_t>(budget)});
+
+        const float direction = emitter.direction * pi / 180.F;
+        const float halfSpread = emitter.spread * pi / 360.F;
+        std::uniform_real_distribution<float> angleDist(direction - halfSpread, direction + halfSpread);
+
+        for(std::size_t i = 0; i < spawnCount; ++i) {
+            const std::size_t index = pool.count++;
+            const float angle = angleDist(m_random);
+            pool.positionX[index] = origin.x;
+            pool.positionY[index] = origin.y;
+            pool.velocityX[index] = std::cos(angle) * emitter.speed;
+            pool.velocityY[index] = std::sin(angle) * emitter.speed;
+            pool.life[index] = emitter.lifeTime;
+            pool.lifeTime[index] = emitter.lifeTime;
+        }
+
+        return static_cast<unsigned int>(spawnCount);
+    }
+
+    ParticleSystem::ParticleBatch& ParticleSystem::getBatch(const ParticleEmitterComponent& emitter) {
+        const auto* texture = emitter.getTexture() ? emitter.getTexture() : &m_whiteTexture;
+        for(auto& batch: m_batches) {
+            if(batch.texture == texture && batch.layerID == emitter.layerIndex)
+                return batch;
+        }
+
+        auto& batch = m_batches.emplace_back();
+        batch.texture = texture;
+        batch.layerID = emitter.layerIndex;
+        return batch;
+    }
+
+    void ParticleSystem::pack(ParticleBatch& batch, const EmitterData& data, const ParticleEmitterComponent& emitter) {
+        const auto& pool = data.pool;
+        const auto startColor = emitter.startColor.toGL();
+        const auto endColor = emitter.endColor.toGL();
+
+        const std::size_t first = batch.instances.size();
+        batch.instances.resize(first + pool.count);
+        for(std::size_t i = 0; i < pool.count; ++i) {
+            const float t = 1.F - pool.life[i] / pool.lifeTime[i];
+            auto& instance = batch.instances[first + i];
+            instance.position = { pool.positionX[i], pool.positionY[i] };
+            instance.size = emitter.startSize + (emitter.endSize - emitter.startSize) * t;
+            instance.color = lerp(startColor, endColor, t);
+        }
+    }
+
+    void ParticleSystem::upload() {
+        /// batches nobody packed into this frame release their buffers
+        m_batches.erase(std::remove_if(m_batches.begin(), m_batches.end(), [](const ParticleBatch& batch) {
+            return batch.instances.empty();
+        }), m_batches.end());
+
+        for(auto& batch: m_batches) {
+            if(!batch.vertexArray || batch.instanceCapacity < batch.instances.size())
+                setupBatchGL(batch, batch.instances.capacity());
+            batch.instanceBuffer -> setData(batch.instances.data(),
+                                            static_cast<uint32_t>(sizeof(ParticleInstance) * batch.instances.size()));
+        }
+    }
+
+    void ParticleSystem::draw(robot2D::RenderTarget& target, robot2D::RenderStates states) const {
+        states.shader = const_cast<robot2D::ShaderHandler*>(&m_particleShader);
+        states.layerProjection = true;
+        states.renderInfo.indexCount = 6;
+        for(const auto& batch: m_batches) {
+            auto renderStates = states;
+            renderStates.layerID = batch.layerID;
+            renderStates.texture = batch.texture;
+            renderStates.renderInfo.instanceCount = static_cast<uint32_t>(batch.instances.size());
+            target.draw(batch.vertexArray, renderStates);
+        }
+    }
+
+    void ParticleSystem::onEntityRemoved(robot2D::ecs::Entity entity) {
+        m_emitters.erase(entity.getIndex());
+    }
+
+    robot2D::ecs::System::Ptr ParticleSystem::cloneSelf(robot2D::ecs::Scene* scene,
+                                                        const std::vector<robot2D::ecs::Entity>& newEntities) {
+        auto cloneSystem = std::make_shared<ParticleSystem>(m_messageBus);
+        if(!cloneBase(cloneSystem, scene, newEntities))
+            return nullptr;
+        cloneSystem -> m_emissionBudget = m_emissionBudget;
+        return cloneSystem;
+    }
+
+}
@@ -20,12 +20,18 @@ source distribution.
 *********************************************************************/
 
 #include <algorithm>
+#include <array>
+#include <cmath>
 
+#include <robot2D/Core/JobSystem.hpp>
 #include <robot2D/Graphics/RenderTarget.hpp>
+#include <robot2D/Graphics/GlyphCache.hpp>
 #include <robot2D/Ecs/EntityManager.hpp>
+#include <robot2D/Util/Profiler.hpp>
 
 #include <editor/RendererSystem.hpp>
 #include <editor/TextSystem.hpp>
+#include <editor/SpatialSystem.hpp>
 #include <editor/Scene.hpp>
 
 //#include "glm/gtc/type_ptr.hpp"
@@ -171,64 +177,184 @@ namespace editor {
 
 
     void RenderSystem::draw(robot2D::RenderTarget& target, robot2D::RenderStates states) const {
-        for(auto& ent: m_entities) {
-            auto& transform = ent.getComponent<TransformComponent>();
-            auto& drawable = ent.getComponent<DrawableComponent>();
-            auto t = transform.getTransform();
-
+        m_batchedEntities.assign(m_entities.size(), true);
+        for(std::size_t i = 0; i < m_entities.size(); ++i) {
+            const auto& ent = m_entities[i];
             if (ent.hasComponent<CameraComponent>() && m_runtimeFlag) {
                 auto camera = ent.getComponent<CameraComponent>();
                 if (camera.isPrimary) {
                      target.setView(m_cameraView);
                 }
             }
+        }
 
-            robot2D::RenderStates renderStates;
-            renderStates.transform *= t;
-            if(drawable.hasTexture())
-                renderStates.texture = &drawable.getTexture();
-            renderStates.color = drawable.getColor();
-            renderStates.layerID = drawable.getLayerIndex();
+        cullEntities(target);
+        resolveGlyphPages();
+        /// recording reads transforms and drawables that systems after RenderSystem still write during update,
+        /// so it can't overlap update, only spread over JobSystem workers
+        recordQuads();
 
-            if(getScene() -> hasSystem<TextSystem>() && ent.hasComponent<TextComponent>()) {
-                if(!ent.getComponent<TextComponent>().getFont())
-                    continue;
+        std::vector<const robot2D::RenderCommandList*> commandLists;
+        commandLists.reserve(m_commandLists.size());
+        for(const auto& commandList: m_commandLists)
+            commandLists.emplace_back(&commandList);
+        target.submit(commandLists);
 
-                auto textSystem = getScene() -> getSystem<TextSystem>();
-                auto vertexArray =  textSystem -> getVertexArray();
-                renderStates.shader = const_cast<robot2D::ShaderHandler*>(&textSystem -> getShader());
-                renderStates.shader -> use();
-                auto view = target.getView(drawable.getLayerIndex()).getTransform();
-                renderStates.shader -> setMatrix("projection", view.get_matrix());
-                renderStates.shader -> unUse();
-                renderStates.renderInfo.indexCount = textSystem -> getIndexCount();
-                target.draw(vertexArray, renderStates);
+        for(const auto& ent: m_entities) {
+            const auto& transform = ent.getComponent<TransformComponent>();
+            const auto& drawable = ent.getComponent<DrawableComponent>();
+            if(!drawable.drawBoundingBox())
+                continue;
+            if(m_cullingEnabled && !m_visibleEntities[ent.getIndex()])
+                continue;
+            const auto& rect = transform.getGlobalBounds();
+            BoundingBox bb;
+            bb.setBox(rect);
+            target.draw(bb);
+        }
+    }
+
+    void RenderSystem::resolveGlyphPages() const {
+        m_textsEnabled = getScene() -> hasSystem<TextSystem>();
+        if(!m_textsEnabled)
+            return;
+
+        /// page textures are created and updated here, workers only read them
+        auto& glyphCache = robot2D::GlyphCache::getInstance();
+        m_glyphPages.resize(glyphCache.getPagesCount());
+        for(std::size_t page = 0; page < m_glyphPages.size(); ++page)
+            m_glyphPages[page] = glyphCache.getPageTexture(static_cast<int>(page));
+    }
+
+    void RenderSystem::cullEntities(const robot2D::RenderTarget& target) const {
+        m_cullingEnabled = getScene() -> hasSystem<SpatialSystem>();
+        if(!m_cullingEnabled)
+            return;
+
+        RB_PROFILE_FUNCTION();
+        const auto* spatialSystem = getScene() -> getSystem<SpatialSystem>();
+
+        std::size_t maxIndex = 0;
+        std::vector<unsigned int> layers;
+        for(const auto& ent: m_entities) {
+            maxIndex = std::max<std::size_t>(maxIndex, ent.getIndex());
+            const auto layer = ent.getComponent<DrawableComponent>().getLayerIndex();
+            if(std::find(layers.begin(), layers.end(), layer) == layers.end())
+                layers.emplace_back(layer);
+        }
+        m_visibleEntities.assign(maxIndex + 1, false);
+
+        for(const auto layer: layers) {
+            const auto& view = target.getView(layer);
+            robot2D::vec2f halfSize = { view.getSize().x / 2.F, view.getSize().y / 2.F };
+            /// rotated view is covered by its half diagonal
+            if(view.getRotation() != 0.F) {
+                const float radius = std::sqrt(halfSize.x * halfSize.x + halfSize.y * halfSize.y);
+                halfSize = { radius, radius };
+            }
+            const robot2D::FloatRect viewRect = { view.getCenter().x - halfSize.x, view.getCenter().y - halfSize.y,
+                                                  halfSize.x * 2.F, halfSize.y * 2.F };
+
+            m_foundEntities.clear();
+            spatialSystem -> query(viewRect, m_foundEntities);
+            for(const auto& found: m_foundEntities) {
+                if(found.getIndex() < m_visibleEntities.size()
+                    && found.hasComponent<DrawableComponent>()
+                    && found.getComponent<DrawableComponent>().getLayerIndex() == layer)
+                    m_visibleEntities[found.getIndex()] = true;
             }
-            else {
+        }
+
+        for(std::size_t i = 0; i < m_entities.size(); ++i) {
+            /// glyphs may leave entity's bounds, texts are left to rasterizer
+            if(m_entities[i].hasComponent<TextComponent>())
+                continue;
+            if(!m_visibleEntities[m_entities[i].getIndex()])
+                m_batchedEntities[i] = false;
+        }
+    }
+
+    void RenderSystem::recordQuads() const {
+        auto& jobSystem = robot2D::JobSystem::getInstance();
+        const std::size_t entitiesCount = m_entities.size();
+        const std::size_t chunksCount = std::max<std::size_t>(1,
+                std::min<std::size_t>(jobSystem.getWorkersCount() + 1, entitiesCount / minQuadsPerRecordJob));
+        const std::size_t chunkSize = (entitiesCount + chunksCount - 1) / chunksCount;
+
+        m_commandLists.resize(chunksCount);
+
+        /// chunks are contiguous and entity index is sort key, so merge keeps depth order
+        auto recordChunk = [this, chunkSize, entitiesCount](std::size_t chunk) {
+            auto& commandList = m_commandLists[chunk];
+            commandList.clear();
+            const std::size_t end = std::min(entitiesCount, (chunk + 1) * chunkSize);
+            for(std::size_t i = chunk * chunkSize; i < end; ++i) {
+                if(!m_batchedEntities[i])
+                    continue;
+
+                const auto& ent = m_entities[i];
+                const auto& transform = ent.getComponent<TransformComponent>();
+                const auto& drawable = ent.getComponent<DrawableComponent>();
+
+                if(m_textsEnabled && ent.hasComponent<TextComponent>()) {
+                    recordText(commandList, ent, static_cast<int>(i));
+                    continue;
+                }
+
+                robot2D::RenderStates renderStates;
+                renderStates.transform *= transform.getTransform();
+                if(drawable.hasTexture())
+                    renderStates.texture = &drawable.getTexture();
+                renderStates.color = drawable.getColor();
+                renderStates.layerID = drawable.getLayerIndex();
+                renderStates.entityID = ent.getIndex();
+
                 auto& vertices = drawable.getVertices();
                 vertices[0].position = renderStates.transform * robot2D::vec2f {0.F, 0.F};
                 vertices[1].position = renderStates.transform * robot2D::vec2f {1.F, 0.F};
                 vertices[2].position = renderStates.transform * robot2D::vec2f {1.F, 1.F};
                 vertices[3].position = renderStates.transform * robot2D::vec2f {0.F, 1.F};
 
-                renderStates.entityID = ent.getIndex();
-
-                robot2D::VertexData vertexData{};
-                for(const auto& vertex: vertices)
-                    vertexData.emplace_back(vertex);
-                target.draw(vertexData, renderStates);
+                renderStates.transform = robot2D::Transform{};
+                commandList.draw(vertices, renderStates, static_cast<int>(i));
             }
+        };
 
-        }
-        for(const auto& ent: m_entities) {
-            const auto& transform = ent.getComponent<TransformComponent>();
-            const auto& drawable = ent.getComponent<DrawableComponent>();
-            if(!drawable.drawBoundingBox())
+        /// one chunk per thread, command lists keep their capacity between frames
+        jobSystem.parallelFor(chunksCount, 1, [&recordChunk](std::size_t begin, std::size_t end) {
+            for(std::size_t chunk = begin; chunk < end; ++chunk)
+                recordChunk(chunk);
+        }, robot2D::JobPriority::Interactive);
+    }
+
+    void RenderSystem::recordText(robot2D::RenderCommandList& commandList,
+                                  const robot2D::ecs::Entity& ent, int sortKey) const {
+        const auto& text = ent.getComponent<TextComponent>();
+        const auto* layout = text.getLayout();
+        if(!text.getFont() || !layout)
+            return;
+
+        const auto& transform = ent.getComponent<TransformComponent>().getTransform();
+        const auto& drawable = ent.getComponent<DrawableComponent>();
+
+        robot2D::RenderStates renderStates;
+        renderStates.color = drawable.getColor();
+        renderStates.layerID = drawable.getLayerIndex();
+        renderStates.entityID = ent.getIndex();
+        renderStates.textureSampling = text.getTextureSampling();
+
+        std::array<robot2D::Vertex, 4> quad;
+        for(const auto& glyph: layout -> glyphs) {
+            /// page could be evicted after layout was built, TextSystem updates it next frame
+            if(glyph.page < 0 || static_cast<std::size_t>(glyph.page) >= m_glyphPages.size()
+                || !m_glyphPages[glyph.page])
                 continue;
-            const auto& rect = transform.getGlobalBounds();
-            BoundingBox bb;
-            bb.setBox(rect);
-            target.draw(bb);
+            renderStates.texture = m_glyphPages[glyph.page];
+            for(std::size_t v = 0; v < quad.size(); ++v) {
+                quad[v].position = transform * glyph.quad.vertices[v].position;
+                quad[v].texCoords = glyph.quad.vertices[v].uvs;
+            }
+            commandList.draw(quad, renderStates, sortKey);
         }
     }
 
@@ -20,6 +20,7 @@ source distribution.
 *********************************************************************/
 #include <optional>
 #include <robot2D/Graphics/RenderTarget.hpp>
+#include <robot2D/Util/Profiler.hpp>
 
 #include <editor/Scene.hpp>
 #include <editor/Components.hpp>
@@ -31,6 +32,8 @@ source distribution.
 #include <editor/AnimatorSystem.hpp>
 #include <editor/AnimationSystem.hpp>
 #include <editor/UISystem.hpp>
+#include <editor/ParticleSystem.hpp>
+#include <editor/SpatialSystem.hpp>
 
 #include <editor/scripting/ScriptingEngine.hpp>
 #include <editor/panels/TreeHierarchy.hpp>
@@ -65,11 +68,13 @@ namespace editor {
     }
 
     void Scene::initScene() {
+        m_scene.addSystem<SpatialSystem>(m_messageBus);
         m_scene.addSystem<RenderSystem>(m_messageBus);
         m_scene.addSystem<TextSystem>(m_messageBus);
         m_scene.addSystem<AnimatorSystem>(m_messageBus);
         m_scene.addSystem<AnimationSystem>(m_messageBus);
         m_scene.addSystem<UISystem>(m_messageBus);
+        m_scene.addSystem<ParticleSystem>(m_messageBus);
     }
 
     void Scene::createMainCamera() {
@@ -101,6 +106,7 @@ namespace editor {
 
 
     void Scene::update(float dt) {
+        RB_PROFILE_SCOPE("Scene::update");
         auto& sceneEntities = m_sceneGraph.getEntities();
         for (const auto& restoreData: m_restoreItems) {
             if (restoreData.anchorIterator == sceneEntities.begin())
@@ -123,6 +129,7 @@ namespace editor {
     }
 
     void Scene::updateRuntime(float dt, IScriptInteractorFrom::Ptr scriptInteractor) {
+        RB_PROFILE_SCOPE("Scene::updateRuntime");
         auto scriptingEngine = scriptInteractor -> getScriptingEngine();
         if(!scriptingEngine)
             return;
@@ -134,6 +141,13 @@ namespace editor {
         m_runtimeScene.update(dt);
     }
 
+    ParticleStats Scene::getParticleStats() const {
+        const auto& scene = m_running ? m_runtimeScene : m_scene;
+        if(!scene.hasSystem<ParticleSystem>())
+            return {};
+        return scene.getSystem<ParticleSystem>() -> getStats();
+    }
+
     void Scene::draw(robot2D::RenderTarget &target, robot2D::RenderStates states) const {
         if(m_running) {
             target.draw(m_runtimeScene);
@@ -265,6 +279,14 @@ namespace editor {
     }
 
 
+    void Scene::markDirty(const SceneEntity& entity) {
+        if(!entity)
+            return;
+        m_fragmentCache.markDirty(entity.getUUID());
+        m_editedEntities.insert(entity.getUUID());
+        m_hasChanges = true;
+    }
+
     void Scene::removeEntityChild(SceneEntity entity) {
         m_hasChanges = true;
     }
@@ -283,6 +305,12 @@ namespace editor {
     }
 
 
+    const SpatialSystem* Scene::getSpatialSystem() const {
+        if(m_running)
+            return m_runtimeScene.getSystem<SpatialSystem>();
+        return m_scene.getSystem<SpatialSystem>();
+    }
+
     bool Scene::setBefore(SceneEntity source, SceneEntity target) {
         if (m_sceneGraph.setBefore(source, target)) {
             m_scene.getSystem<RenderSystem>() -> setBefore(source.getWrappedEntity(),
@@ -0,0 +1,265 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <unordered_set>
+#include <vector>
+
+#include <yaml-cpp/yaml.h>
+#include <robot2D/Util/Logger.hpp>
+
+#include <editor/SceneJournal.hpp>
+#include <editor/SceneJournalFormat.hpp>
+#include <editor/Scene.hpp>
+#include <editor/serializers/EntitySerializer.hpp>
+#include <editor/serializers/SceneFragmentCache.hpp>
+
+namespace editor {
+    namespace fs = std::filesystem;
+
+    namespace {
+        std::uint64_t hashCombine(std::uint64_t seed, std::uint64_t value) {
+            return seed ^ (value + 0x9E3779B97F4A7C15ULL + (seed << 6) + (seed >> 2));
+        }
+
+        /// Same order as scene file: entity goes before its children.
+        template<typename Function>
+        void traverse(std::list<SceneEntity>& entities, Function& function) {
+            for(auto& entity: entities) {
+                if(!entity)
+                    continue;
+                function(entity);
+                if(entity.hasChildren())
+                    traverse(entity.getChildren(), function);
+            }
+        }
+    }
+
+    SceneJournal::~SceneJournal() {
+        stop();
+    }
+
+    template<typename Callback>
+    std::uint64_t SceneJournal::scan(Scene& scene, Callback&& onChanged) {
+        ++m_generation;
+        const auto editedEntities = scene.takeEditedEntities();
+
+        std::uint64_t orderHash = 0;
+        std::function<void(SceneEntity&)> visit = [&](SceneEntity& entity) {
+            const auto uuid = entity.getUUID();
+            orderHash = hashCombine(orderHash, static_cast<std::uint64_t>(uuid));
+
+            EntityState state;
+            if(entity.hasComponent<TransformComponent>()) {
+                state.transformVersion = entity.getComponent<TransformComponent>().getVersion();
+                state.hierarchyHash = SceneFragmentCache::computeHierarchyHash(entity);
+            }
+            state.generation = m_generation;
+
+            auto found = m_entities.find(uuid);
+            const bool changed = found == m_entities.end()
+                    || found -> second.transformVersion != state.transformVersion
+                    || found -> second.hierarchyHash != state.hierarchyHash
+                    || editedEntities.find(uuid) != editedEntities.end();
+            m_entities[uuid] = state;
+            if(changed)
+                onChanged(entity);
+        };
+        traverse(scene.getEntities(), visit);
+        return orderHash;
+    }
+
+    void SceneJournal::start(Scene& scene) {
+        m_scenePath = scene.getPath();
+        m_path = getJournalPath(m_scenePath);
+        m_entities.clear();
+        m_orderHash = scan(scene, [](SceneEntity&) {});
+        m_timer = 0.F;
+        m_captureRequested = false;
+        m_active = true;
+
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            if(!m_running) {
+                m_running = true;
+                m_thread = std::thread(&SceneJournal::writerWork, this);
+            }
+        }
+        push({Operation::Type::Open, m_path, makeHeader()});
+    }
+
+    void SceneJournal::stop() {
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            if(!m_running)
+                return;
+            m_running = false;
+        }
+        m_condition.notify_all();
+        if(m_thread.joinable())
+            m_thread.join();
+        m_active = false;
+    }
+
+    void SceneJournal::update(float dt, Scene& scene, IScriptInteractorFrom::Ptr scriptInteractor) {
+        if(!m_active)
+            return;
+        m_timer += dt;
+        if(m_timer < captureInterval && !m_captureRequested)
+            return;
+        capture(scene, scriptInteractor);
+    }
+
+    void SceneJournal::capture(Scene& scene, IScriptInteractorFrom::Ptr scriptInteractor) {
+        m_timer = 0.F;
+        m_captureRequested = false;
+        if(!m_active || scene.getPath() != m_scenePath)
+            return;
+
+        auto entitySerializer = getSerializer<EntityYAMLSerializer>();
+        std::string bytes;
+        std::string payload;
+        std::vector<std::uint64_t> order;
+        const auto orderHash = scan(scene, [&](SceneEntity& entity) {
+            YAML::Emitter out;
+            out << YAML::BeginSeq;
+            entitySerializer -> serializeSelf(out, entity, scriptInteractor);
+            out << YAML::EndSeq;
+
+            payload.clear();
+            journal::write(payload, static_cast<std::uint64_t>(entity.getUUID()));
+            payload.append(out.c_str(), out.size());
+            journal::appendRecord(bytes, journal::RecordType::Upsert, payload);
+        });
+
+        for(auto it = m_entities.begin(); it != m_entities.end();) {
+            if(it -> second.generation == m_generation) {
+                ++it;
+                continue;
+            }
+            payload.clear();
+            journal::write(payload, static_cast<std::uint64_t>(it -> first));
+            journal::appendRecord(bytes, journal::RecordType::Remove, payload);
+            it = m_entities.erase(it);
+        }
+
+        if(orderHash != m_orderHash) {
+            payload.clear();
+            std::function<void(SceneEntity&)> collect = [&payload](SceneEntity& entity) {
+                journal::write(payload, static_cast<std::uint64_t>(entity.getUUID()));
+            };
+            traverse(scene.getEntities(), collect);
+            journal::appendRecord(bytes, journal::RecordType::Order, payload);
+            m_orderHash = orderHash;
+        }
+
+        if(!bytes.empty())
+            push({Operation::Type::Append, m_path, std::move(bytes)});
+    }
+
+    void SceneJournal::markSaved(Scene& scene) {
+        if(!m_active)
+            return;
+        m_orderHash = scan(scene, [](SceneEntity&) {});
+        for(auto it = m_entities.begin(); it != m_entities.end();) {
+            if(it -> second.generation != m_generation)
+                it = m_entities.erase(it);
+            else
+                ++it;
+        }
+        m_timer = 0.F;
+        m_captureRequested = false;
+        push({Operation::Type::Reset, m_path, makeHeader()});
+    }
+
+    void SceneJournal::discard() {
+        if(!m_active)
+            return;
+        m_active = false;
+        m_entities.clear();
+        push({Operation::Type::Remove, m_path, {}});
+    }
+
+    std::string SceneJournal::makeHeader() const {
+        return journal::makeHeader(journal::sceneStamp(m_scenePath));
+    }
+
+    void SceneJournal::push(Operation&& operation) {
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            if(!m_running)
+                return;
+            m_operations.emplace_back(std::move(operation));
+        }
+        m_condition.notify_all();
+    }
+
+    void SceneJournal::writerWork() {
+        while(true) {
+            Operation operation;
+            {
+                std::unique_lock<std::mutex> lock{m_mutex};
+                m_condition.wait(lock, [this]() { return !m_operations.empty() || !m_running; });
+                if(m_operations.empty())
+                    break;
+                operation = std::move(m_operations.front());
+                m_operations.pop_front();
+            }
+            execute(operation);
+        }
+    }
+
+    void SceneJournal::execute(const Operation& operation) {
+        if(operation.type == Operation::Type::Remove) {
+            std::error_code errorCode;
+            fs::remove(operation.path, errorCode);
+            return;
+        }
+
+        bool truncate = operation.type == Operation::Type::Reset;
+        if(operation.type == Operation::Type::Open) {
+            /// recovered log stays valid while scene file is same save, new records are appended to it
+            std::ifstream existing{operation.path, std::ios::binary};
+            std::string header(operation.bytes.size(), '\0');
+            if(existing.is_open())
+                existing.read(header.data(), static_cast<std::streamsize>(header.size()));
+            if(existing.is_open() && existing.gcount() == static_cast<std::streamsize>(header.size())
+                && header == operation.bytes)
+                return;
+            truncate = true;
+        }
+
+        std::FILE* file = std::fopen(operation.path.c_str(), truncate ? "wb" : "ab");
+        if(!file) {
+            RB_EDITOR_ERROR("SceneJournal: can't open {0}", operation.path);
+            return;
+        }
+        if(std::fwrite(operation.bytes.data(), 1, operation.bytes.size(), file) != operation.bytes.size())
+            RB_EDITOR_ERROR("SceneJournal: can't write {0}", operation.path);
+        std::fflush(file);
+        std::fclose(file);
+    }
+
+} // namespace editor
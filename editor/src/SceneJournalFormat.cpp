@@ -0,0 +1,221 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <unordered_map>
+#include <vector>
+
+#include <yaml-cpp/yaml.h>
+#include <robot2D/Util/Logger.hpp>
+
+#include <editor/SceneJournal.hpp>
+#include <editor/SceneJournalFormat.hpp>
+
+namespace editor {
+    namespace fs = std::filesystem;
+
+    namespace {
+        std::uint32_t fnv1a(const char* data, std::size_t size, std::uint32_t hash = 2166136261U) {
+            for(std::size_t i = 0; i < size; ++i) {
+                hash ^= static_cast<std::uint8_t>(data[i]);
+                hash *= 16777619U;
+            }
+            return hash;
+        }
+
+        template<typename T>
+        bool read(const std::string& bytes, std::size_t& offset, T& value) {
+            if(bytes.size() - offset < sizeof(T))
+                return false;
+            std::memcpy(&value, bytes.data() + offset, sizeof(T));
+            offset += sizeof(T);
+            return true;
+        }
+    }
+
+    namespace journal {
+        std::uint64_t sceneStamp(const std::string& scenePath) {
+            std::error_code errorCode;
+            const auto size = fs::file_size(scenePath, errorCode);
+            if(errorCode)
+                return 0;
+            const auto writeTime = fs::last_write_time(scenePath, errorCode);
+            if(errorCode)
+                return 0;
+            const auto ticks = static_cast<std::uint64_t>(writeTime.time_since_epoch().count());
+            return ticks ^ (static_cast<std::uint64_t>(size) * 0x9E3779B97F4A7C15ULL);
+        }
+
+        void appendRecord(std::string& bytes, RecordType type, const std::string& payload) {
+            std::uint32_t checksum = fnv1a(reinterpret_cast<const char*>(&type), sizeof(type));
+            checksum = fnv1a(payload.data(), payload.size(), checksum);
+            write(bytes, static_cast<std::uint32_t>(payload.size()));
+            write(bytes, checksum);
+            write(bytes, type);
+            bytes += payload;
+        }
+
+        std::string makeHeader(std::uint64_t stamp) {
+            std::string header;
+            write(header, magic);
+            write(header, version);
+            write(header, std::uint16_t{0});
+            write(header, stamp);
+            return header;
+        }
+    }
+
+    std::string SceneJournal::getJournalPath(const std::string& scenePath) {
+        return scenePath + ".journal";
+    }
+
+    bool SceneJournal::replay(const std::string& scenePath, YAML::Node& sceneNode) {
+        const auto path = getJournalPath(scenePath);
+        std::ifstream file{path, std::ios::binary};
+        if(!file.is_open())
+            return false;
+        const std::string bytes{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+
+        std::size_t offset = 0;
+        std::uint32_t fileMagic = 0;
+        std::uint16_t fileVersion = 0;
+        std::uint16_t reserved = 0;
+        std::uint64_t stamp = 0;
+        if(!read(bytes, offset, fileMagic) || !read(bytes, offset, fileVersion)
+            || !read(bytes, offset, reserved) || !read(bytes, offset, stamp))
+            return false;
+        if(fileMagic != journal::magic || fileVersion != journal::version) {
+            RB_EDITOR_WARN("SceneJournal: {0} isn't journal of supported version", path);
+            return false;
+        }
+        if(stamp != journal::sceneStamp(scenePath)) {
+            RB_EDITOR_WARN("SceneJournal: {0} was written for other save of scene, it's ignored", path);
+            return false;
+        }
+
+        auto entitiesNode = sceneNode["Entities"];
+        std::vector<YAML::Node> entities;
+        std::unordered_map<std::uint64_t, std::size_t> indices;
+        if(entitiesNode && entitiesNode.IsSequence()) {
+            for(const auto& entity: entitiesNode) {
+                if(entity["Entity"])
+                    indices[entity["Entity"].as<std::uint64_t>()] = entities.size();
+                entities.emplace_back(entity);
+            }
+        }
+        std::vector<bool> removed(entities.size(), false);
+        std::vector<std::uint64_t> order;
+
+        std::size_t recordsCount = 0;
+        while(offset < bytes.size()) {
+            std::uint32_t payloadSize = 0;
+            std::uint32_t checksum = 0;
+            std::uint8_t type = 0;
+            if(!read(bytes, offset, payloadSize) || !read(bytes, offset, checksum) || !read(bytes, offset, type))
+                break;
+            if(bytes.size() - offset < payloadSize)
+                break;
+            const std::string payload = bytes.substr(offset, payloadSize);
+            offset += payloadSize;
+            /// torn tail of crashed write, everything before it is valid
+            if(fnv1a(payload.data(), payload.size(),
+                     fnv1a(reinterpret_cast<const char*>(&type), sizeof(type))) != checksum)
+                break;
+
+            std::size_t payloadOffset = 0;
+            std::uint64_t uuid = 0;
+            switch(static_cast<journal::RecordType>(type)) {
+                case journal::RecordType::Upsert: {
+                    if(!read(payload, payloadOffset, uuid))
+                        break;
+                    YAML::Node entity;
+                    try {
+                        entity = YAML::Load(payload.substr(payloadOffset));
+                    }
+                    catch (...) {
+                        break;
+                    }
+                    if(!entity.IsSequence() || entity.size() != 1)
+                        break;
+                    auto found = indices.find(uuid);
+                    if(found != indices.end()) {
+                        entities[found -> second] = entity[0];
+                        removed[found -> second] = false;
+                    }
+                    else {
+                        indices[uuid] = entities.size();
+                        entities.emplace_back(entity[0]);
+                        removed.emplace_back(false);
+                    }
+                    break;
+                }
+                case journal::RecordType::Remove: {
+                    if(!read(payload, payloadOffset, uuid))
+                        break;
+                    auto found = indices.find(uuid);
+                    if(found != indices.end())
+                        removed[found -> second] = true;
+                    break;
+                }
+                case journal::RecordType::Order: {
+                    order.resize((payload.size()) / sizeof(std::uint64_t));
+                    if(!order.empty())
+                        std::memcpy(order.data(), payload.data(), order.size() * sizeof(std::uint64_t));
+                    break;
+                }
+                default:
+                    break;
+            }
+            ++recordsCount;
+        }
+
+        if(recordsCount == 0)
+            return false;
+
+        std::vector<std::size_t> sequence;
+        sequence.reserve(entities.size());
+        std::vector<bool> placed(entities.size(), false);
+        for(const auto uuid: order) {
+            auto found = indices.find(uuid);
+            if(found != indices.end() && !removed[found -> second] && !placed[found -> second]) {
+                sequence.emplace_back(found -> second);
+                placed[found -> second] = true;
+            }
+        }
+        for(std::size_t i = 0; i < entities.size(); ++i) {
+            if(!removed[i] && !placed[i])
+                sequence.emplace_back(i);
+        }
+
+        YAML::Node recovered{YAML::NodeType::Sequence};
+        for(const auto index: sequence)
+            recovered.push_back(entities[index]);
+        sceneNode["Entities"] = recovered;
+
+        RB_EDITOR_WARN("SceneJournal: recovered {0} unsaved changes of scene {1}", recordsCount, scenePath);
+        return true;
+    }
+
+} // namespace editor
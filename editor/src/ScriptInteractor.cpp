@@ -1,6 +1,8 @@
 #include <editor/ScriptInteractor.hpp>
 #include <editor/scripting/ScriptingEngineService.hpp>
 #include <editor/EditorInteractor.hpp>
+#include <editor/SpatialSystem.hpp>
+#include <editor/Components.hpp>
 
 namespace editor {
 
@@ -69,6 +71,46 @@ namespace editor {
     }
 
 
+    void ScriptInteractor::queryEntities(const robot2D::FloatRect& rect, std::vector<std::uint64_t>& result) {
+        auto interactor = m_editorInteractor.lock();
+        if(!interactor || !interactor -> getSpatialSystem())
+            return;
+        std::vector<robot2D::ecs::Entity> found;
+        interactor -> getSpatialSystem() -> query(rect, found);
+        appendIDs(found, result);
+    }
+
+    void ScriptInteractor::queryEntities(const robot2D::vec2f& point, std::vector<std::uint64_t>& result) {
+        auto interactor = m_editorInteractor.lock();
+        if(!interactor || !interactor -> getSpatialSystem())
+            return;
+        std::vector<robot2D::ecs::Entity> found;
+        interactor -> getSpatialSystem() -> query(point, found);
+        appendIDs(found, result);
+    }
+
+    void ScriptInteractor::rayCastEntities(const robot2D::vec2f& from, const robot2D::vec2f& to,
+                                           std::vector<std::uint64_t>& result) {
+        auto interactor = m_editorInteractor.lock();
+        if(!interactor || !interactor -> getSpatialSystem())
+            return;
+        std::vector<robot2D::ecs::SpatialIndex::RayHit> hits;
+        interactor -> getSpatialSystem() -> rayCast(from, to, hits);
+        std::vector<robot2D::ecs::Entity> found;
+        found.reserve(hits.size());
+        for(const auto& hit: hits)
+            found.emplace_back(hit.entity);
+        appendIDs(found, result);
+    }
+
+    void ScriptInteractor::appendIDs(const std::vector<robot2D::ecs::Entity>& entities,
+                                     std::vector<std::uint64_t>& result) {
+        for(auto entity: entities) {
+            if(entity.hasComponent<IDComponent>())
+                result.emplace_back(entity.getComponent<IDComponent>().ID);
+        }
+    }
+
     void ScriptInteractor::setScriptClass(std::string name, UUID uuid) {
         auto entityClass = m_scriptingEngine -> getEntityClass(name);
         if(!entityClass)
@@ -0,0 +1,92 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#include <robot2D/Ecs/EntityManager.hpp>
+#include <robot2D/Util/Profiler.hpp>
+
+#include <editor/SpatialSystem.hpp>
+#include <editor/Components.hpp>
+
+namespace editor {
+
+    SpatialSystem::SpatialSystem(robot2D::MessageBus& messageBus):
+        robot2D::ecs::System(messageBus, typeid(SpatialSystem)) {
+        addRequirement<TransformComponent>();
+    }
+
+    void SpatialSystem::update(float dt) {
+        (void)dt;
+        RB_PROFILE_FUNCTION();
+
+        for(auto& entity: m_entities) {
+            auto& proxy = m_proxies[entity.getIndex()];
+            const auto& transform = entity.getComponent<TransformComponent>();
+            if(proxy.version == transform.getVersion())
+                continue;
+            proxy.version = transform.getVersion();
+            m_index.moveProxy(proxy.id, transform.getGlobalBounds());
+        }
+    }
+
+    void SpatialSystem::query(const robot2D::FloatRect& rect, std::vector<robot2D::ecs::Entity>& result) const {
+        m_index.query(rect, result);
+    }
+
+    void SpatialSystem::query(const robot2D::vec2f& point, std::vector<robot2D::ecs::Entity>& result) const {
+        m_index.query(point, result);
+    }
+
+    void SpatialSystem::rayCast(const robot2D::vec2f& from, const robot2D::vec2f& to,
+                                std::vector<robot2D::ecs::SpatialIndex::RayHit>& result) const {
+        m_index.rayCast(from, to, result);
+    }
+
+    void SpatialSystem::onEntityAdded(robot2D::ecs::Entity entity) {
+        const auto index = entity.getIndex();
+        if(index >= m_proxies.size())
+            m_proxies.resize(index + 1);
+
+        const auto& transform = entity.getComponent<TransformComponent>();
+        auto& proxy = m_proxies[index];
+        if(proxy.id != robot2D::ecs::SpatialIndex::nullProxy)
+            m_index.destroyProxy(proxy.id);
+        proxy.id = m_index.createProxy(transform.getGlobalBounds(), entity);
+        proxy.version = transform.getVersion();
+    }
+
+    void SpatialSystem::onEntityRemoved(robot2D::ecs::Entity entity) {
+        const auto index = entity.getIndex();
+        if(index >= m_proxies.size() || m_proxies[index].id == robot2D::ecs::SpatialIndex::nullProxy)
+            return;
+        m_index.destroyProxy(m_proxies[index].id);
+        m_proxies[index] = {};
+    }
+
+    robot2D::ecs::System::Ptr SpatialSystem::cloneSelf(robot2D::ecs::Scene* scene,
+                                                       const std::vector<robot2D::ecs::Entity>& newEntities) {
+        auto cloneSystem = std::make_shared<SpatialSystem>(m_messageBus);
+        if(!cloneBase(cloneSystem, scene, newEntities))
+            return nullptr;
+        return cloneSystem;
+    }
+
+}
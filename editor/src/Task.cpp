@@ -19,10 +19,14 @@ and must not be misrepresented as being the original software.
 source distribution.
 *********************************************************************/
 
+#include <algorithm>
+
 #include <editor/Task.hpp>
 
 namespace editor {
-    ITask::ITask(ITaskFunction::Ptr function): m_function{std::move(function)} {}
+    ITask::ITask(ITaskFunction::Ptr function):
+        m_function{std::move(function)},
+        m_state{std::make_shared<TaskState>()} {}
 
     ITask::~ITask() = default;
 
@@ -32,5 +36,9 @@ namespace editor {
         m_function -> execute(static_cast<void*>(this));
     }
 
-    TaskID ITask::getTaskID() const { return m_taskID; }
+    TaskID ITask::getTaskID() const { return m_state -> id; }
+
+    void ITask::setProgress(float progress) {
+        m_state -> progress.store(std::clamp(progress, 0.F, 1.F), std::memory_order_relaxed);
+    }
 }
\ No newline at end of file
@@ -19,77 +19,71 @@ and must not be misrepresented as being the original software.
 source distribution.
 *********************************************************************/
 
+#include <algorithm>
+
+#include <robot2D/Util/Profiler.hpp>
 #include <editor/TaskQueue.hpp>
 
 namespace editor {
-    TaskQueue::TaskQueue(): m_inputTasksQueue{},
-                            m_outputTasksQueue{},
-                            m_currentId{0} {
-        try {
-            m_thread = std::thread{&TaskQueue::threadWork, this};
-            m_running.store(true, std::memory_order::memory_order_relaxed);
-        }
-        catch(...) {
-            m_running.store(false, std::memory_order::memory_order_relaxed);
-        }
-    }
+    TaskQueue::TaskQueue(): m_jobSystem{robot2D::JobSystem::getInstance()},
+                            m_currentId{0} {}
 
     TaskQueue::~TaskQueue() {
-        m_running.store(false, std::memory_order::memory_order_relaxed);
-
-        if(m_thread.joinable())
-            m_thread.join();
+        stop();
     }
 
-    void TaskQueue::threadWork() {
-        while (m_running.load(std::memory_order::memory_order_relaxed)) {
-            using namespace std::chrono_literals;
+    TaskHandle TaskQueue::schedule(ITask::Ptr task) {
+        task -> m_state -> id = m_currentId.fetch_add(1);
+        task -> m_state -> name = task -> getName();
+        task -> m_state -> cancellable = task -> isCancellable();
+        auto handle = task -> getHandle();
+        {
+            std::lock_guard<std::mutex> lock{m_activeMutex};
+            m_activeTasks.emplace_back(handle);
+        }
 
-            std::unique_lock<std::mutex> lock(m_inputMutex);
-            data_cond.wait(lock, [this] {
-                return !m_inputTasksQueue.empty()
-                       || !m_running.load(std::memory_order::memory_order_relaxed);
-            });
+        auto work = [task]() {
+            RB_PROFILE_SCOPE("TaskQueue::execute");
+            if(!task -> isCancelled())
+                task -> execute();
+        };
+        auto completion = [this, task]() {
+            task -> m_state -> finished = true;
+            removeActiveTask(task -> getTaskID());
+            if(!task -> isCancelled())
+                task -> call();
+        };
 
-            if (m_inputTasksQueue.empty())
-                continue;
-            auto task = m_inputTasksQueue.front();
-            if (!task)
-                continue;
+        if(!task -> isExclusive()) {
+            m_jobSystem.schedule(std::move(work), std::move(completion), task -> getPriority());
+            return handle;
+        }
 
-            m_inputTasksQueue.pop();
+        std::lock_guard<std::mutex> lock{m_exclusiveMutex};
+        m_lastExclusiveJob = m_jobSystem.then(m_lastExclusiveJob, std::move(work),
+                                              std::move(completion), task -> getPriority());
+        return handle;
+    }
 
-            task -> execute();
+    void TaskQueue::removeActiveTask(TaskID taskID) {
+        std::lock_guard<std::mutex> lock{m_activeMutex};
+        auto found = std::find_if(m_activeTasks.begin(), m_activeTasks.end(), [taskID](const TaskHandle& handle) {
+            return handle.getTaskID() == taskID;
+        });
+        if(found != m_activeTasks.end())
+            m_activeTasks.erase(found);
+    }
 
-            {
-                std::lock_guard<std::mutex> outLock{m_outputMutex};
-                m_outputTasksQueue.push(task);
-            }
-        }
+    void TaskQueue::getActiveTasks(std::vector<TaskHandle>& result) const {
+        std::lock_guard<std::mutex> lock{m_activeMutex};
+        result.insert(result.end(), m_activeTasks.begin(), m_activeTasks.end());
     }
 
     void TaskQueue::process() {
-        ITask::Ptr task{nullptr};
-        {
-            std::lock_guard<std::mutex> outLock{m_outputMutex};
-            if(!m_outputTasksQueue.empty()) {
-                task = m_outputTasksQueue.front();
-                m_outputTasksQueue.pop();
-            }
-        }
-        if(task)
-            task -> call();
+        m_jobSystem.drainCompleted(robot2D::Time{processBudgetMicroSeconds});
     }
 
     void TaskQueue::stop() {
-        m_running.store(false, std::memory_order::memory_order_relaxed);
-        {
-            std::unique_lock<std::mutex> lock(m_inputMutex);
-            data_cond.notify_all();
-        }
-
-        if(m_thread.joinable())
-            m_thread.join();
-
+        m_jobSystem.stop();
     }
-}
\ No newline at end of file
+}
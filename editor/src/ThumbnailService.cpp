@@ -0,0 +1,157 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#include <editor/ThumbnailService.hpp>
+#include <editor/ImportCache.hpp>
+
+namespace editor {
+    namespace {
+        /// Thumbnail centered in transparent RGBA cell, empty pixels when image can't be decoded.
+        void makeCell(const std::string& path, std::vector<std::uint8_t>& pixels) {
+            constexpr unsigned int cellSize = ThumbnailService::cellSize;
+
+            robot2D::Image image;
+            if(!ImportCache::getCache() -> importThumbnail(path, cellSize, image))
+                return;
+
+            const auto& size = image.getSize();
+            const auto channels = static_cast<std::size_t>(image.getColorFormat());
+            const auto& source = static_cast<const robot2D::Image&>(image).getBuffer();
+            const unsigned int left = (cellSize - size.x) / 2;
+            const unsigned int top = (cellSize - size.y) / 2;
+
+            pixels.assign(cellSize * cellSize * 4, 0);
+            for(unsigned int y = 0; y < size.y; ++y) {
+                const auto* from = source.data() + static_cast<std::size_t>(y) * size.x * channels;
+                auto* to = pixels.data() + (static_cast<std::size_t>(top + y) * cellSize + left) * 4;
+                for(unsigned int x = 0; x < size.x; ++x, from += channels, to += 4) {
+                    /// RED is grey, second channel of two is alpha
+                    to[0] = from[0];
+                    to[1] = channels >= 3 ? from[1] : from[0];
+                    to[2] = channels >= 3 ? from[2] : from[0];
+                    to[3] = channels == 4 ? from[3] : channels == 2 ? from[1] : 255;
+                }
+            }
+        }
+    }
+
+    ThumbnailService::ThumbnailService():
+        m_cells(cellsPerRow * cellsPerRow),
+        m_alive{std::make_shared<bool>(true)} {}
+
+    const ThumbnailService::Thumbnail* ThumbnailService::getThumbnail(const std::string& path,
+                                                                     robot2D::JobSystem& jobSystem) {
+        auto found = m_entries.find(path);
+        if(found == m_entries.end()) {
+            auto& entry = m_entries[path];
+            entry.request = ++m_requests;
+            entry.lastUse = m_frame;
+            schedule(path, entry.request, jobSystem);
+            return nullptr;
+        }
+
+        auto& entry = found -> second;
+        entry.lastUse = m_frame;
+        return entry.state == State::Ready ? &entry.thumbnail : nullptr;
+    }
+
+    void ThumbnailService::invalidate(const std::string& path) {
+        auto found = m_entries.find(path);
+        if(found == m_entries.end())
+            return;
+        if(found -> second.cell != noCell)
+            m_cells[found -> second.cell].clear();
+        m_entries.erase(found);
+    }
+
+    void ThumbnailService::schedule(const std::string& path, std::uint64_t request, robot2D::JobSystem& jobSystem) {
+        auto pixels = std::make_shared<std::vector<std::uint8_t>>();
+        std::weak_ptr<bool> alive = m_alive;
+        jobSystem.schedule([path, pixels]() { makeCell(path, *pixels); },
+                           [this, alive, path, request, pixels]() {
+                               if(!alive.expired())
+                                   place(path, request, *pixels);
+                           }, robot2D::JobPriority::Background);
+    }
+
+    void ThumbnailService::place(const std::string& path, std::uint64_t request,
+                                 const std::vector<std::uint8_t>& pixels) {
+        auto found = m_entries.find(path);
+        if(found == m_entries.end() || found -> second.request != request)
+            return;
+
+        auto& entry = found -> second;
+        if(pixels.empty()) {
+            entry.state = State::Failed;
+            return;
+        }
+
+        const int cell = takeCell();
+        if(cell == noCell) {
+            /// every cell is on screen, thumbnail is requested again later and comes from disk cache
+            m_entries.erase(found);
+            return;
+        }
+
+        if(!m_atlasCreated) {
+            robot2D::TextureOptions options;
+            options.keepPixels = false;
+            m_atlas.setOptions(options);
+            std::vector<std::uint8_t> empty(static_cast<std::size_t>(atlasSize) * atlasSize * 4, 0);
+            m_atlas.create({atlasSize, atlasSize}, empty.data());
+            m_atlasCreated = true;
+        }
+
+        const int cellX = cell % static_cast<int>(cellsPerRow);
+        const int cellY = cell / static_cast<int>(cellsPerRow);
+        const int side = static_cast<int>(cellSize);
+        m_atlas.update({cellX * side, cellY * side, side, side}, pixels.data());
+
+        constexpr float cellUV = static_cast<float>(cellSize) / static_cast<float>(atlasSize);
+        entry.thumbnail.uv0 = { static_cast<float>(cellX) * cellUV, static_cast<float>(cellY) * cellUV };
+        entry.thumbnail.uv1 = { entry.thumbnail.uv0.x + cellUV, entry.thumbnail.uv0.y + cellUV };
+        entry.cell = cell;
+        entry.state = State::Ready;
+        m_cells[cell] = path;
+    }
+
+    int ThumbnailService::takeCell() {
+        int leastUsed = noCell;
+        std::uint64_t leastUse = m_frame;
+        for(std::size_t cell = 0; cell < m_cells.size(); ++cell) {
+            if(m_cells[cell].empty())
+                return static_cast<int>(cell);
+            const auto lastUse = m_entries.at(m_cells[cell]).lastUse;
+            if(lastUse < leastUse) {
+                leastUse = lastUse;
+                leastUsed = static_cast<int>(cell);
+            }
+        }
+
+        if(leastUsed != noCell) {
+            m_entries.erase(m_cells[leastUsed]);
+            m_cells[leastUsed].clear();
+        }
+        return leastUsed;
+    }
+
+}
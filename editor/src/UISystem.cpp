@@ -19,6 +19,8 @@ and must not be misrepresented as being the original software.
 source distribution.
 *********************************************************************/
 
+#include <algorithm>
+
 #include <robot2D/Ecs/EntityManager.hpp>
 
 #include <editor/UISystem.hpp>
@@ -94,49 +96,88 @@ namespace editor {
     }
 
 
-    void UISystem::update(float dt) {
+    void UISystem::query(const robot2D::vec2f& point, std::vector<robot2D::ecs::Entity>& result) const {
+        const auto first = result.size();
+        m_index.query(point, result);
+        /// index tests closed bounds, hitbox keeps its own contains rule
+        result.erase(std::remove_if(result.begin() + static_cast<std::ptrdiff_t>(first), result.end(),
+                                    [&point](robot2D::ecs::Entity entity) {
+            return !entity.getComponent<UIHitbox>().contains(point);
+        }), result.end());
+    }
+
+    void UISystem::updateProxies() {
         for(auto& ent: m_entities) {
-            bool contains = false;
-            auto& hitbox = ent.getComponent<UIHitbox>();
+            auto& proxy = m_proxies[ent.getIndex()];
+            const auto& area = ent.getComponent<UIHitbox>().m_area;
+            if(proxy.area == area)
+                continue;
+            proxy.area = area;
+            m_index.moveProxy(proxy.id, area);
+        }
+    }
 
+    void UISystem::update(float dt) {
+        (void)dt;
+        updateProxies();
 
-            if((contains = hitbox.m_area.contains( {
-                static_cast<float>(m_eventPosition.x), static_cast<float>(m_eventPosition.y)
-            } ))) {
-                hitbox.isHovered = true;
-            }
-            else
-                hitbox.isHovered = false;
-
-            if (contains) {
-                if(hitbox.isHovered) {
-                    if(hitbox.onHoverOnce && !hitbox.wasHovered) {
-                        auto index = hitbox.callbackIDs[UIHitbox::CallbackID::MouseMoved];
-                        if (index >= 0)
-                            m_mouseHoverCallbacks[index](ent);
-                    }
-                    hitbox.wasHovered = true;
-                }
-
-                for(auto downEvent: m_mouseDownEvents) {
-                    auto index = hitbox.callbackIDs[UIHitbox::CallbackID::MouseDown];
-                    if(m_mousePressedCallbacks[index])
-                        m_mousePressedCallbacks[index](ent, downEvent);
-                }
-            }
+        m_foundEntities.clear();
+        query(m_eventPosition.as<float>(), m_foundEntities);
 
-            if(!hitbox.isHovered) {
+        for(auto& ent: m_foundEntities) {
+            auto& hitbox = ent.getComponent<UIHitbox>();
+            hitbox.isHovered = true;
+            if(hitbox.onHoverOnce && !hitbox.wasHovered) {
                 auto index = hitbox.callbackIDs[UIHitbox::CallbackID::MouseMoved];
-                if(index >= 0)
-                    m_mouseUnHoverCallbacks[index](ent);
+                if (index >= 0)
+                    m_mouseHoverCallbacks[index](ent);
+            }
+            hitbox.wasHovered = true;
 
-                hitbox.wasHovered = false;
+            for(auto downEvent: m_mouseDownEvents) {
+                auto index = hitbox.callbackIDs[UIHitbox::CallbackID::MouseDown];
+                if(index >= 0 && m_mousePressedCallbacks[index])
+                    m_mousePressedCallbacks[index](ent, downEvent);
             }
+        }
 
+        /// only hitboxes hovered last frame can lose hover
+        for(auto& ent: m_hoveredEntities) {
+            if(std::find(m_foundEntities.begin(), m_foundEntities.end(), ent) != m_foundEntities.end())
+                continue;
+            auto& hitbox = ent.getComponent<UIHitbox>();
+            hitbox.isHovered = false;
+            auto index = hitbox.callbackIDs[UIHitbox::CallbackID::MouseMoved];
+            if(index >= 0)
+                m_mouseUnHoverCallbacks[index](ent);
+            hitbox.wasHovered = false;
         }
+        std::swap(m_hoveredEntities, m_foundEntities);
 
         m_mouseDownEvents.clear();
         m_mouseUpEvents.clear();
     }
 
+    void UISystem::onEntityAdded(robot2D::ecs::Entity entity) {
+        const auto index = entity.getIndex();
+        if(index >= m_proxies.size())
+            m_proxies.resize(index + 1);
+
+        auto& proxy = m_proxies[index];
+        if(proxy.id != robot2D::ecs::SpatialIndex::nullProxy)
+            m_index.destroyProxy(proxy.id);
+        proxy.area = entity.getComponent<UIHitbox>().m_area;
+        proxy.id = m_index.createProxy(proxy.area, entity);
+    }
+
+    void UISystem::onEntityRemoved(robot2D::ecs::Entity entity) {
+        m_hoveredEntities.erase(std::remove(m_hoveredEntities.begin(), m_hoveredEntities.end(), entity),
+                                m_hoveredEntities.end());
+        const auto index = entity.getIndex();
+        if(index >= m_proxies.size() || m_proxies[index].id == robot2D::ecs::SpatialIndex::nullProxy)
+            return;
+        m_index.destroyProxy(m_proxies[index].id);
+        m_proxies[index] = {};
+    }
+
 }
\ No newline at end of file
@@ -18,8 +18,15 @@ and must not be misrepresented as being the original software.
 3. This notice may not be removed or altered from any
 source distribution.
 *********************************************************************/
-#include <thread>
+#include <algorithm>
+#include <filesystem>
+#include <string>
+
+#include <robot2D/Core/AssetPack.hpp>
+#include <robot2D/Graphics/TextureCompression.hpp>
+#include <robot2D/Util/Logger.hpp>
 #include <editor/async/ExportTask.hpp>
+#include <editor/FileApi.hpp>
 
 namespace editor {
 
@@ -28,8 +35,77 @@ namespace editor {
 
     }
 
+    namespace {
+        /// Already compressed formats gain nothing from LZ4.
+        robot2D::AssetCompression chooseCompression(const std::filesystem::path& path) {
+            if(isImageFile(path.string()))
+                return robot2D::AssetCompression::None;
+            return robot2D::AssetCompression::LZ4;
+        }
+
+        /// Encodes image with mip chain into CompressedImage container, blocks still shrink with LZ4.
+        bool addCompressedTexture(robot2D::AssetPackWriter& packWriter, const std::string& name,
+                                  const std::string& path, robot2D::CompressedFormat format) {
+            robot2D::Image image;
+            if(!image.loadFromFile(path))
+                return false;
+
+            robot2D::CompressedImage compressedImage;
+            std::vector<std::uint8_t> data;
+            if(!compressedImage.create(image, format) || !compressedImage.saveToMemory(data))
+                return false;
+
+            const auto compressedName = std::filesystem::path(name)
+                    .replace_extension(robot2D::CompressedImage::extension).generic_string();
+            packWriter.addData(compressedName, std::move(data), robot2D::AssetCompression::LZ4);
+            return true;
+        }
+    }
+
     void ExportTask::execute() {
-        using namespace std::chrono_literals;
-        std::this_thread::sleep_for(2s);
+        namespace fs = std::filesystem;
+
+        const fs::path assetsPath = fs::path(m_exportOptions.projectPath) / "assets";
+        std::error_code errorCode;
+        if(!fs::is_directory(assetsPath, errorCode)) {
+            RB_EDITOR_ERROR("ExportTask: project doesn't have assets folder {0}", assetsPath.string());
+            return;
+        }
+
+        robot2D::AssetPackWriter packWriter;
+        for(auto it = fs::recursive_directory_iterator(assetsPath, errorCode);
+                it != fs::recursive_directory_iterator(); it.increment(errorCode)) {
+            if(errorCode)
+                break;
+            if(!it -> is_regular_file())
+                continue;
+            if(isCancelled())
+                return;
+            const auto path = it -> path().string();
+            const auto name = toAssetName(m_exportOptions.projectPath, path);
+            /// loaders look images up by source name, compressed container is only added next to it
+            packWriter.addFile(name, path, chooseCompression(it -> path()));
+            if(m_exportOptions.compressTextures && isImageFile(it -> path().string())
+                && !addCompressedTexture(packWriter, name, path, m_exportOptions.textureFormat))
+                RB_EDITOR_WARN("ExportTask: can't compress {0}, only source is packed", path);
+        }
+
+        fs::create_directories(m_exportOptions.outputFolder, errorCode);
+        if(!fs::is_directory(m_exportOptions.outputFolder, errorCode)) {
+            RB_EDITOR_ERROR("ExportTask: can't create output folder {0}", m_exportOptions.outputFolder);
+            return;
+        }
+
+        const auto packPath = combinePath(m_exportOptions.outputFolder, "assets.pack");
+        const bool saved = packWriter.saveToFile(packPath, [this](std::size_t written, std::size_t total) {
+            setProgress(static_cast<float>(written) / static_cast<float>(std::max<std::size_t>(total, 1)));
+            return !isCancelled();
+        });
+
+        if(!saved) {
+            fs::remove(packPath, errorCode);
+            if(!isCancelled())
+                RB_EDITOR_ERROR("ExportTask: can't save asset pack {0}", packPath);
+        }
     }
 }
\ No newline at end of file
@@ -20,6 +20,7 @@ source distribution.
 *********************************************************************/
 
 #include <editor/async/FontLoadTask.hpp>
+#include <editor/Components.hpp>
 #include <robot2D/Util/Logger.hpp>
 
 namespace editor {
@@ -35,7 +36,7 @@ namespace editor {
     }
 
     void FontLoadTask::execute() {
-        if(!m_font.loadFromFile(m_fontPath)) {
+        if(!m_font.loadFromFile(m_fontPath, TextComponent::defaultCharacterSize, robot2D::FontRenderMode::SDF)) {
             RB_EDITOR_ERROR("Can't load Font async, path = {0}", m_fontPath);
             return;
         }
@@ -18,13 +18,17 @@ and must not be misrepresented as being the original software.
 3. This notice may not be removed or altered from any
 source distribution.
 *********************************************************************/
+#include <algorithm>
 #include <filesystem>
 
 #include <editor/async/SceneLoadTask.hpp>
 #include <editor/serializers/SceneSerializer.hpp>
 #include <editor/ResouceManager.hpp>
+#include <editor/ImportCache.hpp>
+#include <editor/Components.hpp>
 #include <editor/FileApi.hpp>
 #include <editor/AnimationParser.hpp>
+#include <editor/TaskQueue.hpp>
 
 namespace editor {
     namespace fs = std::filesystem;
@@ -50,52 +54,96 @@ namespace editor {
             RB_EDITOR_ERROR("SceneLoadTask: Can't Deserialze Scene");
             return;
         }
+        setProgress(0.5F);
 
         loadAssets();
     }
 
     void SceneLoadTask::loadAssets() {
+        /// keeps packed bytes alive till all jobs finish
+        m_assetPack = ResourceManager::getManager() -> getAssetPack();
+
+        std::vector<AssetLoad> assetLoads;
         for(auto& entity: m_scene -> getEntities())
-            loadAssets(entity);
+            collectAssets(entity, assetLoads);
+
+        /// decoding is independent for every file, waiting lets this worker decode too
+        auto& jobSystem = TaskQueue::GetQueue() -> getJobSystem();
+        std::vector<robot2D::JobHandle> decodeJobs;
+        decodeJobs.reserve(assetLoads.size());
+        for(auto& assetLoad: assetLoads)
+            decodeJobs.emplace_back(jobSystem.schedule([&assetLoad]() { decodeAsset(assetLoad); }));
+
+        const float jobsCount = static_cast<float>(std::max<std::size_t>(decodeJobs.size(), 1));
+        for(std::size_t i = 0; i < decodeJobs.size(); ++i) {
+            jobSystem.wait(decodeJobs[i]);
+            setProgress(0.5F + 0.5F * static_cast<float>(i + 1) / jobsCount);
+        }
+
+        const bool hasPackedFonts = std::any_of(assetLoads.begin(), assetLoads.end(),
+                                                [](const AssetLoad& assetLoad) {
+            return assetLoad.font && assetLoad.packed;
+        });
+        if(hasPackedFonts)
+            ResourceManager::getManager() -> holdAssetPack(m_assetPack);
+        m_assetPack.reset();
+    }
+
+    robot2D::AssetView SceneLoadTask::findPacked(const std::string& absolutePath) {
+        if(!m_assetPack)
+            return {};
+        return m_assetPack -> getAsset(toAssetName(m_scene -> getAssociatedProjectPath(), absolutePath));
     }
 
-    void SceneLoadTask::loadAssets(SceneEntity& entity) {
+    void SceneLoadTask::decodeAsset(AssetLoad& assetLoad) {
+        /// reopened project reads decoded pixels and glyph distance fields from import cache
+        auto importCache = ImportCache::getCache();
+        if(assetLoad.compressedImage) {
+            const bool loaded = assetLoad.compressedPacked
+                    ? assetLoad.compressedImage -> loadFromMemory(assetLoad.compressedPacked.data,
+                                                                 assetLoad.compressedPacked.size)
+                    : assetLoad.compressedImage -> loadFromFile(assetLoad.compressedPath);
+            /// blocks are uploaded as is, so source image isn't decoded at all
+            if(loaded)
+                return;
+            RB_EDITOR_WARN("SceneLoadTask::loadAssets: can't load compressed texture {0}, image is decoded",
+                           assetLoad.compressedPath);
+        }
+        if(assetLoad.image) {
+            if(!importCache -> importImage(assetLoad.path, assetLoad.packed, *assetLoad.image))
+                RB_EDITOR_WARN("SceneLoadTask::loadAssets: can't load image by path {0}", assetLoad.path);
+        }
+        if(assetLoad.font) {
+            /// scene text is zoomed by camera, so it's rendered from distance fields
+            if(!importCache -> importFont(assetLoad.path, assetLoad.packed,
+                                         TextComponent::defaultCharacterSize, *assetLoad.font))
+                RB_EDITOR_WARN("SceneLoadTask::loadAssets: can't load font by path {0}", assetLoad.path);
+        }
+    }
+
+    void SceneLoadTask::collectAssets(SceneEntity& entity, std::vector<AssetLoad>& assetLoads) {
+        auto resourceManager = ResourceManager::getManager();
+        if(!resourceManager)
+            return;
+
         if(entity.hasComponent<DrawableComponent>()) {
             auto& drawable = entity.getComponent<DrawableComponent>();
             auto& localTexturePath = drawable.getTexturePath();
-            if(!localTexturePath.empty()) {
-                fs::path texturePath{localTexturePath};
-                auto id = texturePath.filename().string();
-                auto image = ResourceManager::getManager() -> addImage(id);
-                if(image) {
-                    auto absolutePath = combinePath(m_scene -> getAssociatedProjectPath(),
-                                                    texturePath.string());
-                    if(!image -> loadFromFile(absolutePath)) {
-                        RB_EDITOR_WARN("SceneLoadTask::loadAssets: can't load image by path {0}", absolutePath);
-                    }
-                }
-            }
+            if(!localTexturePath.empty())
+                collectImage(localTexturePath, assetLoads);
         }
         if(entity.hasComponent<TextComponent>()) {
             auto& text = entity.getComponent<TextComponent>();
             auto& localFontPath = text.getFontPath();
             if(!localFontPath.empty()) {
                 fs::path fontPath{localFontPath};
-                auto id = fontPath.filename().string();
-                auto font = ResourceManager::getManager() -> addFont(id);
-                if(font) {
+                if(auto* font = resourceManager -> addFont(fontPath.filename().string())) {
                     auto absolutePath = combinePath(m_scene -> getAssociatedProjectPath(), fontPath.string());
-                    if(!font -> loadFromFile(absolutePath)) {
-                        RB_EDITOR_WARN("SceneLoadTask::loadAssets: can't load image by path {0}", absolutePath);
-                    }
+                    assetLoads.push_back({ nullptr, font, absolutePath, findPacked(absolutePath) });
                 }
             }
         }
         if(entity.hasComponent<AnimationComponent>()) {
-            auto resourceManager = ResourceManager::getManager();
-            if(!resourceManager)
-                return;
-
             auto& animationPaths = resourceManager
                     -> getAnimationsPathToLoad(entity.getComponent<IDComponent>().ID);
             AnimationParser animationParser;
@@ -107,29 +155,45 @@ namespace editor {
                     continue;
                 auto absolutePath = combinePath(m_scene -> getAssociatedProjectPath(),
                                                 animationPath.string());
-                if(!animationParser.loadFromFile(absolutePath, animation))
+                auto packed = findPacked(absolutePath);
+                const bool loaded = packed
+                        ? animationParser.loadFromMemory(reinterpret_cast<const char*>(packed.data),
+                                                         packed.size, animation)
+                        : animationParser.loadFromFile(absolutePath, animation);
+                if(!loaded)
                     RB_EDITOR_WARN("SceneLoadTask::loadAssets: can't load animation by path {0}", absolutePath);
                 animation -> filePath = absolutePath;
 
-                auto localImagePath = animation -> texturePath;
-                fs::path imagePath{localImagePath};
-                auto imageId = imagePath.filename().string();
-                auto* image = resourceManager -> addImage(imageId);
-                if(!image)
-                    continue;
-                auto absoluteImagePath =
-                        combinePath(m_scene -> getAssociatedProjectPath(), imagePath.string());
-
-                if(!image -> loadFromFile(absoluteImagePath)) {
-                    RB_EDITOR_WARN("SceneLoadTask::loadAssets: can't load animation's image by path {0}", absoluteImagePath);
-                }
+                collectImage(animation -> texturePath, assetLoads);
             }
-
         }
 
         if(entity.hasChildren()) {
             for(auto& child: entity.getChildren())
-                loadAssets(child);
+                collectAssets(child, assetLoads);
+        }
+    }
+
+    void SceneLoadTask::collectImage(const std::string& localPath, std::vector<AssetLoad>& assetLoads) {
+        auto resourceManager = ResourceManager::getManager();
+        fs::path imagePath{localPath};
+        const auto id = imagePath.filename().string();
+        /// nullptr means image is already loaded or queued
+        auto* image = resourceManager -> addImage(id);
+        if(!image)
+            return;
+
+        auto absolutePath = combinePath(m_scene -> getAssociatedProjectPath(), imagePath.string());
+        AssetLoad assetLoad{ image, nullptr, absolutePath, findPacked(absolutePath) };
+
+        /// export writes compressed container next to image, in pack or as loose file
+        auto compressedPath = fs::path(absolutePath).replace_extension(robot2D::CompressedImage::extension).string();
+        assetLoad.compressedPacked = findPacked(compressedPath);
+        std::error_code errorCode;
+        if(assetLoad.compressedPacked || fs::is_regular_file(compressedPath, errorCode)) {
+            assetLoad.compressedImage = resourceManager -> addCompressedImage(id);
+            assetLoad.compressedPath = std::move(compressedPath);
         }
+        assetLoads.emplace_back(std::move(assetLoad));
     }
-}
\ No newline at end of file
+}
@@ -304,11 +304,8 @@ namespace editor {
                         /// errror
                     }
 
-                    if (!m_animationEntity.hasComponent<AnimationComponent>()) {
-                        if (!m_animationEntity.hasComponent<AnimationComponent>())
-                            m_animationEntity.addComponent<AnimationComponent>();
+                    if (!m_animationEntity.hasComponent<AnimationComponent>())
                         m_animationEntity.addComponent<AnimationComponent>();
-                    }
 
                     auto& animationComponent = m_animationEntity.getComponent<AnimationComponent>();
                     m_currentAnimation = nullptr;
@@ -322,6 +319,8 @@ namespace editor {
                     m_currentAnimation -> filePath = path;
                     m_animationEntity.getComponent<AnimationComponent>().setAnimation(m_currentAnimation);
                     m_keyFrames.clear();
+                    /// component and animation are added without inspector widgets, so scene is told directly
+                    m_interactor -> markEntityDirty(m_animationEntity);
                 }
             }
 
@@ -809,7 +808,7 @@ namespace editor {
             return;
         }
 
-        texture -> create(manager -> getImage(task.getFileName()));
+        manager -> createTexture(task.getFileName(), *texture);
 
         if(!m_currentAnimation) {
             RB_EDITOR_ERROR("AnimationPanel::onAnimationSlice: No Animation");
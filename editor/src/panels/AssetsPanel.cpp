@@ -36,6 +36,8 @@ source distribution.
 #include <editor/DragDropIDS.hpp>
 #include <editor/EditorResourceManager.hpp>
 #include <editor/Buffer.hpp>
+#include <editor/ImportCache.hpp>
+#include <editor/TaskQueue.hpp>
 
 namespace editor {
     namespace fs = std::filesystem;
@@ -45,7 +47,6 @@ namespace editor {
                                                 | ImGuiInputTextFlags_AutoSelectAll;
 
         static std::unordered_map< std::string, AssetsPanelConfiguration::ResourceIconType> resourceTypes = {
-                {".png", AssetsPanelConfiguration::ResourceIconType::Image },
                 {".scene", AssetsPanelConfiguration::ResourceIconType::Scene },
                 {".cs", AssetsPanelConfiguration::ResourceIconType::Script },
                 {".ttf", AssetsPanelConfiguration::ResourceIconType::Font },
@@ -54,9 +55,10 @@ namespace editor {
         };
 
 
-        void itemDeletePopUp(const std::filesystem::directory_entry& directoryEntry,
+        /// true when item was removed.
+        bool itemDeletePopUp(const std::filesystem::directory_entry& directoryEntry,
                              const std::filesystem::path& path) {
-
+            bool removed = false;
             imgui_Popup("##Delete") {
                 imgui_MenuItem("Delete") {
                     try {
@@ -64,11 +66,15 @@ namespace editor {
                             if (!fs::remove_all(path)) {
                                 RB_EDITOR_WARN("AssetPanel: can't remove directory it's not exists");
                             }
+                            else
+                                removed = true;
                         }
                         else {
                             if(!fs::remove(path)) {
                                 RB_EDITOR_WARN("AssetPanel: can't remove file it's not exists");
                             }
+                            else
+                                removed = true;
                         }
                     }
                     catch(const std::exception& exception) {
@@ -79,6 +85,7 @@ namespace editor {
                     ImGui::CloseCurrentPopup();
                 }
             }
+            return removed;
         }
 
 /*
@@ -167,8 +174,67 @@ namespace editor {
     }
 
     void AssetsPanel::setAssetsPath(const std::string& path) {
-        m_currentPath = fs::path(path);
         m_assetsPath = fs::path(path);
+        changeDirectory(fs::path(path));
+    }
+
+    void AssetsPanel::changeDirectory(const std::filesystem::path& path) {
+        m_currentPath = path;
+        m_itemEditName.second = false;
+        m_assetItems.clear();
+        m_listingDirty = true;
+
+        /// watcher's thread only marks listing, it's enumerated again on next frame
+        m_watcher.reset();
+        try {
+            const auto directory = m_currentPath.string();
+            m_watcher = std::make_unique<filewatch::FileWatch<std::string>>(directory,
+                [this, directory](const std::string& file, const filewatch::Event) {
+                    {
+                        std::lock_guard<std::mutex> lock{m_changesMutex};
+                        m_changedFiles.emplace_back((fs::path{directory} / file).string());
+                    }
+                    m_listingDirty = true;
+            });
+        }
+        catch(const std::exception& exception) {
+            RB_EDITOR_WARN("AssetsPanel: can't watch {0}, only panel's own changes are shown. Reason: {1}",
+                           m_currentPath.string(), exception.what());
+        }
+    }
+
+    void AssetsPanel::refreshListing() {
+        std::vector<std::string> changedFiles;
+        {
+            std::lock_guard<std::mutex> lock{m_changesMutex};
+            changedFiles.swap(m_changedFiles);
+        }
+        for(const auto& file: changedFiles)
+            m_thumbnails.invalidate(file);
+
+        if(!m_listingDirty.exchange(false))
+            return;
+
+        m_listing.clear();
+        std::error_code error;
+        for(fs::directory_iterator it{m_currentPath, error}, end; !error && it != end; it.increment(error)) {
+            ListingItem item;
+            item.entry = *it;
+            item.relativePath = fs::relative(item.entry.path(), m_assetsPath);
+            item.filename = item.relativePath.filename().string();
+            item.iconType = AssetsPanelConfiguration::ResourceIconType::Directory;
+            if(!item.entry.is_directory()) {
+                auto found = resourceTypes.find(item.relativePath.extension().string());
+                if(isImageFile(item.filename))
+                    item.iconType = AssetsPanelConfiguration::ResourceIconType::Image;
+                else
+                    item.iconType = found != resourceTypes.end() ? found -> second
+                                                                 : AssetsPanelConfiguration::ResourceIconType::File;
+            }
+            m_listing.emplace_back(std::move(item));
+        }
+        if(error)
+            RB_EDITOR_ERROR("AssetsPanel: can't list {0}. Reason: {1}", m_currentPath.string(), error.message());
     }
 
     void AssetsPanel::render() {
@@ -181,12 +247,13 @@ namespace editor {
             if(m_state == State::Loading)
                 return;
 
+            refreshListing();
+            m_thumbnails.beginFrame();
+            auto& jobSystem = TaskQueue::GetQueue() -> getJobSystem();
+
             if(m_currentPath != fs::path(m_assetsPath)) {
-                if(ImGui::Button("<-")) {
-                    m_currentPath = m_currentPath.parent_path();
-                    m_itemEditName.second = false;
-                    m_assetItems.clear();
-                }
+                if(ImGui::Button("<-"))
+                    changeDirectory(m_currentPath.parent_path());
             }
 
             auto panelWidth = ImGui::GetContentRegionAvail().x;
@@ -194,7 +261,7 @@ namespace editor {
             if(tableCount < 1)
                 tableCount = 1;
 
-            if(is_directory(m_currentPath) && is_empty(m_currentPath)) {
+            if(m_listing.empty()) {
                 robot2D::DragDropTarget dragDropTarget{treeNodeItemID};
                 if(auto uuid = dragDropTarget.unpackPayload<UUID>()) {
                     auto entity = m_uiManager.getTreeItem(*uuid);
@@ -209,28 +276,31 @@ namespace editor {
             }
             else {
                 imgui_Table("MyTable", tableCount) {
-                    for(auto& directoryEntry: fs::directory_iterator(m_currentPath)) {
+                    for(auto& item: m_listing) {
                         ImGui::TableNextColumn();
+                        const auto& directoryEntry = item.entry;
                         const auto& path = directoryEntry.path();
-                        auto relativePath = fs::relative(path, m_assetsPath);
-                        std::string filenameString = relativePath.filename().string();
+                        auto& relativePath = item.relativePath;
+                        std::string filenameString = item.filename;
 
                         ImGui::PushID(filenameString.c_str());
-                        AssetsPanelConfiguration::ResourceIconType iconType = directoryEntry.is_directory() ?
-                                                                              AssetsPanelConfiguration::ResourceIconType::Directory:
-                                                                              AssetsPanelConfiguration::ResourceIconType::File;
-
-                        if(!directoryEntry.is_directory()) {
-                            auto extension = relativePath.extension();
-                            iconType = resourceTypes[extension.string()];
-                        }
+                        const auto iconType = item.iconType;
 
                         {
                             robot2D::ScopedStyleColor scopedStyleColor(ImGuiCol_Button,
                                                                        robot2D::Color(255.f, 255.f, 255.f, 127.f));
 
-                            if(robot2D::ImageButton(m_assetsIcons[iconType], {m_configuration.m_thumbnaleSize,
-                                                                              m_configuration.m_thumbnaleSize})) {
+                            const robot2D::vec2f buttonSize{m_configuration.m_thumbnaleSize,
+                                                            m_configuration.m_thumbnaleSize};
+                            const ThumbnailService::Thumbnail* thumbnail = nullptr;
+                            if(iconType == AssetsPanelConfiguration::ResourceIconType::Image)
+                                thumbnail = m_thumbnails.getThumbnail(path.string(), jobSystem);
+
+                            const bool pressed = thumbnail
+                                    ? robot2D::ImageButton(m_thumbnails.getAtlas(), buttonSize,
+                                                           thumbnail -> uv0, thumbnail -> uv1)
+                                    : robot2D::ImageButton(m_assetsIcons[iconType], buttonSize);
+                            if(pressed) {
                                 m_itemEditName.first = relativePath;
                                 m_itemEditName.second = true;
 
@@ -250,16 +320,17 @@ namespace editor {
                                 m_itemEditName.second = false;
                             }
 
-                            itemDeletePopUp(directoryEntry, path);
+                            if(itemDeletePopUp(directoryEntry, path)) {
+                                m_thumbnails.invalidate(path.string());
+                                m_listingDirty = true;
+                            }
                         }
 
                         processDragDrop(directoryEntry, relativePath);
 
                         if(ImGui::IsItemHovered() && ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left)) {
-                            if(directoryEntry.is_directory()) {
-                                m_currentPath /= path.filename();
-                                m_assetItems.clear();
-                            }
+                            if(directoryEntry.is_directory())
+                                changeDirectory(m_currentPath / path.filename());
                         }
 
                         if(m_itemEditName.first == relativePath && m_itemEditName.second) {
@@ -267,6 +338,8 @@ namespace editor {
                                 auto rename_path = path;
                                 rename_path.replace_filename(filenameString);
                                 fs::rename(path, rename_path);
+                                m_thumbnails.invalidate(path.string());
+                                m_listingDirty = true;
                                 m_itemEditName.second = false;
                             }
                         }
@@ -328,7 +401,7 @@ namespace editor {
                     ImGui::SetDragDropPayload(contentSceneID, itemPath, len);
                     imgui_Text(relativePath.filename().string().c_str());
                 }
-                if(extension == ".png" || extension == ".ttf") {
+                if(isImageFile(relativePath.string()) || extension == ".ttf") {
                    ImGui::SetDragDropPayload(contentItemID, itemPath, len);
                    imgui_Text(relativePath.filename().string().c_str());
                 }
@@ -402,6 +475,7 @@ namespace editor {
                         auto fullPath = combinePath(asset.absolutePath.string(), asset.name);
                         if(!createDirectory(fullPath))
                             RB_EDITOR_ERROR("Assets Panel: Can't create folder by path {0}", fullPath.c_str());
+                        m_listingDirty = true;
                         break;
                     }
                 }
@@ -425,6 +499,8 @@ namespace editor {
                 auto toPath = m_currentPath;
                 auto finalPath = combinePath(toPath.string(), fromPath.filename().string());
                 fs::copy_file(fromPath, finalPath);
+                m_listingDirty = true;
+                ImportCache::getCache() -> importFile(finalPath, TaskQueue::GetQueue() -> getJobSystem());
             } catch(fs::filesystem_error& e) {
                 RB_EDITOR_ERROR("Assets Panel: Couldn't copy {0}", e.what());
             }
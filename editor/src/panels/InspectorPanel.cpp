@@ -39,11 +39,12 @@ source distribution.
 
 namespace editor {
 
+    /// \return true if component was removed
     template<typename T, typename UIFunction>
-    static void drawComponent(const std::string& name, SceneEntity& entity, UIFunction uiFunction)
+    static bool drawComponent(const std::string& name, SceneEntity& entity, UIFunction uiFunction)
     {
         if(!entity || !entity.hasComponent<T>())
-            return;
+            return false;
 
         static const ImGuiTreeNodeFlags treeNodeFlags = ImGuiTreeNodeFlags_DefaultOpen
                                                  | ImGuiTreeNodeFlags_Framed
@@ -84,6 +85,7 @@ namespace editor {
 
         if (removeComponent)
             entity.removeComponent<T>();
+        return removeComponent;
     }
 
 
@@ -152,14 +154,26 @@ namespace editor {
         propertiesWindowOptions.name = "Inspector";
 
         robot2D::createWindow(propertiesWindowOptions, [this]{
-            if(m_selectedEntity && m_inspectType == InspectType::EditorEntity)
+            if(m_selectedEntity && m_inspectType == InspectType::EditorEntity) {
                 drawComponentsBase(m_selectedEntity);
+                markEditedEntity();
+            }
             else if(m_inspectType != InspectType::EditorEntity)
                 drawAssetBase();
         });
     }
 
 
+    void InspectorPanel::markEditedEntity() {
+        /// widgets write into components directly, so any active widget or one released this frame counts as edit,
+        /// added or removed components don't activate any widget and are reported separately
+        const bool isEditing = ImGui::IsAnyItemActive();
+        if((isEditing || m_wasEditing || m_componentsChanged) && m_interactor)
+            m_interactor -> markEntityDirty(m_selectedEntity);
+        m_wasEditing = isEditing;
+        m_componentsChanged = false;
+    }
+
     void InspectorPanel::drawAssetBase() {
         switch (m_inspectType) {
             default:
@@ -206,23 +220,29 @@ namespace editor {
 
         imgui_Popup("AddComponent") {
             imgui_MenuItem("Camera") {
-                if (!m_selectedEntity.hasComponent<CameraComponent>())
+                if (!m_selectedEntity.hasComponent<CameraComponent>()) {
                     m_selectedEntity.addComponent<CameraComponent>();
+                    m_componentsChanged = true;
+                }
                 else
                     RB_EDITOR_WARN("This entity already has the Camera Component!");
                 ImGui::CloseCurrentPopup();
             }
             imgui_MenuItem("UtilRender") {
-                if(!m_selectedEntity.hasComponent<DrawableComponent>())
+                if(!m_selectedEntity.hasComponent<DrawableComponent>()) {
                     m_selectedEntity.addComponent<DrawableComponent>().isUtil = true;
+                    m_componentsChanged = true;
+                }
                 else
                     RB_EDITOR_WARN("This entity already has the Sprite Renderer Component!");
                 ImGui::CloseCurrentPopup();
             }
 
             imgui_MenuItem("SpriteRender") {
-                if (!m_selectedEntity.hasComponent<DrawableComponent>())
+                if (!m_selectedEntity.hasComponent<DrawableComponent>()) {
                     m_selectedEntity.addComponent<DrawableComponent>();
+                    m_componentsChanged = true;
+                }
                 else {
                     RB_EDITOR_WARN("This entity already has the Sprite Renderer Component!");
                 }
@@ -231,24 +251,30 @@ namespace editor {
             }
 
             imgui_MenuItem("RigidBody2D") {
-                if (!m_selectedEntity.hasComponent<Physics2DComponent>())
+                if (!m_selectedEntity.hasComponent<Physics2DComponent>()) {
                     m_selectedEntity.addComponent<Physics2DComponent>();
+                    m_componentsChanged = true;
+                }
                 else
                     RB_EDITOR_WARN("This entity already has the Physics2D Component!");
                 ImGui::CloseCurrentPopup();
             }
 
             imgui_MenuItem("Collider2D") {
-                if (!m_selectedEntity.hasComponent<Collider2DComponent>())
+                if (!m_selectedEntity.hasComponent<Collider2DComponent>()) {
                     m_selectedEntity.addComponent<Collider2DComponent>();
+                    m_componentsChanged = true;
+                }
                 else
                     RB_EDITOR_WARN("This entity already has the Collider2D Component!");
                 ImGui::CloseCurrentPopup();
             }
 
             imgui_MenuItem("Scripting") {
-                if (!m_selectedEntity.hasComponent<ScriptComponent>())
+                if (!m_selectedEntity.hasComponent<ScriptComponent>()) {
                     m_selectedEntity.addComponent<ScriptComponent>();
+                    m_componentsChanged = true;
+                }
                 else
                     RB_EDITOR_WARN("This entity already has the Scripting Component!");
                 ImGui::CloseCurrentPopup();
@@ -258,6 +284,7 @@ namespace editor {
                 if (!m_selectedEntity.hasComponent<TextComponent>()) {
                     m_selectedEntity.addComponent<TextComponent>();
                     m_selectedEntity.getComponent<TransformComponent>().setSize({1.f, 1.f});
+                    m_componentsChanged = true;
                 }
                 else
                     RB_EDITOR_WARN("This entity already has the Text Component!");
@@ -267,11 +294,22 @@ namespace editor {
             imgui_MenuItem("Animation") {
                 if (!m_selectedEntity.hasComponent<AnimationComponent>()) {
                     m_selectedEntity.addComponent<AnimationComponent>();
+                    m_componentsChanged = true;
                 }
                 else
                     RB_EDITOR_WARN("This entity already has the Animation Component!");
                 ImGui::CloseCurrentPopup();
             }
+
+            imgui_MenuItem("Particle Emitter") {
+                if (!m_selectedEntity.hasComponent<ParticleEmitterComponent>()) {
+                    m_selectedEntity.addComponent<ParticleEmitterComponent>();
+                    m_componentsChanged = true;
+                }
+                else
+                    RB_EDITOR_WARN("This entity already has the Particle Emitter Component!");
+                ImGui::CloseCurrentPopup();
+            }
         }
 
         ImGui::PopItemWidth();
@@ -281,36 +319,51 @@ namespace editor {
     }
 
     void InspectorPanel::drawComponents(SceneEntity entity) {
-        drawComponent<TransformComponent>("Transform", entity, BIND_CLASS_FN(drawTransformComponent));
-        drawComponent<CameraComponent>("Camera", entity, BIND_CLASS_FN(drawCameraComponent));
-        drawComponent<DrawableComponent>("Drawable", entity, BIND_CLASS_FN(drawDrawableComponent));
-        drawComponent<ScriptComponent>("Script", entity, BIND_CLASS_FN(drawScriptComponent));
-        drawComponent<Physics2DComponent>("physics2D", entity, BIND_CLASS_FN(drawPhysics2DComponent));
-        drawComponent<Collider2DComponent>("Collider2D", entity, BIND_CLASS_FN(drawCollider2DComponent));
-        drawComponent<TextComponent>("Text", entity, BIND_CLASS_FN(drawTextComponent));
-        drawComponent<AnimationComponent>("Animation", entity, BIND_CLASS_FN(drawAnimationComponent));
+        m_componentsChanged |= drawComponent<TransformComponent>("Transform", entity, BIND_CLASS_FN(drawTransformComponent));
+        m_componentsChanged |= drawComponent<CameraComponent>("Camera", entity, BIND_CLASS_FN(drawCameraComponent));
+        m_componentsChanged |= drawComponent<DrawableComponent>("Drawable", entity, BIND_CLASS_FN(drawDrawableComponent));
+        m_componentsChanged |= drawComponent<ScriptComponent>("Script", entity, BIND_CLASS_FN(drawScriptComponent));
+        m_componentsChanged |= drawComponent<Physics2DComponent>("physics2D", entity, BIND_CLASS_FN(drawPhysics2DComponent));
+        m_componentsChanged |= drawComponent<Collider2DComponent>("Collider2D", entity, BIND_CLASS_FN(drawCollider2DComponent));
+        m_componentsChanged |= drawComponent<TextComponent>("Text", entity, BIND_CLASS_FN(drawTextComponent));
+        m_componentsChanged |= drawComponent<AnimationComponent>("Animation", entity, BIND_CLASS_FN(drawAnimationComponent));
+        m_componentsChanged |= drawComponent<ParticleEmitterComponent>("Particle Emitter", entity,
+                                                                       BIND_CLASS_FN(drawParticleEmitterComponent));
     }
 
 
     void InspectorPanel::drawTransformComponent([[maybe_unused]] SceneEntity entity, TransformComponent& component) {
-        robot2D::vec2f lastPosition = component.getPosition();
-        robot2D::vec2f lastSize = component.getSize();
-        float lastRotation = component.getRotate();
-
-        component.getScale();
-
-        ui::drawVec2Control("Translation", component.getPosition());
-        ui::drawVec2Control("Size", component.getSize(), 1.0f);
-        ui::drawVec2Control("Origin", component.getOrigin(), 0.f, 100.f, 0.f, 1.f);
-        ui::drawVec1Control("Rotation", component.getRotate(), 0.f);
-        component.setRotate(component.getRotate());
-        component.setPosition(component.getPosition());
-        component.setSize(component.getSize());
-
-        if (lastPosition != component.getPosition() || lastSize != component.getSize() ||
-            lastRotation != component.getRotate())
-            m_prefabHasModification = true;
+        /// controls edit copies, setters bump transform's version only when value really changed
+        robot2D::vec2f position = component.getPosition();
+        robot2D::vec2f size = component.getSize();
+        robot2D::vec2f origin = component.getOrigin();
+        float rotation = component.getRotate();
+
+        ui::drawVec2Control("Translation", position);
+        ui::drawVec2Control("Size", size, 1.0f);
+        ui::drawVec2Control("Origin", origin, 0.f, 100.f, 0.f, 1.f);
+        ui::drawVec1Control("Rotation", rotation, 0.f);
+
+        bool changed = false;
+        if(position != component.getPosition()) {
+            component.setPosition(position);
+            changed = true;
+        }
+        if(size != component.getSize()) {
+            component.setSize(size);
+            changed = true;
+        }
+        if(origin != component.getOrigin()) {
+            component.setOrigin(origin);
+            changed = true;
+        }
+        if(rotation != component.getRotate()) {
+            component.setRotate(rotation);
+            changed = true;
+        }
 
+        if(changed)
+            m_prefabHasModification = true;
     }
     
     void InspectorPanel::drawCameraComponent([[maybe_unused]] SceneEntity entity, CameraComponent& component) {
@@ -366,19 +419,16 @@ namespace editor {
                 auto manager = ResourceManager::getManager();
                 if (!manager -> hasImage(localPath.filename().string())) {
                     auto queue = TaskQueue::GetQueue();
-                    queue -> template addAsyncTask<ImageLoadTask>([](const ImageLoadTask& task) {
-                        InspectorPanel::onLoadImage(task.getImage(), task.getEntity());
+                    queue -> template addAsyncTask<ImageLoadTask>([](ImageLoadTask& task) {
+                        InspectorPanel::onLoadImage(task.takeImage(), task.getEntity());
                     }, texturePath, entity);
                 }
                 else {
                     auto* localManager = LocalResourceManager::getManager();
                     auto idComponent = entity.getComponent<IDComponent>();
                     auto* texture = localManager -> addTexture(std::to_string(idComponent.ID));
-                    if (texture) {
-                        auto image = manager -> getImage(localPath.filename().string());
-                        texture -> create(image);
+                    if (texture && manager -> createTexture(localPath.filename().string(), *texture))
                         component.setTexture(*texture);
-                    }
                 }
             }
         }
@@ -407,8 +457,8 @@ namespace editor {
                 auto fontPath = combinePath(m_interactor -> getAssociatedProjectPath(), localPath.string());
 
                 auto queue = TaskQueue::GetQueue();
-                queue -> template addAsyncTask<FontLoadTask>([](const FontLoadTask& task) {
-                    InspectorPanel::onLoadFont(task.getFont(), task.getEntity());
+                queue -> template addAsyncTask<FontLoadTask>([interactor = m_interactor](const FontLoadTask& task) {
+                    InspectorPanel::onLoadFont(task.getFont(), task.getEntity(), interactor);
                 }, fontPath, entity);
             }
         }
@@ -416,6 +466,27 @@ namespace editor {
         if (component.getFont()) {
             robot2D::InputText("##Text", &component.getText(), 0);
             component.setText(component.getText());
+
+            float maxWidth = component.getMaxWidth();
+            if (ImGui::DragFloat("Max Width", &maxWidth, 1.0f, 0.0f))
+                component.setMaxWidth(maxWidth);
+
+            const char* alignmentStrings[] = { "Left", "Center", "Right" };
+            const char* currentAlignmentString = alignmentStrings[(int)component.getAlignment()];
+            imgui_Combo("Alignment", currentAlignmentString) {
+                for (int i = 0; i < 3; i++)
+                {
+                    bool isSelected = currentAlignmentString == alignmentStrings[i];
+                    if (ImGui::Selectable(alignmentStrings[i], isSelected))
+                    {
+                        currentAlignmentString = alignmentStrings[i];
+                        component.setAlignment((robot2D::TextAlignment)i);
+                    }
+
+                    if (isSelected)
+                        ImGui::SetItemDefaultFocus();
+                }
+            }
         }
     }
 
@@ -457,6 +528,37 @@ namespace editor {
         auto* animationManager = AnimationManager::getManager();
     }
 
+    void InspectorPanel::drawParticleEmitterComponent([[maybe_unused]] SceneEntity entity,
+                                                      ParticleEmitterComponent& component) {
+        ImGui::Checkbox("Emitting", &component.emitting);
+        ImGui::DragFloat("Emission Rate", &component.emissionRate, 1.f, 0.f, 100000.f);
+        ImGui::DragFloat("Life Time", &component.lifeTime, 0.05f, 0.f, 60.f);
+        ImGui::DragFloat("Speed", &component.speed, 1.f);
+        ImGui::DragFloat("Direction", &component.direction, 1.f, -360.f, 360.f);
+        ImGui::DragFloat("Spread", &component.spread, 1.f, 0.f, 360.f);
+
+        float gravity[2] = { component.gravity.x, component.gravity.y };
+        ImGui::DragFloat2("Gravity", gravity);
+        component.gravity = { gravity[0], gravity[1] };
+
+        ImGui::DragFloat("Start Size", &component.startSize, 0.1f, 0.f);
+        ImGui::DragFloat("End Size", &component.endSize, 0.1f, 0.f);
+
+        auto startColor = component.startColor.toGL();
+        auto endColor = component.endColor.toGL();
+        ImGui::ColorEdit4("Start Color", reinterpret_cast<float*>(&startColor));
+        ImGui::ColorEdit4("End Color", reinterpret_cast<float*>(&endColor));
+        component.startColor = robot2D::Color::fromGL(startColor.red, startColor.green, startColor.blue, startColor.alpha);
+        component.endColor = robot2D::Color::fromGL(endColor.red, endColor.green, endColor.blue, endColor.alpha);
+
+        int maxParticles = static_cast<int>(component.maxParticles);
+        if(ImGui::InputInt("Max Particles", &maxParticles))
+            component.maxParticles = static_cast<unsigned int>(std::max(maxParticles, 0));
+        int layerIndex = static_cast<int>(component.layerIndex);
+        if(ImGui::InputInt("Layer", &layerIndex))
+            component.layerIndex = static_cast<unsigned int>(std::max(layerIndex, 0));
+    }
+
 
 
 
@@ -621,7 +723,7 @@ namespace editor {
     }
 
     void InspectorPanel::drawUIComponents(SceneEntity entity) {
-        drawComponent<ButtonComponent>("Button", entity, BIND_CLASS_FN(drawUIButtonComponent));
+        m_componentsChanged |= drawComponent<ButtonComponent>("Button", entity, BIND_CLASS_FN(drawUIButtonComponent));
     }
 
     void InspectorPanel::drawUIButtonComponent([[maybe_unused]] SceneEntity entity, ButtonComponent& component) {
@@ -675,7 +777,7 @@ namespace editor {
     }
 
 
-    void InspectorPanel::onLoadImage(const robot2D::Image& image, SceneEntity entity) {
+    void InspectorPanel::onLoadImage(robot2D::Image&& image, SceneEntity entity) {
         if(!entity) {
             RB_EDITOR_WARN("Can't attach texture to Entity, because it's already destroyed");
             return;
@@ -686,13 +788,13 @@ namespace editor {
         auto* texture = localManager -> addTexture(std::to_string(idComponent.ID));
         if(!texture)
             return;
-        texture -> create(image);
+        texture -> create(std::move(image));
 
         if(entity.hasComponent<DrawableComponent>())
             entity.getComponent<DrawableComponent>().setTexture(*texture);
     }
 
-    void InspectorPanel::onLoadFont(const robot2D::Font& font, SceneEntity entity) {
+    void InspectorPanel::onLoadFont(const robot2D::Font& font, SceneEntity entity, UIInteractor::Ptr interactor) {
         if(!entity) {
             RB_EDITOR_WARN("Can't attach texture to Entity, because it's already destroyed");
             return;
@@ -705,8 +807,12 @@ namespace editor {
             return;
         f -> clone(const_cast<robot2D::Font&>(font));
 
-        if(entity.hasComponent<TextComponent>())
+        if(entity.hasComponent<TextComponent>()) {
             entity.getComponent<TextComponent>().setFont(*f);
+            /// font arrives after inspector edit was reported, so cached fragment may already hold old font
+            if(interactor)
+                interactor -> markEntityDirty(entity);
+        }
     }
 
 
@@ -24,12 +24,14 @@ source distribution.
 
 #include <robot2D/imgui/Api.hpp>
 #include <robot2D/Util/Logger.hpp>
+#include <robot2D/Util/Profiler.hpp>
 
 #include <editor/panels/MenuPanel.hpp>
 #include <editor/Messages.hpp>
 #include <editor/PopupManager.hpp>
 #include <editor/FiledialogAdapter.hpp>
 #include <editor/Buffer.hpp>
+#include <editor/TaskQueue.hpp>
 
 namespace editor {
 
@@ -63,15 +65,46 @@ namespace editor {
             imgui_Menu("Plugins")
                 pluginsMenu();
 
-            imgui_Menu("Developer")
+            imgui_Menu("Developer") {
                 ImGui::MenuItem("Show Info", nullptr, &openDeveloperMenu);
+#ifdef RB_PROFILE
+                /// without profiler scopes compiled in trace would be empty
+                imgui_MenuItem("Capture Frame Trace", nullptr, false, !robot2D::Profiler::isCapturing()) {
+                    std::string tracePath;
+                    if(FiledialogAdapter::get() -> saveFile(tracePath, "Save Chrome Trace",
+                                                            "", {"*.json"}, "Trace"))
+                        robot2D::Profiler::captureFrames(1, tracePath);
+                }
+#endif
+            }
 
             imgui_Menu("Help")
                 helpMenu();
+
+            tasksStatus();
         }
 
     }
 
+    void MenuPanel::tasksStatus() {
+        m_activeTasks.clear();
+        TaskQueue::GetQueue() -> getActiveTasks(m_activeTasks);
+        if(m_activeTasks.empty())
+            return;
+
+        auto& task = m_activeTasks.front();
+        ImGui::Separator();
+        if(m_activeTasks.size() > 1)
+            ImGui::Text("%s (+%zu)", task.getName(), m_activeTasks.size() - 1);
+        else
+            ImGui::TextUnformatted(task.getName());
+
+        constexpr float progressWidth = 120.F;
+        ImGui::ProgressBar(task.getProgress(), ImVec2{progressWidth, 0.F});
+        if(task.isCancellable() && !task.isCancelled() && ImGui::SmallButton("Cancel"))
+            task.cancel();
+    }
+
     void MenuPanel::fileMenu() {
         imgui_MenuItem("New", "Ctrl + N") {
             std::string path;
@@ -254,6 +287,14 @@ namespace editor {
                 }
             }
 
+            ImGui::Checkbox("Compress Textures", &m_exportOptions.compressTextures);
+            if(m_exportOptions.compressTextures) {
+                const char* formatsNames[] = {"BC1", "BC3", "BC7", "ETC2 RGB", "ETC2 RGBA"};
+                int formatIndex = static_cast<int>(m_exportOptions.textureFormat) - 1;
+                if(ImGui::Combo("Texture Format", &formatIndex, formatsNames, IM_ARRAYSIZE(formatsNames)))
+                    m_exportOptions.textureFormat = static_cast<robot2D::CompressedFormat>(formatIndex + 1);
+            }
+
             imgui_Button("Close") {
                 m_popupType = PopupType::None;
                 PopupManager::getManager() -> endPopup();
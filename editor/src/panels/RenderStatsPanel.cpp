@@ -0,0 +1,81 @@
+/*********************************************************************
+(c) Alex Raag 2023
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#include <cfloat>
+#include <cstdio>
+#include <robot2D/imgui/Api.hpp>
+#include <editor/panels/RenderStatsPanel.hpp>
+
+namespace editor {
+
+    namespace {
+        constexpr const char* breakReasonNames[robot2D::RenderStats::breakReasonsCount] = {
+            "Texture Slots", "Buffer Full", "State Change"
+        };
+    }
+
+    RenderStatsPanel::RenderStatsPanel():
+        IPanel(UniqueType(typeid(RenderStatsPanel))) {}
+
+    void RenderStatsPanel::setRenderStats(const robot2D::RenderStats& renderStats) {
+        m_renderStats = renderStats;
+        m_cpuHistory[m_historyOffset] = renderStats.recordTime + renderStats.submitTime;
+        m_gpuHistory[m_historyOffset] = renderStats.gpuTime;
+        m_historyOffset = (m_historyOffset + 1) % historySize;
+    }
+
+    void RenderStatsPanel::render() {
+        ImGui::Begin("Render Profiler");
+
+        ImGui::Text("Draw Calls: %u", m_renderStats.drawCalls);
+        ImGui::Text("Quads: %u Vertices: %u Instances: %u", m_renderStats.drawQuads,
+                    m_renderStats.drawVertices, m_renderStats.drawInstances);
+        ImGui::Text("Uploaded: %.2f KB", static_cast<float>(m_renderStats.uploadedBytes) / 1024.F);
+
+        if(ImGui::CollapsingHeader("Layers", ImGuiTreeNodeFlags_DefaultOpen)) {
+            for(unsigned i = 0; i < robot2D::RenderStats::maxLayers; ++i)
+                ImGui::Text("Layer %u: %u draw calls", i, m_renderStats.layerDrawCalls[i]);
+        }
+
+        if(ImGui::CollapsingHeader("Batch Breaks", ImGuiTreeNodeFlags_DefaultOpen)) {
+            for(unsigned i = 0; i < robot2D::RenderStats::breakReasonsCount; ++i)
+                ImGui::Text("%s: %u", breakReasonNames[i], m_renderStats.batchBreaks[i]);
+        }
+
+        if(ImGui::CollapsingHeader("Timings", ImGuiTreeNodeFlags_DefaultOpen)) {
+            ImGui::Text("CPU Record: %.3f ms", m_renderStats.recordTime);
+            ImGui::Text("CPU Submit: %.3f ms", m_renderStats.submitTime);
+            ImGui::Text("GPU: %.3f ms", m_renderStats.gpuTime);
+
+            char overlay[32];
+            std::snprintf(overlay, sizeof(overlay), "%.3f ms", m_renderStats.recordTime + m_renderStats.submitTime);
+            ImGui::PlotLines("CPU", m_cpuHistory.data(), static_cast<int>(historySize),
+                             static_cast<int>(m_historyOffset), overlay, 0.F, FLT_MAX, ImVec2(0, 60));
+            std::snprintf(overlay, sizeof(overlay), "%.3f ms", m_renderStats.gpuTime);
+            ImGui::PlotLines("GPU", m_gpuHistory.data(), static_cast<int>(historySize),
+                             static_cast<int>(m_historyOffset), overlay, 0.F, FLT_MAX, ImVec2(0, 60));
+        }
+
+        ImGui::End();
+    }
+
+}
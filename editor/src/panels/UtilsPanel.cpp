@@ -39,6 +39,10 @@ namespace editor {
         m_renderStats = std::move(renderStats);
     }
 
+    void UtilPanel::setParticleStats(const ParticleStats& particleStats) {
+        m_particleStats = particleStats;
+    }
+
     void UtilPanel::render() {
         ImGui::Begin("Statistics ");
 
@@ -48,6 +52,11 @@ namespace editor {
 
         ImGui::Text("Quads Count: %d", m_renderStats.drawQuads);
         ImGui::Text("Draw Calls Count: %d", m_renderStats.drawCalls);
+        ImGui::Text("Instances Count: %d", m_renderStats.drawInstances);
+
+        ImGui::Text("Particles: %d alive, %d emitted, %d emitters",
+                    m_particleStats.aliveParticles, m_particleStats.emittedParticles, m_particleStats.emitters);
+        ImGui::Text("Particles Simulation: %.3f ms", m_particleStats.simulationTime);
 
         if(m_camera -> getType() == EditorCameraType::Orthographic) {
             auto& position = m_camera -> getView().getCenter();
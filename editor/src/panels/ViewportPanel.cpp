@@ -119,6 +119,58 @@ namespace editor {
         if(m_panelFocused && m_panelHovered) {
             m_editorCamera -> update({mx, my}, deltaTime);
         }
+
+        updateHoveredEntity({ static_cast<int>(mx), static_cast<int>(my) });
+        updateAreaSelection();
+    }
+
+    robot2D::vec2i ViewportPanel::getFrameBufferMousePos() const {
+        auto[mx, my] = ImGui::GetMousePos();
+        mx -= m_ViewportBounds.minRegion.x;
+        my -= m_ViewportBounds.minRegion.y;
+        robot2D::vec2f viewportSize = m_ViewportBounds.maxRegion - m_ViewportBounds.minRegion;
+        my = viewportSize.y - my;
+        return { static_cast<int>(mx), static_cast<int>(my) };
+    }
+
+    void ViewportPanel::requestAreaSelection(const robot2D::vec2i& from, const robot2D::vec2i& to) {
+        if(!m_frameBuffer)
+            return;
+        /// framebuffer clamps and orders corners itself
+        m_selectionReadback = m_frameBuffer -> requestPixels(entityIDAttachment,
+                                                             { from.x, from.y, to.x - from.x, to.y - from.y });
+    }
+
+    void ViewportPanel::updateAreaSelection() {
+        if(!m_frameBuffer || m_selectionReadback == robot2D::invalidReadback)
+            return;
+
+        const auto status = m_frameBuffer -> fetchPixels(m_selectionReadback, m_readbackPixels);
+        if(status == robot2D::ReadbackStatus::Pending)
+            return;
+        m_selectionReadback = robot2D::invalidReadback;
+        if(status == robot2D::ReadbackStatus::Ready)
+            m_uiInteractor -> findSelectEntities(m_readbackPixels);
+    }
+
+    void ViewportPanel::updateHoveredEntity(const robot2D::vec2i& mousePos) {
+        if(!m_frameBuffer)
+            return;
+
+        if(m_hoverReadback != robot2D::invalidReadback) {
+            const auto status = m_frameBuffer -> fetchPixels(m_hoverReadback, m_readbackPixels);
+            if(status == robot2D::ReadbackStatus::Pending)
+                return;
+            if(status == robot2D::ReadbackStatus::Ready && !m_readbackPixels.empty())
+                m_hoveredEntityIndex = m_readbackPixels.front();
+            m_hoverReadback = robot2D::invalidReadback;
+        }
+
+        if(!m_panelHovered) {
+            m_hoveredEntityIndex = -1;
+            return;
+        }
+        m_hoverReadback = m_frameBuffer -> requestPixels(entityIDAttachment, { mousePos.x, mousePos.y, 1, 1 });
     }
 
     void ViewportPanel::render() {
@@ -150,6 +202,8 @@ namespace editor {
             }
 
             robot2D::RenderFrameBuffer(m_frameBuffer, m_ViewportSize.as<float>());
+            if(m_panelHovered && m_hoveredEntityIndex >= 0 && !m_guizmo2D.isActive())
+                ImGui::SetMouseCursor(ImGuiMouseCursor_Hand);
 
             m_guizmo2D.setIsShow(false);
             m_CameraCollider.setIsShownDots(false);
@@ -27,6 +27,7 @@ source distribution.
 #include <robot2D/Core/Window.hpp>
 
 #include <mono/metadata/loader.h>
+#include <mono/metadata/appdomain.h>
 #include <mono/metadata/object.h>
 #include <mono/metadata/reflection.h>
 
@@ -314,6 +315,46 @@ namespace editor {
         RB_CORE_ASSERT(entity);
     }
 
+    static bool ParticleEmitterComponent_GetEmitting(UUID entityID) {
+        auto service = ScriptGlue::getService();
+        auto interactor = service -> getInteractor();
+        RB_CORE_ASSERT(interactor);
+        SceneEntity entity = interactor -> getEntity(entityID);
+        RB_CORE_ASSERT(entity);
+
+        return entity.getComponent<ParticleEmitterComponent>().emitting;
+    }
+
+    static void ParticleEmitterComponent_SetEmitting(UUID entityID, bool emitting) {
+        auto service = ScriptGlue::getService();
+        auto interactor = service -> getInteractor();
+        RB_CORE_ASSERT(interactor);
+        SceneEntity entity = interactor -> getEntity(entityID);
+        RB_CORE_ASSERT(entity);
+
+        entity.getComponent<ParticleEmitterComponent>().emitting = emitting;
+    }
+
+    static float ParticleEmitterComponent_GetEmissionRate(UUID entityID) {
+        auto service = ScriptGlue::getService();
+        auto interactor = service -> getInteractor();
+        RB_CORE_ASSERT(interactor);
+        SceneEntity entity = interactor -> getEntity(entityID);
+        RB_CORE_ASSERT(entity);
+
+        return entity.getComponent<ParticleEmitterComponent>().emissionRate;
+    }
+
+    static void ParticleEmitterComponent_SetEmissionRate(UUID entityID, float emissionRate) {
+        auto service = ScriptGlue::getService();
+        auto interactor = service -> getInteractor();
+        RB_CORE_ASSERT(interactor);
+        SceneEntity entity = interactor -> getEntity(entityID);
+        RB_CORE_ASSERT(entity);
+
+        entity.getComponent<ParticleEmitterComponent>().emissionRate = emissionRate;
+    }
+
     static bool Input_IsKeyDown(std::uint16_t keycode)
     {
         return robot2D::Keyboard::isKeyPressed(robot2D::Int2Key(keycode));
@@ -386,6 +427,43 @@ namespace editor {
         service -> onCreateEntity(dupEntity);
     }
 
+    static MonoArray* EntityIDsToArray(const std::vector<std::uint64_t>& entityIDs) {
+        MonoArray* array = mono_array_new(mono_domain_get(), mono_get_uint64_class(), entityIDs.size());
+        for(std::size_t index = 0; index < entityIDs.size(); ++index)
+            mono_array_set(array, std::uint64_t, index, entityIDs[index]);
+        return array;
+    }
+
+    static MonoArray* Spatial_QueryRect(robot2D::vec2f* position, robot2D::vec2f* size) {
+        auto service = ScriptGlue::getService();
+        auto interactor = service -> getInteractor();
+        RB_CORE_ASSERT(interactor);
+
+        std::vector<std::uint64_t> entityIDs;
+        interactor -> queryEntities(robot2D::FloatRect{*position, *size}, entityIDs);
+        return EntityIDsToArray(entityIDs);
+    }
+
+    static MonoArray* Spatial_QueryPoint(robot2D::vec2f* point) {
+        auto service = ScriptGlue::getService();
+        auto interactor = service -> getInteractor();
+        RB_CORE_ASSERT(interactor);
+
+        std::vector<std::uint64_t> entityIDs;
+        interactor -> queryEntities(*point, entityIDs);
+        return EntityIDsToArray(entityIDs);
+    }
+
+    static MonoArray* Spatial_RayCast(robot2D::vec2f* from, robot2D::vec2f* to) {
+        auto service = ScriptGlue::getService();
+        auto interactor = service -> getInteractor();
+        RB_CORE_ASSERT(interactor);
+
+        std::vector<std::uint64_t> entityIDs;
+        interactor -> rayCastEntities(*from, *to, entityIDs);
+        return EntityIDsToArray(entityIDs);
+    }
+
     static MonoObject* GetScriptInstance(UUID uuid) {
         auto service = ScriptGlue::getService();
         return service -> getManagedObject(uuid) -> getInstance();
@@ -425,6 +503,7 @@ namespace editor {
         RegisterComponent<TextComponent>(m_service);
         RegisterComponent<DrawableComponent>(m_service);
         RegisterComponent<AnimatorComponent>(m_service);
+        RegisterComponent<ParticleEmitterComponent>(m_service);
     }
 
     void ScriptGlue::registerFunctions()
@@ -452,11 +531,18 @@ namespace editor {
         RB_ADD_INTERNAL_CALL(DrawableComponent_Flip);
         RB_ADD_INTERNAL_CALL(AnimationComponent_Play);
         RB_ADD_INTERNAL_CALL(AnimationComponent_Stop);
+        RB_ADD_INTERNAL_CALL(ParticleEmitterComponent_GetEmitting);
+        RB_ADD_INTERNAL_CALL(ParticleEmitterComponent_SetEmitting);
+        RB_ADD_INTERNAL_CALL(ParticleEmitterComponent_GetEmissionRate);
+        RB_ADD_INTERNAL_CALL(ParticleEmitterComponent_SetEmissionRate);
         RB_ADD_INTERNAL_CALL(SceneManager_LoadScene);
         RB_ADD_INTERNAL_CALL(SceneManager_LoadSceneAsync);
         RB_ADD_INTERNAL_CALL(Engine_Exit);
         RB_ADD_INTERNAL_CALL(Object_Instantiate);
         RB_ADD_INTERNAL_CALL(Object_Instantiate_WithPos);
+        RB_ADD_INTERNAL_CALL(Spatial_QueryRect);
+        RB_ADD_INTERNAL_CALL(Spatial_QueryPoint);
+        RB_ADD_INTERNAL_CALL(Spatial_RayCast);
     }
 
 
@@ -0,0 +1,314 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+
+#include <robot2D/Core/MappedFileInputStream.hpp>
+#include <robot2D/Util/Logger.hpp>
+#include <editor/serializers/SceneBinaryFormat.hpp>
+
+namespace editor {
+    namespace {
+        enum class ChunkType: std::uint32_t {
+            StringOffsets = 0,
+            Strings,
+            Entities,
+            ChildIDs,
+            Transforms,
+            Cameras,
+            Drawables,
+            Texts,
+            Scripts,
+            ScriptFields,
+            Physics,
+            Colliders,
+            Prefabs,
+            Animations,
+            AnimationPaths,
+            Buttons,
+            ParticleEmitters
+        };
+
+        struct FileHeader {
+            std::uint32_t magic;
+            std::uint16_t version;
+            std::uint16_t headerSize;
+            std::uint32_t chunksCount;
+            SceneData::StringID sceneName;
+            std::uint64_t fileSize;
+            std::uint64_t reserved;
+        };
+
+        struct ChunkHeader {
+            std::uint32_t type;
+            std::uint32_t elementSize;
+            std::uint64_t offset;
+            std::uint64_t count;
+        };
+
+        static_assert(sizeof(FileHeader) == 32 && sizeof(ChunkHeader) == 24);
+
+        constexpr std::size_t chunkAlignment = 16;
+
+        std::size_t alignOffset(std::size_t offset) {
+            return (offset + chunkAlignment - 1) & ~(chunkAlignment - 1);
+        }
+
+        bool isLittleEndian() {
+            const std::uint16_t value = 1;
+            std::uint8_t firstByte;
+            std::memcpy(&firstByte, &value, 1);
+            return firstByte == 1;
+        }
+
+        /// Binds chunk type to table of SceneData, same list serves writer and reader.
+        template<typename Data, typename Func>
+        void forEachTable(Data& sceneData, Func&& func) {
+            func(ChunkType::StringOffsets, sceneData.stringOffsets);
+            func(ChunkType::Strings, sceneData.strings);
+            func(ChunkType::Entities, sceneData.entities);
+            func(ChunkType::ChildIDs, sceneData.childIDs);
+            func(ChunkType::Transforms, sceneData.transforms);
+            func(ChunkType::Cameras, sceneData.cameras);
+            func(ChunkType::Drawables, sceneData.drawables);
+            func(ChunkType::Texts, sceneData.texts);
+            func(ChunkType::Scripts, sceneData.scripts);
+            func(ChunkType::ScriptFields, sceneData.scriptFields);
+            func(ChunkType::Physics, sceneData.physics);
+            func(ChunkType::Colliders, sceneData.colliders);
+            func(ChunkType::Prefabs, sceneData.prefabs);
+            func(ChunkType::Animations, sceneData.animations);
+            func(ChunkType::AnimationPaths, sceneData.animationPaths);
+            func(ChunkType::Buttons, sceneData.buttons);
+            func(ChunkType::ParticleEmitters, sceneData.particleEmitters);
+        }
+
+        template<typename Table>
+        using ElementOf = std::decay_t<decltype(*std::declval<Table&>().data())>;
+
+        bool inRange(std::uint32_t first, std::uint32_t count, std::size_t size) {
+            return static_cast<std::size_t>(first) + count <= size;
+        }
+
+        bool validate(const SceneData& sceneData) {
+            const auto& offsets = sceneData.stringOffsets;
+            if(!offsets.empty()) {
+                if(offsets.front() != 0 || offsets.back() != sceneData.strings.size())
+                    return false;
+                for(std::size_t i = 1; i < offsets.size(); ++i)
+                    if(offsets[i] < offsets[i - 1])
+                        return false;
+            }
+
+            const auto stringsCount = sceneData.getStringsCount();
+            auto validString = [stringsCount](SceneData::StringID id) {
+                return id == SceneData::noString || id < stringsCount;
+            };
+            const auto entitiesCount = sceneData.entities.size();
+            auto validEntity = [entitiesCount](std::uint32_t entity) { return entity < entitiesCount; };
+
+            if(!validString(sceneData.name))
+                return false;
+            for(const auto& entity: sceneData.entities)
+                if(!validString(entity.tag)
+                    || !inRange(entity.firstChild, entity.childrenCount, sceneData.childIDs.size()))
+                    return false;
+            for(const auto& transform: sceneData.transforms)
+                if(!validEntity(transform.entity))
+                    return false;
+            for(const auto& camera: sceneData.cameras)
+                if(!validEntity(camera.entity))
+                    return false;
+            for(const auto& drawable: sceneData.drawables)
+                if(!validEntity(drawable.entity) || !validString(drawable.texturePath))
+                    return false;
+            for(const auto& text: sceneData.texts)
+                if(!validEntity(text.entity) || !validString(text.text) || !validString(text.fontPath))
+                    return false;
+            for(const auto& script: sceneData.scripts)
+                if(!validEntity(script.entity) || !validString(script.className)
+                    || !inRange(script.firstField, script.fieldsCount, sceneData.scriptFields.size()))
+                    return false;
+            for(const auto& field: sceneData.scriptFields)
+                if(!validString(field.name) || !validString(field.type))
+                    return false;
+            for(const auto& physics: sceneData.physics)
+                if(!validEntity(physics.entity))
+                    return false;
+            for(const auto& collider: sceneData.colliders)
+                if(!validEntity(collider.entity))
+                    return false;
+            for(const auto& prefab: sceneData.prefabs)
+                if(!validEntity(prefab.entity))
+                    return false;
+            for(const auto& animation: sceneData.animations)
+                if(!validEntity(animation.entity)
+                    || !inRange(animation.firstPath, animation.pathsCount, sceneData.animationPaths.size()))
+                    return false;
+            for(const auto& path: sceneData.animationPaths)
+                if(!validString(path))
+                    return false;
+            for(const auto& button: sceneData.buttons)
+                if(!validEntity(button.entity) || !validString(button.methodName))
+                    return false;
+            for(const auto& emitter: sceneData.particleEmitters)
+                if(!validEntity(emitter.entity))
+                    return false;
+            return true;
+        }
+    }
+
+    bool SceneBinaryFormat::isBinaryScene(const std::string& path) {
+        std::ifstream file{path, std::ios::binary};
+        if(!file.is_open())
+            return false;
+        std::uint32_t fileMagic = 0;
+        file.read(reinterpret_cast<char*>(&fileMagic), sizeof(fileMagic));
+        return file && fileMagic == magic;
+    }
+
+    bool SceneBinaryFormat::loadFromFile(const std::string& path, SceneData& sceneData) {
+        robot2D::MappedFileInputStream file;
+        if(!file.openFromFile(path)) {
+            RB_EDITOR_ERROR("SceneBinaryFormat: can't open file {0}", path);
+            return false;
+        }
+        return loadFromMemory(file.getData(), file.getDataSize(), sceneData);
+    }
+
+    bool SceneBinaryFormat::loadFromMemory(const std::uint8_t* data, std::size_t size, SceneData& sceneData) {
+        sceneData.clear();
+        if(!isLittleEndian()) {
+            RB_EDITOR_ERROR("SceneBinaryFormat: big-endian hosts aren't supported");
+            return false;
+        }
+
+        FileHeader header{};
+        if(!data || size < sizeof(header)) {
+            RB_EDITOR_ERROR("SceneBinaryFormat: data is too small for header");
+            return false;
+        }
+        std::memcpy(&header, data, sizeof(header));
+        if(header.magic != magic) {
+            RB_EDITOR_ERROR("SceneBinaryFormat: not a binary scene");
+            return false;
+        }
+        if(header.version > version) {
+            RB_EDITOR_ERROR("SceneBinaryFormat: version {0} is newer than supported {1}", header.version, version);
+            return false;
+        }
+        if(header.headerSize < sizeof(header) || header.fileSize != size
+            || header.headerSize + static_cast<std::size_t>(header.chunksCount) * sizeof(ChunkHeader) > size) {
+            RB_EDITOR_ERROR("SceneBinaryFormat: corrupted header");
+            return false;
+        }
+
+        bool success = true;
+        for(std::uint32_t i = 0; i < header.chunksCount && success; ++i) {
+            ChunkHeader chunk{};
+            std::memcpy(&chunk, data + header.headerSize + i * sizeof(ChunkHeader), sizeof(chunk));
+
+            forEachTable(sceneData, [&](ChunkType type, auto& table) {
+                using Element = ElementOf<decltype(table)>;
+                if(static_cast<std::uint32_t>(type) != chunk.type || !success)
+                    return;
+                if(chunk.elementSize != sizeof(Element)) {
+                    RB_EDITOR_ERROR("SceneBinaryFormat: chunk {0} has record size {1}, expected {2}",
+                                    chunk.type, chunk.elementSize, sizeof(Element));
+                    success = false;
+                    return;
+                }
+                if(chunk.offset > size || chunk.count > (size - chunk.offset) / sizeof(Element)) {
+                    RB_EDITOR_ERROR("SceneBinaryFormat: chunk {0} is out of file", chunk.type);
+                    success = false;
+                    return;
+                }
+                table.resize(static_cast<std::size_t>(chunk.count));
+                if(chunk.count > 0)
+                    std::memcpy(table.data(), data + chunk.offset, static_cast<std::size_t>(chunk.count) * sizeof(Element));
+            });
+        }
+        sceneData.name = header.sceneName;
+
+        if(success && !validate(sceneData)) {
+            RB_EDITOR_ERROR("SceneBinaryFormat: scene references are out of range");
+            success = false;
+        }
+        if(!success)
+            sceneData.clear();
+        return success;
+    }
+
+    bool SceneBinaryFormat::saveToFile(const std::string& path, const SceneData& sceneData) {
+        std::vector<std::uint8_t> buffer;
+        saveToMemory(buffer, sceneData);
+
+        std::ofstream file{path, std::ios::binary | std::ios::trunc};
+        if(!file.is_open()) {
+            RB_EDITOR_ERROR("SceneBinaryFormat: can't open file {0}", path);
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+        return static_cast<bool>(file);
+    }
+
+    void SceneBinaryFormat::saveToMemory(std::vector<std::uint8_t>& buffer, const SceneData& sceneData) {
+        std::vector<ChunkHeader> chunks;
+        forEachTable(sceneData, [&chunks](ChunkType type, auto& table) {
+            using Element = ElementOf<decltype(table)>;
+            static_assert(std::is_trivially_copyable_v<Element>);
+            if(!table.empty())
+                chunks.push_back({ static_cast<std::uint32_t>(type), sizeof(Element), 0, table.size() });
+        });
+
+        std::size_t offset = sizeof(FileHeader) + chunks.size() * sizeof(ChunkHeader);
+        for(auto& chunk: chunks) {
+            offset = alignOffset(offset);
+            chunk.offset = offset;
+            offset += static_cast<std::size_t>(chunk.count) * chunk.elementSize;
+        }
+
+        buffer.assign(offset, 0);
+        FileHeader header{};
+        header.magic = magic;
+        header.version = version;
+        header.headerSize = sizeof(FileHeader);
+        header.chunksCount = static_cast<std::uint32_t>(chunks.size());
+        header.sceneName = sceneData.name;
+        header.fileSize = offset;
+        std::memcpy(buffer.data(), &header, sizeof(header));
+        if(!chunks.empty())
+            std::memcpy(buffer.data() + sizeof(header), chunks.data(), chunks.size() * sizeof(ChunkHeader));
+
+        std::size_t chunkIndex = 0;
+        forEachTable(sceneData, [&](ChunkType, auto& table) {
+            using Element = ElementOf<decltype(table)>;
+            if(table.empty())
+                return;
+            const auto& chunk = chunks[chunkIndex++];
+            std::memcpy(buffer.data() + chunk.offset, table.data(), table.size() * sizeof(Element));
+        });
+    }
+
+} // namespace editor
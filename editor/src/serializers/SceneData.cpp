@@ -0,0 +1,71 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#include <editor/serializers/SceneData.hpp>
+
+namespace editor {
+
+    SceneData::StringID SceneData::addString(std::string_view value) {
+        if(stringOffsets.empty())
+            stringOffsets.emplace_back(0);
+
+        std::string key{value};
+        auto found = m_stringIndex.find(key);
+        if(found != m_stringIndex.end())
+            return found -> second;
+
+        const auto id = static_cast<StringID>(getStringsCount());
+        strings.append(value.data(), value.size());
+        stringOffsets.emplace_back(static_cast<std::uint32_t>(strings.size()));
+        m_stringIndex.emplace(std::move(key), id);
+        return id;
+    }
+
+    std::string_view SceneData::getString(StringID id) const {
+        if(id == noString || id >= getStringsCount())
+            return {};
+        return std::string_view{strings}.substr(stringOffsets[id], stringOffsets[id + 1] - stringOffsets[id]);
+    }
+
+    void SceneData::clear() {
+        name = noString;
+        strings.clear();
+        stringOffsets.clear();
+        entities.clear();
+        childIDs.clear();
+        transforms.clear();
+        cameras.clear();
+        drawables.clear();
+        texts.clear();
+        scripts.clear();
+        scriptFields.clear();
+        physics.clear();
+        colliders.clear();
+        prefabs.clear();
+        animations.clear();
+        animationPaths.clear();
+        buttons.clear();
+        particleEmitters.clear();
+        m_stringIndex.clear();
+    }
+
+} // namespace editor
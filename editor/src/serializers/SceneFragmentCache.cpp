@@ -0,0 +1,140 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#include <robot2D/Ecs/EntityManager.hpp>
+#include <editor/serializers/SceneFragmentCache.hpp>
+#include <editor/Components.hpp>
+
+namespace editor {
+    namespace {
+        std::uint64_t hashCombine(std::uint64_t seed, std::uint64_t value) {
+            return seed ^ (value + 0x9E3779B97F4A7C15ULL + (seed << 6) + (seed >> 2));
+        }
+
+        /// Emitter output of one entity shifted to be entry of Entities sequence.
+        std::string indentFragment(const std::string& text) {
+            std::string fragment;
+            fragment.reserve(text.size() + text.size() / 16 + 2);
+            fragment += "  ";
+            for(std::size_t i = 0; i < text.size(); ++i) {
+                fragment += text[i];
+                if(text[i] == '\n' && i + 1 < text.size())
+                    fragment += "  ";
+            }
+            return fragment;
+        }
+    }
+
+    std::uint64_t SceneFragmentCache::computeHierarchyHash(SceneEntity& entity) {
+        std::uint64_t hash = 0;
+        auto& transform = entity.getComponent<TransformComponent>();
+        if(transform.isChild())
+            hash = hashCombine(hash, static_cast<std::uint64_t>(transform.getParent().getComponent<IDComponent>().ID));
+        for(auto& child: transform.getChildren()) {
+            if(child)
+                hash = hashCombine(hash, static_cast<std::uint64_t>(child.getUUID()));
+        }
+        return hash;
+    }
+
+    bool SceneFragmentCache::appendEntities(std::string& text, std::list<SceneEntity>& entities,
+                                            const EmitFunction& emitEntity) {
+        const auto size = text.size();
+        for(auto& entity: entities)
+            appendEntity(text, entity, emitEntity);
+        return text.size() != size;
+    }
+
+    void SceneFragmentCache::appendEntity(std::string& text, SceneEntity& entity, const EmitFunction& emitEntity) {
+        const auto uuid = entity.getUUID();
+        const bool hasTransform = entity.hasComponent<TransformComponent>();
+        const auto transformVersion = hasTransform ? entity.getComponent<TransformComponent>().getVersion() : 0;
+        const auto entityHash = hasTransform ? computeHierarchyHash(entity) : 0;
+
+        text += '\n';
+        if(const auto* cached = find(uuid, transformVersion, entityHash)) {
+            text += cached -> text;
+            keep(uuid);
+        }
+        else {
+            Fragment fragment{ indentFragment(emitEntity(entity)), transformVersion, entityHash };
+            text += fragment.text;
+            store(uuid, std::move(fragment));
+        }
+
+        if(hasTransform && entity.hasChildren()) {
+            for(auto child: entity.getChildren()) {
+                if(child)
+                    appendEntity(text, child, emitEntity);
+            }
+        }
+    }
+
+    void SceneFragmentCache::invalidate() {
+        m_fragments.clear();
+        m_dirtyEntities.clear();
+    }
+
+    const SceneFragmentCache::Fragment* SceneFragmentCache::find(UUID uuid, std::uint32_t transformVersion,
+                                                                 std::uint64_t hierarchyHash) const {
+        if(m_dirtyEntities.find(uuid) != m_dirtyEntities.end())
+            return nullptr;
+        auto found = m_fragments.find(uuid);
+        if(found == m_fragments.end())
+            return nullptr;
+        const auto& fragment = found -> second;
+        if(fragment.transformVersion != transformVersion || fragment.hierarchyHash != hierarchyHash)
+            return nullptr;
+        return &fragment;
+    }
+
+    void SceneFragmentCache::keep(UUID uuid) {
+        m_keptEntities.emplace_back(uuid);
+    }
+
+    void SceneFragmentCache::store(UUID uuid, Fragment&& fragment) {
+        m_nextFragments[uuid] = std::move(fragment);
+    }
+
+    void SceneFragmentCache::commit() {
+        std::unordered_map<UUID, Fragment> fragments;
+        fragments.reserve(m_keptEntities.size() + m_nextFragments.size());
+        for(const auto& uuid: m_keptEntities) {
+            auto found = m_fragments.find(uuid);
+            if(found != m_fragments.end())
+                fragments.emplace(uuid, std::move(found -> second));
+        }
+        for(auto& [uuid, fragment]: m_nextFragments)
+            fragments[uuid] = std::move(fragment);
+
+        m_fragments.swap(fragments);
+        m_nextFragments.clear();
+        m_keptEntities.clear();
+        m_dirtyEntities.clear();
+    }
+
+    void SceneFragmentCache::rollback() {
+        m_nextFragments.clear();
+        m_keptEntities.clear();
+    }
+
+}
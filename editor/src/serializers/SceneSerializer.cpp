@@ -19,17 +19,25 @@ and must not be misrepresented as being the original software.
 source distribution.
 *********************************************************************/
 
+#include <cstring>
+#include <filesystem>
 #include <fstream>
+#include <functional>
+#include <unordered_map>
 #include <yaml-cpp/yaml.h>
 #include <robot2D/Util/Logger.hpp>
 
 
 #include <editor/serializers/SceneSerializer.hpp>
 #include <editor/serializers/EntitySerializer.hpp>
+#include <editor/serializers/SceneBinaryFormat.hpp>
+#include <editor/serializers/SceneYAMLFormat.hpp>
+#include <editor/SceneJournal.hpp>
 
 #include <editor/Scene.hpp>
 #include <editor/Components.hpp>
-#include <editor/scripting/ScriptingEngine.hpp>
+#include <editor/ResouceManager.hpp>
+#include <editor/FileApi.hpp>
 
 
 namespace editor {
@@ -60,36 +68,83 @@ namespace editor {
 
 
     bool SceneSerializer::serialize(const std::string& path, const std::string& sceneName,
-                                    IScriptInteractorFrom::Ptr scriptingEngine) {
+                                    IScriptInteractorFrom::Ptr scriptingEngine, SceneFormat format) {
         if(m_scene == nullptr)
             return false;
+        if(format == SceneFormat::Binary)
+            return serializeBinary(path, sceneName, scriptingEngine);
 
 
+        return serializeYaml(path, sceneName, scriptingEngine);
+    }
 
-        YAML::Emitter out;
-        out << YAML::BeginMap;
-        out << YAML::Key << "Scene" << YAML::Value << sceneName;
-        out << YAML::Key << "Entities" << YAML::Value << YAML::BeginSeq;
+    bool SceneSerializer::serializeYaml(const std::string& path, const std::string& sceneName,
+                                        IScriptInteractorFrom::Ptr scriptingEngine) {
+        YAML::Emitter header;
+        header << YAML::BeginMap;
+        header << YAML::Key << "Scene" << YAML::Value << sceneName;
+        header << YAML::EndMap;
 
+        auto& fragmentCache = m_scene -> getFragmentCache();
         auto entitySerializer = getSerializer<EntityYAMLSerializer>();
-        for(auto& entity: m_scene -> getEntities())
-            entitySerializer -> serialize(out, entity, scriptingEngine);
-        out << YAML::EndSeq;
-        out << YAML::EndMap;
 
-        std::ofstream ofstream(path);
+        std::string text{header.c_str(), header.size()};
+        text += "\nEntities:";
+
+        auto emitEntity = [&entitySerializer, &scriptingEngine](SceneEntity& entity) {
+            YAML::Emitter out;
+            out << YAML::BeginSeq;
+            entitySerializer -> serializeSelf(out, entity, scriptingEngine);
+            out << YAML::EndSeq;
+            return std::string{out.c_str(), out.size()};
+        };
+        if(!fragmentCache.appendEntities(text, m_scene -> getEntities(), emitEntity))
+            text += "\n  []";
+
+        std::ofstream ofstream(path, std::ios::binary);
         if(!ofstream.is_open()) {
+            fragmentCache.rollback();
             m_error = SceneSerializerError::NoFileOpen;
             return false;
         }
 
-        ofstream << out.c_str();
+        ofstream.write(text.data(), static_cast<std::streamsize>(text.size()));
         ofstream.close();
+        if(!ofstream) {
+            fragmentCache.rollback();
+            m_error = SceneSerializerError::NoFileOpen;
+            return false;
+        }
 
+        fragmentCache.commit();
         return true;
     }
 
     bool SceneSerializer::deserialize(const std::string& path, IScriptInteractorFrom::Ptr scriptingEngine) {
+        if(auto assetPack = ResourceManager::getManager() -> getAssetPack()) {
+            auto asset = assetPack -> getAsset(toAssetName(m_scene -> getAssociatedProjectPath(), path));
+            if(asset)
+                return deserializeFromMemory(asset.data, asset.size, scriptingEngine);
+        }
+
+        if(SceneBinaryFormat::isBinaryScene(path)) {
+            SceneData sceneData;
+            if(!SceneBinaryFormat{}.loadFromFile(path, sceneData)) {
+                m_error = SceneSerializerError::NoFileOpen;
+                return false;
+            }
+            if(!std::filesystem::exists(SceneJournal::getJournalPath(path)))
+                return deserializeData(sceneData, scriptingEngine);
+
+            /// journal records are YAML, so unsaved changes are replayed onto YAML view of binary scene
+            YAML::Emitter out;
+            SceneYAMLFormat{}.saveToEmitter(out, sceneData);
+            auto data = YAML::Load(out.c_str());
+            if(!SceneJournal::replay(path, data))
+                return deserializeData(sceneData, scriptingEngine);
+            return deserializeReplayed(data, scriptingEngine);
+        }
+
         YAML::Node data;
         try {
             std::ifstream ifstream(path);
@@ -98,50 +153,121 @@ namespace editor {
                 return false;
             }
 
-            std::stringstream sstr;
-            sstr << ifstream.rdbuf();
-            ifstream.close();
-            data = YAML::Load(sstr.str());
+            data = YAML::Load(ifstream);
         }
         catch (...) {
             RB_EDITOR_CRITICAL("YAML Exception");
             exit(2);
         }
 
+        if(SceneJournal::replay(path, data))
+            return deserializeReplayed(data, scriptingEngine);
+        return deserializeYaml(data, scriptingEngine);
+    }
+
+    bool SceneSerializer::deserializeReplayed(const YAML::Node& data, IScriptInteractorFrom::Ptr scriptingEngine) {
+        if(!deserializeYaml(data, scriptingEngine))
+            return false;
+        /// replayed edits aren't in scene file yet, so scene has to be saved
+        m_scene -> setHasChanges(true);
+        return true;
+    }
+
+    bool SceneSerializer::deserializeFromMemory(const std::uint8_t* bytes, std::size_t size,
+                                                IScriptInteractorFrom::Ptr scriptingEngine) {
+        std::uint32_t magic = 0;
+        if(size >= sizeof(magic))
+            std::memcpy(&magic, bytes, sizeof(magic));
+        if(magic == SceneBinaryFormat::magic) {
+            SceneData sceneData;
+            if(!SceneBinaryFormat{}.loadFromMemory(bytes, size, sceneData))
+                return false;
+            return deserializeData(sceneData, scriptingEngine);
+        }
+
+        YAML::Node data;
+        try {
+            data = YAML::Load(std::string{reinterpret_cast<const char*>(bytes), size});
+        }
+        catch (...) {
+            RB_EDITOR_CRITICAL("YAML Exception");
+            return false;
+        }
+        return deserializeYaml(data, scriptingEngine);
+    }
+
+    bool SceneSerializer::deserializeYaml(const YAML::Node& data, IScriptInteractorFrom::Ptr scriptingEngine) {
         if(!data["Scene"]) {
             m_error = SceneSerializerError::NotSceneTag;
             return false;
         }
 
-        std::string sceneName = data["Scene"].as<std::string>();
-        auto entites = data["Entities"];
-        if(!entites)
+        SceneData sceneData;
+        if(!SceneYAMLFormat{}.loadFromNode(data, sceneData))
             return false;
+        return deserializeData(sceneData, scriptingEngine);
+    }
 
+    bool SceneSerializer::serializeBinary(const std::string& path, const std::string& sceneName,
+                                          IScriptInteractorFrom::Ptr scriptingEngine) {
+        SceneData sceneData;
+        sceneData.name = sceneData.addString(sceneName);
+        for(auto& entity: m_scene -> getEntities())
+            collectEntity(entity, sceneData, scriptingEngine);
 
-        auto entitySerializer = getSerializer<EntityYAMLSerializer>();
-        std::vector<ChildInfo> children;
+        if(!SceneBinaryFormat{}.saveToFile(path, sceneData)) {
+            m_error = SceneSerializerError::NoFileOpen;
+            return false;
+        }
+        return true;
+    }
 
-        for(const auto& entity: entites) {
-            bool addToScene = true;
+    bool SceneSerializer::deserializeData(const SceneData& sceneData, IScriptInteractorFrom::Ptr scriptingEngine) {
+        std::vector<SceneEntity> entities;
+        entities.reserve(sceneData.entities.size());
+        for(std::size_t i = 0; i < sceneData.entities.size(); ++i)
+            entities.emplace_back(m_scene -> createEntity());
+        applySceneData(sceneData, entities, scriptingEngine);
 
-            auto deserializeEntity = m_scene -> createEntity();
-            entitySerializer -> deserialize(entity, deserializeEntity, addToScene, children, scriptingEngine);
+        std::vector<ChildInfo> children;
+        for(std::size_t i = 0; i < entities.size(); ++i) {
+            auto childInfo = getChildInfo(sceneData, i, entities[i]);
+            if(!childInfo.isChild)
+                m_scene -> addAssociatedEntity(std::move(entities[i]));
 
-            if(addToScene)
-                m_scene -> addAssociatedEntity(std::move(deserializeEntity));
+            if(!childInfo.isEmpty())
+                children.emplace_back(std::move(childInfo));
         }
 
+        resolveChildren(children);
+        return true;
+    }
+
+    void SceneSerializer::resolveChildren(std::vector<ChildInfo>& children) {
         /// TODO(a.raag): Save and Read Scene as Tree
+        std::unordered_map<UUID, std::vector<std::size_t>> childrenByParent;
+        std::unordered_map<UUID, std::size_t> childrenBySelf;
+        childrenByParent.reserve(children.size());
+        childrenBySelf.reserve(children.size());
+        for(std::size_t i = 0; i < children.size(); ++i) {
+            if(!children[i].isChild)
+                continue;
+            childrenByParent[children[i].parentUUID].push_back(i);
+            childrenBySelf.emplace(children[i].self.getUUID(), i);
+        }
+
+        auto addChildrenOf = [&children, &childrenByParent](SceneEntity& self, const UUID& parentUUID) {
+            auto found = childrenByParent.find(parentUUID);
+            if(found == childrenByParent.end())
+                return;
+            for(auto index: found -> second)
+                self.addChild(children[index].self);
+        };
+
         for(auto& child: children) {
             if(child.isChild) {
-                auto selfUUID = child.self.getUUID();
-                if(child.hasChildren()) {
-                    for(auto& item: children) {
-                        if(item.isChild && item.parentUUID == selfUUID)
-                            child.self.addChild(item.self);
-                    }
-                }
+                if(child.hasChildren())
+                    addChildrenOf(child.self, child.self.getUUID());
 
                 auto parent = child.self.getComponent<TransformComponent>().getParent();
                 if(!parent) {
@@ -149,10 +275,9 @@ namespace editor {
                     if(found)
                         found.addChild(child.self);
                     else {
-                        for(auto& item: children) {
-                            if(item.isChild && item.self.getUUID() == child.parentUUID)
-                                item.self.addChild(child.self);
-                        }
+                        auto foundChild = childrenBySelf.find(child.parentUUID);
+                        if(foundChild != childrenBySelf.end())
+                            children[foundChild -> second].self.addChild(child.self);
                     }
                 }
             }
@@ -160,18 +285,11 @@ namespace editor {
                 if(child.hasChildren()) {
                     auto& parentUUID = child.childPair.first;
                     auto self = m_scene -> getEntity(parentUUID);
-
-                    for(auto& item: children) {
-                        if(item.isChild && item.parentUUID == parentUUID)
-                            self.addChild(item.self);
-                    }
+                    addChildrenOf(self, parentUUID);
                 }
             }
 
         }
-
-
-        return true;
     }
 
     SceneSerializerError SceneSerializer::getError() const {
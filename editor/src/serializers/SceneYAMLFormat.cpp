@@ -0,0 +1,525 @@
+/*********************************************************************
+(c) Alex Raag 2024
+https://github.com/Enziferum
+robot2D - Zlib license.
+This software is provided 'as-is', without any express or
+implied warranty. In no event will the authors be held
+liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions:
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any
+source distribution.
+*********************************************************************/
+
+
+#include <array>
+#include <cstring>
+#include <type_traits>
+#include <fstream>
+#include <yaml-cpp/yaml.h>
+
+#include <robot2D/Util/Logger.hpp>
+#include <editor/serializers/SceneYAMLFormat.hpp>
+#include <editor/serializers/SceneBinaryFormat.hpp>
+
+namespace editor {
+    namespace {
+        /// DrawableComponent's depth when YAML doesn't store it.
+        constexpr std::int32_t defaultDepth = 1;
+        constexpr std::int32_t noRecord = -1;
+
+        robot2D::vec2f readVec2(const YAML::Node& node) {
+            if(!node.IsSequence() || node.size() != 2)
+                return {};
+            return { node[0].as<float>(), node[1].as<float>() };
+        }
+
+        robot2D::Color readColor(const YAML::Node& node) {
+            if(!node.IsSequence() || node.size() != 4)
+                return {};
+            return { node[0].as<float>(), node[1].as<float>(), node[2].as<float>(), node[3].as<float>() };
+        }
+
+        void writeVec2(YAML::Emitter& out, const robot2D::vec2f& value) {
+            out << YAML::Flow << YAML::BeginSeq << value.x << value.y << YAML::EndSeq;
+        }
+
+        void writeColor(YAML::Emitter& out, const robot2D::Color& value) {
+            out << YAML::Flow << YAML::BeginSeq << value.red << value.green
+                << value.blue << value.alpha << YAML::EndSeq;
+        }
+
+        std::string_view bodyTypeToString(std::uint32_t bodyType) {
+            switch(bodyType) {
+                case 1: return "Dynamic";
+                case 2: return "Kinematic";
+                default: return "Static";
+            }
+        }
+
+        std::uint32_t bodyTypeFromString(const std::string& bodyType) {
+            if(bodyType == "Dynamic") return 1;
+            if(bodyType == "Kinematic") return 2;
+            return 0;
+        }
+
+        template<typename T>
+        struct FieldTag {
+            using Type = T;
+        };
+
+        /// Calls func with FieldTag of C++ type which EntityYAMLSerializer uses for field type.
+        template<typename Func>
+        bool visitFieldType(std::string_view type, Func&& func) {
+            if(type == "Float")     { func(FieldTag<float>{}); return true; }
+            if(type == "Double")    { func(FieldTag<double>{}); return true; }
+            if(type == "Bool")      { func(FieldTag<bool>{}); return true; }
+            if(type == "Char")      { func(FieldTag<char>{}); return true; }
+            if(type == "Byte")      { func(FieldTag<std::int8_t>{}); return true; }
+            if(type == "Short")     { func(FieldTag<std::int16_t>{}); return true; }
+            if(type == "Int")       { func(FieldTag<std::int32_t>{}); return true; }
+            if(type == "Long")      { func(FieldTag<std::int64_t>{}); return true; }
+            if(type == "UByte")     { func(FieldTag<std::uint8_t>{}); return true; }
+            if(type == "UShort")    { func(FieldTag<std::uint16_t>{}); return true; }
+            if(type == "UInt")      { func(FieldTag<std::uint32_t>{}); return true; }
+            if(type == "ULong")     { func(FieldTag<std::uint64_t>{}); return true; }
+            if(type == "Vector2")   { func(FieldTag<robot2D::vec2f>{}); return true; }
+            if(type == "Transform") { func(FieldTag<std::uint64_t>{}); return true; }
+            return false;
+        }
+
+        /// Field bytes are same as in script field buffer, vec2f is two floats there.
+        template<typename T>
+        std::uint64_t packField(const T& value) {
+            static_assert(sizeof(T) <= sizeof(std::uint64_t) && std::is_trivially_copyable_v<T>);
+            std::uint64_t data = 0;
+            std::memcpy(&data, &value, sizeof(T));
+            return data;
+        }
+
+        template<>
+        std::uint64_t packField<robot2D::vec2f>(const robot2D::vec2f& value) {
+            const std::array<float, 2> components{ value.x, value.y };
+            return packField(components);
+        }
+
+        template<typename T>
+        T unpackField(std::uint64_t data) {
+            static_assert(sizeof(T) <= sizeof(std::uint64_t) && std::is_trivially_copyable_v<T>);
+            T value{};
+            std::memcpy(&value, &data, sizeof(T));
+            return value;
+        }
+
+        template<>
+        robot2D::vec2f unpackField<robot2D::vec2f>(std::uint64_t data) {
+            const auto components = unpackField<std::array<float, 2>>(data);
+            return { components[0], components[1] };
+        }
+
+        template<typename T>
+        T readField(const YAML::Node& node) { return node.as<T>(); }
+
+        template<>
+        robot2D::vec2f readField<robot2D::vec2f>(const YAML::Node& node) { return readVec2(node); }
+
+        template<>
+        robot2D::Color readField<robot2D::Color>(const YAML::Node& node) { return readColor(node); }
+
+        template<typename T>
+        void writeField(YAML::Emitter& out, const T& value) { out << value; }
+
+        template<>
+        void writeField<robot2D::vec2f>(YAML::Emitter& out, const robot2D::vec2f& value) { writeVec2(out, value); }
+
+        template<>
+        void writeField<robot2D::Color>(YAML::Emitter& out, const robot2D::Color& value) { writeColor(out, value); }
+
+        /// Index of record of every entity in table, noRecord when entity doesn't have component.
+        template<typename Table>
+        std::vector<std::int32_t> indexByEntity(const Table& table, std::size_t entitiesCount) {
+            std::vector<std::int32_t> index(entitiesCount, noRecord);
+            for(std::size_t i = 0; i < table.size(); ++i)
+                index[table[i].entity] = static_cast<std::int32_t>(i);
+            return index;
+        }
+
+        bool readEntity(const YAML::Node& node, SceneData& sceneData) {
+            if(!node["Entity"] || !node["TagComponent"])
+                return false;
+
+            const auto entityIndex = static_cast<std::uint32_t>(sceneData.entities.size());
+            auto& entity = sceneData.entities.emplace_back();
+            entity.uuid = node["Entity"].as<std::uint64_t>();
+            entity.parentUUID = 0;
+            entity.tag = sceneData.addString(node["TagComponent"]["Tag"].as<std::string>());
+            entity.flags = 0;
+            entity.firstChild = static_cast<std::uint32_t>(sceneData.childIDs.size());
+            entity.childrenCount = 0;
+
+            if(auto camera = node["CameraComponent"]) {
+                sceneData.cameras.push_back({ entityIndex, camera["isPrimary"].as<bool>() ? 1U : 0U,
+                                              camera["OrthoSize"].as<float>(),
+                                              readVec2(camera["Size"]), readVec2(camera["Position"]) });
+            }
+
+            if(auto transform = node["TransformComponent"]) {
+                sceneData.transforms.push_back({ entityIndex, readVec2(transform["Position"]),
+                                                 readVec2(transform["Size"]),
+                                                 transform["Origin"] ? readVec2(transform["Origin"]) : robot2D::vec2f{},
+                                                 transform["Rotation"].as<float>() });
+                if(transform["HasChildren"]) {
+                    for(const auto& childID: transform["ChildIDs"])
+                        sceneData.childIDs.emplace_back(childID.as<std::uint64_t>());
+                    entity.childrenCount = static_cast<std::uint32_t>(sceneData.childIDs.size()) - entity.firstChild;
+                }
+                if(transform["isChild"]) {
+                    entity.flags |= SceneData::IsChild;
+                    entity.parentUUID = transform["ParentID"].as<std::uint64_t>();
+                }
+            }
+
+            if(auto sprite = node["SpriteComponent"]) {
+                sceneData.drawables.push_back({ entityIndex, readColor(sprite["Color"]),
+                                                sprite["TexturePath"] ?
+                                                    sceneData.addString(sprite["TexturePath"].as<std::string>())
+                                                    : SceneData::noString,
+                                                sprite["zDepth"] ? sprite["zDepth"].as<std::int32_t>() : defaultDepth });
+            }
+
+            if(auto text = node["TextComponent"]) {
+                sceneData.texts.push_back({ entityIndex, sceneData.addString(text["Text"].as<std::string>()),
+                                            text["FontPath"] ?
+                                                sceneData.addString(text["FontPath"].as<std::string>())
+                                                : SceneData::noString });
+            }
+
+            if(auto script = node["ScriptComponent"]) {
+                SceneData::Script record{ entityIndex, sceneData.addString(script["ClassName"].as<std::string>()),
+                                          static_cast<std::uint32_t>(sceneData.scriptFields.size()), 0 };
+                if(auto fields = script["ScriptFields"]) {
+                    for(const auto& field: fields) {
+                        auto type = field["Type"].as<std::string>();
+                        std::uint64_t data = 0;
+                        if(auto value = field["Data"]) {
+                            visitFieldType(type, [&data, &value](auto tag) {
+                                using Type = typename decltype(tag)::Type;
+                                data = packField(readField<Type>(value));
+                            });
+                        }
+                        sceneData.scriptFields.push_back({ sceneData.addString(field["Name"].as<std::string>()),
+                                                           sceneData.addString(type), data });
+                    }
+                }
+                record.fieldsCount = static_cast<std::uint32_t>(sceneData.scriptFields.size()) - record.firstField;
+                sceneData.scripts.push_back(record);
+            }
+
+            if(auto rigidbody = node["Rigidbody2DComponent"]) {
+                sceneData.physics.push_back({ entityIndex,
+                                              bodyTypeFromString(rigidbody["BodyType"].as<std::string>()),
+                                              rigidbody["FixedRotation"].as<bool>() ? 1U : 0U });
+            }
+
+            if(auto collider = node["BoxCollider2DComponent"]) {
+                sceneData.colliders.push_back({ entityIndex, readVec2(collider["Offset"]), readVec2(collider["Size"]),
+                                                collider["Density"].as<float>(), collider["Friction"].as<float>(),
+                                                collider["Restitution"].as<float>(),
+                                                collider["RestitutionThreshold"].as<float>() });
+            }
+
+            if(auto prefab = node["PrefabComponent"])
+                sceneData.prefabs.push_back({ entityIndex, 0, prefab["UUID"].as<std::uint64_t>() });
+
+            if(auto animation = node["AnimationComponent"]) {
+                SceneData::Animation record{ entityIndex, static_cast<std::uint32_t>(sceneData.animationPaths.size()), 0 };
+                for(const auto& path: animation["Animations"])
+                    sceneData.animationPaths.emplace_back(sceneData.addString(path.as<std::string>()));
+                record.pathsCount = static_cast<std::uint32_t>(sceneData.animationPaths.size()) - record.firstPath;
+                sceneData.animations.push_back(record);
+            }
+
+            if(auto button = node["ButtonComponent"]) {
+                sceneData.buttons.push_back({ entityIndex,
+                                              button["MethodName"] ?
+                                                  sceneData.addString(button["MethodName"].as<std::string>())
+                                                  : SceneData::noString,
+                                              button["ScriptUUID"].as<std::uint64_t>() });
+            }
+
+            if(auto emitter = node["ParticleEmitterComponent"]) {
+                auto& record = sceneData.particleEmitters.emplace_back();
+                record.entity = entityIndex;
+#define READ_EMITTER_FIELD(name, member, Type) \
+                record.member = static_cast<decltype(record.member)>(readField<Type>(emitter[name]));
+                PARTICLE_EMITTER_FIELDS(READ_EMITTER_FIELD)
+#undef READ_EMITTER_FIELD
+            }
+
+            return true;
+        }
+    }
+
+    bool SceneYAMLFormat::loadFromFile(const std::string& path, SceneData& sceneData) {
+        YAML::Node root;
+        try {
+            root = YAML::LoadFile(path);
+        }
+        catch(const YAML::Exception& exception) {
+            RB_EDITOR_ERROR("SceneYAMLFormat: can't parse {0}. Reason: {1}", path, exception.what());
+            return false;
+        }
+        return loadFromNode(root, sceneData);
+    }
+
+    bool SceneYAMLFormat::loadFromNode(const YAML::Node& root, SceneData& sceneData) {
+        sceneData.clear();
+        if(!root["Scene"] || !root["Entities"])
+            return false;
+
+        try {
+            sceneData.name = sceneData.addString(root["Scene"].as<std::string>());
+            const auto& entities = root["Entities"];
+            sceneData.entities.reserve(entities.size());
+            for(const auto& entity: entities) {
+                if(!readEntity(entity, sceneData)) {
+                    RB_EDITOR_WARN("SceneYAMLFormat: skip entity without id or tag");
+                }
+            }
+        }
+        catch(const YAML::Exception& exception) {
+            RB_EDITOR_ERROR("SceneYAMLFormat: bad scene layout. Reason: {0}", exception.what());
+            sceneData.clear();
+            return false;
+        }
+        return true;
+    }
+
+    bool SceneYAMLFormat::loadEntity(const YAML::Node& node, SceneData& sceneData) {
+        return readEntity(node, sceneData);
+    }
+
+    bool SceneYAMLFormat::saveToFile(const std::string& path, const SceneData& sceneData) {
+        YAML::Emitter out;
+        saveToEmitter(out, sceneData);
+
+        std::ofstream file{path};
+        if(!file.is_open()) {
+            RB_EDITOR_ERROR("SceneYAMLFormat: can't open file {0}", path);
+            return false;
+        }
+        file << out.c_str();
+        return static_cast<bool>(file);
+    }
+
+    void SceneYAMLFormat::saveToEmitter(YAML::Emitter& out, const SceneData& sceneData) {
+        out << YAML::BeginMap;
+        out << YAML::Key << "Scene" << YAML::Value << std::string{sceneData.getString(sceneData.name)};
+        out << YAML::Key << "Entities" << YAML::Value << YAML::BeginSeq;
+        saveEntities(out, sceneData);
+        out << YAML::EndSeq;
+        out << YAML::EndMap;
+    }
+
+    void SceneYAMLFormat::saveEntities(YAML::Emitter& out, const SceneData& sceneData) {
+        const auto entitiesCount = sceneData.entities.size();
+        const auto cameras = indexByEntity(sceneData.cameras, entitiesCount);
+        const auto transforms = indexByEntity(sceneData.transforms, entitiesCount);
+        const auto drawables = indexByEntity(sceneData.drawables, entitiesCount);
+        const auto scripts = indexByEntity(sceneData.scripts, entitiesCount);
+        const auto physics = indexByEntity(sceneData.physics, entitiesCount);
+        const auto colliders = indexByEntity(sceneData.colliders, entitiesCount);
+        const auto texts = indexByEntity(sceneData.texts, entitiesCount);
+        const auto prefabs = indexByEntity(sceneData.prefabs, entitiesCount);
+        const auto animations = indexByEntity(sceneData.animations, entitiesCount);
+        const auto buttons = indexByEntity(sceneData.buttons, entitiesCount);
+        const auto particleEmitters = indexByEntity(sceneData.particleEmitters, entitiesCount);
+        auto getString = [&sceneData](SceneData::StringID id) { return std::string{sceneData.getString(id)}; };
+
+        for(std::size_t i = 0; i < entitiesCount; ++i) {
+            const auto& entity = sceneData.entities[i];
+            out << YAML::BeginMap;
+            out << YAML::Key << "Entity" << YAML::Value << entity.uuid;
+
+            out << YAML::Key << "TagComponent";
+            out << YAML::BeginMap;
+            out << YAML::Key << "Tag" << YAML::Value << getString(entity.tag);
+            out << YAML::EndMap;
+
+            if(cameras[i] != noRecord) {
+                const auto& camera = sceneData.cameras[cameras[i]];
+                out << YAML::Key << "CameraComponent";
+                out << YAML::BeginMap;
+                out << YAML::Key << "isPrimary" << YAML::Value << (camera.isPrimary != 0);
+                out << YAML::Key << "OrthoSize" << YAML::Value << camera.orthoSize;
+                out << YAML::Key << "Size" << YAML::Value;
+                writeVec2(out, camera.size);
+                out << YAML::Key << "Position" << YAML::Value;
+                writeVec2(out, camera.position);
+                out << YAML::EndMap;
+            }
+
+            if(transforms[i] != noRecord) {
+                const auto& transform = sceneData.transforms[transforms[i]];
+                out << YAML::Key << "TransformComponent";
+                out << YAML::BeginMap;
+                out << YAML::Key << "Position" << YAML::Value;
+                writeVec2(out, transform.position);
+                out << YAML::Key << "Size" << YAML::Value;
+                writeVec2(out, transform.size);
+                out << YAML::Key << "Rotation" << YAML::Value << transform.rotation;
+                out << YAML::Key << "Origin" << YAML::Value;
+                writeVec2(out, transform.origin);
+                if(entity.childrenCount > 0) {
+                    out << YAML::Key << "HasChildren" << YAML::Value << true;
+                    out << YAML::Key << "ChildIDs" << YAML::Value << YAML::BeginSeq;
+                    for(std::uint32_t child = 0; child < entity.childrenCount; ++child)
+                        out << sceneData.childIDs[entity.firstChild + child];
+                    out << YAML::EndSeq;
+                }
+                if(entity.flags & SceneData::IsChild) {
+                    out << YAML::Key << "isChild" << YAML::Value << true;
+                    out << YAML::Key << "ParentID" << YAML::Value << entity.parentUUID;
+                }
+                out << YAML::EndMap;
+            }
+
+            if(drawables[i] != noRecord) {
+                const auto& drawable = sceneData.drawables[drawables[i]];
+                out << YAML::Key << "SpriteComponent";
+                out << YAML::BeginMap;
+                out << YAML::Key << "Color" << YAML::Value;
+                writeColor(out, drawable.color);
+                out << YAML::Key << "TexturePath" << YAML::Value << getString(drawable.texturePath);
+                out << YAML::Key << "zDepth" << YAML::Value << drawable.depth;
+                out << YAML::EndMap;
+            }
+
+            if(scripts[i] != noRecord) {
+                const auto& script = sceneData.scripts[scripts[i]];
+                out << YAML::Key << "ScriptComponent";
+                out << YAML::BeginMap;
+                out << YAML::Key << "ClassName" << YAML::Value << getString(script.className);
+                if(script.fieldsCount > 0) {
+                    out << YAML::Key << "ScriptFields" << YAML::Value << YAML::BeginSeq;
+                    for(std::uint32_t f = 0; f < script.fieldsCount; ++f) {
+                        const auto& field = sceneData.scriptFields[script.firstField + f];
+                        const auto type = sceneData.getString(field.type);
+                        out << YAML::BeginMap;
+                        out << YAML::Key << "Name" << YAML::Value << getString(field.name);
+                        out << YAML::Key << "Type" << YAML::Value << std::string{type};
+                        out << YAML::Key << "Data" << YAML::Value;
+                        if(!visitFieldType(type, [&out, &field](auto tag) {
+                            using Type = typename decltype(tag)::Type;
+                            writeField(out, unpackField<Type>(field.data));
+                        }))
+                            out << YAML::Null;
+                        out << YAML::EndMap;
+                    }
+                    out << YAML::EndSeq;
+                }
+                out << YAML::EndMap;
+            }
+
+            if(physics[i] != noRecord) {
+                const auto& body = sceneData.physics[physics[i]];
+                out << YAML::Key << "Rigidbody2DComponent";
+                out << YAML::BeginMap;
+                out << YAML::Key << "BodyType" << YAML::Value << std::string{bodyTypeToString(body.bodyType)};
+                out << YAML::Key << "FixedRotation" << YAML::Value << (body.fixedRotation != 0);
+                out << YAML::EndMap;
+            }
+
+            if(colliders[i] != noRecord) {
+                const auto& collider = sceneData.colliders[colliders[i]];
+                out << YAML::Key << "BoxCollider2DComponent";
+                out << YAML::BeginMap;
+                out << YAML::Key << "Offset" << YAML::Value;
+                writeVec2(out, collider.offset);
+                out << YAML::Key << "Size" << YAML::Value;
+                writeVec2(out, collider.size);
+                out << YAML::Key << "Density" << YAML::Value << collider.density;
+                out << YAML::Key << "Friction" << YAML::Value << collider.friction;
+                out << YAML::Key << "Restitution" << YAML::Value << collider.restitution;
+                out << YAML::Key << "RestitutionThreshold" << YAML::Value << collider.restitutionThreshold;
+                out << YAML::EndMap;
+            }
+
+            if(texts[i] != noRecord) {
+                const auto& text = sceneData.texts[texts[i]];
+                out << YAML::Key << "TextComponent";
+                out << YAML::BeginMap;
+                out << YAML::Key << "Text" << YAML::Value << getString(text.text);
+                if(text.fontPath != SceneData::noString)
+                    out << YAML::Key << "FontPath" << YAML::Value << getString(text.fontPath);
+                out << YAML::EndMap;
+            }
+
+            if(prefabs[i] != noRecord) {
+                out << YAML::Key << "PrefabComponent";
+                out << YAML::BeginMap;
+                out << YAML::Key << "UUID" << YAML::Value << sceneData.prefabs[prefabs[i]].prefabUUID;
+                out << YAML::EndMap;
+            }
+
+            if(animations[i] != noRecord) {
+                const auto& animation = sceneData.animations[animations[i]];
+                out << YAML::Key << "AnimationComponent";
+                out << YAML::BeginMap;
+                out << YAML::Key << "Animations" << YAML::Value << YAML::BeginSeq;
+                for(std::uint32_t p = 0; p < animation.pathsCount; ++p)
+                    out << getString(sceneData.animationPaths[animation.firstPath + p]);
+                out << YAML::EndSeq;
+                out << YAML::EndMap;
+            }
+
+            if(buttons[i] != noRecord) {
+                const auto& button = sceneData.buttons[buttons[i]];
+                out << YAML::Key << "ButtonComponent";
+                out << YAML::BeginMap;
+                out << YAML::Key << "ScriptUUID" << YAML::Value << button.scriptUUID;
+                if(button.methodName != SceneData::noString)
+                    out << YAML::Key << "MethodName" << YAML::Value << getString(button.methodName);
+                out << YAML::EndMap;
+            }
+
+            if(particleEmitters[i] != noRecord) {
+                const auto& emitter = sceneData.particleEmitters[particleEmitters[i]];
+                out << YAML::Key << "ParticleEmitterComponent";
+                out << YAML::BeginMap;
+#define WRITE_EMITTER_FIELD(name, member, Type)          \
+                out << YAML::Key << name << YAML::Value; \
+                writeField<Type>(out, static_cast<Type>(emitter.member));
+                PARTICLE_EMITTER_FIELDS(WRITE_EMITTER_FIELD)
+#undef WRITE_EMITTER_FIELD
+                out << YAML::EndMap;
+            }
+
+            out << YAML::EndMap;
+        }
+    }
+
+    bool convertScene(const std::string& sourcePath, const std::string& targetPath, SceneFormat targetFormat) {
+        SceneData sceneData;
+        const bool isBinary = SceneBinaryFormat::isBinaryScene(sourcePath);
+        const bool loaded = isBinary ? SceneBinaryFormat{}.loadFromFile(sourcePath, sceneData)
+                                     : SceneYAMLFormat{}.loadFromFile(sourcePath, sceneData);
+        if(!loaded) {
+            RB_EDITOR_ERROR("convertScene: can't load {0}", sourcePath);
+            return false;
+        }
+
+        if(targetFormat == SceneFormat::Binary)
+            return SceneBinaryFormat{}.saveToFile(targetPath, sceneData);
+        return SceneYAMLFormat{}.saveToFile(targetPath, sceneData);
+    }
+
+} // namespace editor
@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <editor/QuadTree.hpp>
+
+namespace {
+    using Tree = editor::QuadTree<int>;
+
+    constexpr float areaSize = 10000.F;
+
+    /// Items the way tree should see them, brute force answers are taken from here.
+    struct Tracked {
+        Tree::ItemID itemID{Tree::invalidItem};
+        robot2D::FloatRect rect;
+        bool alive{false};
+    };
+
+    std::vector<int> sorted(std::vector<int> values) {
+        std::sort(values.begin(), values.end());
+        return values;
+    }
+
+    std::vector<int> search(const Tree& tree, const robot2D::FloatRect& rect) {
+        std::vector<int> result;
+        tree.search(rect, result);
+        return sorted(std::move(result));
+    }
+
+    std::vector<int> search(const Tree& tree, const robot2D::vec2f& point) {
+        std::vector<int> result;
+        tree.search(point, result);
+        return sorted(std::move(result));
+    }
+
+    std::vector<int> bruteForce(const std::vector<Tracked>& items, const robot2D::FloatRect& rect) {
+        std::vector<int> result;
+        for(std::size_t it = 0; it < items.size(); ++it) {
+            if(items[it].alive && rect.intersects(items[it].rect))
+                result.push_back(static_cast<int>(it));
+        }
+        return result;
+    }
+
+    std::vector<int> bruteForce(const std::vector<Tracked>& items, const robot2D::vec2f& point) {
+        return bruteForce(items, robot2D::FloatRect{point.x, point.y, 1, 1});
+    }
+
+    class QuadTreeTest: public ::testing::Test {
+    protected:
+        void SetUp() override {
+            m_tree.resize({0, 0, areaSize, areaSize});
+        }
+
+        Tree m_tree;
+    };
+}
+
+TEST_F(QuadTreeTest, InsertAndSearch) {
+    const auto first = m_tree.insert(1, {100, 100, 50, 50});
+    const auto second = m_tree.insert(2, {5000, 5000, 10, 10});
+    /// bigger than any child, stays in root
+    const auto third = m_tree.insert(3, {0, 0, 9000, 9000});
+    /// out of area, root keeps it too
+    const auto fourth = m_tree.insert(4, {-500, -500, 20, 20});
+
+    EXPECT_EQ(m_tree.size(), 4u);
+    EXPECT_EQ(m_tree.getValue(first), 1);
+    EXPECT_EQ(m_tree.getValue(second), 2);
+    EXPECT_EQ(m_tree.getValue(third), 3);
+    EXPECT_EQ(m_tree.getValue(fourth), 4);
+
+    EXPECT_EQ(search(m_tree, robot2D::FloatRect{90, 90, 20, 20}), (std::vector<int>{1, 3}));
+    EXPECT_EQ(search(m_tree, robot2D::FloatRect{9500, 9500, 100, 100}), (std::vector<int>{}));
+    EXPECT_EQ(search(m_tree, robot2D::FloatRect{-1000, -1000, 600, 600}), (std::vector<int>{4}));
+    EXPECT_EQ(search(m_tree, robot2D::FloatRect{0, 0, areaSize, areaSize}), (std::vector<int>{1, 2, 3}));
+    EXPECT_EQ(search(m_tree, robot2D::vec2f{5005, 5005}), (std::vector<int>{2, 3}));
+}
+
+TEST_F(QuadTreeTest, RemoveFreesItemForReuse) {
+    const auto first = m_tree.insert(1, {100, 100, 50, 50});
+    m_tree.insert(2, {120, 120, 50, 50});
+
+    EXPECT_TRUE(m_tree.remove(first));
+    EXPECT_FALSE(m_tree.remove(first));
+    EXPECT_FALSE(m_tree.remove(Tree::invalidItem));
+    EXPECT_EQ(m_tree.size(), 1u);
+    EXPECT_EQ(search(m_tree, robot2D::FloatRect{100, 100, 100, 100}), (std::vector<int>{2}));
+
+    const auto reused = m_tree.insert(3, {7000, 7000, 5, 5});
+    EXPECT_EQ(reused, first);
+    EXPECT_EQ(m_tree.getValue(reused), 3);
+    EXPECT_EQ(m_tree.size(), 2u);
+
+    m_tree.clear();
+    EXPECT_TRUE(m_tree.empty());
+    EXPECT_EQ(search(m_tree, robot2D::FloatRect{0, 0, areaSize, areaSize}), (std::vector<int>{}));
+}
+
+TEST_F(QuadTreeTest, RelocateMovesItem) {
+    const auto moving = m_tree.insert(1, {100, 100, 20, 20});
+    m_tree.insert(2, {110, 110, 20, 20});
+
+    /// small move stays in same node, only its rect changes
+    m_tree.relocate(moving, {102, 102, 20, 20});
+    EXPECT_EQ(search(m_tree, robot2D::vec2f{100, 100}), (std::vector<int>{}));
+    EXPECT_EQ(search(m_tree, robot2D::vec2f{103, 103}), (std::vector<int>{1}));
+
+    m_tree.relocate(moving, {8000, 3000, 20, 20});
+    EXPECT_EQ(search(m_tree, robot2D::FloatRect{90, 90, 50, 50}), (std::vector<int>{2}));
+    EXPECT_EQ(search(m_tree, robot2D::FloatRect{7990, 2990, 50, 50}), (std::vector<int>{1}));
+    EXPECT_EQ(m_tree.size(), 2u);
+
+    /// growing over child's size moves item up
+    m_tree.relocate(moving, {0, 0, 8000, 8000});
+    EXPECT_EQ(search(m_tree, robot2D::vec2f{4000, 4000}), (std::vector<int>{1}));
+
+    /// removed item isn't relocated back into tree
+    m_tree.remove(moving);
+    m_tree.relocate(moving, {100, 100, 20, 20});
+    EXPECT_EQ(search(m_tree, robot2D::FloatRect{0, 0, areaSize, areaSize}), (std::vector<int>{2}));
+}
+
+TEST_F(QuadTreeTest, RandomRelocatesMatchBruteForce) {
+    std::mt19937 generator{7};
+    /// few items lie partly out of area
+    std::uniform_real_distribution<float> position{-200.F, areaSize + 200.F};
+    std::uniform_real_distribution<float> size{1.F, 400.F};
+    std::uniform_real_distribution<float> step{-300.F, 300.F};
+    std::uniform_real_distribution<float> querySize{1.F, 2500.F};
+    std::uniform_int_distribution<int> action{0, 9};
+
+    auto randomRect = [&]() {
+        return robot2D::FloatRect{position(generator), position(generator), size(generator), size(generator)};
+    };
+
+    constexpr int itemsCount = 3000;
+    std::vector<Tracked> items(itemsCount);
+    for(int it = 0; it < itemsCount; ++it) {
+        items[it].rect = randomRect();
+        items[it].itemID = m_tree.insert(it, items[it].rect);
+        items[it].alive = true;
+    }
+
+    for(int round = 0; round < 20; ++round) {
+        for(auto& item: items) {
+            const int value = static_cast<int>(&item - items.data());
+            const int next = action(generator);
+            if(item.alive && next == 0) {
+                ASSERT_TRUE(m_tree.remove(item.itemID));
+                item.alive = false;
+            }
+            else if(!item.alive && next < 5) {
+                item.rect = randomRect();
+                item.itemID = m_tree.insert(value, item.rect);
+                item.alive = true;
+            }
+            else if(item.alive) {
+                /// mostly short moves inside same node, sometimes jumps and resizes
+                if(next == 9)
+                    item.rect = randomRect();
+                else {
+                    item.rect.lx += step(generator);
+                    item.rect.ly += step(generator);
+                }
+                m_tree.relocate(item.itemID, item.rect);
+            }
+        }
+
+        const auto aliveCount = std::count_if(items.begin(), items.end(),
+                                              [](const Tracked& item) { return item.alive; });
+        ASSERT_EQ(m_tree.size(), static_cast<std::size_t>(aliveCount));
+
+        for(int query = 0; query < 50; ++query) {
+            const robot2D::FloatRect rect{position(generator), position(generator),
+                                          querySize(generator), querySize(generator)};
+            ASSERT_EQ(search(m_tree, rect), bruteForce(items, rect)) << "round " << round;
+
+            const robot2D::vec2f point{position(generator), position(generator)};
+            ASSERT_EQ(search(m_tree, point), bruteForce(items, point)) << "round " << round;
+        }
+        /// whole area query takes subtrees without testing their rects
+        const robot2D::FloatRect everything{-1000, -1000, areaSize + 2000, areaSize + 2000};
+        ASSERT_EQ(search(m_tree, everything), bruteForce(items, everything));
+    }
+}
@@ -0,0 +1,262 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+
+#include <editor/serializers/SceneData.hpp>
+#include <editor/serializers/SceneBinaryFormat.hpp>
+#include <editor/serializers/SceneYAMLFormat.hpp>
+
+namespace {
+    template<typename T>
+    std::uint64_t fieldData(const T& value) {
+        std::uint64_t data = 0;
+        std::memcpy(&data, &value, sizeof(T));
+        return data;
+    }
+
+    void addField(editor::SceneData& sceneData, const char* name, const char* type, std::uint64_t data) {
+        sceneData.scriptFields.push_back({ sceneData.addString(name), sceneData.addString(type), data });
+    }
+
+    /// Parent with one child, every component table has record, values are exact in YAML text.
+    void makeScene(editor::SceneData& sceneData) {
+        sceneData.name = sceneData.addString("RoundTrip");
+
+        editor::SceneData::Entity parent{};
+        parent.uuid = 0x1234567890ABCDEFULL;
+        parent.tag = sceneData.addString("Parent");
+        parent.firstChild = 0;
+        parent.childrenCount = 1;
+        editor::SceneData::Entity child{};
+        child.uuid = 42;
+        child.parentUUID = parent.uuid;
+        child.tag = sceneData.addString("Child");
+        child.flags = editor::SceneData::IsChild;
+        sceneData.entities = { parent, child };
+        sceneData.childIDs = { child.uuid };
+
+        sceneData.transforms.push_back({ 0, { 10.5F, -3.25F }, { 64.F, 32.F }, { 0.5F, 0.5F }, 90.F });
+        sceneData.transforms.push_back({ 1, { 1.F, 2.F }, { 8.F, 8.F }, {}, 0.F });
+        sceneData.cameras.push_back({ 0, 1, 2.5F, { 1280.F, 720.F }, { 4.F, 8.F } });
+        sceneData.drawables.push_back({ 1, robot2D::Color{ 255.F, 128.F, 0.F, 64.F },
+                                        sceneData.addString("assets/textures/hero.png"), 3 });
+        sceneData.texts.push_back({ 0, sceneData.addString("Hello"), sceneData.addString("assets/fonts/arial.ttf") });
+
+        sceneData.scripts.push_back({ 1, sceneData.addString("Game.Player"), 0, 6 });
+        addField(sceneData, "speed", "Float", fieldData(2.75F));
+        addField(sceneData, "scale", "Double", fieldData(0.125));
+        addField(sceneData, "alive", "Bool", fieldData(true));
+        addField(sceneData, "lives", "Int", fieldData(std::int32_t{-7}));
+        addField(sceneData, "direction", "Vector2", fieldData(robot2D::vec2f{ -1.5F, 0.25F }));
+        addField(sceneData, "target", "Transform", fieldData(parent.uuid));
+
+        sceneData.physics.push_back({ 1, 2, 1 });
+        sceneData.colliders.push_back({ 1, { 0.5F, 1.F }, { 2.F, 4.F }, 1.F, 0.5F, 0.25F, 0.5F });
+        sceneData.prefabs.push_back({ 0, 0, 777 });
+        sceneData.animationPaths = { sceneData.addString("assets/animations/run.anim"),
+                                     sceneData.addString("assets/animations/idle.anim") };
+        sceneData.animations.push_back({ 1, 0, 2 });
+        sceneData.buttons.push_back({ 0, sceneData.addString("onClick"), 99 });
+        sceneData.particleEmitters.push_back({ 1, 50.F, 1.5F, 120.F, 90.F, 30.F, { 0.F, -9.5F }, 4.F, 1.F,
+                                               robot2D::Color::White, robot2D::Color{ 255.F, 0.F, 0.F, 0.F },
+                                               512, 2, 1 });
+    }
+
+    void expectColor(const robot2D::Color& left, const robot2D::Color& right) {
+        EXPECT_FLOAT_EQ(left.red, right.red);
+        EXPECT_FLOAT_EQ(left.green, right.green);
+        EXPECT_FLOAT_EQ(left.blue, right.blue);
+        EXPECT_FLOAT_EQ(left.alpha, right.alpha);
+    }
+
+    void expectString(const editor::SceneData& left, editor::SceneData::StringID leftID,
+                      const editor::SceneData& right, editor::SceneData::StringID rightID) {
+        if(leftID == editor::SceneData::noString || rightID == editor::SceneData::noString)
+            EXPECT_EQ(leftID, rightID);
+        else
+            EXPECT_EQ(left.getString(leftID), right.getString(rightID));
+    }
+
+    /// Compares by values, string ids may differ between formats.
+    void expectSameScene(const editor::SceneData& expected, const editor::SceneData& actual) {
+        expectString(expected, expected.name, actual, actual.name);
+
+        ASSERT_EQ(expected.entities.size(), actual.entities.size());
+        for(std::size_t i = 0; i < expected.entities.size(); ++i) {
+            const auto& left = expected.entities[i];
+            const auto& right = actual.entities[i];
+            EXPECT_EQ(left.uuid, right.uuid);
+            EXPECT_EQ(left.parentUUID, right.parentUUID);
+            EXPECT_EQ(left.flags, right.flags);
+            EXPECT_EQ(left.childrenCount, right.childrenCount);
+            expectString(expected, left.tag, actual, right.tag);
+        }
+        EXPECT_EQ(expected.childIDs, actual.childIDs);
+
+        ASSERT_EQ(expected.transforms.size(), actual.transforms.size());
+        for(std::size_t i = 0; i < expected.transforms.size(); ++i) {
+            const auto& left = expected.transforms[i];
+            const auto& right = actual.transforms[i];
+            EXPECT_EQ(left.entity, right.entity);
+            EXPECT_EQ(left.position, right.position);
+            EXPECT_EQ(left.size, right.size);
+            EXPECT_EQ(left.origin, right.origin);
+            EXPECT_FLOAT_EQ(left.rotation, right.rotation);
+        }
+
+        ASSERT_EQ(expected.cameras.size(), actual.cameras.size());
+        for(std::size_t i = 0; i < expected.cameras.size(); ++i) {
+            const auto& left = expected.cameras[i];
+            const auto& right = actual.cameras[i];
+            EXPECT_EQ(left.entity, right.entity);
+            EXPECT_EQ(left.isPrimary, right.isPrimary);
+            EXPECT_FLOAT_EQ(left.orthoSize, right.orthoSize);
+            EXPECT_EQ(left.size, right.size);
+            EXPECT_EQ(left.position, right.position);
+        }
+
+        ASSERT_EQ(expected.drawables.size(), actual.drawables.size());
+        for(std::size_t i = 0; i < expected.drawables.size(); ++i) {
+            const auto& left = expected.drawables[i];
+            const auto& right = actual.drawables[i];
+            EXPECT_EQ(left.entity, right.entity);
+            expectColor(left.color, right.color);
+            expectString(expected, left.texturePath, actual, right.texturePath);
+            EXPECT_EQ(left.depth, right.depth);
+        }
+
+        ASSERT_EQ(expected.texts.size(), actual.texts.size());
+        for(std::size_t i = 0; i < expected.texts.size(); ++i) {
+            EXPECT_EQ(expected.texts[i].entity, actual.texts[i].entity);
+            expectString(expected, expected.texts[i].text, actual, actual.texts[i].text);
+            expectString(expected, expected.texts[i].fontPath, actual, actual.texts[i].fontPath);
+        }
+
+        ASSERT_EQ(expected.scripts.size(), actual.scripts.size());
+        for(std::size_t i = 0; i < expected.scripts.size(); ++i) {
+            EXPECT_EQ(expected.scripts[i].entity, actual.scripts[i].entity);
+            expectString(expected, expected.scripts[i].className, actual, actual.scripts[i].className);
+            EXPECT_EQ(expected.scripts[i].fieldsCount, actual.scripts[i].fieldsCount);
+        }
+        ASSERT_EQ(expected.scriptFields.size(), actual.scriptFields.size());
+        for(std::size_t i = 0; i < expected.scriptFields.size(); ++i) {
+            const auto& left = expected.scriptFields[i];
+            const auto& right = actual.scriptFields[i];
+            expectString(expected, left.name, actual, right.name);
+            expectString(expected, left.type, actual, right.type);
+            EXPECT_EQ(left.data, right.data) << expected.getString(left.name);
+        }
+
+        ASSERT_EQ(expected.physics.size(), actual.physics.size());
+        for(std::size_t i = 0; i < expected.physics.size(); ++i) {
+            EXPECT_EQ(expected.physics[i].entity, actual.physics[i].entity);
+            EXPECT_EQ(expected.physics[i].bodyType, actual.physics[i].bodyType);
+            EXPECT_EQ(expected.physics[i].fixedRotation, actual.physics[i].fixedRotation);
+        }
+
+        ASSERT_EQ(expected.colliders.size(), actual.colliders.size());
+        for(std::size_t i = 0; i < expected.colliders.size(); ++i) {
+            const auto& left = expected.colliders[i];
+            const auto& right = actual.colliders[i];
+            EXPECT_EQ(left.entity, right.entity);
+            EXPECT_EQ(left.offset, right.offset);
+            EXPECT_EQ(left.size, right.size);
+            EXPECT_FLOAT_EQ(left.density, right.density);
+            EXPECT_FLOAT_EQ(left.friction, right.friction);
+            EXPECT_FLOAT_EQ(left.restitution, right.restitution);
+            EXPECT_FLOAT_EQ(left.restitutionThreshold, right.restitutionThreshold);
+        }
+
+        ASSERT_EQ(expected.prefabs.size(), actual.prefabs.size());
+        for(std::size_t i = 0; i < expected.prefabs.size(); ++i) {
+            EXPECT_EQ(expected.prefabs[i].entity, actual.prefabs[i].entity);
+            EXPECT_EQ(expected.prefabs[i].prefabUUID, actual.prefabs[i].prefabUUID);
+        }
+
+        ASSERT_EQ(expected.animations.size(), actual.animations.size());
+        for(std::size_t i = 0; i < expected.animations.size(); ++i) {
+            const auto& left = expected.animations[i];
+            const auto& right = actual.animations[i];
+            EXPECT_EQ(left.entity, right.entity);
+            ASSERT_EQ(left.pathsCount, right.pathsCount);
+            for(std::uint32_t path = 0; path < left.pathsCount; ++path)
+                expectString(expected, expected.animationPaths[left.firstPath + path],
+                             actual, actual.animationPaths[right.firstPath + path]);
+        }
+
+        ASSERT_EQ(expected.buttons.size(), actual.buttons.size());
+        for(std::size_t i = 0; i < expected.buttons.size(); ++i) {
+            EXPECT_EQ(expected.buttons[i].entity, actual.buttons[i].entity);
+            expectString(expected, expected.buttons[i].methodName, actual, actual.buttons[i].methodName);
+            EXPECT_EQ(expected.buttons[i].scriptUUID, actual.buttons[i].scriptUUID);
+        }
+
+        ASSERT_EQ(expected.particleEmitters.size(), actual.particleEmitters.size());
+        for(std::size_t i = 0; i < expected.particleEmitters.size(); ++i) {
+            const auto& left = expected.particleEmitters[i];
+            const auto& right = actual.particleEmitters[i];
+            EXPECT_EQ(left.entity, right.entity);
+            EXPECT_FLOAT_EQ(left.emissionRate, right.emissionRate);
+            EXPECT_FLOAT_EQ(left.lifeTime, right.lifeTime);
+            EXPECT_FLOAT_EQ(left.speed, right.speed);
+            EXPECT_FLOAT_EQ(left.direction, right.direction);
+            EXPECT_FLOAT_EQ(left.spread, right.spread);
+            EXPECT_EQ(left.gravity, right.gravity);
+            EXPECT_FLOAT_EQ(left.startSize, right.startSize);
+            EXPECT_FLOAT_EQ(left.endSize, right.endSize);
+            expectColor(left.startColor, right.startColor);
+            expectColor(left.endColor, right.endColor);
+            EXPECT_EQ(left.maxParticles, right.maxParticles);
+            EXPECT_EQ(left.layerIndex, right.layerIndex);
+            EXPECT_EQ(left.emitting, right.emitting);
+        }
+    }
+}
+
+TEST(Serializers, SceneYAMLRoundTrip) {
+    editor::SceneData sceneData;
+    makeScene(sceneData);
+
+    YAML::Emitter out;
+    editor::SceneYAMLFormat{}.saveToEmitter(out, sceneData);
+    ASSERT_TRUE(out.good());
+
+    editor::SceneData loaded;
+    ASSERT_TRUE(editor::SceneYAMLFormat{}.loadFromNode(YAML::Load(out.c_str()), loaded));
+    expectSameScene(sceneData, loaded);
+}
+
+TEST(Serializers, SceneBinaryRoundTrip) {
+    editor::SceneData sceneData;
+    makeScene(sceneData);
+
+    std::vector<std::uint8_t> buffer;
+    editor::SceneBinaryFormat{}.saveToMemory(buffer, sceneData);
+
+    editor::SceneData loaded;
+    ASSERT_TRUE(editor::SceneBinaryFormat{}.loadFromMemory(buffer.data(), buffer.size(), loaded));
+    expectSameScene(sceneData, loaded);
+}
+
+TEST(Serializers, SceneYAMLToBinaryAndBack) {
+    editor::SceneData sceneData;
+    makeScene(sceneData);
+
+    YAML::Emitter yamlOut;
+    editor::SceneYAMLFormat{}.saveToEmitter(yamlOut, sceneData);
+    editor::SceneData fromYaml;
+    ASSERT_TRUE(editor::SceneYAMLFormat{}.loadFromNode(YAML::Load(yamlOut.c_str()), fromYaml));
+
+    std::vector<std::uint8_t> buffer;
+    editor::SceneBinaryFormat{}.saveToMemory(buffer, fromYaml);
+    editor::SceneData fromBinary;
+    ASSERT_TRUE(editor::SceneBinaryFormat{}.loadFromMemory(buffer.data(), buffer.size(), fromBinary));
+
+    YAML::Emitter binaryOut;
+    editor::SceneYAMLFormat{}.saveToEmitter(binaryOut, fromBinary);
+    expectSameScene(sceneData, fromBinary);
+    EXPECT_EQ(std::string{yamlOut.c_str()}, std::string{binaryOut.c_str()});
+}
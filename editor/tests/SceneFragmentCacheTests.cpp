@@ -0,0 +1,197 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+
+#include <robot2D/Core/MessageBus.hpp>
+#include <robot2D/Ecs/EntityManager.hpp>
+#include <robot2D/Ecs/Scene.hpp>
+#include <editor/serializers/SceneFragmentCache.hpp>
+#include <editor/SceneGraph.hpp>
+#include <editor/Components.hpp>
+
+namespace {
+    constexpr std::uint64_t firstUUID = 11;
+    constexpr std::uint64_t secondUUID = 22;
+    constexpr std::uint64_t thirdUUID = 33;
+
+    /// Same shape of output as EntityYAMLSerializer: parent and children ids are part of entity's YAML.
+    std::string emitEntity(editor::SceneEntity& entity) {
+        YAML::Emitter out;
+        out << YAML::BeginSeq << YAML::BeginMap;
+        out << YAML::Key << "Entity" << YAML::Value << static_cast<std::uint64_t>(entity.getUUID());
+        out << YAML::Key << "TagComponent" << YAML::Value << YAML::BeginMap;
+        out << YAML::Key << "Tag" << YAML::Value << entity.getComponent<editor::TagComponent>().getTag();
+        out << YAML::EndMap;
+
+        auto& transform = entity.getComponent<editor::TransformComponent>();
+        out << YAML::Key << "TransformComponent" << YAML::Value << YAML::BeginMap;
+        out << YAML::Key << "Position" << YAML::Value << YAML::Flow << YAML::BeginSeq
+            << transform.getPosition().x << transform.getPosition().y << YAML::EndSeq;
+        if(transform.hasChildren()) {
+            std::vector<std::uint64_t> childIds;
+            for(auto& child: transform.getChildren())
+                childIds.emplace_back(child.getUUID());
+            out << YAML::Key << "ChildIDs" << YAML::Value << YAML::Flow << childIds;
+        }
+        if(transform.isChild())
+            out << YAML::Key << "ParentID" << YAML::Value
+                << static_cast<std::uint64_t>(transform.getParent().getUUID());
+        out << YAML::EndMap;
+        out << YAML::EndMap << YAML::EndSeq;
+        return {out.c_str(), out.size()};
+    }
+
+    class SceneFragmentCacheTest: public ::testing::Test {
+    protected:
+        SceneFragmentCacheTest(): m_ecsScene{m_messageBus, false}, m_sceneGraph{m_messageBus} {}
+
+        editor::SceneEntity createEntity(std::uint64_t uuid, const std::string& tag) {
+            auto entity = m_sceneGraph.createEntity(m_ecsScene.createEntity());
+            entity.addComponent<editor::IDComponent>().ID = uuid;
+            entity.addComponent<editor::TagComponent>(tag);
+            entity.addComponent<editor::TransformComponent>().setPosition({static_cast<float>(uuid), 0.f});
+            m_sceneGraph.addEntity(entity);
+            return entity;
+        }
+
+        editor::SceneEntity& getEntity(std::uint64_t uuid) {
+            for(auto& entity: m_sceneGraph.getEntities()) {
+                if(static_cast<std::uint64_t>(entity.getUUID()) == uuid)
+                    return entity;
+            }
+            throw std::runtime_error("no entity " + std::to_string(uuid));
+        }
+
+        std::string emit(editor::SceneFragmentCache& cache) {
+            std::string text = "Scene: Fragments\nEntities:";
+            const auto countingEmit = [this](editor::SceneEntity& entity) {
+                ++m_emitCount;
+                return emitEntity(entity);
+            };
+            if(!cache.appendEntities(text, m_sceneGraph.getEntities(), countingEmit))
+                text += "\n  []";
+            return text;
+        }
+
+        /// Save through scene's cache, file is always written.
+        std::string save() {
+            m_emitCount = 0;
+            auto text = emit(m_cache);
+            m_cache.commit();
+            return text;
+        }
+
+        /// Save of same scene without any cached fragment.
+        std::string freshSave() {
+            editor::SceneFragmentCache cache;
+            const auto emitCount = m_emitCount;
+            auto text = emit(cache);
+            m_emitCount = emitCount;
+            return text;
+        }
+
+        void SetUp() override {
+            createEntity(firstUUID, "First");
+            createEntity(secondUUID, "Second");
+            createEntity(thirdUUID, "Third");
+        }
+
+        robot2D::MessageBus m_messageBus;
+        robot2D::ecs::Scene m_ecsScene;
+        editor::SceneGraph m_sceneGraph;
+        editor::SceneFragmentCache m_cache;
+        int m_emitCount{0};
+    };
+}
+
+TEST_F(SceneFragmentCacheTest, UntouchedSceneIsSplicedFromCache) {
+    const auto first = save();
+    EXPECT_EQ(m_emitCount, 3);
+    EXPECT_EQ(m_cache.getFragmentsCount(), 3u);
+
+    const auto second = save();
+    EXPECT_EQ(m_emitCount, 0);
+    EXPECT_EQ(second, first);
+    EXPECT_EQ(second, freshSave());
+
+    const auto sceneNode = YAML::Load(second);
+    EXPECT_EQ(sceneNode["Entities"].size(), 3u);
+}
+
+TEST_F(SceneFragmentCacheTest, EditedEntityIsEmittedAgain) {
+    save();
+
+    getEntity(secondUUID).getComponent<editor::TransformComponent>().setPosition({5.f, 7.f});
+    auto moved = save();
+    EXPECT_EQ(m_emitCount, 1);
+    EXPECT_EQ(moved, freshSave());
+
+    getEntity(thirdUUID).getComponent<editor::TagComponent>().setTag("Renamed");
+    m_cache.markDirty(thirdUUID);
+    auto renamed = save();
+    EXPECT_EQ(m_emitCount, 1);
+    EXPECT_EQ(renamed, freshSave());
+    EXPECT_EQ(YAML::Load(renamed)["Entities"][2]["TagComponent"]["Tag"].as<std::string>(), "Renamed");
+}
+
+TEST_F(SceneFragmentCacheTest, ReparentingChangesParentAndChildFragments) {
+    save();
+
+    auto child = getEntity(thirdUUID);
+    m_sceneGraph.getEntities().remove(child);
+    getEntity(firstUUID).addChild(child);
+    auto attached = save();
+    EXPECT_EQ(m_emitCount, 2);
+    EXPECT_EQ(attached, freshSave());
+
+    auto sceneNode = YAML::Load(attached);
+    ASSERT_EQ(sceneNode["Entities"].size(), 3u);
+    EXPECT_EQ(sceneNode["Entities"][1]["Entity"].as<std::uint64_t>(), thirdUUID);
+    EXPECT_EQ(sceneNode["Entities"][1]["TransformComponent"]["ParentID"].as<std::uint64_t>(), firstUUID);
+
+    getEntity(firstUUID).getComponent<editor::TransformComponent>().removeChild(child, false);
+    getEntity(secondUUID).addChild(child);
+    auto moved = save();
+    EXPECT_EQ(m_emitCount, 3);
+    EXPECT_EQ(moved, freshSave());
+    sceneNode = YAML::Load(moved);
+    EXPECT_FALSE(sceneNode["Entities"][0]["TransformComponent"]["ChildIDs"]);
+    EXPECT_EQ(sceneNode["Entities"][2]["TransformComponent"]["ParentID"].as<std::uint64_t>(), secondUUID);
+}
+
+TEST_F(SceneFragmentCacheTest, RemovedEntityIsDroppedFromSaveAndCache) {
+    save();
+
+    m_sceneGraph.removeEntity(getEntity(secondUUID));
+    m_sceneGraph.update(0.f, m_ecsScene);
+    auto removed = save();
+    EXPECT_EQ(m_emitCount, 0);
+    EXPECT_EQ(removed, freshSave());
+    EXPECT_EQ(m_cache.getFragmentsCount(), 2u);
+    EXPECT_EQ(removed.find(std::to_string(secondUUID)), std::string::npos);
+
+    m_sceneGraph.removeEntity(getEntity(firstUUID));
+    m_sceneGraph.removeEntity(getEntity(thirdUUID));
+    m_sceneGraph.update(0.f, m_ecsScene);
+    auto empty = save();
+    EXPECT_EQ(empty, freshSave());
+    EXPECT_EQ(m_cache.getFragmentsCount(), 0u);
+    EXPECT_EQ(YAML::Load(empty)["Entities"].size(), 0u);
+}
+
+TEST_F(SceneFragmentCacheTest, RollbackKeepsPreviousFragments) {
+    save();
+
+    getEntity(firstUUID).getComponent<editor::TransformComponent>().setPosition({1.f, 2.f});
+    m_emitCount = 0;
+    emit(m_cache);
+    m_cache.rollback();
+    EXPECT_EQ(m_emitCount, 1);
+    EXPECT_EQ(m_cache.getFragmentsCount(), 3u);
+
+    EXPECT_EQ(save(), freshSave());
+    EXPECT_EQ(m_emitCount, 1);
+}
@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+
+#include <robot2D/Util/Logger.hpp>
+#include <editor/SceneJournal.hpp>
+#include <editor/SceneJournalFormat.hpp>
+
+namespace {
+    namespace fs = std::filesystem;
+
+    constexpr std::uint64_t firstUUID = 11;
+    constexpr std::uint64_t secondUUID = 22;
+    constexpr std::uint64_t thirdUUID = 33;
+
+    std::string entityYAML(std::uint64_t uuid, const std::string& tag) {
+        return "- Entity: " + std::to_string(uuid) + "\n  TagComponent:\n    Tag: " + tag + "\n";
+    }
+
+    std::string upsert(std::uint64_t uuid, const std::string& tag) {
+        std::string payload;
+        editor::journal::write(payload, uuid);
+        payload += entityYAML(uuid, tag);
+        std::string bytes;
+        editor::journal::appendRecord(bytes, editor::journal::RecordType::Upsert, payload);
+        return bytes;
+    }
+
+    std::string remove(std::uint64_t uuid) {
+        std::string payload;
+        editor::journal::write(payload, uuid);
+        std::string bytes;
+        editor::journal::appendRecord(bytes, editor::journal::RecordType::Remove, payload);
+        return bytes;
+    }
+
+    std::string order(const std::vector<std::uint64_t>& uuids) {
+        std::string payload;
+        for(const auto uuid: uuids)
+            editor::journal::write(payload, uuid);
+        std::string bytes;
+        editor::journal::appendRecord(bytes, editor::journal::RecordType::Order, payload);
+        return bytes;
+    }
+
+    class SceneJournalTest: public ::testing::Test {
+    protected:
+        static void SetUpTestSuite() {
+            if(!logger::Log::getEditorLogger())
+                logger::Log::Init();
+        }
+
+        void SetUp() override {
+            m_directory = fs::temp_directory_path() / "robot2D-journal-tests";
+            fs::create_directories(m_directory);
+            m_scenePath = (m_directory / "scene.robot2D").string();
+
+            std::ofstream scene{m_scenePath};
+            scene << "Scene: Journal\nEntities:\n"
+                  << entityYAML(firstUUID, "First") << entityYAML(secondUUID, "Second");
+        }
+
+        void TearDown() override {
+            std::error_code errorCode;
+            fs::remove_all(m_directory, errorCode);
+        }
+
+        std::string header() const {
+            return editor::journal::makeHeader(editor::journal::sceneStamp(m_scenePath));
+        }
+
+        void writeJournal(const std::string& bytes) const {
+            std::ofstream journal{editor::SceneJournal::getJournalPath(m_scenePath), std::ios::binary};
+            journal.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        }
+
+        YAML::Node loadScene() const {
+            return YAML::LoadFile(m_scenePath);
+        }
+
+        static std::vector<std::string> tags(const YAML::Node& sceneNode) {
+            std::vector<std::string> result;
+            for(const auto& entity: sceneNode["Entities"])
+                result.emplace_back(entity["TagComponent"]["Tag"].as<std::string>());
+            return result;
+        }
+
+        fs::path m_directory;
+        std::string m_scenePath;
+    };
+}
+
+TEST_F(SceneJournalTest, ReplayWithoutJournalKeepsScene) {
+    auto sceneNode = loadScene();
+    EXPECT_FALSE(editor::SceneJournal::replay(m_scenePath, sceneNode));
+    EXPECT_EQ(tags(sceneNode), (std::vector<std::string>{"First", "Second"}));
+}
+
+TEST_F(SceneJournalTest, UpsertReplacesExistingAndAppendsNewEntity) {
+    writeJournal(header() + upsert(secondUUID, "Edited") + upsert(thirdUUID, "Third"));
+
+    auto sceneNode = loadScene();
+    ASSERT_TRUE(editor::SceneJournal::replay(m_scenePath, sceneNode));
+    EXPECT_EQ(tags(sceneNode), (std::vector<std::string>{"First", "Edited", "Third"}));
+    EXPECT_EQ(sceneNode["Entities"][2]["Entity"].as<std::uint64_t>(), thirdUUID);
+    EXPECT_EQ(sceneNode["Scene"].as<std::string>(), "Journal");
+}
+
+TEST_F(SceneJournalTest, RemoveAndOrderRecordsRebuildSequence) {
+    writeJournal(header() + upsert(thirdUUID, "Third") + remove(firstUUID)
+                 + order({thirdUUID, secondUUID}));
+
+    auto sceneNode = loadScene();
+    ASSERT_TRUE(editor::SceneJournal::replay(m_scenePath, sceneNode));
+    EXPECT_EQ(tags(sceneNode), (std::vector<std::string>{"Third", "Second"}));
+}
+
+TEST_F(SceneJournalTest, UpsertAfterRemoveRestoresEntity) {
+    writeJournal(header() + remove(firstUUID) + upsert(firstUUID, "Restored"));
+
+    auto sceneNode = loadScene();
+    ASSERT_TRUE(editor::SceneJournal::replay(m_scenePath, sceneNode));
+    EXPECT_EQ(tags(sceneNode), (std::vector<std::string>{"Restored", "Second"}));
+}
+
+TEST_F(SceneJournalTest, TornTailIsTruncated) {
+    const auto valid = header() + upsert(secondUUID, "Edited");
+    const auto torn = upsert(thirdUUID, "Third");
+    writeJournal(valid + torn.substr(0, torn.size() / 2));
+
+    auto sceneNode = loadScene();
+    ASSERT_TRUE(editor::SceneJournal::replay(m_scenePath, sceneNode));
+    EXPECT_EQ(tags(sceneNode), (std::vector<std::string>{"First", "Edited"}));
+}
+
+TEST_F(SceneJournalTest, ChecksumMismatchStopsReplay) {
+    auto corrupted = upsert(thirdUUID, "Third");
+    corrupted.back() ^= 0x20;
+    writeJournal(header() + upsert(secondUUID, "Edited") + corrupted + remove(firstUUID));
+
+    auto sceneNode = loadScene();
+    ASSERT_TRUE(editor::SceneJournal::replay(m_scenePath, sceneNode));
+    EXPECT_EQ(tags(sceneNode), (std::vector<std::string>{"First", "Edited"}));
+}
+
+TEST_F(SceneJournalTest, StampMismatchIgnoresJournal) {
+    const auto stamp = editor::journal::sceneStamp(m_scenePath);
+    writeJournal(editor::journal::makeHeader(stamp + 1) + remove(firstUUID));
+
+    auto sceneNode = loadScene();
+    EXPECT_FALSE(editor::SceneJournal::replay(m_scenePath, sceneNode));
+    EXPECT_EQ(tags(sceneNode), (std::vector<std::string>{"First", "Second"}));
+}